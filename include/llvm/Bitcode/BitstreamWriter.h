@@ -114,6 +114,22 @@ public:
   /// \brief Retrieve the current position in the stream, in bits.
   uint64_t GetCurrentBitNo() const { return GetBufferOffset() * 8 + CurBit; }
 
+  /// \brief Overwrite the 32-bit fixed width field that starts at bit BitNo,
+  /// which must already be flushed to the output. Unlike the block size words
+  /// BackpatchWord handles, such a field need not be 32-bit aligned.
+  void BackpatchFixed32(uint64_t BitNo, uint32_t NewValue) {
+    assert(BitNo + 32 <= GetBufferOffset() * 8 && "Field not flushed yet");
+    size_t ByteNo = BitNo / 8;
+    unsigned Shift = BitNo & 7;
+    uint64_t Bits = uint64_t(NewValue) << Shift;
+    uint64_t Mask = uint64_t(0xFFFFFFFF) << Shift;
+    for (unsigned i = 0, e = Shift ? 5 : 4; i != e; ++i) {
+      unsigned char M = (unsigned char)(Mask >> (8 * i));
+      unsigned char B = (unsigned char)Out[ByteNo + i];
+      Out[ByteNo + i] = (char)((B & ~M) | (unsigned char)(Bits >> (8 * i)));
+    }
+  }
+
   //===--------------------------------------------------------------------===//
   // Basic Primitives for emitting bits to the stream.
   //===--------------------------------------------------------------------===//
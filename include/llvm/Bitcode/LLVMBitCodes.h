@@ -42,7 +42,9 @@ namespace bitc {
 
     TYPE_BLOCK_ID_NEW,
 
-    USELIST_BLOCK_ID
+    USELIST_BLOCK_ID,
+
+    FUNCTION_INDEX_BLOCK_ID
   };
 
 
@@ -332,6 +334,13 @@ namespace bitc {
     USELIST_CODE_ENTRY = 1   // USELIST_CODE_ENTRY: TBD.
   };
 
+  // The function index block only has one code (FUNCTION_INDEX_CODE_OFFSETS).
+  // Each offset is the distance in 32-bit words from the start of the index
+  // block to the FUNCTION_BLOCK of the Nth function with a body.
+  enum FunctionIndexCodes {
+    FUNCTION_INDEX_CODE_OFFSETS = 1  // OFFSETS: [offset x N]
+  };
+
   enum AttributeKindCodes {
     // = 0 is unused
     ATTR_KIND_ALIGNMENT = 1,
@@ -57,8 +57,12 @@ namespace llvm {
 
   /// WriteBitcodeToFile - Write the specified module to the specified
   /// raw output stream.  For streams where it matters, the given stream
-  /// should be in "binary" mode.
-  void WriteBitcodeToFile(const Module *M, raw_ostream &Out);
+  /// should be in "binary" mode.  If EmitFunctionIndex is true, the module
+  /// records where each function body starts, so that getLazyBitcodeModule
+  /// and getStreamedBitcodeModule can materialize any function without
+  /// reading past the bodies before it.
+  void WriteBitcodeToFile(const Module *M, raw_ostream &Out,
+                          bool EmitFunctionIndex = false);
 
 
   /// isBitcodeWrapper - Return true if the given bytes are the magic bytes
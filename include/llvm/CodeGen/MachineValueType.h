@@ -241,7 +241,8 @@ namespace llvm {
     bool isParabixVector() const {
       return (SimpleTy == MVT::v32i1 || SimpleTy == MVT::v64i1 ||
               SimpleTy == MVT::v64i2 || SimpleTy == MVT::v32i4 ||
-              SimpleTy == MVT::v128i1);
+              SimpleTy == MVT::v128i1 || SimpleTy == MVT::v256i1 ||
+              SimpleTy == MVT::v128i2 || SimpleTy == MVT::v64i4);
     }
 
     bool isParabixValue() const {
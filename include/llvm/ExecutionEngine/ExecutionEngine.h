@@ -207,7 +207,9 @@ public:
 
   /// addModule - Add a Module to the list of modules that we can JIT from.
   /// Note that this takes ownership of the Module: when the ExecutionEngine is
-  /// destroyed, it destroys the Module as well.
+  /// destroyed, it destroys the Module as well. MCJIT finds the functions and
+  /// variables of M by name as they are when it next looks up a symbol or
+  /// compiles a module, so define them before then.
   virtual void addModule(Module *M) {
     Modules.push_back(M);
   }
@@ -293,6 +295,11 @@ public:
   /// locally can use the getFunctionAddress call, which will generate code
   /// and apply final preparations all in one step.
   ///
+  /// MCJIT generates code for different modules in parallel when this, or a
+  /// call that leads to it, is made from several threads.  This needs
+  /// llvm_start_multithreaded(), and the modules compiled at the same time
+  /// must belong to different LLVMContexts.
+  ///
   /// This method has no effect for the legacy JIT engine or the interpeter.
   virtual void generateCodeForModule(Module *M) {}
 
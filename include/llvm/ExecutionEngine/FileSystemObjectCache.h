@@ -0,0 +1,91 @@
+//===-- FileSystemObjectCache.h - On-disk object cache for MCJIT -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares an ObjectCache that keeps compiled objects in a directory
+// so that they survive the process.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_FILESYSTEMOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_FILESYSTEMOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/DataTypes.h"
+#include "llvm/Support/Mutex.h"
+#include <string>
+
+namespace llvm {
+
+class TargetMachine;
+
+/// An ObjectCache that stores each compiled object as a file in a cache
+/// directory, so that a later process JITing the same module loads the object
+/// instead of running code generation again.
+///
+/// Objects are keyed by an MD5 hash of the module's bitcode together with the
+/// target triple, CPU, feature string and optimization level of the
+/// TargetMachine the cache was created for; a module that changes, or the
+/// same module compiled for a different target, misses. The module identifier
+/// is not part of the key.
+///
+/// Files are written through FileOutputBuffer, so another process sharing the
+/// directory never sees a partial object, and hits are memory mapped. If
+/// MaxCacheSize is non-zero, the least recently used objects are removed
+/// after each write until the cached objects fit in MaxCacheSize bytes.
+///
+/// Typical use with MCJIT:
+/// \code
+///   FileSystemObjectCache Cache(Dir, *EE->getTargetMachine());
+///   EE->setObjectCache(&Cache);
+/// \endcode
+class FileSystemObjectCache : public ObjectCache {
+  FileSystemObjectCache(const FileSystemObjectCache&) LLVM_DELETED_FUNCTION;
+  void operator=(const FileSystemObjectCache&) LLVM_DELETED_FUNCTION;
+
+public:
+  FileSystemObjectCache(StringRef CacheDir, const TargetMachine &TM,
+                        uint64_t MaxCacheSize = 0);
+  virtual ~FileSystemObjectCache();
+
+  /// Write the object compiled for M to the cache directory.
+  void notifyObjectCompiled(const Module *M, const MemoryBuffer *Obj) override;
+
+  /// Map the cached object for M, or return null if there is none.
+  MemoryBuffer *getObject(const Module *M) override;
+
+  /// Return the cache file that holds, or would hold, the object for M. Code
+  /// generation changes the IR, so ask before M is compiled.
+  std::string getCachePath(const Module *M) const;
+
+  /// Remove least recently used objects until the cached objects fit in
+  /// MaxCacheSize bytes. Does nothing if MaxCacheSize is zero. KeepPath, if
+  /// given, is removed last among objects last used at the same time.
+  void prune(StringRef KeepPath = StringRef());
+
+private:
+  std::string getCacheKey(const Module *M) const;
+  std::string getPathForKey(StringRef Key) const;
+
+  std::string CacheDir;
+  /// Triple, CPU, features and optimization level, hashed into every key.
+  std::string TargetKey;
+  uint64_t MaxCacheSize;
+
+  /// Keys computed by getObject for modules that missed, taken back out by
+  /// notifyObjectCompiled. Code generation rewrites the IR before
+  /// notifyObjectCompiled is called, so the key must be taken beforehand.
+  /// Guarded by PendingKeysLock; MCJIT may compile several modules at once.
+  mutable sys::Mutex PendingKeysLock;
+  DenseMap<const Module *, std::string> PendingKeys;
+};
+
+}
+
+#endif
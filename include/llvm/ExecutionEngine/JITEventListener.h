@@ -123,6 +123,11 @@ public:
   }
 #endif // USE_OPROFILE
 
+  /// Construct a listener that tells Linux perf about JITed functions: each
+  /// one gets a line in /tmp/perf-<pid>.map, and with \p JITDump its code and
+  /// line table go to jit-<pid>.dump, in $JITDUMPDIR or /tmp, for
+  /// perf inject --jit. Returns null on other systems.
+  static JITEventListener *createPerfJITEventListener(bool JITDump = false);
 };
 
 } // end namespace llvm.
@@ -19,6 +19,9 @@ class Module;
 /// This is the base ObjectCache type which can be provided to an
 /// ExecutionEngine for the purpose of avoiding compilation for Modules that
 /// have already been compiled and an object file is available.
+///
+/// MCJIT compiles modules on whichever threads ask for them, so both methods
+/// may be called concurrently, for different modules.
 class ObjectCache {
   virtual void anchor();
 public:
@@ -105,6 +105,13 @@ public:
   virtual void notifyObjectLoaded(ExecutionEngine *EE,
                                   const ObjectImage *) {}
 
+  /// This method is called when an object that was reported to
+  /// notifyObjectLoaded is removed from the execution engine.  Its sections
+  /// are no longer used, and the memory manager may release the memory they
+  /// were allocated in.
+  virtual void notifyObjectFreed(ExecutionEngine *EE,
+                                 const ObjectImage *) {}
+
   /// This method is called when object loading is complete and section page
   /// permissions can be applied.  It is up to the memory manager implementation
   /// to decide whether or not to act on this method.  The memory manager will
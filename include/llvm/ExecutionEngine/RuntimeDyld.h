@@ -57,6 +57,12 @@ public:
   /// failure, the input object will be deleted.
   ObjectImage *loadObject(std::unique_ptr<object::ObjectFile> InputObject);
 
+  /// Forget an object returned by loadObject: its symbols are no longer
+  /// found and the EH frames among its sections are deregistered. The
+  /// relocations of the object must have been resolved. The memory of its
+  /// sections is left to the memory manager; the caller still owns Obj.
+  void unloadObject(ObjectImage *Obj);
+
   /// Get the address of our local copy of the symbol. This may or may not
   /// be the address used for relocation (clients can copy the data around
   /// and resolve relocatons based on where they put it).
@@ -15,10 +15,12 @@
 #ifndef LLVM_EXECUTIONENGINE_SECTIONMEMORYMANAGER_H
 #define LLVM_EXECUTIONENGINE_SECTIONMEMORYMANAGER_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ExecutionEngine/RuntimeDyld.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Memory.h"
+#include <vector>
 
 namespace llvm {
 
@@ -35,14 +37,46 @@ namespace llvm {
 /// in the JITed object.  Permissions can be applied either by calling
 /// MCJIT::finalizeObject or by calling SectionMemoryManager::finalizeMemory
 /// directly.  Clients of MCJIT should call MCJIT::finalizeObject.
+///
+/// By default the sections of consecutive objects share blocks, and memory is
+/// only returned to the operating system when the memory manager is
+/// destroyed. With setObjectUnloading, the sections of each object reported
+/// to notifyObjectLoaded are allocated in blocks of their own, which
+/// notifyObjectFreed returns.
+///
+/// Given an arena size, the memory manager maps one region of that size on
+/// its first allocation and takes the blocks from it: code from the bottom
+/// up, data from the top down. Each object reserves one block for its code
+/// and one for each kind of data before it is loaded, sized from what
+/// RuntimeDyld asks for. The code of all objects then sits together,
+/// in as few pages and TLB entries as it can, and finalizeMemory changes the
+/// permissions of each run of adjacent blocks at once. The blocks of a freed
+/// object go back to the arena rather than to the operating system, and
+/// merge back into its unused middle where they border it. Blocks that do
+/// not fit in the arena are mapped on their own.
 class SectionMemoryManager : public RTDyldMemoryManager {
   SectionMemoryManager(const SectionMemoryManager&) LLVM_DELETED_FUNCTION;
   void operator=(const SectionMemoryManager&) LLVM_DELETED_FUNCTION;
 
 public:
-  SectionMemoryManager() { }
+  SectionMemoryManager()
+    : ObjectUnloading(false), ArenaSize(0), UseHugePages(false) { }
+
+  /// Allocate sections from an arena of \p ArenaSize bytes. With
+  /// \p UseHugePages the arena is mapped with sys::Memory::MF_HUGE_HINT.
+  explicit SectionMemoryManager(uintptr_t ArenaSize,
+                                bool UseHugePages = false)
+    : ObjectUnloading(false), ArenaSize(ArenaSize),
+      UseHugePages(UseHugePages) { }
+
   virtual ~SectionMemoryManager();
 
+  /// \brief Allocate the sections of each object loaded from now on in
+  /// blocks of their own, so that notifyObjectFreed can release them. This
+  /// costs at least one block per object and kind of section; enable it if
+  /// the engine will remove modules.
+  void setObjectUnloading(bool Enable);
+
   /// \brief Allocates a memory block of (at least) the given size suitable for
   /// executable code.
   ///
@@ -61,6 +95,16 @@ public:
                                unsigned SectionID, StringRef SectionName,
                                bool isReadOnly) override;
 
+  /// \brief Set aside one block for each kind of section of the object about
+  /// to be loaded, so that its sections are allocated together.
+  void reserveAllocationSpace(uintptr_t CodeSize, uintptr_t DataSizeRO,
+                              uintptr_t DataSizeRW) override;
+
+  /// Only objects allocated from an arena reserve their blocks up front.
+  /// Without one, a block per kind of section and object would be a separate
+  /// page-rounded mapping.
+  bool needsToReserveAllocationSpace() override { return ArenaSize != 0; }
+
   /// \brief Update section-specific memory permissions and other attributes.
   ///
   /// This method is called when object loading is complete and section page
@@ -74,7 +118,8 @@ public:
   /// \returns true if an error occurred, false otherwise.
   bool finalizeMemory(std::string *ErrMsg = nullptr) override;
 
-  /// \brief Invalidate instruction cache for code sections.
+  /// \brief Invalidate instruction cache for the code sections allocated since
+  /// the last call to finalizeMemory.
   ///
   /// Some platforms with separate data cache and instruction cache require
   /// explicit cache flush, otherwise JIT code manipulations (like resolved
@@ -83,9 +128,20 @@ public:
   /// This method is called from finalizeMemory.
   virtual void invalidateInstructionCache();
 
+  /// \brief With object unloading, give the blocks allocated since the
+  /// previous object was loaded to \p Obj, and start allocating the next
+  /// object's sections in new blocks.
+  void notifyObjectLoaded(ExecutionEngine *EE,
+                          const ObjectImage *Obj) override;
+
+  /// \brief Release the blocks the sections of \p Obj were allocated in.
+  void notifyObjectFreed(ExecutionEngine *EE, const ObjectImage *Obj) override;
+
 private:
   struct MemoryGroup {
-      SmallVector<sys::MemoryBlock, 16> AllocatedMem;
+      // The blocks finalizeMemory has not yet applied permissions to. Earlier
+      // blocks keep theirs, since no section is allocated from them again.
+      SmallVector<sys::MemoryBlock, 16> PendingMem;
       SmallVector<sys::MemoryBlock, 16> FreeMem;
       sys::MemoryBlock Near;
   };
@@ -93,12 +149,38 @@ private:
   uint8_t *allocateSection(MemoryGroup &MemGroup, uintptr_t Size,
                            unsigned Alignment);
 
+  /// Map a new block of at least \p Size bytes for \p MemGroup, from the
+  /// arena if there is one, and count it as the loading object's.
+  sys::MemoryBlock allocateBlock(MemoryGroup &MemGroup, uintptr_t Size);
+
+  sys::MemoryBlock allocateFromArena(bool FromBottom, uintptr_t Size);
+
+  bool isInArena(const sys::MemoryBlock &MB) const;
+
+  void releaseBlock(sys::MemoryBlock &MB);
+
   error_code applyMemoryGroupPermissions(MemoryGroup &MemGroup,
                                          unsigned Permissions);
 
   MemoryGroup CodeMem;
   MemoryGroup RWDataMem;
   MemoryGroup RODataMem;
+
+  // The blocks allocated, in all groups, since the last object was loaded,
+  // and the blocks of each loaded object. Without object unloading, the
+  // blocks of loaded objects are shared and kept in SharedMem instead.
+  bool ObjectUnloading;
+  std::vector<sys::MemoryBlock> LoadingMem;
+  DenseMap<const ObjectImage *, std::vector<sys::MemoryBlock> > ObjectMem;
+  std::vector<sys::MemoryBlock> SharedMem;
+
+  uintptr_t ArenaSize;
+  bool UseHugePages;
+  // The arena once it is mapped, the ends of its code and data parts, and
+  // the blocks freed inside them, sorted by address.
+  sys::MemoryBlock Arena;
+  uintptr_t ArenaCodeEnd, ArenaDataBegin;
+  SmallVector<sys::MemoryBlock, 16> ArenaFreeMem;
 };
 
 }
@@ -47,7 +47,12 @@ namespace sys {
     enum ProtectionFlags {
       MF_READ  = 0x1000000,
       MF_WRITE = 0x2000000,
-      MF_EXEC  = 0x4000000
+      MF_EXEC  = 0x4000000,
+
+      /// Asks allocateMappedMemory to back the block with huge pages where
+      /// the operating system can. It is only a hint: the block may get
+      /// normal pages, and it is not passed to protectMappedMemory.
+      MF_HUGE_HINT = 0x0000001
     };
 
     /// This method allocates a block of memory that is suitable for loading
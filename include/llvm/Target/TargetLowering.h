@@ -480,14 +480,10 @@ public:
   LegalizeAction getOperand0Action(ISD::NodeType Op, EVT VT) const {
     // FIXME: we only use operand0action for simpleTy for now.
     if (VT.isExtended()) return Legal;
+    if (Op >= array_lengthof(Operand0Actions[0])) return Legal;
 
-    Operand0ActionsKeyTy key = std::make_pair(VT.getSimpleVT(), Op);
-    auto iter = Operand0Actions.find(key);
-    if (iter == Operand0Actions.end()) {
-      return Legal;
-    } else {
-      return iter->second;
-    }
+    unsigned I = (unsigned) VT.getSimpleVT().SimpleTy;
+    return (LegalizeAction)Operand0Actions[I][Op];
   }
 
   /// Return true if the specified operation is legal on this target or can be
@@ -1100,13 +1096,12 @@ protected:
   /// specified operand type, and indicate what to do about it.
   void setOperand0Action(ISD::NodeType Op, MVT VT,
                         LegalizeAction Action) {
-    assert(Op < array_lengthof(OpActions[0]) && "Op too large for the table");
-    Operand0ActionsKeyTy key = std::make_pair(VT, Op);
-    Operand0Actions[key] = Action;
+    assert(Op < array_lengthof(Operand0Actions[0]) && "Op too large for the table");
+    Operand0Actions[(unsigned)VT.SimpleTy][Op] = (uint8_t)Action;
   }
 
   void resetOperand0Action() {
-    Operand0Actions.clear();
+    memset(Operand0Actions, 0, sizeof(Operand0Actions));
   }
 
   /// Indicate that the specified load with extension does not work with the
@@ -1597,9 +1592,10 @@ private:
   /// non-legal value types are not described here.
   uint8_t OpActions[MVT::LAST_VALUETYPE][ISD::BUILTIN_OP_END];
 
-  /// Same with OpActions, but for Operand(0)
-  typedef std::pair<MVT, ISD::NodeType> Operand0ActionsKeyTy;
-  std::map<Operand0ActionsKeyTy, LegalizeAction> Operand0Actions;
+  /// Same with OpActions, but keyed on the type of Operand(0). The legalizer
+  /// checks it for every node with operands, so it is a flat table too.
+  /// Entries default to Legal (zero).
+  uint8_t Operand0Actions[MVT::LAST_VALUETYPE][ISD::BUILTIN_OP_END];
 
   /// For each load extension type and each value type, keep a LegalizeAction
   /// that indicates how instruction selection should deal with a load of a
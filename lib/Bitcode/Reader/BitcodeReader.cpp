@@ -1664,6 +1664,53 @@ error_code BitcodeReader::ParseUseLists() {
   }
 }
 
+/// ParseFunctionIndex - Read where the body of each function starts. The
+/// index follows the prototypes, so FunctionsWithBodies is complete and still
+/// in the order of the bodies.
+error_code BitcodeReader::ParseFunctionIndex() {
+  if (SeenFirstFunctionBody)
+    return Error(InvalidFunctionIndex);
+  if (Stream.EnterSubBlock(bitc::FUNCTION_INDEX_BLOCK_ID))
+    return Error(InvalidRecord);
+
+  // The offsets count 32-bit words from here.
+  uint64_t IndexStart = Stream.GetCurrentBitNo();
+
+  SmallVector<uint64_t, 64> Record;
+  while (1) {
+    BitstreamEntry Entry = Stream.advanceSkippingSubblocks();
+
+    switch (Entry.Kind) {
+    case BitstreamEntry::SubBlock: // Handled for us already.
+    case BitstreamEntry::Error:
+      return Error(MalformedBlock);
+    case BitstreamEntry::EndBlock:
+      return error_code::success();
+    case BitstreamEntry::Record:
+      // The interesting case.
+      break;
+    }
+
+    // Read a record.
+    Record.clear();
+    switch (Stream.readRecord(Entry.ID, Record)) {
+    default:  // Default behavior: unknown type.
+      break;
+    case bitc::FUNCTION_INDEX_CODE_OFFSETS:  // OFFSETS: [offset x N]
+      if (Record.size() != FunctionsWithBodies.size())
+        return Error(InvalidFunctionIndex);
+      for (unsigned i = 0, e = Record.size(); i != e; ++i) {
+        if (!Record[i])
+          return Error(InvalidFunctionIndex);
+        DeferredFunctionInfo[FunctionsWithBodies[i]] =
+            (IndexStart + Record[i] * 32) | IndexedBodyBit;
+      }
+      HasFunctionIndex = true;
+      break;
+    }
+  }
+}
+
 /// RememberAndSkipFunctionBody - When we see the block for a function body,
 /// remember where it is and then skip it.  This lets us lazily deserialize the
 /// functions.
@@ -1771,9 +1818,15 @@ error_code BitcodeReader::ParseModule(bool Resume) {
         if (error_code EC = ParseMetadata())
           return EC;
         break;
-      case bitc::FUNCTION_BLOCK_ID:
+      case bitc::FUNCTION_INDEX_BLOCK_ID:
+        ModuleCodeSize = Stream.getAbbrevIDWidth();
+        if (error_code EC = ParseFunctionIndex())
+          return EC;
+        break;
+      case bitc::FUNCTION_BLOCK_ID: {
         // If this is the first function body we've seen, reverse the
         // FunctionsWithBodies list.
+        bool FirstBody = !SeenFirstFunctionBody;
         if (!SeenFirstFunctionBody) {
           std::reverse(FunctionsWithBodies.begin(), FunctionsWithBodies.end());
           if (error_code EC = GlobalCleanup())
@@ -1788,12 +1841,16 @@ error_code BitcodeReader::ParseModule(bool Resume) {
         // necessary. For streaming, the function bodies must be at the end of
         // the bitcode. If the bitcode file is old, the symbol table will be
         // at the end instead and will not have been seen yet. In this case,
-        // just finish the parse now.
-        if (LazyStreamer && SeenValueSymbolTable) {
+        // just finish the parse now. With a function index, bodies are found
+        // through it rather than in order, so stop at the first one whether
+        // streaming or not, and read the rest only when resumed.
+        if (SeenValueSymbolTable &&
+            (HasFunctionIndex ? FirstBody : LazyStreamer != nullptr)) {
           NextUnreadBit = Stream.GetCurrentBitNo();
           return error_code::success();
         }
         break;
+      }
       case bitc::USELIST_BLOCK_ID:
         if (error_code EC = ParseUseLists())
           return EC;
@@ -2078,7 +2135,7 @@ error_code BitcodeReader::ParseBitcodeInto(Module *M) {
         TheModule = M;
         if (error_code EC = ParseModule(false))
           return EC;
-        if (LazyStreamer)
+        if (LazyStreamer || NextUnreadBit)
           return error_code::success();
         break;
       default:
@@ -3163,6 +3220,24 @@ error_code BitcodeReader::FindFunctionInStream(Function *F,
   return error_code::success();
 }
 
+/// Find the function body where the function index says it starts, without
+/// reading the bodies before it.
+error_code BitcodeReader::FindFunctionInIndex(Function *F,
+       DenseMap<Function*, uint64_t>::iterator DeferredFunctionInfoIterator) {
+  uint64_t BlockStart = DeferredFunctionInfoIterator->second & ~IndexedBodyBit;
+
+  // Check that the index points at a FUNCTION_BLOCK, and leave its position
+  // just past the block ID, where RememberAndSkipFunctionBody records it.
+  if (!Stream.canSkipToPos(BlockStart / 8))
+    return Error(InvalidFunctionIndex);
+  Stream.JumpToBit(BlockStart);
+  if (Stream.Read(ModuleCodeSize) != bitc::ENTER_SUBBLOCK ||
+      Stream.ReadSubBlockID() != bitc::FUNCTION_BLOCK_ID)
+    return Error(InvalidFunctionIndex);
+  DeferredFunctionInfoIterator->second = Stream.GetCurrentBitNo();
+  return error_code::success();
+}
+
 //===----------------------------------------------------------------------===//
 // GVMaterializer implementation
 //===----------------------------------------------------------------------===//
@@ -3189,6 +3264,10 @@ error_code BitcodeReader::Materialize(GlobalValue *GV) {
   if (DFII->second == 0 && LazyStreamer)
     if (error_code EC = FindFunctionInStream(F, DFII))
       return EC;
+  // If the function index gave its position, check it before reading there.
+  if (DFII->second & IndexedBodyBit)
+    if (error_code EC = FindFunctionInIndex(F, DFII))
+      return EC;
 
   // Move the bit stream to the saved position of the deferred function body.
   Stream.JumpToBit(DFII->second);
@@ -3352,6 +3431,8 @@ class BitcodeErrorCategoryType : public error_category {
       return "Invalid bitcode wrapper header";
     case BitcodeReader::InvalidConstantReference:
       return "Invalid ronstant reference";
+    case BitcodeReader::InvalidFunctionIndex:
+      return "Invalid function index";
     case BitcodeReader::InvalidID:
       return "Invalid ID";
     case BitcodeReader::InvalidInstructionWithNoBB:
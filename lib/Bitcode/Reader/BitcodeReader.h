@@ -176,8 +176,18 @@ class BitcodeReader : public GVMaterializer {
 
   /// DeferredFunctionInfo - When function bodies are initially scanned, this
   /// map contains info about where to find deferred function body in the
-  /// stream.
+  /// stream. A position marked with IndexedBodyBit is where the function
+  /// index says the FUNCTION_BLOCK starts, which has not been checked yet.
   DenseMap<Function*, uint64_t> DeferredFunctionInfo;
+  static const uint64_t IndexedBodyBit = 1ULL << 63;
+
+  /// HasFunctionIndex - True if the module has a FUNCTION_INDEX block, which
+  /// gives DeferredFunctionInfo the position of every body up front.
+  bool HasFunctionIndex;
+
+  /// ModuleCodeSize - The abbrev ID width of the module block, which the
+  /// blocks the function index points at are entered with.
+  unsigned ModuleCodeSize;
 
   /// BlockAddrFwdRefs - These are blockaddr references to basic blocks.  These
   /// are resolved lazily when functions are loaded.
@@ -205,6 +215,7 @@ public:
     InvalidBitcodeSignature,
     InvalidBitcodeWrapperHeader,
     InvalidConstantReference,
+    InvalidFunctionIndex,
     InvalidID, // A read identifier is not found in the table it should be in.
     InvalidInstructionWithNoBB,
     InvalidRecord, // A read record doesn't have the expected size or structure
@@ -227,13 +238,15 @@ public:
     : Context(C), TheModule(nullptr), Buffer(buffer), BufferOwned(false),
       LazyStreamer(nullptr), NextUnreadBit(0), SeenValueSymbolTable(false),
       ValueList(C), MDValueList(C),
-      SeenFirstFunctionBody(false), UseRelativeIDs(false) {
+      SeenFirstFunctionBody(false), HasFunctionIndex(false), ModuleCodeSize(0),
+      UseRelativeIDs(false) {
   }
   explicit BitcodeReader(DataStreamer *streamer, LLVMContext &C)
     : Context(C), TheModule(nullptr), Buffer(nullptr), BufferOwned(false),
       LazyStreamer(streamer), NextUnreadBit(0), SeenValueSymbolTable(false),
       ValueList(C), MDValueList(C),
-      SeenFirstFunctionBody(false), UseRelativeIDs(false) {
+      SeenFirstFunctionBody(false), HasFunctionIndex(false), ModuleCodeSize(0),
+      UseRelativeIDs(false) {
   }
   ~BitcodeReader() {
     FreeState();
@@ -355,6 +368,7 @@ private:
 
   error_code ParseValueSymbolTable();
   error_code ParseConstants();
+  error_code ParseFunctionIndex();
   error_code RememberAndSkipFunctionBody();
   error_code ParseFunctionBody(Function *F);
   error_code GlobalCleanup();
@@ -368,6 +382,8 @@ private:
   error_code InitLazyStream();
   error_code FindFunctionInStream(Function *F,
          DenseMap<Function*, uint64_t>::iterator DeferredFunctionInfoIterator);
+  error_code FindFunctionInIndex(Function *F,
+         DenseMap<Function*, uint64_t>::iterator DeferredFunctionInfoIterator);
 };
 
 } // End llvm namespace
@@ -38,6 +38,12 @@ EnablePreserveUseListOrdering("enable-bc-uselist-preserve",
                                        "use-list order preservation."),
                               cl::init(false), cl::Hidden);
 
+static cl::opt<bool>
+EnableFunctionIndex("enable-bc-function-index",
+                    cl::desc("Emit an index of the function bodies, which "
+                             "lets lazy readers seek to any one of them."),
+                    cl::init(false), cl::Hidden);
+
 /// These are manifest constants used by the bitcode writer. They do not need to
 /// be kept in sync with the reader, but need to be consistent within this file.
 enum {
@@ -1888,8 +1894,37 @@ static void WriteModuleUseLists(const Module *M, ValueEnumerator &VE,
   Stream.ExitBlock();
 }
 
+/// WriteFunctionIndex - Emit a FUNCTION_INDEX block with a zero offset for
+/// each function with a body, and return the bit number of the first offset.
+/// WriteModule patches the offsets in as it writes the bodies. IndexStart is
+/// set to the bit number the offsets count from.
+static uint64_t WriteFunctionIndex(const Module *M, BitstreamWriter &Stream,
+                                   uint64_t &IndexStart) {
+  Stream.EnterSubblock(bitc::FUNCTION_INDEX_BLOCK_ID, 3);
+  IndexStart = Stream.GetCurrentBitNo();
+
+  // The offsets are fixed width so that they can be patched in place.
+  BitCodeAbbrev *Abbv = new BitCodeAbbrev();
+  Abbv->Add(BitCodeAbbrevOp(bitc::FUNCTION_INDEX_CODE_OFFSETS));
+  Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Array));
+  Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
+  unsigned OffsetsAbbrev = Stream.EmitAbbrev(Abbv);
+
+  SmallVector<unsigned, 64> Vals;
+  for (const Function &F : *M)
+    if (!F.isDeclaration())
+      Vals.push_back(0);
+  uint64_t NumOffsets = Vals.size();
+  Stream.EmitRecord(bitc::FUNCTION_INDEX_CODE_OFFSETS, Vals, OffsetsAbbrev);
+  uint64_t FirstOffset = Stream.GetCurrentBitNo() - 32 * NumOffsets;
+
+  Stream.ExitBlock();
+  return FirstOffset;
+}
+
 /// WriteModule - Emit the specified module to the bitstream.
-static void WriteModule(const Module *M, BitstreamWriter &Stream) {
+static void WriteModule(const Module *M, BitstreamWriter &Stream,
+                        bool EmitFunctionIndex) {
   Stream.EnterSubblock(bitc::MODULE_BLOCK_ID, 3);
 
   SmallVector<unsigned, 1> Vals;
@@ -1916,6 +1951,12 @@ static void WriteModule(const Module *M, BitstreamWriter &Stream) {
   // descriptors for global variables, and function prototype info.
   WriteModuleInfo(M, VE, Stream);
 
+  // Emit the function index after the prototypes it refers to, but ahead of
+  // everything else, so that a streaming reader sees it early.
+  uint64_t IndexStart = 0, NextIndexOffset = 0;
+  if (EmitFunctionIndex || EnableFunctionIndex)
+    NextIndexOffset = WriteFunctionIndex(M, Stream, IndexStart);
+
   // Emit constants.
   WriteModuleConstants(VE, Stream);
 
@@ -1934,8 +1975,17 @@ static void WriteModule(const Module *M, BitstreamWriter &Stream) {
 
   // Emit function bodies.
   for (Module::const_iterator F = M->begin(), E = M->end(); F != E; ++F)
-    if (!F->isDeclaration())
+    if (!F->isDeclaration()) {
+      if (NextIndexOffset) {
+        // Everything after the index is a block, so each body starts on a
+        // 32-bit boundary.
+        uint64_t BodyStart = Stream.GetCurrentBitNo();
+        assert(BodyStart % 32 == 0 && "Function block not 32-bit aligned!");
+        Stream.BackpatchFixed32(NextIndexOffset, (BodyStart - IndexStart) / 32);
+        NextIndexOffset += 32;
+      }
       WriteFunction(*F, VE, Stream);
+    }
 
   Stream.ExitBlock();
 }
@@ -2015,7 +2065,8 @@ static void EmitDarwinBCHeaderAndTrailer(SmallVectorImpl<char> &Buffer,
 
 /// WriteBitcodeToFile - Write the specified module to the specified output
 /// stream.
-void llvm::WriteBitcodeToFile(const Module *M, raw_ostream &Out) {
+void llvm::WriteBitcodeToFile(const Module *M, raw_ostream &Out,
+                              bool EmitFunctionIndex) {
   SmallVector<char, 0> Buffer;
   Buffer.reserve(256*1024);
 
@@ -2038,7 +2089,7 @@ void llvm::WriteBitcodeToFile(const Module *M, raw_ostream &Out) {
     Stream.Emit(0xD, 4);
 
     // Emit the module.
-    WriteModule(M, Stream);
+    WriteModule(M, Stream, EmitFunctionIndex);
   }
 
   if (TT.isOSDarwin())
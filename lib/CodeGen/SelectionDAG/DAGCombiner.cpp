@@ -25,6 +25,7 @@
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
@@ -187,6 +188,8 @@ namespace {
     SDValue PromoteIntShiftOp(SDValue Op);
     SDValue PromoteExtend(SDValue Op);
     bool PromoteLoad(SDValue Op);
+    SDValue ExpandUADDE(SDNode *N);
+    SDValue ExpandParabixAdvance(SDNode *N);
 
     void ExtendSetCCUses(const SmallVectorImpl<SDNode *> &SetCCs,
                          SDValue Trunc, SDValue ExtLoad, SDLoc DL,
@@ -890,6 +893,73 @@ SDValue DAGCombiner::ZExtPromoteOperand(SDValue Op, EVT PVT) {
   return DAG.getZeroExtendInReg(NewOp, dl, OldVT);
 }
 
+/// ExpandUADDE - Expand an add with carry in and carry out into two plain
+/// adds and compares. The second add only carries out when the first sum is
+/// all ones. Any integer width can be legalized from there.
+SDValue DAGCombiner::ExpandUADDE(SDNode *N) {
+  SDValue N0 = N->getOperand(0);
+  SDValue N1 = N->getOperand(1);
+  SDValue CarryIn = N->getOperand(2);
+  EVT VT = N0.getValueType();
+  EVT CarryVT = N->getValueType(1);
+  SDLoc dl(N);
+
+  if (VT.isVector())
+    return SDValue();
+
+  SDValue Sum0 = DAG.getNode(ISD::ADD, dl, VT, N0, N1);
+  SDValue Sum = DAG.getNode(ISD::ADD, dl, VT, Sum0,
+                            DAG.getZExtOrTrunc(CarryIn, dl, VT));
+  SDValue AllOnes =
+    DAG.getConstant(APInt::getAllOnesValue(VT.getSizeInBits()), VT);
+  SDValue CarryOut =
+    DAG.getNode(ISD::OR, dl, CarryVT,
+                DAG.getSetCC(dl, CarryVT, Sum0, N0, ISD::SETULT),
+                DAG.getNode(ISD::AND, dl, CarryVT, CarryIn,
+                            DAG.getSetCC(dl, CarryVT, Sum0, AllOnes,
+                                         ISD::SETEQ)));
+
+  SDValue Ops[] = { Sum, CarryOut };
+  return DAG.getMergeValues(Ops, dl);
+}
+
+/// ExpandParabixAdvance - Expand llvm.parabix.advance into plain shifts:
+/// (S << Shift) | (Carry >> (N - Shift)). The right shift is split in two so
+/// that Shift == 0 needs no shift by N; Shift == N is a select of Carry.
+SDValue DAGCombiner::ExpandParabixAdvance(SDNode *N) {
+  SDValue S = N->getOperand(1);
+  SDValue Carry = N->getOperand(2);
+  SDValue Shift = N->getOperand(3);
+  EVT VT = S.getValueType();
+  unsigned Size = VT.getSizeInBits();
+  SDLoc dl(N);
+
+  if (VT.isVector())
+    return SDValue();
+
+  // Same shift amount type as a shift in the IR would get; wide types make
+  // do with i32 until they are split.
+  EVT ShiftTy = TLI.getShiftAmountTy(VT);
+  if (ShiftTy.getSizeInBits() < Log2_32_Ceil(Size + 1))
+    ShiftTy = MVT::i32;
+  Shift = DAG.getZExtOrTrunc(Shift, dl, ShiftTy);
+
+  SDValue Hi = DAG.getNode(ISD::SHL, dl, VT, S, Shift);
+  SDValue Lo = DAG.getNode(ISD::SRL, dl, VT,
+                           DAG.getNode(ISD::SRL, dl, VT, Carry,
+                                       DAG.getConstant(1, ShiftTy)),
+                           DAG.getNode(ISD::SUB, dl, ShiftTy,
+                                       DAG.getConstant(Size - 1, ShiftTy),
+                                       Shift));
+  SDValue IsWhole = DAG.getSetCC(dl, MVT::i1, Shift,
+                                 DAG.getConstant(Size, ShiftTy), ISD::SETEQ);
+  SDValue Res = DAG.getSelect(dl, VT, IsWhole, Carry,
+                              DAG.getNode(ISD::OR, dl, VT, Hi, Lo));
+
+  SDValue Ops[] = { Res, S };
+  return DAG.getMergeValues(Ops, dl);
+}
+
 /// PromoteIntBinOp - Promote the specified integer binary operation if the
 /// target indicates it is beneficial. e.g. On x86, it's usually better to
 /// promote i16 operations to i32 since i16 instructions are longer.
@@ -1316,6 +1386,18 @@ SDValue DAGCombiner::combine(SDNode *N) {
     }
   }
 
+  // Neither the legalizer nor most targets know UADDE. If the target didn't
+  // combine it, expand it while the types are still the original ones.
+  if (!RV.getNode() && N->getOpcode() == ISD::UADDE &&
+      Level == BeforeLegalizeTypes)
+    RV = ExpandUADDE(N);
+
+  // Likewise for llvm.parabix.advance, which nothing else lowers.
+  if (!RV.getNode() && N->getOpcode() == ISD::INTRINSIC_WO_CHAIN &&
+      Level == BeforeLegalizeTypes &&
+      N->getConstantOperandVal(0) == Intrinsic::parabix_advance)
+    RV = ExpandParabixAdvance(N);
+
   // If N is a commutative binary node, try commuting it to enable more
   // sdisel CSE.
   if (!RV.getNode() && SelectionDAG::isCommutativeBinOp(N->getOpcode()) &&
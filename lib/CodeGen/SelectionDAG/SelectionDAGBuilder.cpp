@@ -5332,6 +5332,31 @@ SelectionDAGBuilder::visitIntrinsicCall(const CallInst &I, unsigned Intrinsic) {
     setValue(&I, DAG.getNode(ISD::UADDE, sdl, VTs, Op1, Op2, Op3));
     return nullptr;
   }
+  case Intrinsic::parabix_matchstar:
+  case Intrinsic::parabix_scanthru: {
+    // Both are one addition with carry plus logic. Building them around a
+    // UADDE lets targets lower the addition as a long stream addition.
+    SDValue M = getValue(I.getArgOperand(0));
+    SDValue C = getValue(I.getArgOperand(1));
+    SDValue CarryIn = getValue(I.getArgOperand(2));
+    EVT VT = M.getValueType();
+
+    SDVTList VTs = DAG.getVTList(VT, MVT::i1);
+    SDValue Sum, Res;
+    if (Intrinsic == Intrinsic::parabix_matchstar) {
+      SDValue MC = DAG.getNode(ISD::AND, sdl, VT, M, C);
+      Sum = DAG.getNode(ISD::UADDE, sdl, VTs, MC, C, CarryIn);
+      Res = DAG.getNode(ISD::OR, sdl, VT,
+                        DAG.getNode(ISD::XOR, sdl, VT, Sum, C), M);
+    } else {
+      Sum = DAG.getNode(ISD::UADDE, sdl, VTs, M, C, CarryIn);
+      Res = DAG.getNode(ISD::AND, sdl, VT, Sum, DAG.getNOT(sdl, C, VT));
+    }
+
+    SDValue Ops[] = { Res, Sum.getValue(1) };
+    setValue(&I, DAG.getMergeValues(Ops, sdl));
+    return nullptr;
+  }
   case Intrinsic::prefetch: {
     SDValue Ops[5];
     unsigned rw = cast<ConstantInt>(I.getArgOperand(1))->getZExtValue();
@@ -714,6 +714,7 @@ TargetLoweringBase::~TargetLoweringBase() {
 void TargetLoweringBase::initActions() {
   // All operations default to being supported.
   memset(OpActions, 0, sizeof(OpActions));
+  memset(Operand0Actions, 0, sizeof(Operand0Actions));
   memset(LoadExtActions, 0, sizeof(LoadExtActions));
   memset(TruncStoreActions, 0, sizeof(TruncStoreActions));
   memset(IndexedModeActions, 0, sizeof(IndexedModeActions));
@@ -0,0 +1,1076 @@
+//===- Bytecode.cpp - Register-slot bytecode for the interpreter ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file lowers functions to the bytecode described in Bytecode.h and runs
+// it. A function that uses something the bytecode does not cover (vectors,
+// aggregates, integers wider than 64 bits, varargs, invoke, most intrinsics)
+// is not lowered and is interpreted from the IR as before. Calls between the
+// two, and calls to external functions, pass GenericValues.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Interpreter.h"
+#include "Bytecode.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/GetElementPtrTypeIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MathExtras.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+using namespace llvm;
+using namespace llvm::bytecode;
+
+#define DEBUG_TYPE "interpreter"
+
+STATISTIC(NumLowered, "Number of functions lowered to bytecode");
+STATISTIC(NumNotLowered, "Number of functions interpreted from the IR");
+
+static cl::opt<bool> UseBytecode("interpreter-bytecode",
+  cl::desc("Lower each function to register-slot bytecode on its first call "
+           "and interpret that instead of the IR"));
+
+static uint64_t maskOf(unsigned Bits) {
+  return Bits == 64 ? ~0ULL : (1ULL << Bits) - 1;
+}
+
+static Slot toSlot(const GenericValue &GV, Type *Ty) {
+  Slot S;
+  S.I = 0;
+  switch (Ty->getTypeID()) {
+  case Type::IntegerTyID:
+    S.I = GV.IntVal.getZExtValue() &
+          maskOf(cast<IntegerType>(Ty)->getBitWidth());
+    break;
+  case Type::FloatTyID:   S.F = GV.FloatVal; break;
+  case Type::DoubleTyID:  S.D = GV.DoubleVal; break;
+  case Type::PointerTyID: S.I = (uintptr_t)GV.PointerVal; break;
+  default: break;
+  }
+  return S;
+}
+
+static GenericValue fromSlot(Slot S, Type *Ty) {
+  GenericValue GV;
+  switch (Ty->getTypeID()) {
+  case Type::IntegerTyID:
+    GV.IntVal = APInt(cast<IntegerType>(Ty)->getBitWidth(), S.I);
+    break;
+  case Type::FloatTyID:   GV.FloatVal = S.F; break;
+  case Type::DoubleTyID:  GV.DoubleVal = S.D; break;
+  case Type::PointerTyID: GV.PointerVal = (void *)(uintptr_t)S.I; break;
+  default: break;
+  }
+  return GV;
+}
+
+namespace llvm {
+namespace bytecode {
+
+/// Lowering - Lower one function to bytecode, or fail if it uses something
+/// the bytecode cannot express.
+class Lowering {
+  Interpreter &Interp;
+  const DataLayout &TD;
+  Code &C;
+  unsigned PtrBits;
+
+  DenseMap<const Value *, unsigned> Slots;
+  DenseMap<const BasicBlock *, unsigned> BlockStart;
+  DenseMap<std::pair<const BasicBlock *, const BasicBlock *>, unsigned> Stubs;
+  unsigned TempBase, NumTemps;
+
+  // A branch target to fill in once the blocks are laid out: the field Field
+  // of instruction InstIdx, or entry CaseIdx of SwitchCases if Field is null.
+  // The target is the start of To, through the PHI moves of the edge from
+  // From if From is not null.
+  struct Fixup {
+    unsigned InstIdx;
+    unsigned Inst::*Field;
+    unsigned CaseIdx;
+    const BasicBlock *From, *To;
+  };
+  std::vector<Fixup> Fixups;
+
+public:
+  Lowering(Interpreter &Interp, Code &C)
+      : Interp(Interp), TD(*Interp.getDataLayout()), C(C),
+        PtrBits(TD.getPointerSizeInBits()), NumTemps(0) {}
+
+  bool run(Function &F);
+
+private:
+  unsigned getBits(Type *Ty) const;
+  bool isInt(Type *Ty) const { return Ty->isIntegerTy() && getBits(Ty); }
+  bool getSlot(const Value *V, unsigned &S) const;
+  void addConstant(Constant *K);
+
+  unsigned emit(unsigned Op, unsigned Dst, unsigned A = 0, unsigned B = 0,
+                unsigned Cc = 0, uint64_t Imm = 0, unsigned Bits = 0);
+  void branchTo(unsigned InstIdx, unsigned Inst::*Field,
+                const BasicBlock *From, const BasicBlock *To);
+  bool emitEdgeMoves(const BasicBlock *From, const BasicBlock *To);
+
+  bool lowerInst(Instruction &I, const BasicBlock *Next);
+  bool lowerBinary(BinaryOperator &I);
+  bool lowerCast(CastInst &I);
+  bool lowerGEP(GetElementPtrInst &I);
+  bool lowerCall(CallInst &I);
+  bool lowerLoad(LoadInst &I);
+  bool lowerStore(StoreInst &I);
+};
+
+}
+}
+
+/// Return the width in bits of a value of type Ty, or 0 if the bytecode
+/// cannot hold it.
+unsigned Lowering::getBits(Type *Ty) const {
+  if (IntegerType *ITy = dyn_cast<IntegerType>(Ty))
+    return ITy->getBitWidth() <= 64 ? ITy->getBitWidth() : 0;
+  if (Ty->isPointerTy())
+    return PtrBits;
+  if (Ty->isFloatTy())
+    return 32;
+  if (Ty->isDoubleTy())
+    return 64;
+  return 0;
+}
+
+bool Lowering::getSlot(const Value *V, unsigned &S) const {
+  DenseMap<const Value *, unsigned>::const_iterator I = Slots.find(V);
+  if (I == Slots.end())
+    return false;
+  S = I->second;
+  return true;
+}
+
+void Lowering::addConstant(Constant *K) {
+  if (Slots.count(K) || !getBits(K->getType()))
+    return;
+  ExecutionContext SF;
+  Slots[K] = C.ConstBase + C.Consts.size();
+  C.Consts.push_back(toSlot(Interp.getOperandValue(K, SF), K->getType()));
+}
+
+unsigned Lowering::emit(unsigned Op, unsigned Dst, unsigned A, unsigned B,
+                        unsigned Cc, uint64_t Imm, unsigned Bits) {
+  Inst I;
+  I.Op = Op;
+  I.Bits = Bits;
+  I.Dst = Dst;
+  I.A = A;
+  I.B = B;
+  I.C = Cc;
+  I.Imm = Imm;
+  C.Insts.push_back(I);
+  return C.Insts.size() - 1;
+}
+
+void Lowering::branchTo(unsigned InstIdx, unsigned Inst::*Field,
+                        const BasicBlock *From, const BasicBlock *To) {
+  Fixup F = { InstIdx, Field, 0, From, To };
+  Fixups.push_back(F);
+}
+
+/// Emit the moves of the PHI nodes of To for the edge from From. They happen
+/// at once, so if one PHI reads another, every value goes through a
+/// temporary.
+bool Lowering::emitEdgeMoves(const BasicBlock *From, const BasicBlock *To) {
+  SmallVector<std::pair<unsigned, unsigned>, 8> Moves;
+  for (BasicBlock::const_iterator I = To->begin();
+       const PHINode *PN = dyn_cast<PHINode>(I); ++I) {
+    unsigned Dst, Src;
+    if (!getSlot(PN, Dst) ||
+        !getSlot(PN->getIncomingValueForBlock(From), Src))
+      return false;
+    if (Dst != Src)
+      Moves.push_back(std::make_pair(Dst, Src));
+  }
+
+  bool Overlap = false;
+  for (unsigned i = 0, e = Moves.size(); i != e && !Overlap; ++i)
+    for (unsigned j = 0; j != e; ++j)
+      if (i != j && Moves[i].second == Moves[j].first) {
+        Overlap = true;
+        break;
+      }
+  if (!Overlap) {
+    for (unsigned i = 0, e = Moves.size(); i != e; ++i)
+      emit(Move, Moves[i].first, Moves[i].second);
+    return true;
+  }
+  for (unsigned i = 0, e = Moves.size(); i != e; ++i)
+    emit(Move, TempBase + i, Moves[i].second);
+  for (unsigned i = 0, e = Moves.size(); i != e; ++i)
+    emit(Move, Moves[i].first, TempBase + i);
+  NumTemps = std::max<unsigned>(NumTemps, Moves.size());
+  return true;
+}
+
+bool Lowering::run(Function &F) {
+  // The bytecode keeps pointers in its slots as host integers and accesses
+  // memory in host byte order.
+  if (F.isVarArg() || PtrBits != sizeof(void *) * 8 ||
+      TD.isLittleEndian() != sys::IsLittleEndianHost)
+    return false;
+  if (!F.getReturnType()->isVoidTy() && !getBits(F.getReturnType()))
+    return false;
+  C.F = &F;
+
+  // Number the arguments, then every instruction with a result, then the
+  // constants the instructions use.
+  unsigned NumSlots = 0;
+  for (Function::arg_iterator AI = F.arg_begin(), E = F.arg_end(); AI != E;
+       ++AI) {
+    if (!getBits(AI->getType()))
+      return false;
+    Slots[AI] = NumSlots++;
+  }
+  for (Function::iterator BB = F.begin(), BE = F.end(); BB != BE; ++BB)
+    for (BasicBlock::iterator I = BB->begin(), E = BB->end(); I != E; ++I)
+      if (getBits(I->getType()))
+        Slots[I] = NumSlots++;
+  C.ConstBase = NumSlots;
+  for (Function::iterator BB = F.begin(), BE = F.end(); BB != BE; ++BB)
+    for (BasicBlock::iterator I = BB->begin(), E = BB->end(); I != E; ++I) {
+      // Direct callees and the operands of the intrinsics lowered to nothing
+      // need no slot.
+      const CallInst *CI = dyn_cast<CallInst>(I);
+      if (CI && isa<DbgInfoIntrinsic>(CI))
+        continue;
+      for (User::op_iterator OI = I->op_begin(), OE = I->op_end(); OI != OE;
+           ++OI)
+        if (Constant *K = dyn_cast<Constant>(*OI))
+          if (!CI || *OI != CI->getCalledValue() || !isa<Function>(K))
+            addConstant(K);
+    }
+  TempBase = C.ConstBase + C.Consts.size();
+
+  for (Function::iterator BB = F.begin(), BE = F.end(); BB != BE; ++BB) {
+    BlockStart[BB] = C.Insts.size();
+    Function::iterator Next = std::next(BB);
+    for (BasicBlock::iterator I = BB->begin(), E = BB->end(); I != E; ++I)
+      if (!lowerInst(*I, Next == BE ? nullptr : Next)) {
+        DEBUG(dbgs() << "Interpreting " << F.getName()
+                     << " from the IR, as the bytecode cannot express: " << *I
+                     << '\n');
+        return false;
+      }
+  }
+
+  // Resolve the branches, emitting the PHI moves of each edge that needs
+  // them in a stub of its own.
+  for (unsigned i = 0, e = Fixups.size(); i != e; ++i) {
+    const Fixup &Fx = Fixups[i];
+    unsigned Target = BlockStart[Fx.To];
+    if (Fx.From && isa<PHINode>(Fx.To->begin())) {
+      std::pair<const BasicBlock *, const BasicBlock *> Edge(Fx.From, Fx.To);
+      DenseMap<std::pair<const BasicBlock *, const BasicBlock *>,
+               unsigned>::iterator S = Stubs.find(Edge);
+      if (S != Stubs.end()) {
+        Target = S->second;
+      } else {
+        unsigned Stub = C.Insts.size();
+        if (!emitEdgeMoves(Fx.From, Fx.To))
+          return false;
+        emit(Br, 0, BlockStart[Fx.To]);
+        Stubs[Edge] = Target = Stub;
+      }
+    }
+    if (Fx.Field)
+      C.Insts[Fx.InstIdx].*Fx.Field = Target;
+    else
+      C.SwitchCases[Fx.CaseIdx] = Target;
+  }
+
+  C.NumSlots = TempBase + NumTemps;
+  return true;
+}
+
+bool Lowering::lowerInst(Instruction &I, const BasicBlock *Next) {
+  unsigned Dst, A, B, Cc;
+  switch (I.getOpcode()) {
+  default:
+    if (BinaryOperator *BO = dyn_cast<BinaryOperator>(&I))
+      return lowerBinary(*BO);
+    if (CastInst *CI = dyn_cast<CastInst>(&I))
+      return lowerCast(*CI);
+    return false;
+
+  case Instruction::PHI:
+    // Lowered to moves on the incoming edges.
+    return true;
+
+  case Instruction::Ret: {
+    ReturnInst &RI = cast<ReturnInst>(I);
+    if (!RI.getReturnValue()) {
+      emit(RetVoid, 0);
+      return true;
+    }
+    if (!getSlot(RI.getReturnValue(), A))
+      return false;
+    emit(Ret, 0, A);
+    return true;
+  }
+
+  case Instruction::Br: {
+    BranchInst &BI = cast<BranchInst>(I);
+    const BasicBlock *From = BI.getParent();
+    if (BI.isUnconditional()) {
+      const BasicBlock *To = BI.getSuccessor(0);
+      if (!emitEdgeMoves(From, To))
+        return false;
+      if (To != Next)
+        branchTo(emit(Br, 0), &Inst::A, nullptr, To);
+      return true;
+    }
+    if (!getSlot(BI.getCondition(), A))
+      return false;
+    unsigned Idx = emit(CondBr, 0, A);
+    branchTo(Idx, &Inst::B, From, BI.getSuccessor(0));
+    branchTo(Idx, &Inst::C, From, BI.getSuccessor(1));
+    return true;
+  }
+
+  case Instruction::Switch: {
+    SwitchInst &SI = cast<SwitchInst>(I);
+    if (!getSlot(SI.getCondition(), A))
+      return false;
+    unsigned First = C.SwitchCases.size();
+    unsigned Idx = emit(Switch, 0, A, First, SI.getNumCases());
+    branchTo(Idx, &Inst::Dst, SI.getParent(), SI.getDefaultDest());
+    for (SwitchInst::CaseIt CI = SI.case_begin(), CE = SI.case_end();
+         CI != CE; ++CI) {
+      C.SwitchCases.push_back(CI.getCaseValue()->getZExtValue());
+      C.SwitchCases.push_back(0);
+      Fixup F = { 0, nullptr, unsigned(C.SwitchCases.size() - 1),
+                  SI.getParent(), CI.getCaseSuccessor() };
+      Fixups.push_back(F);
+    }
+    return true;
+  }
+
+  case Instruction::Unreachable:
+    emit(Unreachable, 0);
+    return true;
+
+  case Instruction::ICmp: {
+    ICmpInst &CI = cast<ICmpInst>(I);
+    unsigned Bits = getBits(CI.getOperand(0)->getType());
+    if (!getSlot(&CI, Dst) || !getSlot(CI.getOperand(0), A) ||
+        !getSlot(CI.getOperand(1), B) || !Bits ||
+        !(CI.getOperand(0)->getType()->isIntegerTy() ||
+          CI.getOperand(0)->getType()->isPointerTy()))
+      return false;
+    // Greater-than compares are the less-than ones with the operands swapped.
+    switch (CI.getPredicate()) {
+    case ICmpInst::ICMP_EQ:  emit(ICmpEQ, Dst, A, B); break;
+    case ICmpInst::ICMP_NE:  emit(ICmpNE, Dst, A, B); break;
+    case ICmpInst::ICMP_ULT: emit(ICmpULT, Dst, A, B); break;
+    case ICmpInst::ICMP_ULE: emit(ICmpULE, Dst, A, B); break;
+    case ICmpInst::ICMP_UGT: emit(ICmpULT, Dst, B, A); break;
+    case ICmpInst::ICMP_UGE: emit(ICmpULE, Dst, B, A); break;
+    case ICmpInst::ICMP_SLT: emit(ICmpSLT, Dst, A, B, 0, 0, Bits); break;
+    case ICmpInst::ICMP_SLE: emit(ICmpSLE, Dst, A, B, 0, 0, Bits); break;
+    case ICmpInst::ICMP_SGT: emit(ICmpSLT, Dst, B, A, 0, 0, Bits); break;
+    case ICmpInst::ICMP_SGE: emit(ICmpSLE, Dst, B, A, 0, 0, Bits); break;
+    default: return false;
+    }
+    return true;
+  }
+
+  case Instruction::FCmp: {
+    FCmpInst &CI = cast<FCmpInst>(I);
+    Type *Ty = CI.getOperand(0)->getType();
+    if (!getSlot(&CI, Dst) || !getSlot(CI.getOperand(0), A) ||
+        !getSlot(CI.getOperand(1), B))
+      return false;
+    if (Ty->isFloatTy())
+      emit(FCmpF32, Dst, A, B, 0, CI.getPredicate());
+    else if (Ty->isDoubleTy())
+      emit(FCmpF64, Dst, A, B, 0, CI.getPredicate());
+    else
+      return false;
+    return true;
+  }
+
+  case Instruction::Select: {
+    SelectInst &SI = cast<SelectInst>(I);
+    if (!getSlot(&SI, Dst) || !getSlot(SI.getCondition(), A) ||
+        !getSlot(SI.getTrueValue(), B) || !getSlot(SI.getFalseValue(), Cc))
+      return false;
+    emit(Select, Dst, A, B, Cc);
+    return true;
+  }
+
+  case Instruction::Alloca: {
+    AllocaInst &AI = cast<AllocaInst>(I);
+    if (!getSlot(&AI, Dst) || !getSlot(AI.getArraySize(), A))
+      return false;
+    emit(Alloca, Dst, A, 0, 0, TD.getTypeAllocSize(AI.getAllocatedType()));
+    return true;
+  }
+
+  case Instruction::Load:
+    return lowerLoad(cast<LoadInst>(I));
+  case Instruction::Store:
+    return lowerStore(cast<StoreInst>(I));
+  case Instruction::GetElementPtr:
+    return lowerGEP(cast<GetElementPtrInst>(I));
+  case Instruction::Call:
+    return lowerCall(cast<CallInst>(I));
+  }
+}
+
+bool Lowering::lowerBinary(BinaryOperator &I) {
+  Type *Ty = I.getType();
+  unsigned Dst, A, B;
+  if (!getSlot(&I, Dst) || !getSlot(I.getOperand(0), A) ||
+      !getSlot(I.getOperand(1), B))
+    return false;
+
+  if (Ty->isFloatTy() || Ty->isDoubleTy()) {
+    bool F64 = Ty->isDoubleTy();
+    unsigned Op;
+    switch (I.getOpcode()) {
+    case Instruction::FAdd: Op = F64 ? FAddF64 : FAddF32; break;
+    case Instruction::FSub: Op = F64 ? FSubF64 : FSubF32; break;
+    case Instruction::FMul: Op = F64 ? FMulF64 : FMulF32; break;
+    case Instruction::FDiv: Op = F64 ? FDivF64 : FDivF32; break;
+    case Instruction::FRem: Op = F64 ? FRemF64 : FRemF32; break;
+    default: return false;
+    }
+    emit(Op, Dst, A, B);
+    return true;
+  }
+
+  if (!isInt(Ty))
+    return false;
+  unsigned Bits = getBits(Ty);
+  unsigned Op;
+  switch (I.getOpcode()) {
+  case Instruction::Add:  Op = Add; break;
+  case Instruction::Sub:  Op = Sub; break;
+  case Instruction::Mul:  Op = Mul; break;
+  case Instruction::UDiv: Op = UDiv; break;
+  case Instruction::SDiv: Op = SDiv; break;
+  case Instruction::URem: Op = URem; break;
+  case Instruction::SRem: Op = SRem; break;
+  case Instruction::Shl:  Op = Shl; break;
+  case Instruction::LShr: Op = LShr; break;
+  case Instruction::AShr: Op = AShr; break;
+  case Instruction::And:  Op = And; break;
+  case Instruction::Or:   Op = Or; break;
+  case Instruction::Xor:  Op = Xor; break;
+  default: return false;
+  }
+  emit(Op, Dst, A, B, 0, maskOf(Bits), Bits);
+  return true;
+}
+
+bool Lowering::lowerCast(CastInst &I) {
+  Type *SrcTy = I.getSrcTy(), *DstTy = I.getDestTy();
+  unsigned Dst, A;
+  if (!getSlot(&I, Dst) || !getSlot(I.getOperand(0), A))
+    return false;
+  unsigned SrcBits = getBits(SrcTy), DstBits = getBits(DstTy);
+  bool SrcInt = SrcTy->isIntegerTy() || SrcTy->isPointerTy();
+  bool DstInt = DstTy->isIntegerTy() || DstTy->isPointerTy();
+
+  switch (I.getOpcode()) {
+  case Instruction::Trunc:
+  case Instruction::ZExt:
+  case Instruction::PtrToInt:
+  case Instruction::IntToPtr:
+    if (DstBits < SrcBits)
+      emit(Trunc, Dst, A, 0, 0, maskOf(DstBits));
+    else
+      emit(Move, Dst, A);
+    return true;
+  case Instruction::SExt:
+    emit(SExt, Dst, A, 0, 0, maskOf(DstBits), SrcBits);
+    return true;
+  case Instruction::FPTrunc:
+    if (!SrcTy->isDoubleTy() || !DstTy->isFloatTy())
+      return false;
+    emit(FPTrunc, Dst, A);
+    return true;
+  case Instruction::FPExt:
+    if (!SrcTy->isFloatTy() || !DstTy->isDoubleTy())
+      return false;
+    emit(FPExt, Dst, A);
+    return true;
+  case Instruction::FPToUI:
+  case Instruction::FPToSI: {
+    bool Signed = I.getOpcode() == Instruction::FPToSI;
+    if (SrcTy->isFloatTy())
+      emit(Signed ? FPToSIF32 : FPToUIF32, Dst, A, 0, 0, maskOf(DstBits));
+    else if (SrcTy->isDoubleTy())
+      emit(Signed ? FPToSIF64 : FPToUIF64, Dst, A, 0, 0, maskOf(DstBits));
+    else
+      return false;
+    return true;
+  }
+  case Instruction::UIToFP:
+  case Instruction::SIToFP: {
+    bool Signed = I.getOpcode() == Instruction::SIToFP;
+    if (DstTy->isFloatTy())
+      emit(Signed ? SIToFPF32 : UIToFPF32, Dst, A, 0, 0, 0, SrcBits);
+    else if (DstTy->isDoubleTy())
+      emit(Signed ? SIToFPF64 : UIToFPF64, Dst, A, 0, 0, 0, SrcBits);
+    else
+      return false;
+    return true;
+  }
+  case Instruction::BitCast:
+    if (SrcInt == DstInt || SrcTy == DstTy)
+      emit(Move, Dst, A);
+    else if (DstTy->isFloatTy())
+      emit(BitsToF32, Dst, A);
+    else if (SrcTy->isFloatTy())
+      emit(F32ToBits, Dst, A);
+    else if (DstTy->isDoubleTy())
+      emit(BitsToF64, Dst, A);
+    else
+      emit(F64ToBits, Dst, A);
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool Lowering::lowerLoad(LoadInst &I) {
+  Type *Ty = I.getType();
+  unsigned Dst, A, Op;
+  if (!getSlot(&I, Dst) || !getSlot(I.getPointerOperand(), A))
+    return false;
+  if (Ty->isFloatTy())
+    Op = LoadF32;
+  else if (Ty->isDoubleTy())
+    Op = LoadF64;
+  else
+    switch (getBits(Ty)) {
+    case 1:  Op = Load1; break;
+    case 8:  Op = Load8; break;
+    case 16: Op = Load16; break;
+    case 32: Op = Load32; break;
+    case 64: Op = Load64; break;
+    default: return false;
+    }
+  emit(Op, Dst, A);
+  return true;
+}
+
+bool Lowering::lowerStore(StoreInst &I) {
+  Type *Ty = I.getValueOperand()->getType();
+  unsigned A, B, Op;
+  if (!getSlot(I.getValueOperand(), A) || !getSlot(I.getPointerOperand(), B))
+    return false;
+  if (Ty->isFloatTy())
+    Op = StoreF32;
+  else if (Ty->isDoubleTy())
+    Op = StoreF64;
+  else
+    switch (getBits(Ty)) {
+    // An i1 is stored as a byte, as StoreValueToMemory does.
+    case 1:
+    case 8:  Op = Store8; break;
+    case 16: Op = Store16; break;
+    case 32: Op = Store32; break;
+    case 64: Op = Store64; break;
+    default: return false;
+    }
+  emit(Op, 0, A, B);
+  return true;
+}
+
+bool Lowering::lowerGEP(GetElementPtrInst &I) {
+  unsigned Dst, Base;
+  if (!getSlot(&I, Dst) || !getSlot(I.getPointerOperand(), Base))
+    return false;
+
+  // Fold the constant indices into one offset, and scale each of the others.
+  uint64_t Offset = 0;
+  for (gep_type_iterator GTI = gep_type_begin(I), E = gep_type_end(I);
+       GTI != E; ++GTI) {
+    Value *Idx = GTI.getOperand();
+    if (StructType *STy = dyn_cast<StructType>(*GTI)) {
+      unsigned Field = cast<ConstantInt>(Idx)->getZExtValue();
+      Offset += TD.getStructLayout(STy)->getElementOffset(Field);
+      continue;
+    }
+    uint64_t Size =
+        TD.getTypeAllocSize(cast<SequentialType>(*GTI)->getElementType());
+    if (ConstantInt *CI = dyn_cast<ConstantInt>(Idx)) {
+      if (CI->getBitWidth() > 64)
+        return false;
+      Offset += CI->getSExtValue() * Size;
+      continue;
+    }
+    unsigned IdxSlot;
+    if (!isInt(Idx->getType()) || !getSlot(Idx, IdxSlot))
+      return false;
+    emit(GEPIndex, Dst, IdxSlot, Base, 0, Size, getBits(Idx->getType()));
+    Base = Dst;
+  }
+  if (Offset || Base != Dst)
+    emit(GEPOffset, Dst, Base, 0, 0, Offset);
+  return true;
+}
+
+bool Lowering::lowerCall(CallInst &I) {
+  if (I.isInlineAsm())
+    return false;
+  Function *Callee = I.getCalledFunction();
+  if (Callee && Callee->isIntrinsic()) {
+    unsigned A, B, Cc;
+    switch (Callee->getIntrinsicID()) {
+    case Intrinsic::dbg_declare:
+    case Intrinsic::dbg_value:
+    case Intrinsic::lifetime_start:
+    case Intrinsic::lifetime_end:
+      return true;
+    case Intrinsic::memcpy:
+    case Intrinsic::memmove:
+    case Intrinsic::memset:
+      if (!getSlot(I.getArgOperand(0), A) ||
+          !getSlot(I.getArgOperand(1), B) ||
+          !getSlot(I.getArgOperand(2), Cc))
+        return false;
+      emit(Callee->getIntrinsicID() == Intrinsic::memcpy   ? MemCpy
+           : Callee->getIntrinsicID() == Intrinsic::memmove ? MemMove
+                                                            : MemSet,
+           0, A, B, Cc);
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  CallInfo CI;
+  CI.Callee = Callee;
+  CI.CalleeSlot = 0;
+  CI.Call = &I;
+  if (!Callee && !getSlot(I.getCalledValue(), CI.CalleeSlot))
+    return false;
+  for (unsigned i = 0, e = I.getNumArgOperands(); i != e; ++i) {
+    unsigned A;
+    if (!getSlot(I.getArgOperand(i), A))
+      return false;
+    CI.Args.push_back(A);
+  }
+  unsigned Dst = NoSlot;
+  if (!I.getType()->isVoidTy() && !getSlot(&I, Dst))
+    return false;
+  C.Calls.push_back(CI);
+  emit(Call, Dst, C.Calls.size() - 1);
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+//                        Interpreter Entry Points
+//===----------------------------------------------------------------------===//
+
+Code *Interpreter::getFunctionCode(Function *F) {
+  if (!UseBytecode || F->isDeclaration())
+    return nullptr;
+  std::pair<DenseMap<const Function *, Code *>::iterator, bool> I =
+      FunctionCodes.insert(std::make_pair(F, (Code *)nullptr));
+  if (!I.second)
+    return I.first->second;
+
+  std::unique_ptr<Code> C(new Code());
+  if (!Lowering(*this, *C).run(*F)) {
+    ++NumNotLowered;
+    return nullptr;
+  }
+  ++NumLowered;
+  return I.first->second = C.release();
+}
+
+void Interpreter::freeMachineCodeForFunction(Function *F) {
+  DenseMap<const Function *, Code *>::iterator I = FunctionCodes.find(F);
+  if (I == FunctionCodes.end())
+    return;
+  delete I->second;
+  FunctionCodes.erase(I);
+}
+
+void Interpreter::freeFunctionCodes() {
+  for (DenseMap<const Function *, Code *>::iterator I = FunctionCodes.begin(),
+                                                    E = FunctionCodes.end();
+       I != E; ++I)
+    delete I->second;
+  FunctionCodes.clear();
+}
+
+/// callFromCode - Call F, which is external or not lowered, from bytecode.
+GenericValue Interpreter::callFromCode(Function *F, const CallInfo &CI,
+                                       const Slot *R) {
+  std::vector<GenericValue> ArgVals;
+  ArgVals.reserve(CI.Args.size());
+  for (unsigned i = 0, e = CI.Args.size(); i != e; ++i)
+    ArgVals.push_back(
+        fromSlot(R[CI.Args[i]], CI.Call->getArgOperand(i)->getType()));
+
+  // Bytecode only runs with the IR frames of its callers set aside, see
+  // callFunction, so F runs on an empty stack and returns in ExitValue.
+  assert(ECStack.empty() && "Bytecode running above IR frames!");
+  callFunction(F, ArgVals);
+  run();
+  return ExitValue;
+}
+
+static bool compareFP(unsigned Pred, double X, double Y) {
+  bool Unordered = std::isnan(X) || std::isnan(Y);
+  switch (Pred) {
+  default: llvm_unreachable("Invalid FCmp predicate!");
+  case FCmpInst::FCMP_FALSE: return false;
+  case FCmpInst::FCMP_OEQ:   return !Unordered && X == Y;
+  case FCmpInst::FCMP_OGT:   return !Unordered && X > Y;
+  case FCmpInst::FCMP_OGE:   return !Unordered && X >= Y;
+  case FCmpInst::FCMP_OLT:   return !Unordered && X < Y;
+  case FCmpInst::FCMP_OLE:   return !Unordered && X <= Y;
+  case FCmpInst::FCMP_ONE:   return !Unordered && X != Y;
+  case FCmpInst::FCMP_ORD:   return !Unordered;
+  case FCmpInst::FCMP_UNO:   return Unordered;
+  case FCmpInst::FCMP_UEQ:   return Unordered || X == Y;
+  case FCmpInst::FCMP_UGT:   return Unordered || X > Y;
+  case FCmpInst::FCMP_UGE:   return Unordered || X >= Y;
+  case FCmpInst::FCMP_ULT:   return Unordered || X < Y;
+  case FCmpInst::FCMP_ULE:   return Unordered || X <= Y;
+  case FCmpInst::FCMP_UNE:   return Unordered || X != Y;
+  case FCmpInst::FCMP_TRUE:  return true;
+  }
+}
+
+// With GCC and Clang every handler jumps straight to the next one through a
+// table of label addresses, which gives each handler a branch of its own to
+// predict; elsewhere the handlers are the cases of a switch.
+#if defined(__GNUC__)
+#define BYTECODE_THREADED 1
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+#ifdef BYTECODE_THREADED
+#define HANDLER(Op) L_##Op:
+#define DISPATCH() goto *Labels[PC->Op]
+#else
+#define HANDLER(Op) case Op:
+#define DISPATCH() continue
+#endif
+// Not do { } while (0): DISPATCH() may be a continue of the dispatch loop.
+#define NEXT() { ++PC; DISPATCH(); }
+#define JUMP(Target) { PC = Insts + (Target); DISPATCH(); }
+
+#define PTR(S) ((void *)(uintptr_t)(S).I)
+#define SEXT(S, Bits) ((uint64_t)SignExtend64((S).I, Bits))
+
+/// runCode - Run the function Entry was lowered from with the given arguments
+/// and return its result. Calls to other lowered functions are run in this
+/// loop, each in a frame of slots above its caller's.
+GenericValue Interpreter::runCode(Code *Entry,
+                                  const std::vector<GenericValue> &ArgVals) {
+  struct Frame {
+    Code *C;
+    const Inst *Call;    // The call to return to, in the caller.
+    size_t Base;         // The first slot of the frame in Stack.
+    size_t AllocaMark;   // The allocations made before the frame was entered.
+  };
+  SmallVector<Frame, 16> Frames;
+  std::vector<Slot> Stack(std::max(Entry->NumSlots, 1U));
+  std::vector<void *> Allocas;
+
+  Code *C = Entry;
+  size_t Base = 0;
+  Slot *R = Stack.data();
+  Function::arg_iterator AI = C->F->arg_begin();
+  for (unsigned i = 0, e = std::min<size_t>(ArgVals.size(), C->F->arg_size());
+       i != e; ++i, ++AI)
+    R[i] = toSlot(ArgVals[i], AI->getType());
+  std::copy(C->Consts.begin(), C->Consts.end(), R + C->ConstBase);
+  Frame Outer = { C, nullptr, 0, 0 };
+  Frames.push_back(Outer);
+
+  const Inst *Insts = C->Insts.data();
+  const Inst *PC = Insts;
+  Slot Result;
+  Result.I = 0;
+
+#ifdef BYTECODE_THREADED
+  static const void *const Labels[] = {
+#define BYTECODE_LABEL(Op) &&L_##Op,
+    BYTECODE_OPCODES(BYTECODE_LABEL)
+#undef BYTECODE_LABEL
+  };
+  DISPATCH();
+#else
+  for (;;) {
+  switch (PC->Op) {
+  default: llvm_unreachable("Invalid bytecode opcode!");
+#endif
+
+  HANDLER(Br) JUMP(PC->A);
+  HANDLER(CondBr) JUMP(R[PC->A].I & 1 ? PC->B : PC->C);
+  HANDLER(Switch) {
+    uint64_t V = R[PC->A].I;
+    const uint64_t *Cases = C->SwitchCases.data() + PC->B;
+    unsigned Target = PC->Dst;
+    for (unsigned i = 0; i != PC->C; ++i)
+      if (Cases[2 * i] == V) {
+        Target = Cases[2 * i + 1];
+        break;
+      }
+    JUMP(Target);
+  }
+  HANDLER(Ret) Result = R[PC->A]; goto Return;
+  HANDLER(RetVoid) goto Return;
+  HANDLER(Unreachable)
+    report_fatal_error("Program executed an 'unreachable' instruction!");
+
+  HANDLER(Move) R[PC->Dst] = R[PC->A]; NEXT();
+  HANDLER(Select) R[PC->Dst] = R[PC->A].I & 1 ? R[PC->B] : R[PC->C]; NEXT();
+
+  HANDLER(Add) R[PC->Dst].I = (R[PC->A].I + R[PC->B].I) & PC->Imm; NEXT();
+  HANDLER(Sub) R[PC->Dst].I = (R[PC->A].I - R[PC->B].I) & PC->Imm; NEXT();
+  HANDLER(Mul) R[PC->Dst].I = (R[PC->A].I * R[PC->B].I) & PC->Imm; NEXT();
+  HANDLER(UDiv) R[PC->Dst].I = R[PC->A].I / R[PC->B].I; NEXT();
+  HANDLER(URem) R[PC->Dst].I = R[PC->A].I % R[PC->B].I; NEXT();
+  HANDLER(SDiv) {
+    // INT_MIN / -1 overflows, which the host may trap on.
+    uint64_t X = SEXT(R[PC->A], PC->Bits), Y = SEXT(R[PC->B], PC->Bits);
+    uint64_t Q = Y == ~0ULL ? 0 - X : (uint64_t)((int64_t)X / (int64_t)Y);
+    R[PC->Dst].I = Q & PC->Imm;
+    NEXT();
+  }
+  HANDLER(SRem) {
+    uint64_t X = SEXT(R[PC->A], PC->Bits), Y = SEXT(R[PC->B], PC->Bits);
+    uint64_t M = Y == ~0ULL ? 0 : (uint64_t)((int64_t)X % (int64_t)Y);
+    R[PC->Dst].I = M & PC->Imm;
+    NEXT();
+  }
+  HANDLER(Shl) {
+    uint64_t Amt = R[PC->B].I;
+    R[PC->Dst].I = Amt < 64 ? (R[PC->A].I << Amt) & PC->Imm : 0;
+    NEXT();
+  }
+  HANDLER(LShr) {
+    uint64_t Amt = R[PC->B].I;
+    R[PC->Dst].I = Amt < 64 ? R[PC->A].I >> Amt : 0;
+    NEXT();
+  }
+  HANDLER(AShr) {
+    uint64_t Amt = std::min<uint64_t>(R[PC->B].I, 63);
+    int64_t X = SignExtend64(R[PC->A].I, PC->Bits);
+    R[PC->Dst].I = (uint64_t)(X >> Amt) & PC->Imm;
+    NEXT();
+  }
+  HANDLER(And) R[PC->Dst].I = R[PC->A].I & R[PC->B].I; NEXT();
+  HANDLER(Or) R[PC->Dst].I = R[PC->A].I | R[PC->B].I; NEXT();
+  HANDLER(Xor) R[PC->Dst].I = R[PC->A].I ^ R[PC->B].I; NEXT();
+
+  HANDLER(ICmpEQ) R[PC->Dst].I = R[PC->A].I == R[PC->B].I; NEXT();
+  HANDLER(ICmpNE) R[PC->Dst].I = R[PC->A].I != R[PC->B].I; NEXT();
+  HANDLER(ICmpULT) R[PC->Dst].I = R[PC->A].I < R[PC->B].I; NEXT();
+  HANDLER(ICmpULE) R[PC->Dst].I = R[PC->A].I <= R[PC->B].I; NEXT();
+  HANDLER(ICmpSLT)
+    R[PC->Dst].I = SignExtend64(R[PC->A].I, PC->Bits) <
+                   SignExtend64(R[PC->B].I, PC->Bits);
+    NEXT();
+  HANDLER(ICmpSLE)
+    R[PC->Dst].I = SignExtend64(R[PC->A].I, PC->Bits) <=
+                   SignExtend64(R[PC->B].I, PC->Bits);
+    NEXT();
+
+  HANDLER(FAddF32) R[PC->Dst].F = R[PC->A].F + R[PC->B].F; NEXT();
+  HANDLER(FSubF32) R[PC->Dst].F = R[PC->A].F - R[PC->B].F; NEXT();
+  HANDLER(FMulF32) R[PC->Dst].F = R[PC->A].F * R[PC->B].F; NEXT();
+  HANDLER(FDivF32) R[PC->Dst].F = R[PC->A].F / R[PC->B].F; NEXT();
+  HANDLER(FRemF32) R[PC->Dst].F = fmodf(R[PC->A].F, R[PC->B].F); NEXT();
+  HANDLER(FCmpF32)
+    R[PC->Dst].I = compareFP(PC->Imm, R[PC->A].F, R[PC->B].F);
+    NEXT();
+  HANDLER(FAddF64) R[PC->Dst].D = R[PC->A].D + R[PC->B].D; NEXT();
+  HANDLER(FSubF64) R[PC->Dst].D = R[PC->A].D - R[PC->B].D; NEXT();
+  HANDLER(FMulF64) R[PC->Dst].D = R[PC->A].D * R[PC->B].D; NEXT();
+  HANDLER(FDivF64) R[PC->Dst].D = R[PC->A].D / R[PC->B].D; NEXT();
+  HANDLER(FRemF64) R[PC->Dst].D = fmod(R[PC->A].D, R[PC->B].D); NEXT();
+  HANDLER(FCmpF64)
+    R[PC->Dst].I = compareFP(PC->Imm, R[PC->A].D, R[PC->B].D);
+    NEXT();
+
+  HANDLER(Trunc) R[PC->Dst].I = R[PC->A].I & PC->Imm; NEXT();
+  HANDLER(SExt) R[PC->Dst].I = SEXT(R[PC->A], PC->Bits) & PC->Imm; NEXT();
+  HANDLER(FPTrunc) R[PC->Dst].F = (float)R[PC->A].D; NEXT();
+  HANDLER(FPExt) R[PC->Dst].D = (double)R[PC->A].F; NEXT();
+  HANDLER(FPToUIF32) R[PC->Dst].I = (uint64_t)R[PC->A].F & PC->Imm; NEXT();
+  HANDLER(FPToSIF32)
+    R[PC->Dst].I = (uint64_t)(int64_t)R[PC->A].F & PC->Imm;
+    NEXT();
+  HANDLER(UIToFPF32) R[PC->Dst].F = (float)R[PC->A].I; NEXT();
+  HANDLER(SIToFPF32)
+    R[PC->Dst].F = (float)SignExtend64(R[PC->A].I, PC->Bits);
+    NEXT();
+  HANDLER(FPToUIF64) R[PC->Dst].I = (uint64_t)R[PC->A].D & PC->Imm; NEXT();
+  HANDLER(FPToSIF64)
+    R[PC->Dst].I = (uint64_t)(int64_t)R[PC->A].D & PC->Imm;
+    NEXT();
+  HANDLER(UIToFPF64) R[PC->Dst].D = (double)R[PC->A].I; NEXT();
+  HANDLER(SIToFPF64)
+    R[PC->Dst].D = (double)SignExtend64(R[PC->A].I, PC->Bits);
+    NEXT();
+  HANDLER(BitsToF32) {
+    uint32_t V = R[PC->A].I;
+    memcpy(&R[PC->Dst].F, &V, sizeof(V));
+    NEXT();
+  }
+  HANDLER(F32ToBits) {
+    uint32_t V;
+    memcpy(&V, &R[PC->A].F, sizeof(V));
+    R[PC->Dst].I = V;
+    NEXT();
+  }
+  HANDLER(BitsToF64) memcpy(&R[PC->Dst].D, &R[PC->A].I, 8); NEXT();
+  HANDLER(F64ToBits) memcpy(&R[PC->Dst].I, &R[PC->A].D, 8); NEXT();
+
+  HANDLER(Load1) {
+    uint8_t V;
+    memcpy(&V, PTR(R[PC->A]), sizeof(V));
+    R[PC->Dst].I = V & 1;
+    NEXT();
+  }
+  HANDLER(Load8) {
+    uint8_t V;
+    memcpy(&V, PTR(R[PC->A]), sizeof(V));
+    R[PC->Dst].I = V;
+    NEXT();
+  }
+  HANDLER(Load16) {
+    uint16_t V;
+    memcpy(&V, PTR(R[PC->A]), sizeof(V));
+    R[PC->Dst].I = V;
+    NEXT();
+  }
+  HANDLER(Load32) {
+    uint32_t V;
+    memcpy(&V, PTR(R[PC->A]), sizeof(V));
+    R[PC->Dst].I = V;
+    NEXT();
+  }
+  HANDLER(Load64) memcpy(&R[PC->Dst].I, PTR(R[PC->A]), 8); NEXT();
+  HANDLER(LoadF32) memcpy(&R[PC->Dst].F, PTR(R[PC->A]), 4); NEXT();
+  HANDLER(LoadF64) memcpy(&R[PC->Dst].D, PTR(R[PC->A]), 8); NEXT();
+  HANDLER(Store8) {
+    uint8_t V = R[PC->A].I;
+    memcpy(PTR(R[PC->B]), &V, sizeof(V));
+    NEXT();
+  }
+  HANDLER(Store16) {
+    uint16_t V = R[PC->A].I;
+    memcpy(PTR(R[PC->B]), &V, sizeof(V));
+    NEXT();
+  }
+  HANDLER(Store32) {
+    uint32_t V = R[PC->A].I;
+    memcpy(PTR(R[PC->B]), &V, sizeof(V));
+    NEXT();
+  }
+  HANDLER(Store64) memcpy(PTR(R[PC->B]), &R[PC->A].I, 8); NEXT();
+  HANDLER(StoreF32) memcpy(PTR(R[PC->B]), &R[PC->A].F, 4); NEXT();
+  HANDLER(StoreF64) memcpy(PTR(R[PC->B]), &R[PC->A].D, 8); NEXT();
+
+  HANDLER(Alloca) {
+    // Avoid malloc-ing zero bytes, as visitAllocaInst does.
+    void *Memory = malloc(std::max<uint64_t>(1, R[PC->A].I * PC->Imm));
+    Allocas.push_back(Memory);
+    R[PC->Dst].I = (uintptr_t)Memory;
+    NEXT();
+  }
+  HANDLER(GEPOffset)
+    R[PC->Dst].I = (uintptr_t)(R[PC->A].I + PC->Imm);
+    NEXT();
+  HANDLER(GEPIndex)
+    R[PC->Dst].I = (uintptr_t)(R[PC->B].I + SEXT(R[PC->A], PC->Bits) * PC->Imm);
+    NEXT();
+  HANDLER(MemCpy)
+    memcpy(PTR(R[PC->A]), PTR(R[PC->B]), R[PC->C].I);
+    NEXT();
+  HANDLER(MemMove)
+    memmove(PTR(R[PC->A]), PTR(R[PC->B]), R[PC->C].I);
+    NEXT();
+  HANDLER(MemSet)
+    memset(PTR(R[PC->A]), (int)R[PC->B].I, R[PC->C].I);
+    NEXT();
+
+  HANDLER(Call) {
+    const CallInfo &CI = C->Calls[PC->A];
+    Function *Callee =
+        CI.Callee ? CI.Callee : (Function *)PTR(R[CI.CalleeSlot]);
+    if (Code *CalleeCode = getFunctionCode(Callee)) {
+      size_t NewBase = Base + C->NumSlots;
+      size_t NewTop = NewBase + CalleeCode->NumSlots;
+      if (Stack.size() < NewTop) {
+        Stack.resize(std::max(NewTop, 2 * Stack.size()));
+        R = &Stack[Base];
+      }
+      Slot *NewR = &Stack[NewBase];
+      for (unsigned i = 0, e = std::min<size_t>(CI.Args.size(),
+                                                Callee->arg_size());
+           i != e; ++i)
+        NewR[i] = R[CI.Args[i]];
+      std::copy(CalleeCode->Consts.begin(), CalleeCode->Consts.end(),
+                NewR + CalleeCode->ConstBase);
+      Frame F = { CalleeCode, PC, NewBase, Allocas.size() };
+      Frames.push_back(F);
+      C = CalleeCode;
+      Base = NewBase;
+      R = NewR;
+      Insts = C->Insts.data();
+      JUMP(0);
+    }
+    GenericValue RetVal = callFromCode(Callee, CI, R);
+    if (PC->Dst != NoSlot)
+      R[PC->Dst] = toSlot(RetVal, CI.Call->getType());
+    NEXT();
+  }
+
+#ifndef BYTECODE_THREADED
+  }
+#endif
+
+Return: {
+    const Frame &F = Frames.back();
+    for (size_t i = F.AllocaMark, e = Allocas.size(); i != e; ++i)
+      free(Allocas[i]);
+    Allocas.resize(F.AllocaMark);
+    if (Frames.size() == 1)
+      return fromSlot(Result, C->F->getReturnType());
+
+    const Inst *Call = F.Call;
+    Frames.pop_back();
+    C = Frames.back().C;
+    Base = Frames.back().Base;
+    R = &Stack[Base];
+    Insts = C->Insts.data();
+    if (Call->Dst != NoSlot)
+      R[Call->Dst] = Result;
+    PC = Call;
+    NEXT();
+  }
+#ifndef BYTECODE_THREADED
+  }
+#endif
+}
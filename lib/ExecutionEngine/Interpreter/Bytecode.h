@@ -0,0 +1,108 @@
+//===-- Bytecode.h - Register-slot bytecode for the interpreter -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header defines the bytecode the interpreter lowers a function to on its
+// first call when -interpreter-bytecode is given. Every SSA value of the
+// function is given a numbered slot in a flat frame, PHI nodes become moves on
+// the incoming edges, and each instruction becomes an opcode specialized for
+// its operand type, so running it needs neither a map lookup nor a
+// GenericValue per operand.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLI_BYTECODE_H
+#define LLI_BYTECODE_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace llvm {
+
+class CallInst;
+class Function;
+
+namespace bytecode {
+
+// Opcodes. Integer operations work on values zero-extended to 64 bits and
+// mask their result to the width of their type; the signed ones first
+// sign-extend their operands from Inst::Bits.
+#define BYTECODE_OPCODES(X)                                                    \
+  X(Br) X(CondBr) X(Switch) X(Ret) X(RetVoid) X(Unreachable)                   \
+  X(Move) X(Select)                                                            \
+  X(Add) X(Sub) X(Mul) X(UDiv) X(SDiv) X(URem) X(SRem)                         \
+  X(Shl) X(LShr) X(AShr) X(And) X(Or) X(Xor)                                   \
+  X(ICmpEQ) X(ICmpNE) X(ICmpULT) X(ICmpULE) X(ICmpSLT) X(ICmpSLE)              \
+  X(FAddF32) X(FSubF32) X(FMulF32) X(FDivF32) X(FRemF32) X(FCmpF32)           \
+  X(FAddF64) X(FSubF64) X(FMulF64) X(FDivF64) X(FRemF64) X(FCmpF64)           \
+  X(Trunc) X(SExt) X(FPTrunc) X(FPExt)                                         \
+  X(FPToUIF32) X(FPToSIF32) X(UIToFPF32) X(SIToFPF32)                          \
+  X(FPToUIF64) X(FPToSIF64) X(UIToFPF64) X(SIToFPF64)                          \
+  X(BitsToF32) X(F32ToBits) X(BitsToF64) X(F64ToBits)                          \
+  X(Load1) X(Load8) X(Load16) X(Load32) X(Load64) X(LoadF32) X(LoadF64)        \
+  X(Store8) X(Store16) X(Store32) X(Store64) X(StoreF32) X(StoreF64)           \
+  X(Alloca) X(GEPOffset) X(GEPIndex)                                           \
+  X(MemCpy) X(MemMove) X(MemSet) X(Call)
+
+enum Opcode {
+#define BYTECODE_ENUM(Op) Op,
+  BYTECODE_OPCODES(BYTECODE_ENUM)
+#undef BYTECODE_ENUM
+  NumOpcodes
+};
+
+/// One value in a frame. Integers and pointers are kept in I, zero-extended;
+/// float and double values in F and D.
+union Slot {
+  uint64_t I;
+  float F;
+  double D;
+};
+
+/// Slot number of a call's result when it has none.
+const unsigned NoSlot = ~0U;
+
+/// One instruction. Dst, A, B and C are slot numbers, except for the
+/// branches, whose targets are instruction indices. Imm holds the result
+/// mask of integer operations, the predicate of FCmp, and the constant byte
+/// offset, scale or size of memory operations.
+struct Inst {
+  uint16_t Op;
+  uint8_t Bits;
+  unsigned Dst, A, B, C;
+  uint64_t Imm;
+};
+
+/// The operands of a Call instruction, which do not fit in Inst.
+struct CallInfo {
+  Function *Callee;     // Null for an indirect call through CalleeSlot.
+  unsigned CalleeSlot;
+  CallInst *Call;       // The types at the GenericValue boundary.
+  SmallVector<unsigned, 4> Args;
+};
+
+/// A lowered function. Its frame holds the arguments in the first slots,
+/// then the instruction results, then the constants, which are copied in
+/// from Consts on entry, then the temporaries for PHI moves.
+struct Code {
+  Function *F;
+  std::vector<Inst> Insts;
+  std::vector<Slot> Consts;
+  unsigned ConstBase;
+  unsigned NumSlots;
+  /// Each Switch uses C (value, target index) pairs starting at B.
+  std::vector<uint64_t> SwitchCases;
+  std::vector<CallInfo> Calls;
+};
+
+} // End bytecode namespace
+
+} // End llvm namespace
+
+#endif
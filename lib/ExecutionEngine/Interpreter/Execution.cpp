@@ -2077,6 +2077,19 @@ void Interpreter::callFunction(Function *F,
   assert((ECStack.empty() || !ECStack.back().Caller.getInstruction() ||
           ECStack.back().Caller.arg_size() == ArgVals.size()) &&
          "Incorrect number of arguments passed into function call!");
+  // A function lowered to bytecode runs to completion here. The frames of its
+  // callers are set aside meanwhile, so that it can call back into the IR.
+  if (bytecode::Code *Code = getFunctionCode(F)) {
+    std::vector<ExecutionContext> Callers;
+    Callers.swap(ECStack);
+    GenericValue Result = runCode(Code, ArgVals);
+    ECStack.swap(Callers);
+    ECStack.push_back(ExecutionContext());
+    ECStack.back().CurFunction = F;
+    popStackAndReturnValueToCaller(F->getReturnType(), Result);
+    return;
+  }
+
   // Make a new stack frame... and fill it in.
   ECStack.push_back(ExecutionContext());
   ExecutionContext &StackFrame = ECStack.back();
@@ -61,6 +61,7 @@ Interpreter::Interpreter(Module *M)
 }
 
 Interpreter::~Interpreter() {
+  freeFunctionCodes();
   delete IL;
 }
 
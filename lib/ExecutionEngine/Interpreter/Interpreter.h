@@ -14,6 +14,7 @@
 #ifndef LLI_INTERPRETER_H
 #define LLI_INTERPRETER_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/ExecutionEngine/GenericValue.h"
 #include "llvm/IR/CallSite.h"
@@ -31,6 +32,13 @@ template<typename T> class generic_gep_type_iterator;
 class ConstantExpr;
 typedef generic_gep_type_iterator<User::const_op_iterator> gep_type_iterator;
 
+namespace bytecode {
+class Lowering;
+struct CallInfo;
+struct Code;
+union Slot;
+}
+
 
 // AllocaHolder - Object to track all of the blocks of memory allocated by
 // alloca.  When the function returns, this object is popped off the execution
@@ -93,6 +101,12 @@ class Interpreter : public ExecutionEngine, public InstVisitor<Interpreter> {
   // registered with the atexit() library function.
   std::vector<Function*> AtExitHandlers;
 
+  // FunctionCodes - The bytecode each function called so far was lowered to,
+  // or null if it could not be, with -interpreter-bytecode.
+  DenseMap<const Function*, bytecode::Code*> FunctionCodes;
+
+  friend class bytecode::Lowering;
+
 public:
   explicit Interpreter(Module *M);
   ~Interpreter();
@@ -128,9 +142,10 @@ public:
     return getPointerToFunction(F);
   }
 
-  /// freeMachineCodeForFunction - The interpreter does not generate any code.
+  /// freeMachineCodeForFunction - Drop the bytecode of F, if any; it is
+  /// lowered again from the IR on the next call.
   ///
-  void freeMachineCodeForFunction(Function *F) override { }
+  void freeMachineCodeForFunction(Function *F) override;
 
   // Methods used to execute code:
   // Place a call on the stack
@@ -247,6 +262,14 @@ private:  // Helper functions
                                     Type *Ty, ExecutionContext &SF);
   void popStackAndReturnValueToCaller(Type *RetTy, GenericValue Result);
 
+  // Bytecode execution, in Bytecode.cpp.
+  bytecode::Code *getFunctionCode(Function *F);
+  void freeFunctionCodes();
+  GenericValue runCode(bytecode::Code *Entry,
+                       const std::vector<GenericValue> &ArgVals);
+  GenericValue callFromCode(Function *F, const bytecode::CallInfo &CI,
+                            const bytecode::Slot *R);
+
 };
 
 } // End llvm namespace
@@ -0,0 +1,224 @@
+//===- FileSystemObjectCache.cpp - On-disk object cache for MCJIT ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the on-disk ObjectCache declared in
+// FileSystemObjectCache.h.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/FileSystemObjectCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Bitcode/ReaderWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileOutputBuffer.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MutexGuard.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+using namespace llvm;
+
+// Cache files are named <prefix><32 hex digits><suffix>; prune() only ever
+// removes files named like that.
+static const char CacheFilePrefix[] = "llvm-obj-";
+static const char CacheFileSuffix[] = ".o";
+
+FileSystemObjectCache::FileSystemObjectCache(StringRef CacheDir,
+                                             const TargetMachine &TM,
+                                             uint64_t MaxCacheSize)
+    : CacheDir(CacheDir), MaxCacheSize(MaxCacheSize) {
+  // Objects from another LLVM release are not reused either.
+  raw_string_ostream OS(TargetKey);
+  OS << LLVM_VERSION_MAJOR << '.' << LLVM_VERSION_MINOR << '\0'
+     << TM.getTargetTriple() << '\0' << TM.getTargetCPU() << '\0'
+     << TM.getTargetFeatureString() << '\0' << unsigned(TM.getOptLevel());
+  OS.flush();
+}
+
+FileSystemObjectCache::~FileSystemObjectCache() {}
+
+std::string FileSystemObjectCache::getCacheKey(const Module *M) const {
+  SmallVector<char, 4096> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(M, OS);
+  OS.flush();
+
+  MD5 Hash;
+  Hash.update(TargetKey);
+  Hash.update(StringRef(Bitcode.data(), Bitcode.size()));
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Key;
+  MD5::stringifyResult(Result, Key);
+  return Key.str();
+}
+
+std::string FileSystemObjectCache::getCachePath(const Module *M) const {
+  {
+    MutexGuard locked(PendingKeysLock);
+    DenseMap<const Module *, std::string>::const_iterator I =
+        PendingKeys.find(M);
+    if (I != PendingKeys.end())
+      return getPathForKey(I->second);
+  }
+  return getPathForKey(getCacheKey(M));
+}
+
+std::string FileSystemObjectCache::getPathForKey(StringRef Key) const {
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, CacheFilePrefix + Key + CacheFileSuffix);
+  return Path.str();
+}
+
+namespace {
+/// A cached object mapped copy-on-write. The dynamic linker writes section
+/// load addresses into the object it is given, which a read-only mapping, as
+/// MemoryBuffer::getFile would make, does not allow.
+class MappedObjectBuffer : public MemoryBuffer {
+  sys::fs::mapped_file_region Region;
+
+public:
+  MappedObjectBuffer(int FD, uint64_t Size, error_code &EC)
+      : Region(FD, /*closefd=*/false, sys::fs::mapped_file_region::priv, Size,
+               0, EC) {
+    if (!EC)
+      init(Region.const_data(), Region.const_data() + Size,
+           /*RequiresNullTerminator=*/false);
+  }
+
+  const char *getBufferIdentifier() const override {
+    return "<cached object>";
+  }
+
+  BufferKind getBufferKind() const override { return MemoryBuffer_MMap; }
+};
+}
+
+/// Map the cache file open as FD, or return null if it can't be used. The
+/// descriptor is also used to record the hit for prune(), which evicts by
+/// modification time.
+static MemoryBuffer *mapCachedObject(int FD) {
+  sys::fs::file_status Status;
+  if (sys::fs::status(FD, Status) || !Status.getSize())
+    return nullptr;
+  error_code EC;
+  std::unique_ptr<MemoryBuffer> Obj(
+      new MappedObjectBuffer(FD, Status.getSize(), EC));
+  if (EC)
+    return nullptr;
+  sys::fs::setLastModificationAndAccessTime(FD, sys::TimeValue::now());
+  return Obj.release();
+}
+
+MemoryBuffer *FileSystemObjectCache::getObject(const Module *M) {
+  std::string Key = getCacheKey(M);
+
+  MemoryBuffer *Obj = nullptr;
+  int FD;
+  if (!sys::fs::openFileForRead(getPathForKey(Key), FD)) {
+    Obj = mapCachedObject(FD);
+    close(FD);
+  }
+
+  // Only a miss is followed by notifyObjectCompiled, which takes the key
+  // back out. A hit must not leave one behind for a later module that
+  // happens to reuse M's address.
+  MutexGuard locked(PendingKeysLock);
+  if (Obj)
+    PendingKeys.erase(M);
+  else
+    PendingKeys[M] = Key;
+  return Obj;
+}
+
+void FileSystemObjectCache::notifyObjectCompiled(const Module *M,
+                                                 const MemoryBuffer *Obj) {
+  std::string Key;
+  {
+    MutexGuard locked(PendingKeysLock);
+    DenseMap<const Module *, std::string>::iterator I = PendingKeys.find(M);
+    if (I != PendingKeys.end()) {
+      Key = I->second;
+      PendingKeys.erase(I);
+    }
+  }
+  if (Key.empty())
+    Key = getCacheKey(M);
+  std::string Path = getPathForKey(Key);
+
+  // A cache that cannot be written is only a missed optimization.
+  if (sys::fs::create_directories(CacheDir))
+    return;
+  std::unique_ptr<FileOutputBuffer> Out;
+  if (FileOutputBuffer::create(Path, Obj->getBufferSize(), Out))
+    return;
+  memcpy(Out->getBufferStart(), Obj->getBufferStart(), Obj->getBufferSize());
+  if (Out->commit())
+    return;
+
+  prune(Path);
+}
+
+namespace {
+struct CacheEntry {
+  std::string Path;
+  uint64_t Size;
+  sys::TimeValue LastUsed;
+  bool Keep;
+
+  // Modification times may only have a resolution of seconds; on a tie the
+  // object that was just written goes last.
+  bool operator<(const CacheEntry &RHS) const {
+    if (LastUsed != RHS.LastUsed)
+      return LastUsed < RHS.LastUsed;
+    return !Keep && RHS.Keep;
+  }
+};
+}
+
+void FileSystemObjectCache::prune(StringRef KeepPath) {
+  if (!MaxCacheSize)
+    return;
+
+  std::vector<CacheEntry> Entries;
+  uint64_t TotalSize = 0;
+  error_code EC;
+  for (sys::fs::directory_iterator I(CacheDir, EC), E; I != E && !EC;
+       I.increment(EC)) {
+    StringRef Name = sys::path::filename(I->path());
+    if (!Name.startswith(CacheFilePrefix) || !Name.endswith(CacheFileSuffix))
+      continue;
+    sys::fs::file_status Status;
+    if (I->status(Status) || !sys::fs::is_regular_file(Status))
+      continue;
+    CacheEntry Entry = { I->path(), Status.getSize(),
+                         Status.getLastModificationTime(),
+                         I->path() == KeepPath };
+    Entries.push_back(Entry);
+    TotalSize += Entry.Size;
+  }
+
+  std::sort(Entries.begin(), Entries.end());
+  for (unsigned i = 0, e = Entries.size(); i != e && TotalSize > MaxCacheSize;
+       ++i) {
+    if (!sys::fs::remove(Entries[i].Path))
+      TotalSize -= Entries[i].Size;
+  }
+}
@@ -0,0 +1,320 @@
+//===-- LazyFunctionStubs.cpp - Lazy per-function compilation in MCJIT ----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements MCJIT's lazy compilation: splitting a module into stubs
+// and one module per function body, and compiling a body on the first call
+// of its stub. See "About lazy compilation" in MCJIT.h.
+//
+//===----------------------------------------------------------------------===//
+
+#include "MCJIT.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/CallSite.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MutexGuard.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
+#include <map>
+
+using namespace llvm;
+
+/// Whether F can be replaced by a stub that forwards its arguments.
+static bool canCompileLazily(const Function &F) {
+  if (F.isDeclaration() || F.isVarArg() || F.hasAvailableExternallyLinkage() ||
+      F.hasGC() || F.hasPrefixData() || F.getName().startswith("llvm."))
+    return false;
+  if (F.getAttributes().hasAttribute(AttributeSet::FunctionIndex,
+                                     Attribute::Naked))
+    return false;
+  for (Function::const_arg_iterator A = F.arg_begin(), E = F.arg_end();
+       A != E; ++A)
+    if (A->hasInAllocaAttr())
+      return false;
+  // A block address refers into the code of the function itself.
+  for (Function::const_iterator BB = F.begin(), E = F.end(); BB != E; ++BB)
+    if (BB->hasAddressTaken())
+      return false;
+  return true;
+}
+
+/// Give a local global value of a module being split a unique external name,
+/// so that the bodies split off can refer to it.
+static void makeExternal(GlobalValue &GV, StringRef Suffix) {
+  if (!GV.hasLocalLinkage() || GV.getName().startswith("llvm."))
+    return;
+  // Names like .LC0 would still be assembler temporaries, which are not
+  // exported.
+  StringRef Name = GV.getName();
+  GV.setName(Twine(Name.empty() || Name[0] == '.' ? "lazy" : "") + Name +
+             Suffix);
+  GV.setLinkage(GlobalValue::ExternalLinkage);
+  GV.setVisibility(GlobalValue::HiddenVisibility);
+}
+
+namespace {
+/// Declares in the module of a function body the global values of the split
+/// module that the body refers to.
+class DeclarationMaterializer : public ValueMaterializer {
+  Module &Body;
+
+public:
+  explicit DeclarationMaterializer(Module &Body) : Body(Body) {}
+
+  Value *materializeValueFor(Value *V) override {
+    GlobalValue *GV = dyn_cast<GlobalValue>(V);
+    if (!GV)
+      return nullptr;
+    PointerType *Ty = GV->getType();
+    if (FunctionType *FTy = dyn_cast<FunctionType>(Ty->getElementType())) {
+      Function *Decl = Function::Create(FTy, GlobalValue::ExternalLinkage,
+                                        GV->getName(), &Body);
+      if (Function *F = dyn_cast<Function>(GV)) {
+        Decl->setCallingConv(F->getCallingConv());
+        Decl->setAttributes(F->getAttributes());
+      }
+      return Decl;
+    }
+    GlobalVariable *Var = dyn_cast<GlobalVariable>(GV);
+    return new GlobalVariable(
+        Body, Ty->getElementType(), Var && Var->isConstant(),
+        GlobalValue::ExternalLinkage, nullptr, GV->getName(), nullptr,
+        Var ? Var->getThreadLocalMode() : GlobalVariable::NotThreadLocal,
+        Ty->getAddressSpace());
+  }
+};
+}
+
+/// Move the body of F into a module of its own, as an external function
+/// named after F with Suffix appended.
+static Module *extractBody(Function &F, StringRef Suffix) {
+  Module *M = F.getParent();
+  Module *Body = new Module((F.getName() + Suffix).str(), M->getContext());
+  Body->setDataLayout(M->getDataLayoutStr());
+  Body->setTargetTriple(M->getTargetTriple());
+
+  Function *NewF = Function::Create(F.getFunctionType(),
+                                    GlobalValue::ExternalLinkage,
+                                    F.getName() + Suffix, Body);
+  NewF->copyAttributesFrom(&F);
+  ValueToValueMapTy VMap;
+  Function::arg_iterator NewA = NewF->arg_begin();
+  for (Function::arg_iterator A = F.arg_begin(), E = F.arg_end(); A != E;
+       ++A, ++NewA) {
+    NewA->setName(A->getName());
+    VMap[A] = NewA;
+  }
+  SmallVector<ReturnInst *, 8> Returns;
+  DeclarationMaterializer Materializer(*Body);
+  CloneFunctionInto(NewF, &F, VMap, /*ModuleLevelChanges=*/true, Returns, "",
+                    nullptr, nullptr, &Materializer);
+  // The debug info of the module stays behind with the compile unit.
+  StripDebugInfo(*Body);
+
+  // Recursive calls need not go through the stub. Other uses of F keep
+  // referring to the stub, which is the address of F everyone else sees.
+  if (Function *Self = Body->getFunction(F.getName())) {
+    for (Value::user_iterator UI = Self->user_begin(), UE = Self->user_end();
+         UI != UE;) {
+      CallSite CS(*UI++);
+      if (CS && CS.getCalledValue() == Self)
+        CS.setCalledFunction(NewF);
+    }
+    if (Self->use_empty())
+      Self->eraseFromParent();
+  }
+  return Body;
+}
+
+/// Finish the function Builder is in with a tail call to Callee, returning
+/// its result. The call passes on the arguments of From, except for the last
+/// DropArgs of them, followed by Extra if it is given.
+static void forwardCall(IRBuilder<> &Builder, Function &From, Value *Callee,
+                        AttributeSet Attrs, unsigned DropArgs = 0,
+                        Value *Extra = nullptr) {
+  SmallVector<Value *, 8> Args;
+  for (Function::arg_iterator A = From.arg_begin(), E = From.arg_end(); A != E;
+       ++A)
+    Args.push_back(A);
+  Args.resize(Args.size() - DropArgs);
+  if (Extra)
+    Args.push_back(Extra);
+  CallInst *Call = Builder.CreateCall(Callee, Args);
+  Call->setCallingConv(From.getCallingConv());
+  Call->setAttributes(Attrs);
+  Call->setTailCall();
+  if (Call->getType()->isVoidTy())
+    Builder.CreateRetVoid();
+  else
+    Builder.CreateRet(Call);
+}
+
+Module *MCJIT::splitLazyFunctions(Module *Src, ValueToValueMapTy &VMap) {
+  if (error_code EC = Src->materializeAllPermanently())
+    report_fatal_error("MCJIT could not materialize " +
+                       Src->getModuleIdentifier() + ": " + EC.message());
+
+  bool HasLazy = false;
+  for (Module::iterator I = Src->begin(), E = Src->end(); I != E && !HasLazy;
+       ++I)
+    HasLazy = canCompileLazily(*I);
+  if (!HasLazy)
+    return nullptr;
+
+  // The stubs refer to LazyFunctions that go away with the engine, so the
+  // module of the caller is not touched.
+  Module *M = CloneModule(Src, VMap);
+  SmallVector<Function *, 16> Lazy;
+  for (Module::iterator I = M->begin(), E = M->end(); I != E; ++I)
+    if (canCompileLazily(*I))
+      Lazy.push_back(I);
+
+  std::string Suffix = ".lazy" + utostr(NextLazyModuleID++);
+  for (Module::iterator I = M->begin(), E = M->end(); I != E; ++I)
+    makeExternal(*I, Suffix);
+  for (Module::global_iterator I = M->global_begin(), E = M->global_end();
+       I != E; ++I)
+    makeExternal(*I, Suffix);
+  for (Module::alias_iterator I = M->alias_begin(), E = M->alias_end(); I != E;
+       ++I)
+    makeExternal(*I, Suffix);
+
+  LLVMContext &Context = M->getContext();
+  Type *Int8PtrTy = Type::getInt8PtrTy(Context);
+  IntegerType *IntPtrTy = Type::getIntNTy(Context, sizeof(void *) * 8);
+  FunctionType *CallbackTy = FunctionType::get(Int8PtrTy, Int8PtrTy, false);
+  Constant *Callback = ConstantExpr::getIntToPtr(
+      ConstantInt::get(IntPtrTy, reinterpret_cast<uintptr_t>(
+                                     &MCJIT::compileLazyFunction)),
+      CallbackTy->getPointerTo());
+
+  // Each function becomes a stub that calls through a pointer, which starts
+  // out at a thunk. The thunk calls a resolver shared by the functions of its
+  // type, passing its LazyFunction after the arguments. The resolver has the
+  // body compiled, which points the pointer at the body, and calls it. So the
+  // stub needs no frame of its own, and what is emitted for each function is
+  // two jumps.
+  typedef std::pair<FunctionType *, std::pair<unsigned, void *> > Signature;
+  std::map<Signature, Function *> Resolvers;
+  LazyFunctionList &LFs = LazyFunctions[Src];
+  for (unsigned i = 0, e = Lazy.size(); i != e; ++i) {
+    Function &F = *Lazy[i];
+    LazyFunction *LF = new LazyFunction();
+    LF->Engine = this;
+    LF->Body = extractBody(F, Suffix);
+    LF->BodyName = (F.getName() + Suffix).str();
+    LF->AddrName = (F.getName() + ".addr" + Suffix).str();
+    LF->Added = false;
+    LFs.push_back(LF);
+
+    GlobalValue::LinkageTypes Linkage = F.getLinkage();
+    F.deleteBody();
+    F.setLinkage(Linkage);
+
+    // The arguments are passed on with the attributes F has for them.
+    FunctionType *FTy = F.getFunctionType();
+    AttributeSet Attrs = F.getAttributes();
+    Attrs = Attrs.removeAttributes(Context, AttributeSet::FunctionIndex,
+                                   Attrs.getFnAttributes());
+
+    Function *&Resolver = Resolvers[std::make_pair(
+        FTy,
+        std::make_pair(unsigned(F.getCallingConv()), Attrs.getRawPointer()))];
+    if (!Resolver) {
+      SmallVector<Type *, 8> Params(FTy->param_begin(), FTy->param_end());
+      Params.push_back(Int8PtrTy);
+      Resolver = Function::Create(
+          FunctionType::get(FTy->getReturnType(), Params, false),
+          GlobalValue::InternalLinkage, "resolve" + Suffix, M);
+      Resolver->setCallingConv(F.getCallingConv());
+      // A resolver runs once per function; spend no time optimizing it.
+      Resolver->setAttributes(
+          Attrs.addAttribute(Context, AttributeSet::FunctionIndex,
+                             Attribute::NoInline)
+               .addAttribute(Context, AttributeSet::FunctionIndex,
+                             Attribute::OptimizeNone));
+      IRBuilder<> Builder(BasicBlock::Create(Context, "", Resolver));
+      Value *Body = Builder.CreateBitCast(
+          Builder.CreateCall(Callback, --Resolver->arg_end()),
+          FTy->getPointerTo());
+      forwardCall(Builder, *Resolver, Body, Attrs, /*DropArgs=*/1);
+    }
+
+    Function *Thunk = Function::Create(FTy, GlobalValue::InternalLinkage,
+                                       F.getName() + ".compile", M);
+    Thunk->setCallingConv(F.getCallingConv());
+    Thunk->setAttributes(Attrs);
+    IRBuilder<> Builder(BasicBlock::Create(Context, "", Thunk));
+    forwardCall(Builder, *Thunk, Resolver, Attrs, 0,
+                ConstantExpr::getIntToPtr(
+                    ConstantInt::get(IntPtrTy, reinterpret_cast<uintptr_t>(LF)),
+                    Int8PtrTy));
+
+    // getLazyFunctionBody finds the pointer by its name.
+    GlobalVariable *Addr =
+        new GlobalVariable(*M, F.getType(), false, GlobalValue::ExternalLinkage,
+                           Thunk, LF->AddrName);
+    Addr->setVisibility(GlobalValue::HiddenVisibility);
+    Builder.SetInsertPoint(BasicBlock::Create(Context, "", &F));
+    forwardCall(Builder, F, Builder.CreateLoad(Addr), Attrs);
+  }
+  return M;
+}
+
+void *MCJIT::compileLazyFunction(void *LF) {
+  LazyFunction *Lazy = static_cast<LazyFunction *>(LF);
+  return reinterpret_cast<void *>(
+      static_cast<uintptr_t>(Lazy->Engine->getLazyFunctionBody(Lazy)));
+}
+
+uint64_t MCJIT::getLazyFunctionBody(LazyFunction *LF) {
+  {
+    MutexGuard locked(lock);
+    if (!LF->Added) {
+      // The body is compiled as it is; claiming it here keeps it from being
+      // split up in turn.
+      OwnedModules.addModule(LF->Body);
+      Compiles[LF->Body] = new ModuleCompile();
+      LF->Added = true;
+    }
+  }
+
+  generateCodeForModule(LF->Body);
+  finalizeLoadedModules();
+
+  // Point the stub at the body. Threads racing to compile the same function
+  // all store the same address.
+  MutexGuard locked(lock);
+  uint64_t Addr = getExistingSymbolAddress(LF->BodyName);
+  uint64_t StubAddr = getExistingSymbolAddress(LF->AddrName);
+  if (!Addr || !StubAddr)
+    report_fatal_error("MCJIT could not compile " + LF->BodyName);
+  *reinterpret_cast<void **>(static_cast<uintptr_t>(StubAddr)) =
+      reinterpret_cast<void *>(static_cast<uintptr_t>(Addr));
+  return Addr;
+}
+
+void MCJIT::freeLazyFunctions(LazyFunctionList &LFs) {
+  for (unsigned i = 0, e = LFs.size(); i != e; ++i) {
+    LazyFunction *LF = LFs[i];
+    if (LF->Added)
+      removeModule(LF->Body);
+    delete LF->Body;
+    delete LF;
+  }
+  LFs.clear();
+}
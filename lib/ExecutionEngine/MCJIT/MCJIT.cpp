@@ -27,7 +27,9 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/MutexGuard.h"
+#include "llvm/Support/TargetRegistry.h"
 #include "llvm/Target/TargetLowering.h"
+#include <algorithm>
 
 using namespace llvm;
 
@@ -58,10 +60,11 @@ ExecutionEngine *MCJIT::createJIT(Module *M,
 
 MCJIT::MCJIT(Module *m, TargetMachine *tm, RTDyldMemoryManager *MM,
              bool AllocateGVsWithCode)
-  : ExecutionEngine(m), TM(tm), Ctx(nullptr), MemMgr(this, MM), Dyld(&MemMgr),
-    ObjCache(nullptr) {
+  : ExecutionEngine(m), TM(tm), MemMgr(this, MM), Dyld(&MemMgr),
+    ObjCache(nullptr), NextLazyModuleID(0) {
 
   OwnedModules.addModule(m);
+  UnindexedModules.push_back(m);
   setDataLayout(TM->getDataLayout());
 }
 
@@ -98,22 +101,128 @@ MCJIT::~MCJIT() {
   }
   Archives.clear();
 
+  for (ModuleCompileMap::iterator I = Compiles.begin(), E = Compiles.end();
+       I != E; ++I)
+    delete I->second;
+  Compiles.clear();
+
+  // The bodies that were compiled go with the other owned modules.
+  for (DenseMap<Module *, LazyFunctionList>::iterator
+           I = LazyFunctions.begin(), E = LazyFunctions.end();
+       I != E; ++I) {
+    for (unsigned i = 0, e = I->second.size(); i != e; ++i) {
+      if (!I->second[i]->Added)
+        delete I->second[i]->Body;
+      delete I->second[i];
+    }
+  }
+  LazyFunctions.clear();
+
+  for (unsigned i = 0, e = CodeGenTMs.size(); i != e; ++i)
+    delete CodeGenTMs[i];
   delete TM;
 }
 
 void MCJIT::addModule(Module *M) {
   MutexGuard locked(lock);
   OwnedModules.addModule(M);
+  UnindexedModules.push_back(M);
 }
 
 bool MCJIT::removeModule(Module *M) {
   MutexGuard locked(lock);
+  ModuleCompileMap::iterator I = Compiles.find(M);
+  if (I != Compiles.end()) {
+    delete I->second;
+    Compiles.erase(I);
+  }
+  SmallVectorImpl<Module *>::iterator Unindexed =
+      std::find(UnindexedModules.begin(), UnindexedModules.end(), M);
+  if (Unindexed != UnindexedModules.end())
+    UnindexedModules.erase(Unindexed);
+  else if (OwnedModules.hasModuleBeenAddedButNotLoaded(M))
+    unindexModule(M);
+
+  DenseMap<Module *, ObjectImage *>::iterator Obj = ModuleObjects.find(M);
+  bool KeepsObject = false;
+  if (Obj != ModuleObjects.end()) {
+    // Relocations into a loaded but unfinalized object may still be pending,
+    // so only a finalized module's object can go.
+    if (OwnedModules.hasModuleBeenFinalized(M))
+      unloadObject(Obj->second);
+    else
+      KeepsObject = true;
+    ModuleObjects.erase(Obj);
+  }
+
+  DenseMap<Module *, LazyFunctionList>::iterator Lazy = LazyFunctions.find(M);
+  if (Lazy != LazyFunctions.end()) {
+    LazyFunctionList LFs;
+    LFs.swap(Lazy->second);
+    LazyFunctions.erase(Lazy);
+    // The stubs of an object that stays in place may still be called.
+    if (KeepsObject) {
+      LazyFunctionList &Kept = LazyFunctions[nullptr];
+      Kept.insert(Kept.end(), LFs.begin(), LFs.end());
+    } else {
+      freeLazyFunctions(LFs);
+    }
+  }
+
+  clearGlobalMappingsFromModule(M);
   return OwnedModules.removeModule(M);
 }
 
+void MCJIT::unloadObject(ObjectImage *Obj) {
+  NotifyFreeingObject(*Obj);
+  Dyld.unloadObject(Obj);
+  MemMgr.notifyObjectFreed(this, Obj);
+
+  LoadedObjects.erase(
+      std::find(LoadedObjects.begin(), LoadedObjects.end(), Obj));
+  delete Obj;
+}
+
+// The index is built from the definitions a module has when the engine first
+// looks up a symbol or claims a module after it was added, so a module may
+// still be filled in between addModule and then; definitions added to it
+// later are not found by symbol lookup. A name defined by several modules
+// resolves to the first one added.
+void MCJIT::indexModule(Module *M) {
+  for (Module::iterator I = M->begin(), E = M->end(); I != E; ++I)
+    if (!I->isDeclaration())
+      FunctionIndex.GetOrCreateValue(I->getName(), M);
+  for (Module::global_iterator I = M->global_begin(), E = M->global_end();
+       I != E; ++I)
+    if (!I->isDeclaration())
+      VariableIndex.GetOrCreateValue(I->getName(), M);
+}
+
+void MCJIT::indexAddedModules() {
+  for (unsigned i = 0, e = UnindexedModules.size(); i != e; ++i)
+    indexModule(UnindexedModules[i]);
+  UnindexedModules.clear();
+}
+
+// Once a module is loaded its symbols are found in the dynamic linker.
+void MCJIT::unindexModule(Module *M) {
+  for (Module::iterator I = M->begin(), E = M->end(); I != E; ++I) {
+    StringMap<Module *>::iterator Entry = FunctionIndex.find(I->getName());
+    if (Entry != FunctionIndex.end() && Entry->second == M)
+      FunctionIndex.erase(Entry);
+  }
+  for (Module::global_iterator I = M->global_begin(), E = M->global_end();
+       I != E; ++I) {
+    StringMap<Module *>::iterator Entry = VariableIndex.find(I->getName());
+    if (Entry != VariableIndex.end() && Entry->second == M)
+      VariableIndex.erase(Entry);
+  }
+}
+
 
 
 void MCJIT::addObjectFile(std::unique_ptr<object::ObjectFile> Obj) {
+  MutexGuard locked(lock);
   ObjectImage *LoadedObject = Dyld.loadObject(std::move(Obj));
   if (!LoadedObject || Dyld.hasError())
     report_fatal_error(Dyld.getErrorString());
@@ -133,36 +242,63 @@ void MCJIT::setObjectCache(ObjectCache* NewCache) {
   ObjCache = NewCache;
 }
 
-ObjectBufferStream* MCJIT::emitObject(Module *M) {
-  MutexGuard locked(lock);
+TargetMachine *MCJIT::acquireTargetMachine() {
+  MutexGuard locked(TMPoolLock);
+  if (!IdleTMs.empty())
+    return IdleTMs.pop_back_val();
+
+  // Every target machine is busy; make another one like TM. Code generation
+  // updates the options of the target machine it runs on as it goes, so each
+  // compile needs its own.
+  TargetMachine *CodeGenTM = TM->getTarget().createTargetMachine(
+      TM->getTargetTriple(), TM->getTargetCPU(), TM->getTargetFeatureString(),
+      TM->Options, TM->getRelocationModel(), TM->getCodeModel(),
+      TM->getOptLevel());
+  if (!CodeGenTM)
+    report_fatal_error("Could not allocate a target machine for MCJIT!");
+  CodeGenTMs.push_back(CodeGenTM);
+  return CodeGenTM;
+}
+
+void MCJIT::releaseTargetMachine(TargetMachine *CodeGenTM) {
+  MutexGuard locked(TMPoolLock);
+  IdleTMs.push_back(CodeGenTM);
+}
 
+ObjectBufferStream* MCJIT::emitObject(Module *M, bool Cacheable) {
   // This must be a module which has already been added but not loaded to this
   // MCJIT instance, since these conditions are tested by our caller,
   // generateCodeForModule.
 
-  PassManager PM;
-
-  M->setDataLayout(TM->getDataLayout());
-  PM.add(new DataLayoutPass(M));
-
   // The RuntimeDyld will take ownership of this shortly
   std::unique_ptr<ObjectBufferStream> CompiledObject(new ObjectBufferStream());
 
-  // Turn the machine code intermediate representation into bytes in memory
-  // that may be executed.
-  if (TM->addPassesToEmitMC(PM, Ctx, CompiledObject->getOStream(),
-                            !getVerifyModules())) {
-    report_fatal_error("Target does not support MC emission!");
+  TargetMachine *CodeGenTM = acquireTargetMachine();
+  {
+    PassManager PM;
+
+    M->setDataLayout(CodeGenTM->getDataLayout());
+    PM.add(new DataLayoutPass(M));
+
+    // Turn the machine code intermediate representation into bytes in memory
+    // that may be executed.
+    MCContext *Ctx;
+    if (CodeGenTM->addPassesToEmitMC(PM, Ctx, CompiledObject->getOStream(),
+                                     !getVerifyModules())) {
+      report_fatal_error("Target does not support MC emission!");
+    }
+
+    // Initialize passes.
+    PM.run(*M);
   }
+  releaseTargetMachine(CodeGenTM);
 
-  // Initialize passes.
-  PM.run(*M);
   // Flush the output buffer to get the generated code into memory
   CompiledObject->flush();
 
   // If we have an object cache, tell it about the new object.
   // Note that we're using the compiled image, not the loaded image (as below).
-  if (ObjCache) {
+  if (ObjCache && Cacheable) {
     // MemoryBuffer is a thin wrapper around the actual memory, so it's OK
     // to create a temporary object here and delete it after the call.
     std::unique_ptr<MemoryBuffer> MB(CompiledObject->getMemBuffer());
@@ -172,30 +308,70 @@ ObjectBufferStream* MCJIT::emitObject(Module *M) {
   return CompiledObject.release();
 }
 
+MCJIT::ModuleCompile *MCJIT::claimModule(Module *M) {
+  ModuleCompile *&MC = Compiles[M];
+  if (!MC) {
+    // A claimed module can't be read while it compiles, so index it now.
+    indexAddedModules();
+    MC = new ModuleCompile();
+    // Whoever claims the module first splits it, before anyone compiles it.
+    if (isCompilingLazily())
+      MC->Split = splitLazyFunctions(M, MC->SplitMap);
+  }
+  return MC;
+}
+
 void MCJIT::generateCodeForModule(Module *M) {
-  // Get a thread lock to make sure we aren't trying to load multiple times
-  MutexGuard locked(lock);
+  ModuleCompile *MC;
+  {
+    // Get a thread lock to make sure we aren't trying to load multiple times
+    MutexGuard locked(lock);
+
+    // This must be a module which has already been added to this MCJIT
+    // instance.
+    assert(OwnedModules.ownsModule(M) &&
+           "MCJIT::generateCodeForModule: Unknown module.");
 
-  // This must be a module which has already been added to this MCJIT instance.
-  assert(OwnedModules.ownsModule(M) &&
-         "MCJIT::generateCodeForModule: Unknown module.");
+    // Re-compilation is not supported
+    if (OwnedModules.hasModuleBeenLoaded(M))
+      return;
 
-  // Re-compilation is not supported
+    MC = claimModule(M);
+  }
+
+  // Produce the object holding only this module's lock, so that other modules
+  // compile meanwhile. A thread that wants this module as well waits here and
+  // then finds the object ready.
+  {
+    MutexGuard compiling(MC->Lock);
+    if (!MC->Compiled) {
+      // Try to load the pre-compiled object from cache if possible
+      if (ObjCache && !MC->Split) {
+        std::unique_ptr<MemoryBuffer> PreCompiledObject(ObjCache->getObject(M));
+        if (PreCompiledObject.get())
+          MC->Object.reset(new ObjectBuffer(PreCompiledObject.release()));
+      }
+
+      // If the cache did not contain a suitable object, compile the object
+      if (!MC->Object) {
+        MC->Object.reset(MC->Split ? emitObject(MC->Split, false)
+                                   : emitObject(M, true));
+        assert(MC->Object.get() && "Compilation did not produce an object.");
+      }
+      MC->Compiled = true;
+    }
+  }
+
+  MutexGuard locked(lock);
+
+  // Another thread may have loaded the object while this one waited.
   if (OwnedModules.hasModuleBeenLoaded(M))
     return;
 
   std::unique_ptr<ObjectBuffer> ObjectToLoad;
-  // Try to load the pre-compiled object from cache if possible
-  if (ObjCache) {
-    std::unique_ptr<MemoryBuffer> PreCompiledObject(ObjCache->getObject(M));
-    if (PreCompiledObject.get())
-      ObjectToLoad.reset(new ObjectBuffer(PreCompiledObject.release()));
-  }
-
-  // If the cache did not contain a suitable object, compile the object
-  if (!ObjectToLoad) {
-    ObjectToLoad.reset(emitObject(M));
-    assert(ObjectToLoad.get() && "Compilation did not produce an object.");
+  {
+    MutexGuard compiling(MC->Lock);
+    ObjectToLoad = std::move(MC->Object);
   }
 
   // Load the object into the dynamic linker.
@@ -210,6 +386,8 @@ void MCJIT::generateCodeForModule(Module *M) {
 
   NotifyObjectEmitted(*LoadedObject);
 
+  ModuleObjects[M] = LoadedObject;
+  unindexModule(M);
   OwnedModules.markModuleAsLoaded(M);
 }
 
@@ -230,27 +408,24 @@ void MCJIT::finalizeLoadedModules() {
 
 // FIXME: Rename this.
 void MCJIT::finalizeObject() {
-  MutexGuard locked(lock);
-
-  for (ModulePtrSet::iterator I = OwnedModules.begin_added(),
-                              E = OwnedModules.end_added();
-       I != E; ++I) {
-    Module *M = *I;
-    generateCodeForModule(M);
+  // Compiling a module loads it, which changes the set of added modules, and
+  // must not happen under the engine lock; work on a copy.
+  SmallVector<Module *, 8> ModulesToCompile;
+  {
+    MutexGuard locked(lock);
+    ModulesToCompile.append(OwnedModules.begin_added(),
+                            OwnedModules.end_added());
   }
 
+  for (unsigned i = 0, e = ModulesToCompile.size(); i != e; ++i)
+    generateCodeForModule(ModulesToCompile[i]);
+
   finalizeLoadedModules();
 }
 
 void MCJIT::finalizeModule(Module *M) {
-  MutexGuard locked(lock);
-
-  // This must be a module which has already been added to this MCJIT instance.
-  assert(OwnedModules.ownsModule(M) && "MCJIT::finalizeModule: Unknown module.");
-
   // If the module hasn't been compiled, just do that.
-  if (!OwnedModules.hasModuleBeenLoaded(M))
-    generateCodeForModule(M);
+  generateCodeForModule(M);
 
   finalizeLoadedModules();
 }
@@ -271,20 +446,18 @@ Module *MCJIT::findModuleForSymbol(const std::string &Name,
   MutexGuard locked(lock);
 
   // If it hasn't already been generated, see if it's in one of our modules.
-  for (ModulePtrSet::iterator I = OwnedModules.begin_added(),
-                              E = OwnedModules.end_added();
-       I != E; ++I) {
-    Module *M = *I;
-    Function *F = M->getFunction(Name);
-    if (F && !F->isDeclaration())
-      return M;
-    if (!CheckFunctionsOnly) {
-      GlobalVariable *G = M->getGlobalVariable(Name);
-      if (G && !G->isDeclaration())
-        return M;
-      // FIXME: Do we need to worry about global aliases?
-    }
+  // The index, unlike the modules, may be read while they are compiled.
+  indexAddedModules();
+  StringMap<Module *>::iterator I = FunctionIndex.find(Name);
+  if (I != FunctionIndex.end())
+    return I->second;
+  if (!CheckFunctionsOnly) {
+    I = VariableIndex.find(Name);
+    if (I != VariableIndex.end())
+      return I->second;
+    // FIXME: Do we need to worry about global aliases?
   }
+
   // We didn't find the symbol in any of our modules.
   return nullptr;
 }
@@ -292,13 +465,34 @@ Module *MCJIT::findModuleForSymbol(const std::string &Name,
 uint64_t MCJIT::getSymbolAddress(const std::string &Name,
                                  bool CheckFunctionsOnly)
 {
-  MutexGuard locked(lock);
+  Module *M;
+  {
+    MutexGuard locked(lock);
+
+    // First, check to see if we already have this symbol.
+    uint64_t Addr = getExistingSymbolAddress(Name);
+    if (Addr)
+      return Addr;
+
+    Addr = getSymbolAddressInArchives(Name);
+    if (Addr)
+      return Addr;
+
+    // If it hasn't already been generated, see if it's in one of our modules.
+    M = findModuleForSymbol(Name, CheckFunctionsOnly);
+    if (!M)
+      return 0;
+  }
 
-  // First, check to see if we already have this symbol.
-  uint64_t Addr = getExistingSymbolAddress(Name);
-  if (Addr)
-    return Addr;
+  // Compile without the engine lock, so other threads can meanwhile.
+  generateCodeForModule(M);
 
+  // Check the RuntimeDyld table again, it should be there now.
+  MutexGuard locked(lock);
+  return getExistingSymbolAddress(Name);
+}
+
+uint64_t MCJIT::getSymbolAddressInArchives(const std::string &Name) {
   SmallVector<object::Archive*, 2>::iterator I, E;
   for (I = Archives.begin(), E = Archives.end(); I != E; ++I) {
     object::Archive *A = *I;
@@ -313,26 +507,16 @@ uint64_t MCJIT::getSymbolAddress(const std::string &Name,
         // This causes the object file to be loaded.
         addObjectFile(std::move(OF));
         // The address should be here now.
-        Addr = getExistingSymbolAddress(Name);
+        uint64_t Addr = getExistingSymbolAddress(Name);
         if (Addr)
           return Addr;
       }
     }
   }
-
-  // If it hasn't already been generated, see if it's in one of our modules.
-  Module *M = findModuleForSymbol(Name, CheckFunctionsOnly);
-  if (!M)
-    return 0;
-
-  generateCodeForModule(M);
-
-  // Check the RuntimeDyld table again, it should be there now.
-  return getExistingSymbolAddress(Name);
+  return 0;
 }
 
 uint64_t MCJIT::getGlobalValueAddress(const std::string &Name) {
-  MutexGuard locked(lock);
   uint64_t Result = getSymbolAddress(Name, false);
   if (Result != 0)
     finalizeLoadedModules();
@@ -340,7 +524,6 @@ uint64_t MCJIT::getGlobalValueAddress(const std::string &Name) {
 }
 
 uint64_t MCJIT::getFunctionAddress(const std::string &Name) {
-  MutexGuard locked(lock);
   uint64_t Result = getSymbolAddress(Name, true);
   if (Result != 0)
     finalizeLoadedModules();
@@ -349,8 +532,6 @@ uint64_t MCJIT::getFunctionAddress(const std::string &Name) {
 
 // Deprecated.  Use getFunctionAddress instead.
 void *MCJIT::getPointerToFunction(Function *F) {
-  MutexGuard locked(lock);
-
   if (F->isDeclaration() || F->hasAvailableExternallyLinkage()) {
     bool AbortOnFailure = !F->hasExternalWeakLinkage();
     void *Addr = getPointerToNamedFunction(F->getName(), AbortOnFailure);
@@ -359,19 +540,32 @@ void *MCJIT::getPointerToFunction(Function *F) {
   }
 
   Module *M = F->getParent();
-  bool HasBeenAddedButNotLoaded = OwnedModules.hasModuleBeenAddedButNotLoaded(M);
+  bool HasBeenAddedButNotLoaded;
+  {
+    MutexGuard locked(lock);
+    HasBeenAddedButNotLoaded = OwnedModules.hasModuleBeenAddedButNotLoaded(M);
+    // If this function doesn't belong to one of our modules, we're done.
+    if (!HasBeenAddedButNotLoaded && !OwnedModules.hasModuleBeenLoaded(M))
+      return nullptr;
+  }
 
   // Make sure the relevant module has been compiled and loaded.
   if (HasBeenAddedButNotLoaded)
     generateCodeForModule(M);
-  else if (!OwnedModules.hasModuleBeenLoaded(M))
-    // If this function doesn't belong to one of our modules, we're done.
-    return nullptr;
+
+  MutexGuard locked(lock);
 
   // FIXME: Should the Dyld be retaining module information? Probably not.
   //
   // This is the accessor for the target address, so make sure to check the
   // load address of the symbol, not the local address.
+  // The functions of a module split up for lazy compilation are known by the
+  // names they have in the split copy.
+  ModuleCompileMap::iterator MC = Compiles.find(M);
+  if (MC != Compiles.end() && MC->second->Split)
+    if (Value *SplitF = MC->second->SplitMap.lookup(F))
+      F = cast<Function>(SplitF);
+
   Mangler Mang(TM->getDataLayout());
   SmallString<128> Name;
   TM->getNameWithPrefix(Name, F, Mang);
@@ -13,11 +13,14 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/ObjectImage.h"
 #include "llvm/ExecutionEngine/RuntimeDyld.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
 
 namespace llvm {
 class MCJIT;
@@ -61,6 +64,11 @@ public:
     ClientMM->notifyObjectLoaded(EE, Obj);
   }
 
+  void notifyObjectFreed(ExecutionEngine *EE,
+                         const ObjectImage *Obj) override {
+    ClientMM->notifyObjectFreed(EE, Obj);
+  }
+
   void registerEHFrames(uint8_t *Addr, uint64_t LoadAddr,
                         size_t Size) override {
     ClientMM->registerEHFrames(Addr, LoadAddr, Size);
@@ -99,6 +107,31 @@ private:
 // lli tool does this.  In that case, the intermediate action is taken by the
 // RemoteMemoryManager in response to the notifyObjectLoaded function being
 // called.
+//
+// About threads: the engine lock guards the module sets, the dynamic linker
+// and everything else shared, but it is not held while a module is compiled.
+// Each module has a ModuleCompile of its own whose lock is held instead, and
+// the code generator runs on a target machine taken from a pool, so that
+// threads asking for symbols of different modules compile them in parallel.
+// Loading the resulting objects, applying relocations and publishing their
+// symbols stays serialized under the engine lock. Locks are taken in the
+// order engine lock, ModuleCompile lock, target machine pool lock; a thread
+// holding a ModuleCompile lock only runs the code generator and the object
+// cache, and never asks for the engine lock.
+//
+// About lazy compilation: when it is enabled (see
+// ExecutionEngine::DisableLazyCompilation), a copy of a module is split up as
+// the module is claimed for code generation, and is compiled in its place; the
+// module itself is left as it was, so that it can be used again once it has
+// been removed. The body of each function moves to a module of its own, which
+// is kept out of the module sets, and the function itself becomes a stub that
+// calls through a pointer. The pointer starts out at a thunk that has a
+// resolver, shared by the functions of its type, ask the engine to compile the
+// body. The engine points the pointer at the body and the resolver calls it;
+// so only the functions that are run get compiled, each into an object of its
+// own. Everything a body refers to stays in the split copy, whose local symbols
+// are made external under unique names. Calls between lazily compiled
+// functions go through the stubs. The bodies have no debug info.
 
 class MCJIT : public ExecutionEngine {
   MCJIT(Module *M, TargetMachine *tm, RTDyldMemoryManager *MemMgr,
@@ -208,8 +241,44 @@ class MCJIT : public ExecutionEngine {
     }
   };
 
+  // The compilation state of a module that has been claimed for code
+  // generation; see generateCodeForModule.
+  struct ModuleCompile {
+    ModuleCompile() : Compiled(false), Split(nullptr) {}
+    ~ModuleCompile() { delete Split; }
+
+    // Held while the object is compiled or read from the object cache.
+    sys::Mutex Lock;
+    // Guarded by Lock. Object is taken by whoever loads it, under both locks.
+    bool Compiled;
+    std::unique_ptr<ObjectBuffer> Object;
+    // The copy of a module split up for lazy compilation, which is compiled
+    // in its place; null for a module compiled as it is. Its stubs hold
+    // addresses in this process, so its object is not cached. SplitMap maps
+    // the values of the module to those of the copy.
+    Module *Split;
+    ValueToValueMapTy SplitMap;
+  };
+  typedef DenseMap<Module *, ModuleCompile *> ModuleCompileMap;
+
+  // A function of a module split up for lazy compilation. Its thunk passes
+  // the LazyFunction to compileLazyFunction.
+  struct LazyFunction {
+    MCJIT *Engine;
+    // Owned by the LazyFunction until it is added to the engine on the first
+    // call, by OwnedModules after that.
+    Module *Body;
+    std::string BodyName;
+    // The pointer the stub calls through.
+    std::string AddrName;
+    bool Added;
+  };
+  typedef std::vector<LazyFunction *> LazyFunctionList;
+
+  // TM describes the target and is the template for the target machines the
+  // code generator runs on; it is never used to generate code itself, so it
+  // can be read while compiles are in flight.
   TargetMachine *TM;
-  MCContext *Ctx;
   LinkingMemoryManager MemMgr;
   RuntimeDyld Dyld;
   SmallVector<JITEventListener*, 2> EventListeners;
@@ -221,10 +290,53 @@ class MCJIT : public ExecutionEngine {
   typedef SmallVector<ObjectImage *, 2> LoadedObjectList;
   LoadedObjectList  LoadedObjects;
 
+  // The object each loaded module was compiled to, for removeModule.
+  DenseMap<Module *, ObjectImage *> ModuleObjects;
+
   // An optional ObjectCache to be notified of compiled objects and used to
   // perform lookup of pre-compiled code to avoid re-compilation.
   ObjectCache *ObjCache;
 
+  // Modules claimed for code generation that are still owned. Guarded by the
+  // engine lock.
+  ModuleCompileMap Compiles;
+
+  // The module that defines each function and variable of the modules added
+  // but not yet loaded, so that resolving a symbol does not search every
+  // module; see indexModule. Modules are indexed at the first symbol lookup or
+  // claim after they are added, and until then wait in UnindexedModules.
+  // Guarded by the engine lock.
+  StringMap<Module *> FunctionIndex;
+  StringMap<Module *> VariableIndex;
+  SmallVector<Module *, 2> UnindexedModules;
+
+  void indexModule(Module *M);
+  void indexAddedModules();
+  void unindexModule(Module *M);
+
+  // The lazily compiled functions of each split module. The functions of a
+  // module that was removed while its object stays in place are kept under a
+  // null module. Guarded by the engine lock.
+  DenseMap<Module *, LazyFunctionList> LazyFunctions;
+  // Makes the names splitLazyFunctions gives unique. Guarded by the engine
+  // lock.
+  unsigned NextLazyModuleID;
+
+  Module *splitLazyFunctions(Module *M, ValueToValueMapTy &VMap);
+  uint64_t getLazyFunctionBody(LazyFunction *LF);
+  void freeLazyFunctions(LazyFunctionList &LFs);
+  static void *compileLazyFunction(void *LF);
+
+  // Target machines that no compile is using, and all of those created from
+  // TM. Guarded by TMPoolLock.
+  sys::Mutex TMPoolLock;
+  SmallVector<TargetMachine *, 4> IdleTMs;
+  SmallVector<TargetMachine *, 4> CodeGenTMs;
+
+  TargetMachine *acquireTargetMachine();
+  void releaseTargetMachine(TargetMachine *CodeGenTM);
+  ModuleCompile *claimModule(Module *M);
+
   Function *FindFunctionNamedInModulePtrSet(const char *FnName,
                                             ModulePtrSet::iterator I,
                                             ModulePtrSet::iterator E);
@@ -241,6 +353,13 @@ public:
   void addModule(Module *M) override;
   void addObjectFile(std::unique_ptr<object::ObjectFile> O) override;
   void addArchive(object::Archive *O) override;
+
+  /// removeModule - Remove M from the engine; the caller owns it again. If M
+  /// has been finalized, its object is unloaded too: its symbols are dropped,
+  /// its EH frames deregistered and the memory manager is told to free its
+  /// sections, so no code or data of M may be in use. The same goes for the
+  /// functions of M that were compiled lazily. The object of a module that is
+  /// loaded but not finalized stays in place.
   bool removeModule(Module *M) override;
 
   /// FindFunctionNamed - Search all of the active modules to find the one that
@@ -340,16 +459,18 @@ public:
 
 protected:
   /// emitObject -- Generate a JITed object in memory from the specified module
-  /// Currently, MCJIT only supports a single module and the module passed to
-  /// this function call is expected to be the contained module.  The module
-  /// is passed as a parameter here to prepare for multiple module support in
-  /// the future.
-  ObjectBufferStream* emitObject(Module *M);
+  /// Called without the engine lock, with M's ModuleCompile lock held; the
+  /// code generator runs on a target machine of its own, so emitObject may run
+  /// for several modules at once.
+  /// The object is offered to the object cache unless Cacheable is false.
+  ObjectBufferStream* emitObject(Module *M, bool Cacheable);
 
   void NotifyObjectEmitted(const ObjectImage& Obj);
   void NotifyFreeingObject(const ObjectImage& Obj);
+  void unloadObject(ObjectImage *Obj);
 
   uint64_t getExistingSymbolAddress(const std::string &Name);
+  uint64_t getSymbolAddressInArchives(const std::string &Name);
   Module *findModuleForSymbol(const std::string &Name,
                               bool CheckFunctionsOnly);
 };
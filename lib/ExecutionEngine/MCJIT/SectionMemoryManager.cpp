@@ -15,6 +15,8 @@
 #include "llvm/Config/config.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Process.h"
+#include <algorithm>
 
 namespace llvm {
 
@@ -50,11 +52,12 @@ uint8_t *SectionMemoryManager::allocateSection(MemoryGroup &MemGroup,
   // is available.
   for (int i = 0, e = MemGroup.FreeMem.size(); i != e; ++i) {
     sys::MemoryBlock &MB = MemGroup.FreeMem[i];
-    if (MB.size() >= RequiredSize) {
-      Addr = (uintptr_t)MB.base();
-      uintptr_t EndOfBlock = Addr + MB.size();
-      // Align the address.
-      Addr = (Addr + Alignment - 1) & ~(uintptr_t)(Alignment - 1);
+    Addr = (uintptr_t)MB.base();
+    uintptr_t EndOfBlock = Addr + MB.size();
+    // Align the address.
+    Addr = (Addr + Alignment - 1) & ~(uintptr_t)(Alignment - 1);
+    // A reserved block fits its sections exactly.
+    if (Addr <= EndOfBlock && Size <= EndOfBlock - Addr) {
       // Store cutted free memory block.
       MemGroup.FreeMem[i] = sys::MemoryBlock((void*)(Addr + Size),
                                              EndOfBlock - Addr - Size);
@@ -65,27 +68,12 @@ uint8_t *SectionMemoryManager::allocateSection(MemoryGroup &MemGroup,
   // No pre-allocated free block was large enough. Allocate a new memory region.
   // Note that all sections get allocated as read-write.  The permissions will
   // be updated later based on memory group.
-  //
-  // FIXME: It would be useful to define a default allocation size (or add
-  // it as a constructor parameter) to minimize the number of allocations.
-  //
-  // FIXME: Initialize the Near member for each memory group to avoid
-  // interleaving.
-  error_code ec;
-  sys::MemoryBlock MB = sys::Memory::allocateMappedMemory(RequiredSize,
-                                                          &MemGroup.Near,
-                                                          sys::Memory::MF_READ |
-                                                            sys::Memory::MF_WRITE,
-                                                          ec);
-  if (ec) {
+  sys::MemoryBlock MB = allocateBlock(MemGroup, RequiredSize);
+  if (!MB.base()) {
     // FIXME: Add error propagation to the interface.
     return nullptr;
   }
 
-  // Save this address as the basis for our next request
-  MemGroup.Near = MB;
-
-  MemGroup.AllocatedMem.push_back(MB);
   Addr = (uintptr_t)MB.base();
   uintptr_t EndOfBlock = Addr + MB.size();
 
@@ -102,6 +90,159 @@ uint8_t *SectionMemoryManager::allocateSection(MemoryGroup &MemGroup,
   return (uint8_t*)Addr;
 }
 
+void SectionMemoryManager::reserveAllocationSpace(uintptr_t CodeSize,
+                                                  uintptr_t DataSizeRO,
+                                                  uintptr_t DataSizeRW) {
+  // The sizes are enough for the object's sections, except for the padding
+  // of its common symbols; a section that does not fit gets a block of its
+  // own.
+  if (CodeSize) {
+    sys::MemoryBlock MB = allocateBlock(CodeMem, CodeSize);
+    if (MB.base())
+      CodeMem.FreeMem.push_back(MB);
+  }
+  if (DataSizeRO) {
+    sys::MemoryBlock MB = allocateBlock(RODataMem, DataSizeRO);
+    if (MB.base())
+      RODataMem.FreeMem.push_back(MB);
+  }
+  if (DataSizeRW) {
+    sys::MemoryBlock MB = allocateBlock(RWDataMem, DataSizeRW);
+    if (MB.base())
+      RWDataMem.FreeMem.push_back(MB);
+  }
+}
+
+sys::MemoryBlock SectionMemoryManager::allocateBlock(MemoryGroup &MemGroup,
+                                                     uintptr_t Size) {
+  sys::MemoryBlock MB = allocateFromArena(&MemGroup == &CodeMem, Size);
+  if (!MB.base()) {
+    // FIXME: Initialize the Near member for each memory group to avoid
+    // interleaving.
+    error_code ec;
+    MB = sys::Memory::allocateMappedMemory(Size, &MemGroup.Near,
+                                           sys::Memory::MF_READ |
+                                             sys::Memory::MF_WRITE,
+                                           ec);
+    if (ec)
+      return sys::MemoryBlock();
+
+    // Save this address as the basis for our next request
+    MemGroup.Near = MB;
+  }
+
+  LoadingMem.push_back(MB);
+  MemGroup.PendingMem.push_back(MB);
+  return MB;
+}
+
+sys::MemoryBlock SectionMemoryManager::allocateFromArena(bool FromBottom,
+                                                         uintptr_t Size) {
+  if (!Arena.base()) {
+    if (!ArenaSize)
+      return sys::MemoryBlock();
+    unsigned Flags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+    if (UseHugePages)
+      Flags |= sys::Memory::MF_HUGE_HINT;
+    error_code ec;
+    Arena = sys::Memory::allocateMappedMemory(ArenaSize, nullptr, Flags, ec);
+    if (ec) {
+      // Map every block on its own instead.
+      ArenaSize = 0;
+      return sys::MemoryBlock();
+    }
+    ArenaCodeEnd = (uintptr_t)Arena.base();
+    ArenaDataBegin = ArenaCodeEnd + Arena.size();
+  }
+
+  // Blocks are whole pages, so that their permissions can differ.
+  static const uintptr_t PageSize = sys::process::get_self()->page_size();
+  Size = RoundUpToAlignment(Size, PageSize);
+
+  // Reuse the memory of freed objects first, code from the lowest block and
+  // data from the highest.
+  for (unsigned n = 0, e = ArenaFreeMem.size(); n != e; ++n) {
+    unsigned i = FromBottom ? n : e - 1 - n;
+    sys::MemoryBlock &Free = ArenaFreeMem[i];
+    if (Free.size() < Size)
+      continue;
+    uintptr_t Base = (uintptr_t)Free.base();
+    uintptr_t Rest = Free.size() - Size;
+    sys::MemoryBlock MB;
+    if (FromBottom) {
+      MB = sys::MemoryBlock((void *)Base, Size);
+      Free = sys::MemoryBlock((void *)(Base + Size), Rest);
+    } else {
+      MB = sys::MemoryBlock((void *)(Base + Rest), Size);
+      Free = sys::MemoryBlock((void *)Base, Rest);
+    }
+    if (!Rest)
+      ArenaFreeMem.erase(ArenaFreeMem.begin() + i);
+    return MB;
+  }
+
+  if (ArenaDataBegin - ArenaCodeEnd < Size)
+    return sys::MemoryBlock();
+  if (FromBottom) {
+    ArenaCodeEnd += Size;
+    return sys::MemoryBlock((void *)(ArenaCodeEnd - Size), Size);
+  }
+  ArenaDataBegin -= Size;
+  return sys::MemoryBlock((void *)ArenaDataBegin, Size);
+}
+
+bool SectionMemoryManager::isInArena(const sys::MemoryBlock &MB) const {
+  uintptr_t Base = (uintptr_t)Arena.base();
+  uintptr_t Addr = (uintptr_t)MB.base();
+  return Base && Addr >= Base && Addr - Base < Arena.size();
+}
+
+static bool blockBaseLess(const sys::MemoryBlock &A,
+                          const sys::MemoryBlock &B) {
+  return A.base() < B.base();
+}
+
+void SectionMemoryManager::releaseBlock(sys::MemoryBlock &MB) {
+  if (!isInArena(MB)) {
+    sys::Memory::releaseMappedMemory(MB);
+    return;
+  }
+
+  // Make the block writable again for the object that gets it next.
+  sys::Memory::protectMappedMemory(MB, sys::Memory::MF_READ |
+                                         sys::Memory::MF_WRITE);
+  uintptr_t Base = (uintptr_t)MB.base();
+  uintptr_t End = Base + MB.size();
+
+  // Merge the block with its free neighbours. Free blocks are kept sorted.
+  SmallVectorImpl<sys::MemoryBlock>::iterator I =
+      std::upper_bound(ArenaFreeMem.begin(), ArenaFreeMem.end(), MB,
+                       blockBaseLess);
+  if (I != ArenaFreeMem.begin()) {
+    sys::MemoryBlock &Prev = *(I - 1);
+    if ((uintptr_t)Prev.base() + Prev.size() == Base) {
+      Base = (uintptr_t)Prev.base();
+      I = ArenaFreeMem.erase(I - 1);
+    }
+  }
+  if (I != ArenaFreeMem.end() && (uintptr_t)I->base() == End) {
+    End += I->size();
+    I = ArenaFreeMem.erase(I);
+  }
+
+  // Free memory next to the unused middle of the arena goes back to it, so
+  // objects freed out of order don't leave the arena fragmented.
+  if (End == ArenaCodeEnd) {
+    ArenaCodeEnd = Base;
+    return;
+  }
+  if (Base == ArenaDataBegin) {
+    ArenaDataBegin = End;
+    return;
+  }
+  ArenaFreeMem.insert(I, sys::MemoryBlock((void *)Base, End - Base));
+}
+
 bool SectionMemoryManager::finalizeMemory(std::string *ErrMsg)
 {
   // FIXME: Should in-progress permissions be reverted if an error occurs?
@@ -140,16 +281,33 @@ bool SectionMemoryManager::finalizeMemory(std::string *ErrMsg)
   // relocations) will get to the data cache but not to the instruction cache.
   invalidateInstructionCache();
 
+  // Only memory allocated from now on needs to be finalized again; an engine
+  // finalizes after every module it loads.
+  CodeMem.PendingMem.clear();
+  RWDataMem.PendingMem.clear();
+  RODataMem.PendingMem.clear();
+
   return false;
 }
 
 error_code SectionMemoryManager::applyMemoryGroupPermissions(MemoryGroup &MemGroup,
                                                              unsigned Permissions) {
+  // Blocks taken from the arena one after another are adjacent; protect each
+  // run of them with one call. Separately mapped blocks are protected one by
+  // one, since they may not be merged even where they happen to touch.
+  SmallVectorImpl<sys::MemoryBlock> &Pending = MemGroup.PendingMem;
+  std::sort(Pending.begin(), Pending.end(), blockBaseLess);
+  for (unsigned i = 0, e = Pending.size(); i != e;) {
+      sys::MemoryBlock Run = Pending[i++];
+      if (isInArena(Run))
+        for (; i != e && isInArena(Pending[i]) &&
+               (uintptr_t)Run.base() + Run.size() ==
+                   (uintptr_t)Pending[i].base();
+             ++i)
+          Run = sys::MemoryBlock(Run.base(), Run.size() + Pending[i].size());
 
-  for (int i = 0, e = MemGroup.AllocatedMem.size(); i != e; ++i) {
       error_code ec;
-      ec = sys::Memory::protectMappedMemory(MemGroup.AllocatedMem[i],
-                                            Permissions);
+      ec = sys::Memory::protectMappedMemory(Run, Permissions);
       if (ec) {
         return ec;
       }
@@ -159,18 +317,81 @@ error_code SectionMemoryManager::applyMemoryGroupPermissions(MemoryGroup &MemGro
 }
 
 void SectionMemoryManager::invalidateInstructionCache() {
-  for (int i = 0, e = CodeMem.AllocatedMem.size(); i != e; ++i)
-    sys::Memory::InvalidateInstructionCache(CodeMem.AllocatedMem[i].base(),
-                                            CodeMem.AllocatedMem[i].size());
+  for (int i = 0, e = CodeMem.PendingMem.size(); i != e; ++i)
+    sys::Memory::InvalidateInstructionCache(CodeMem.PendingMem[i].base(),
+                                            CodeMem.PendingMem[i].size());
+}
+
+void SectionMemoryManager::setObjectUnloading(bool Enable) {
+  // Sections allocated from here on must not land in a block of an earlier,
+  // shared object.
+  if (Enable && !ObjectUnloading) {
+    CodeMem.FreeMem.clear();
+    RWDataMem.FreeMem.clear();
+    RODataMem.FreeMem.clear();
+  }
+  ObjectUnloading = Enable;
+}
+
+void SectionMemoryManager::notifyObjectLoaded(ExecutionEngine *EE,
+                                              const ObjectImage *Obj) {
+  if (!ObjectUnloading) {
+    SharedMem.insert(SharedMem.end(), LoadingMem.begin(), LoadingMem.end());
+    LoadingMem.clear();
+    return;
+  }
+
+  std::vector<sys::MemoryBlock> &Blocks = ObjectMem[Obj];
+  Blocks.insert(Blocks.end(), LoadingMem.begin(), LoadingMem.end());
+  LoadingMem.clear();
+
+  // Don't let the next object's sections share a block with this one's.
+  CodeMem.FreeMem.clear();
+  RWDataMem.FreeMem.clear();
+  RODataMem.FreeMem.clear();
+}
+
+static void erasePendingBlock(SmallVectorImpl<sys::MemoryBlock> &PendingMem,
+                              const sys::MemoryBlock &MB) {
+  for (unsigned i = 0, e = PendingMem.size(); i != e; ++i)
+    if (PendingMem[i].base() == MB.base()) {
+      PendingMem.erase(PendingMem.begin() + i);
+      return;
+    }
+}
+
+void SectionMemoryManager::notifyObjectFreed(ExecutionEngine *EE,
+                                             const ObjectImage *Obj) {
+  DenseMap<const ObjectImage *, std::vector<sys::MemoryBlock> >::iterator I =
+      ObjectMem.find(Obj);
+  if (I == ObjectMem.end())
+    return;
+
+  for (unsigned i = 0, e = I->second.size(); i != e; ++i) {
+    sys::MemoryBlock &MB = I->second[i];
+    // The object may be freed before it was finalized.
+    erasePendingBlock(CodeMem.PendingMem, MB);
+    erasePendingBlock(RWDataMem.PendingMem, MB);
+    erasePendingBlock(RODataMem.PendingMem, MB);
+    releaseBlock(MB);
+  }
+  ObjectMem.erase(I);
 }
 
 SectionMemoryManager::~SectionMemoryManager() {
-  for (unsigned i = 0, e = CodeMem.AllocatedMem.size(); i != e; ++i)
-    sys::Memory::releaseMappedMemory(CodeMem.AllocatedMem[i]);
-  for (unsigned i = 0, e = RWDataMem.AllocatedMem.size(); i != e; ++i)
-    sys::Memory::releaseMappedMemory(RWDataMem.AllocatedMem[i]);
-  for (unsigned i = 0, e = RODataMem.AllocatedMem.size(); i != e; ++i)
-    sys::Memory::releaseMappedMemory(RODataMem.AllocatedMem[i]);
+  for (unsigned i = 0, e = LoadingMem.size(); i != e; ++i)
+    if (!isInArena(LoadingMem[i]))
+      sys::Memory::releaseMappedMemory(LoadingMem[i]);
+  for (unsigned i = 0, e = SharedMem.size(); i != e; ++i)
+    if (!isInArena(SharedMem[i]))
+      sys::Memory::releaseMappedMemory(SharedMem[i]);
+  for (DenseMap<const ObjectImage *, std::vector<sys::MemoryBlock> >::iterator
+           I = ObjectMem.begin(), E = ObjectMem.end();
+       I != E; ++I)
+    for (unsigned i = 0, e = I->second.size(); i != e; ++i)
+      if (!isInArena(I->second[i]))
+        sys::Memory::releaseMappedMemory(I->second[i]);
+  sys::Memory::releaseMappedMemory(Arena);
 }
 
 } // namespace llvm
@@ -0,0 +1,287 @@
+//===-- PerfJITEventListener.cpp - Tell Linux perf about JITed code -------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a JITEventListener object to tell Linux perf about JITed
+// functions. perf report names the samples that fall in anonymous memory from
+// /tmp/perf-<pid>.map, which gets a line for each function. With a jitdump
+// file as well, perf inject --jit turns each function into an ELF image of
+// its own, with its code and line table, so that perf annotate can show it.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/JITEventListener.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/DebugInfo/DIContext.h"
+#include "llvm/ExecutionEngine/ObjectImage.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Support/ELF.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/MutexGuard.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+
+#ifdef __linux__
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using namespace llvm;
+
+#ifdef __linux__
+
+namespace {
+
+// The jitdump format, as perf's tools/perf/util/jitdump.h defines it. All
+// fields are in the byte order of the host, which the magic tells perf.
+const uint32_t JITDumpMagic = 0x4A695444; // "JiTD"
+const uint32_t JITDumpVersion = 1;
+const uint32_t JITDumpHeaderSize = 40;
+const uint32_t JITDumpRecordHeaderSize = 16;
+
+enum JITDumpRecordType {
+  JIT_CODE_LOAD = 0,
+  JIT_CODE_DEBUG_INFO = 2,
+  JIT_CODE_CLOSE = 3
+};
+
+// perf inject --jit puts the code of each function after an ELF header of
+// this size, and reads the line table as if the code were at its address.
+const uint64_t PerfELFHeaderSize = 0x40;
+
+/// Tells perf about the functions of each object MCJIT loads, and about each
+/// function the JIT emits, without a line table. Neither format can say that
+/// code was unloaded, so NotifyFreeingObject and NotifyFreeingMachineCode are
+/// not overridden; when later code reuses the memory, perf inject tells the
+/// two apart by the timestamps of their jitdump records.
+class PerfJITEventListener : public JITEventListener {
+public:
+  PerfJITEventListener(bool JITDump);
+  ~PerfJITEventListener();
+
+  void NotifyFunctionEmitted(const Function &F, void *Code, size_t Size,
+                             const EmittedFunctionDetails &Details) override;
+
+  void NotifyObjectEmitted(const ObjectImage &Obj) override;
+
+private:
+  void openJITDump();
+  void recordFunction(StringRef Name, uint64_t Addr, uint64_t Size,
+                      DIContext *Context);
+  void flush();
+  void writeRecordHeader(uint32_t Type, uint64_t Size);
+  void writeDebugInfo(uint64_t Addr, const DILineInfoTable &Lines);
+  void writeCodeLoad(StringRef Name, uint64_t Addr, uint64_t Size);
+
+  template <typename T> void write(T Value) {
+    Dump->write(reinterpret_cast<const char *>(&Value), sizeof(T));
+  }
+
+  sys::Mutex Lock;
+  std::unique_ptr<raw_fd_ostream> PerfMap;
+  std::unique_ptr<raw_fd_ostream> Dump;
+  // perf record finds the jitdump file through this executable mapping of it.
+  void *DumpMarker;
+  size_t DumpMarkerSize;
+  uint64_t CodeIndex;
+};
+
+} // end anonymous namespace
+
+static uint64_t getTimestamp() {
+  // perf record -k mono samples with the same clock.
+  struct timespec TS;
+  if (clock_gettime(CLOCK_MONOTONIC, &TS))
+    return 0;
+  return uint64_t(TS.tv_sec) * 1000000000 + TS.tv_nsec;
+}
+
+static uint32_t getELFMachine() {
+  switch (Triple(sys::getProcessTriple()).getArch()) {
+  case Triple::x86:        return ELF::EM_386;
+  case Triple::x86_64:     return ELF::EM_X86_64;
+  case Triple::arm:
+  case Triple::thumb:      return ELF::EM_ARM;
+  case Triple::aarch64:
+  case Triple::arm64:      return ELF::EM_AARCH64;
+  case Triple::mips:
+  case Triple::mipsel:
+  case Triple::mips64:
+  case Triple::mips64el:   return ELF::EM_MIPS;
+  case Triple::ppc:        return ELF::EM_PPC;
+  case Triple::ppc64:
+  case Triple::ppc64le:    return ELF::EM_PPC64;
+  case Triple::systemz:    return ELF::EM_S390;
+  default:                 return ELF::EM_NONE;
+  }
+}
+
+PerfJITEventListener::PerfJITEventListener(bool JITDump)
+    : DumpMarker(nullptr), DumpMarkerSize(0), CodeIndex(0) {
+  std::string Path = "/tmp/perf-" + utostr(getpid()) + ".map";
+  std::string ErrorInfo;
+  PerfMap.reset(new raw_fd_ostream(Path.c_str(), ErrorInfo,
+                                   sys::fs::F_Append | sys::fs::F_Text));
+  if (!ErrorInfo.empty())
+    PerfMap.reset();
+
+  if (JITDump)
+    openJITDump();
+}
+
+void PerfJITEventListener::openJITDump() {
+  const char *Dir = getenv("JITDUMPDIR");
+  std::string Path = std::string(Dir ? Dir : "/tmp") + "/jit-" +
+                     utostr(getpid()) + ".dump";
+  // The file is mapped below, which needs it open for reading as well.
+  int FD = ::open(Path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0666);
+  if (FD < 0)
+    return;
+  Dump.reset(new raw_fd_ostream(FD, /*shouldClose=*/true));
+
+  write(JITDumpMagic);
+  write(JITDumpVersion);
+  write(JITDumpHeaderSize);
+  write(getELFMachine());
+  write(uint32_t(0));
+  write(uint32_t(getpid()));
+  write(getTimestamp());
+  write(uint64_t(0)); // Flags.
+  Dump->flush();
+
+  DumpMarkerSize = sys::process::get_self()->page_size();
+  DumpMarker = ::mmap(nullptr, DumpMarkerSize, PROT_READ | PROT_EXEC,
+                      MAP_PRIVATE, FD, 0);
+  if (DumpMarker == MAP_FAILED) {
+    DumpMarker = nullptr;
+    Dump.reset();
+  }
+}
+
+PerfJITEventListener::~PerfJITEventListener() {
+  if (Dump) {
+    writeRecordHeader(JIT_CODE_CLOSE, JITDumpRecordHeaderSize);
+    Dump->flush();
+    ::munmap(DumpMarker, DumpMarkerSize);
+  }
+}
+
+void PerfJITEventListener::writeRecordHeader(uint32_t Type, uint64_t Size) {
+  write(Type);
+  write(uint32_t(Size));
+  write(getTimestamp());
+}
+
+void PerfJITEventListener::writeDebugInfo(uint64_t Addr,
+                                          const DILineInfoTable &Lines) {
+  uint64_t Size = JITDumpRecordHeaderSize + 16;
+  for (unsigned i = 0, e = Lines.size(); i != e; ++i)
+    Size += 16 + Lines[i].second.FileName.size() + 1;
+
+  writeRecordHeader(JIT_CODE_DEBUG_INFO, Size);
+  write(Addr);
+  write(uint64_t(Lines.size()));
+  for (unsigned i = 0, e = Lines.size(); i != e; ++i) {
+    const DILineInfo &Line = Lines[i].second;
+    write(Lines[i].first + PerfELFHeaderSize);
+    write(uint32_t(Line.Line));
+    write(uint32_t(0)); // Discriminator.
+    Dump->write(Line.FileName.c_str(), Line.FileName.size() + 1);
+  }
+}
+
+void PerfJITEventListener::writeCodeLoad(StringRef Name, uint64_t Addr,
+                                         uint64_t Size) {
+  writeRecordHeader(JIT_CODE_LOAD,
+                    JITDumpRecordHeaderSize + 40 + Name.size() + 1 + Size);
+  write(uint32_t(getpid()));
+  write(uint32_t(syscall(SYS_gettid)));
+  write(Addr); // vma
+  write(Addr);
+  write(Size);
+  write(CodeIndex++);
+  *Dump << Name << '\0';
+  Dump->write(reinterpret_cast<const char *>(uintptr_t(Addr)), Size);
+}
+
+void PerfJITEventListener::NotifyObjectEmitted(const ObjectImage &Obj) {
+  if (!PerfMap && !Dump)
+    return;
+
+  std::unique_ptr<DIContext> Context;
+  if (Dump)
+    Context.reset(DIContext::getDWARFContext(Obj.getObjectFile()));
+
+  MutexGuard Guard(Lock);
+  for (object::symbol_iterator I = Obj.begin_symbols(), E = Obj.end_symbols();
+       I != E; ++I) {
+    object::SymbolRef::Type SymType;
+    if (I->getType(SymType) || SymType != object::SymbolRef::ST_Function)
+      continue;
+    StringRef Name;
+    uint64_t Addr, Size;
+    if (I->getName(Name) || I->getAddress(Addr) || I->getSize(Size))
+      continue;
+    if (!Size || Size == object::UnknownAddressOrSize)
+      continue;
+    recordFunction(Name, Addr, Size, Context.get());
+  }
+  flush();
+}
+
+void PerfJITEventListener::NotifyFunctionEmitted(
+    const Function &F, void *Code, size_t Size,
+    const EmittedFunctionDetails &Details) {
+  MutexGuard Guard(Lock);
+  recordFunction(F.getName(), uint64_t(uintptr_t(Code)), Size, nullptr);
+  flush();
+}
+
+void PerfJITEventListener::recordFunction(StringRef Name, uint64_t Addr,
+                                          uint64_t Size, DIContext *Context) {
+  if (PerfMap) {
+    PerfMap->write_hex(Addr) << ' ';
+    PerfMap->write_hex(Size) << ' ' << Name << '\n';
+  }
+  if (Dump) {
+    // perf wants the line table before the code it describes.
+    if (Context) {
+      DILineInfoTable Lines = Context->getLineInfoForAddressRange(Addr, Size);
+      if (!Lines.empty())
+        writeDebugInfo(Addr, Lines);
+    }
+    writeCodeLoad(Name, Addr, Size);
+  }
+}
+
+void PerfJITEventListener::flush() {
+  // Profiles are often taken of processes that never exit cleanly.
+  if (PerfMap)
+    PerfMap->flush();
+  if (Dump)
+    Dump->flush();
+}
+
+JITEventListener *JITEventListener::createPerfJITEventListener(bool JITDump) {
+  return new PerfJITEventListener(JITDump);
+}
+
+#else
+
+JITEventListener *JITEventListener::createPerfJITEventListener(bool JITDump) {
+  return nullptr;
+}
+
+#endif
@@ -47,18 +47,22 @@ void RuntimeDyldImpl::resolveRelocations() {
   // First, resolve relocations associated with external symbols.
   resolveExternalSymbols();
 
-  // Just iterate over the sections we have and resolve all the relocations
-  // in them. Gross overkill, but it gets the job done.
-  for (int i = 0, e = Sections.size(); i != e; ++i) {
-    // The Section here (Sections[i]) refers to the section in which the
-    // symbol for the relocation is located.  The SectionID in the relocation
-    // entry provides the section to which the relocation will be applied.
-    uint64_t Addr = Sections[i].LoadAddress;
-    DEBUG(dbgs() << "Resolving relocations Section #" << i << "\t"
+  // Resolve the relocations against each section that still has some. Only
+  // sections loaded since the last call do, so this does not revisit every
+  // section of every object loaded so far.
+  for (DenseMap<unsigned, RelocationList>::iterator I = Relocations.begin(),
+                                                    E = Relocations.end();
+       I != E; ++I) {
+    // The Section here (Sections[I->first]) refers to the section in which
+    // the symbol for the relocation is located.  The SectionID in the
+    // relocation entry provides the section to which the relocation will be
+    // applied.
+    uint64_t Addr = Sections[I->first].LoadAddress;
+    DEBUG(dbgs() << "Resolving relocations Section #" << I->first << "\t"
                  << format("%p", (uint8_t *)Addr) << "\n");
-    resolveRelocationList(Relocations[i], Addr);
-    Relocations.erase(i);
+    resolveRelocationList(I->second, Addr);
   }
+  Relocations.clear();
 }
 
 void RuntimeDyldImpl::mapSectionAddress(const void *LocalAddress,
@@ -108,6 +112,9 @@ ObjectImage *RuntimeDyldImpl::loadObject(ObjectImage *InputObject) {
   if (!Obj)
     return nullptr;
 
+  // Every section emitted from here on belongs to this object.
+  unsigned FirstSectionID = Sections.size();
+
   // Save information about our target
   Arch = (Triple::ArchType)Obj->getArch();
   IsTargetLittleEndian = Obj->getObjectFile()->isLittleEndian();
@@ -209,9 +216,45 @@ ObjectImage *RuntimeDyldImpl::loadObject(ObjectImage *InputObject) {
   // Give the subclasses a chance to tie-up any loose ends.
   finalizeLoad(*Obj, LocalSections);
 
+  ObjectSections[Obj.get()] = std::make_pair(FirstSectionID, Sections.size());
   return Obj.release();
 }
 
+void RuntimeDyldImpl::unloadObject(ObjectImage *Obj) {
+  MutexGuard locked(lock);
+
+  DenseMap<const ObjectImage *, std::pair<unsigned, unsigned> >::iterator I =
+      ObjectSections.find(Obj);
+  if (I == ObjectSections.end())
+    return;
+  SID FirstSID = I->second.first, EndSID = I->second.second;
+  ObjectSections.erase(I);
+
+  unloadSections(FirstSID, EndSID);
+
+  // Forget the object's symbols, unless a later object redefined them.
+  for (symbol_iterator SI = Obj->begin_symbols(), SE = Obj->end_symbols();
+       SI != SE; ++SI) {
+    StringRef Name;
+    if (SI->getName(Name))
+      continue;
+    SymbolTableMap::iterator Loc = GlobalSymbolTable.find(Name);
+    if (Loc != GlobalSymbolTable.end() && Loc->second.first >= FirstSID &&
+        Loc->second.first < EndSID)
+      GlobalSymbolTable.erase(Loc);
+  }
+
+  // The SectionIDs stay taken; the sections become empty.
+  for (SID i = FirstSID; i != EndSID; ++i) {
+    Relocations.erase(i);
+    SectionEntry &Section = Sections[i];
+    Section.Address = nullptr;
+    Section.Size = 0;
+    Section.LoadAddress = 0;
+    Section.StubOffset = 0;
+  }
+}
+
 // A helper method for computeTotalAllocSize.
 // Computes the memory size required to allocate sections with the given sizes,
 // assuming that all sections are allocated with the given alignment
@@ -783,6 +826,11 @@ uint64_t RuntimeDyld::getSymbolLoadAddress(StringRef Name) {
   return Dyld->getSymbolLoadAddress(Name);
 }
 
+void RuntimeDyld::unloadObject(ObjectImage *Obj) {
+  if (Dyld)
+    Dyld->unloadObject(Obj);
+}
+
 void RuntimeDyld::resolveRelocations() { Dyld->resolveRelocations(); }
 
 void RuntimeDyld::reassignSectionAddress(unsigned SectionID, uint64_t Addr) {
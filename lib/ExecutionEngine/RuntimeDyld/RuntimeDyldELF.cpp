@@ -177,6 +177,39 @@ void RuntimeDyldELF::deregisterEHFrames() {
   RegisteredEHFrameSections.clear();
 }
 
+void RuntimeDyldELF::unloadSections(SID FirstSID, SID EndSID) {
+  // Deregister the EH frames among the sections, or drop them if they were
+  // never registered.
+  for (unsigned i = 0; i != RegisteredEHFrameSections.size();) {
+    SID EHFrameSID = RegisteredEHFrameSections[i];
+    if (EHFrameSID < FirstSID || EHFrameSID >= EndSID) {
+      ++i;
+      continue;
+    }
+    if (MemMgr)
+      MemMgr->deregisterEHFrames(Sections[EHFrameSID].Address,
+                                 Sections[EHFrameSID].LoadAddress,
+                                 Sections[EHFrameSID].Size);
+    RegisteredEHFrameSections.erase(RegisteredEHFrameSections.begin() + i);
+  }
+  for (unsigned i = 0; i != UnregisteredEHFrameSections.size();) {
+    SID EHFrameSID = UnregisteredEHFrameSections[i];
+    if (EHFrameSID >= FirstSID && EHFrameSID < EndSID)
+      UnregisteredEHFrameSections.erase(UnregisteredEHFrameSections.begin() +
+                                        i);
+    else
+      ++i;
+  }
+
+  // Drop the global offset tables allocated in them.
+  for (unsigned i = 0; i != GOTs.size();) {
+    if (GOTs[i].first >= FirstSID && GOTs[i].first < EndSID)
+      GOTs.erase(GOTs.begin() + i);
+    else
+      ++i;
+  }
+}
+
 ObjectImage *
 RuntimeDyldELF::createObjectImageFromFile(std::unique_ptr<object::ObjectFile> ObjFile) {
   if (!ObjFile)
@@ -118,6 +118,7 @@ public:
   void deregisterEHFrames() override;
   void finalizeLoad(ObjectImage &ObjImg,
                     ObjSectionToIDMap &SectionMap) override;
+  void unloadSections(SID FirstSID, SID EndSID) override;
   virtual ~RuntimeDyldELF();
 
   static ObjectImage *createObjectImage(ObjectBuffer *InputBuffer);
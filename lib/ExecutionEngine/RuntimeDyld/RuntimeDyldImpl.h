@@ -196,6 +196,10 @@ protected:
   // SectionID/Offset in the relocation itself.
   DenseMap<unsigned, RelocationList> Relocations;
 
+  // The sections of each loaded object, as the range [first, second) of
+  // SectionIDs, for unloadObject.
+  DenseMap<const ObjectImage *, std::pair<unsigned, unsigned> > ObjectSections;
+
   // Relocations to external symbols that are not yet resolved.  Symbols are
   // external when they aren't found in the global symbol table of all loaded
   // modules.  This map is indexed by symbol name.
@@ -392,6 +396,12 @@ public:
   virtual void deregisterEHFrames();
 
   virtual void finalizeLoad(ObjectImage &ObjImg, ObjSectionToIDMap &SectionMap) {}
+
+  void unloadObject(ObjectImage *Obj);
+
+  // Give the subclasses a chance to forget the sections [FirstSID, EndSID) of
+  // an object being unloaded.
+  virtual void unloadSections(SID FirstSID, SID EndSID) {}
 };
 
 } // end namespace llvm
@@ -479,7 +479,13 @@ enum IIT_Info {
   IIT_ANYPTR = 25,
   IIT_V1   = 26,
   IIT_VARARG = 27,
-  IIT_HALF_VEC_ARG = 28
+  IIT_HALF_VEC_ARG = 28,
+  IIT_STRUCT6 = 29,
+  IIT_STRUCT7 = 30,
+  IIT_STRUCT8 = 31,
+  IIT_V64  = 32,
+  IIT_V128 = 33,
+  IIT_V256 = 34
 };
 
 
@@ -550,6 +556,18 @@ static void DecodeIITType(unsigned &NextElt, ArrayRef<unsigned char> Infos,
     OutputTable.push_back(IITDescriptor::get(IITDescriptor::Vector, 32));
     DecodeIITType(NextElt, Infos, OutputTable);
     return;
+  case IIT_V64:
+    OutputTable.push_back(IITDescriptor::get(IITDescriptor::Vector, 64));
+    DecodeIITType(NextElt, Infos, OutputTable);
+    return;
+  case IIT_V128:
+    OutputTable.push_back(IITDescriptor::get(IITDescriptor::Vector, 128));
+    DecodeIITType(NextElt, Infos, OutputTable);
+    return;
+  case IIT_V256:
+    OutputTable.push_back(IITDescriptor::get(IITDescriptor::Vector, 256));
+    DecodeIITType(NextElt, Infos, OutputTable);
+    return;
   case IIT_PTR:
     OutputTable.push_back(IITDescriptor::get(IITDescriptor::Pointer, 0));
     DecodeIITType(NextElt, Infos, OutputTable);
@@ -586,6 +604,9 @@ static void DecodeIITType(unsigned &NextElt, ArrayRef<unsigned char> Infos,
   case IIT_EMPTYSTRUCT:
     OutputTable.push_back(IITDescriptor::get(IITDescriptor::Struct, 0));
     return;
+  case IIT_STRUCT8: ++StructElts; // FALL THROUGH.
+  case IIT_STRUCT7: ++StructElts; // FALL THROUGH.
+  case IIT_STRUCT6: ++StructElts; // FALL THROUGH.
   case IIT_STRUCT5: ++StructElts; // FALL THROUGH.
   case IIT_STRUCT4: ++StructElts; // FALL THROUGH.
   case IIT_STRUCT3: ++StructElts; // FALL THROUGH.
@@ -662,8 +683,8 @@ static Type *DecodeFixedType(ArrayRef<Intrinsic::IITDescriptor> &Infos,
     return PointerType::get(DecodeFixedType(Infos, Tys, Context),
                             D.Pointer_AddressSpace);
   case IITDescriptor::Struct: {
-    Type *Elts[5];
-    assert(D.Struct_NumElements <= 5 && "Can't handle this yet");
+    Type *Elts[8];
+    assert(D.Struct_NumElements <= 8 && "Can't handle this yet");
     for (unsigned i = 0, e = D.Struct_NumElements; i != e; ++i)
       Elts[i] = DecodeFixedType(Infos, Tys, Context);
     return StructType::get(Context, ArrayRef<Type*>(Elts,D.Struct_NumElements));
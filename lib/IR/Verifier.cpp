@@ -2463,6 +2463,12 @@ void Verifier::visitIntrinsicFunctionCall(Intrinsic::ID ID, CallInst &CI) {
     Assert1(isa<ConstantInt>(CI.getArgOperand(1)),
             "llvm.invariant.end parameter #2 must be a constant integer", &CI);
     break;
+  case Intrinsic::parabix_matchstar:
+  case Intrinsic::parabix_scanthru:
+  case Intrinsic::parabix_advance:
+    Assert1(!CI.getArgOperand(0)->getType()->isVectorTy(),
+            "Parabix bitstream intrinsics take a scalar integer block", &CI);
+    break;
   }
 }
 
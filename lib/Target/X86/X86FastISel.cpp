@@ -78,7 +78,8 @@ public:
 private:
   bool X86FastEmitCompare(const Value *LHS, const Value *RHS, EVT VT);
 
-  bool X86FastEmitLoad(EVT VT, const X86AddressMode &AM, unsigned &RR);
+  bool X86FastEmitLoad(EVT VT, const X86AddressMode &AM, unsigned &RR,
+                       bool Aligned = false);
 
   bool X86FastEmitStore(EVT VT, const Value *Val, const X86AddressMode &AM,
                         bool Aligned = false);
@@ -114,6 +115,9 @@ private:
   bool X86SelectFPExt(const Instruction *I);
   bool X86SelectFPTrunc(const Instruction *I);
 
+  bool X86SelectParabixBinaryOp(const Instruction *I);
+  bool X86SelectParabixBitCast(const Instruction *I);
+
   bool X86VisitIntrinsicCall(const IntrinsicInst &I);
   bool X86SelectCall(const Instruction *I);
 
@@ -130,6 +134,8 @@ private:
 
   unsigned TargetMaterializeConstant(const Constant *C) override;
 
+  unsigned X86MaterializeParabixConstant(const Constant *C, MVT VT);
+
   unsigned TargetMaterializeAlloca(const AllocaInst *C) override;
 
   unsigned TargetMaterializeFloatZero(const ConstantFP *CF) override;
@@ -151,6 +157,23 @@ private:
 
 } // end anonymous namespace.
 
+/// isParabixVT - Return true if VT is one of the Parabix stream types, which
+/// live in GR32X, GR64X, VR128PX or VR256PX.
+static bool isParabixVT(MVT VT) {
+  switch (VT.SimpleTy) {
+  default: return false;
+  case MVT::v32i1:
+  case MVT::v64i1:
+  case MVT::v64i2:
+  case MVT::v32i4:
+  case MVT::v128i1:
+  case MVT::v128i2:
+  case MVT::v64i4:
+  case MVT::v256i1:
+    return true;
+  }
+}
+
 bool X86FastISel::isTypeLegal(Type *Ty, MVT &VT, bool AllowI1) {
   EVT evt = TLI.getValueType(Ty, /*HandleUnknown=*/true);
   if (evt == MVT::Other || !evt.isSimple())
@@ -180,7 +203,7 @@ bool X86FastISel::isTypeLegal(Type *Ty, MVT &VT, bool AllowI1) {
 /// The address is either pre-computed, i.e. Ptr, or a GlobalAddress, i.e. GV.
 /// Return true and the result register by reference if it is possible.
 bool X86FastISel::X86FastEmitLoad(EVT VT, const X86AddressMode &AM,
-                                  unsigned &ResultReg) {
+                                  unsigned &ResultReg, bool Aligned) {
   // Get opcode and regclass of the output for the given load instruction.
   unsigned Opc = 0;
   const TargetRegisterClass *RC = nullptr;
@@ -225,6 +248,31 @@ bool X86FastISel::X86FastEmitLoad(EVT VT, const X86AddressMode &AM,
   case MVT::f80:
     // No f80 support yet.
     return false;
+  case MVT::v32i1:
+    Opc = X86::MOV32rm;
+    RC  = &X86::GR32XRegClass;
+    break;
+  case MVT::v64i1:
+    // Must be in x86-64 mode.
+    Opc = X86::MOV64rm;
+    RC  = &X86::GR64XRegClass;
+    break;
+  case MVT::v128i1:
+  case MVT::v64i2:
+  case MVT::v32i4:
+    if (Aligned)
+      Opc = Subtarget->hasAVX() ? X86::VMOVDQArm : X86::MOVDQArm;
+    else
+      Opc = Subtarget->hasAVX() ? X86::VMOVDQUrm : X86::MOVDQUrm;
+    RC  = &X86::VR128PXRegClass;
+    break;
+  case MVT::v256i1:
+  case MVT::v128i2:
+  case MVT::v64i4:
+    // Must have AVX2.
+    Opc = Aligned ? X86::VMOVDQAYrm : X86::VMOVDQUYrm;
+    RC  = &X86::VR256PXRegClass;
+    break;
   }
 
   ResultReg = createResultReg(RC);
@@ -286,6 +334,22 @@ X86FastISel::X86FastEmitStore(EVT VT, unsigned ValReg,
     else
       Opc = Subtarget->hasAVX() ? X86::VMOVDQUmr : X86::MOVDQUmr;
     break;
+  case MVT::v32i1: Opc = X86::MOV32mr; break;
+  case MVT::v64i1: Opc = X86::MOV64mr; break; // Must be in x86-64 mode.
+  case MVT::v128i1:
+  case MVT::v64i2:
+  case MVT::v32i4:
+    if (Aligned)
+      Opc = Subtarget->hasAVX() ? X86::VMOVDQAmr : X86::MOVDQAmr;
+    else
+      Opc = Subtarget->hasAVX() ? X86::VMOVDQUmr : X86::MOVDQUmr;
+    break;
+  case MVT::v256i1:
+  case MVT::v128i2:
+  case MVT::v64i4:
+    // Must have AVX2.
+    Opc = Aligned ? X86::VMOVDQAYmr : X86::VMOVDQUYmr;
+    break;
   }
 
   addFullAddress(BuildMI(*FuncInfo.MBB, FuncInfo.InsertPt,
@@ -748,6 +812,12 @@ bool X86FastISel::X86SelectStore(const Instruction *I) {
   if (!isTypeLegal(I->getOperand(0)->getType(), VT, /*AllowI1=*/true))
     return false;
 
+  // The ABI alignment of a vector of i1 counts a byte per element; a Parabix
+  // stream only needs the alignment of its register.
+  if (isParabixVT(VT))
+    Aligned = S->getAlignment() == 0 ||
+              S->getAlignment() >= VT.getStoreSize();
+
   X86AddressMode AM;
   if (!X86SelectAddress(I->getOperand(1), AM))
     return false;
@@ -889,19 +959,28 @@ bool X86FastISel::X86SelectRet(const Instruction *I) {
 ///
 bool X86FastISel::X86SelectLoad(const Instruction *I)  {
   // Atomic loads need special handling.
-  if (cast<LoadInst>(I)->isAtomic())
+  const LoadInst *LI = cast<LoadInst>(I);
+  if (LI->isAtomic())
     return false;
 
+  unsigned LABIAlignment = DL.getABITypeAlignment(LI->getType());
+  bool Aligned = LI->getAlignment() == 0 || LI->getAlignment() >= LABIAlignment;
+
   MVT VT;
   if (!isTypeLegal(I->getType(), VT, /*AllowI1=*/true))
     return false;
 
+  // See X86SelectStore.
+  if (isParabixVT(VT))
+    Aligned = LI->getAlignment() == 0 ||
+              LI->getAlignment() >= VT.getStoreSize();
+
   X86AddressMode AM;
   if (!X86SelectAddress(I->getOperand(0), AM))
     return false;
 
   unsigned ResultReg = 0;
-  if (X86FastEmitLoad(VT, AM, ResultReg)) {
+  if (X86FastEmitLoad(VT, AM, ResultReg, Aligned)) {
     UpdateValueMap(I, ResultReg);
     return true;
   }
@@ -1597,6 +1676,89 @@ bool X86FastISel::X86SelectTrunc(const Instruction *I) {
   return true;
 }
 
+/// X86SelectParabixBinaryOp - Select a logic operation on a Parabix stream
+/// type, or an add/sub of i1 streams (which is XOR), as the plain GPR or SSE
+/// instruction on the register holding it. Wider fields carry between bits
+/// and are left to SelectionDAG.
+bool X86FastISel::X86SelectParabixBinaryOp(const Instruction *I) {
+  MVT VT;
+  if (!isTypeLegal(I->getType(), VT) || !isParabixVT(VT))
+    return false;
+
+  unsigned OpIdx;
+  switch (I->getOpcode()) {
+  default: return false;
+  case Instruction::And: OpIdx = 0; break;
+  case Instruction::Or:  OpIdx = 1; break;
+  case Instruction::Xor: OpIdx = 2; break;
+  case Instruction::Add:
+  case Instruction::Sub:
+    if (VT.getScalarSizeInBits() != 1)
+      return false;
+    OpIdx = 2;
+    break;
+  }
+
+  static const unsigned OpTable[5][3] = {
+    { X86::AND32rr,  X86::OR32rr,  X86::XOR32rr  }, // GR32X
+    { X86::AND64rr,  X86::OR64rr,  X86::XOR64rr  }, // GR64X
+    { X86::PANDrr,   X86::PORrr,   X86::PXORrr   }, // VR128PX
+    { X86::VPANDrr,  X86::VPORrr,  X86::VPXORrr  }, // VR128PX, AVX
+    { X86::VPANDYrr, X86::VPORYrr, X86::VPXORYrr }  // VR256PX
+  };
+
+  unsigned TableIdx;
+  switch (VT.getSizeInBits()) {
+  default: return false;
+  case 32:  TableIdx = 0; break;
+  case 64:  TableIdx = 1; break;
+  case 128: TableIdx = Subtarget->hasAVX() ? 3 : 2; break;
+  case 256: TableIdx = 4; break;
+  }
+
+  unsigned Op0Reg = getRegForValue(I->getOperand(0));
+  if (Op0Reg == 0)
+    return false;
+
+  unsigned Op1Reg = getRegForValue(I->getOperand(1));
+  if (Op1Reg == 0)
+    return false;
+
+  unsigned ResultReg = FastEmitInst_rr(OpTable[TableIdx][OpIdx],
+                                       TLI.getRegClassFor(VT),
+                                       Op0Reg, /*TODO: Kill=*/false,
+                                       Op1Reg, /*TODO: Kill=*/false);
+  UpdateValueMap(I, ResultReg);
+  return true;
+}
+
+/// X86SelectParabixBitCast - Select a bitcast to or from a Parabix stream
+/// type. The Parabix register classes share their registers with GR32, GR64,
+/// VR128 and VR256, so a bitcast within a register bank is a plain COPY.
+bool X86FastISel::X86SelectParabixBitCast(const Instruction *I) {
+  MVT SrcVT, DstVT;
+  if (!isTypeLegal(I->getOperand(0)->getType(), SrcVT) ||
+      !isTypeLegal(I->getType(), DstVT))
+    return false;
+  if (!isParabixVT(SrcVT) && !isParabixVT(DstVT))
+    return false;
+
+  const TargetRegisterClass *SrcRC = TLI.getRegClassFor(SrcVT);
+  const TargetRegisterClass *DstRC = TLI.getRegClassFor(DstVT);
+  if (!TRI.getCommonSubClass(SrcRC, DstRC))
+    return false;
+
+  unsigned Reg = getRegForValue(I->getOperand(0));
+  if (Reg == 0)
+    return false;
+
+  unsigned ResultReg = createResultReg(DstRC);
+  BuildMI(*FuncInfo.MBB, FuncInfo.InsertPt, DbgLoc,
+          TII.get(TargetOpcode::COPY), ResultReg).addReg(Reg);
+  UpdateValueMap(I, ResultReg);
+  return true;
+}
+
 bool X86FastISel::IsMemcpySmall(uint64_t Len) {
   return Len <= (Subtarget->is64Bit() ? 32 : 16);
 }
@@ -2349,6 +2511,14 @@ X86FastISel::TargetSelectInstruction(const Instruction *I)  {
     return X86SelectFPExt(I);
   case Instruction::FPTrunc:
     return X86SelectFPTrunc(I);
+  case Instruction::And:
+  case Instruction::Or:
+  case Instruction::Xor:
+  case Instruction::Add:
+  case Instruction::Sub:
+    return X86SelectParabixBinaryOp(I);
+  case Instruction::BitCast:
+    return X86SelectParabixBitCast(I);
   case Instruction::IntToPtr: // Deliberate fall-through.
   case Instruction::PtrToInt: {
     EVT SrcVT = TLI.getValueType(I->getOperand(0)->getType());
@@ -2372,6 +2542,9 @@ unsigned X86FastISel::TargetMaterializeConstant(const Constant *C) {
   if (!isTypeLegal(C->getType(), VT))
     return 0;
 
+  if (isParabixVT(VT))
+    return X86MaterializeParabixConstant(C, VT);
+
   // Can't handle alternate code models yet.
   if (TM.getCodeModel() != CodeModel::Small)
     return 0;
@@ -2471,6 +2644,37 @@ unsigned X86FastISel::TargetMaterializeConstant(const Constant *C) {
   return ResultReg;
 }
 
+/// X86MaterializeParabixConstant - Materialize the all-zeros or all-ones
+/// Parabix stream. Other stream constants are left to SelectionDAG.
+unsigned X86FastISel::X86MaterializeParabixConstant(const Constant *C,
+                                                    MVT VT) {
+  bool AllOnes = C->isAllOnesValue();
+  if (!AllOnes && !C->isNullValue())
+    return 0;
+
+  unsigned ResultReg = createResultReg(TLI.getRegClassFor(VT));
+  switch (VT.getSizeInBits()) {
+  default: llvm_unreachable("Unexpected Parabix type");
+  case 32:
+    BuildMI(*FuncInfo.MBB, FuncInfo.InsertPt, DbgLoc, TII.get(X86::MOV32ri),
+            ResultReg).addImm(AllOnes ? -1 : 0);
+    break;
+  case 64:
+    BuildMI(*FuncInfo.MBB, FuncInfo.InsertPt, DbgLoc, TII.get(X86::MOV64ri32),
+            ResultReg).addImm(AllOnes ? -1 : 0);
+    break;
+  case 128:
+    BuildMI(*FuncInfo.MBB, FuncInfo.InsertPt, DbgLoc,
+            TII.get(AllOnes ? X86::V_SETALLONES : X86::V_SET0), ResultReg);
+    break;
+  case 256:
+    BuildMI(*FuncInfo.MBB, FuncInfo.InsertPt, DbgLoc,
+            TII.get(AllOnes ? X86::AVX2_SETALLONES : X86::AVX_SET0), ResultReg);
+    break;
+  }
+  return ResultReg;
+}
+
 unsigned X86FastISel::TargetMaterializeAlloca(const AllocaInst *C) {
   // Fail on dynamic allocas. At this point, getRegForValue has already
   // checked its CSE maps, so if we're here trying to handle a dynamic
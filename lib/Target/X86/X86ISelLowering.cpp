@@ -208,10 +208,9 @@ X86TargetLowering::X86TargetLowering(X86TargetMachine &TM)
   TD = getDataLayout();
 
   resetOperationActions();
+  resetParabixOperations();
 }
 
-extern MVT getFullRegisterType(MVT VT);
-
 void X86TargetLowering::resetOperationActions() {
   const TargetMachine &TM = getTargetMachine();
   static bool FirstTimeThrough = true;
@@ -301,7 +300,8 @@ void X86TargetLowering::resetOperationActions() {
 
   // Parabix register class
   static const MVT ParabixVTs[] = { MVT::v32i1, MVT::v64i1, MVT::v64i2, MVT::v32i4,
-                                    MVT::v128i1 };
+                                    MVT::v128i1, MVT::v256i1, MVT::v128i2,
+                                    MVT::v64i4 };
   for (unsigned i = 0; i != array_lengthof(ParabixVTs); ++i) {
     if (ParabixVTs[i].is32BitVector()) {
       addRegisterClass(ParabixVTs[i], &X86::GR32XRegClass);
@@ -312,6 +312,9 @@ void X86TargetLowering::resetOperationActions() {
     else if (ParabixVTs[i].is128BitVector() && Subtarget->hasSSE2()) {
       addRegisterClass(ParabixVTs[i], &X86::VR128PXRegClass);
     }
+    else if (ParabixVTs[i].is256BitVector() && Subtarget->hasAVX2()) {
+      addRegisterClass(ParabixVTs[i], &X86::VR256PXRegClass);
+    }
   }
 
   setLoadExtAction(ISD::SEXTLOAD, MVT::i1, Promote);
@@ -1300,8 +1303,9 @@ void X86TargetLowering::resetOperationActions() {
       if (VT.is128BitVector())
         setOperationAction(ISD::EXTRACT_SUBVECTOR, VT, Custom);
 
-      // Do not attempt to custom lower other non-256-bit vectors
-      if (!VT.is256BitVector())
+      // Do not attempt to custom lower other non-256-bit vectors. Parabix
+      // vectors are set up separately below.
+      if (!VT.is256BitVector() || VT.isParabixVector())
         continue;
 
       setOperationAction(ISD::BUILD_VECTOR,       VT, Custom);
@@ -1569,11 +1573,18 @@ void X86TargetLowering::resetOperationActions() {
     setOperationAction(ISD::MUL, MVT::v16i8, Custom);
     setOperationAction(ISD::MULHU, MVT::v128i1, Custom);
   }
+  if (Subtarget->hasAVX2()) {
+    setOperationAction(ISD::MUL, MVT::v32i8, Custom);
+    setOperationAction(ISD::MULHU, MVT::v256i1, Custom);
+  }
 
   for (unsigned i = 0; i != array_lengthof(ParabixVTs); ++i) {
     // v64i1 is only added and lowered for 64bit subtarget
     if (ParabixVTs[i].is64BitVector() && !Subtarget->is64Bit())
       continue;
+    // 256-bit parabix vectors live in YMM registers and need AVX2 integer ops
+    if (ParabixVTs[i].is256BitVector() && !Subtarget->hasAVX2())
+      continue;
 
     setOperationAction(ISD::ADD, ParabixVTs[i], Custom);
     setOperationAction(ISD::SUB, ParabixVTs[i], Custom);
@@ -1590,17 +1601,22 @@ void X86TargetLowering::resetOperationActions() {
     setOperationAction(ISD::EXTRACT_VECTOR_ELT, ParabixVTs[i], Custom);
     setOperationAction(ISD::INSERT_VECTOR_ELT,  ParabixVTs[i], Custom);
 
-    //Better way to lower LOAD/STORE
-    setOperationAction(ISD::STORE, ParabixVTs[i], Promote);
-    AddPromotedToType (ISD::STORE, ParabixVTs[i], getFullRegisterType(ParabixVTs[i]));
-    setOperationAction(ISD::LOAD,  ParabixVTs[i], Promote);
-    AddPromotedToType (ISD::LOAD,  ParabixVTs[i], getFullRegisterType(ParabixVTs[i]));
+    // Loads and stores select to mov / movdqa / movdqu directly (PXLoadStore
+    // patterns), so they fold into the users like any other vector memop.
+    setOperationAction(ISD::STORE, ParabixVTs[i], Legal);
+    setOperationAction(ISD::LOAD,  ParabixVTs[i], Legal);
   }
   // Parabix: custom lowering ISD::UADDO for long stream addition.
   // ref: LegalizeDAG.cpp 3693. UADDO is expanded to ADD and SetCC
   // ref: this file, lowerXALUO, UADDO to X86ISD::ADD and SetCC X86::Cond_B
   setTargetDAGCombine(ISD::UADDO);
   setTargetDAGCombine(ISD::UADDE);
+  // Parabix: bit counts of i128 / i256 streams on 64-bit words.
+  setTargetDAGCombine(ISD::CTPOP);
+  setTargetDAGCombine(ISD::CTTZ);
+  setTargetDAGCombine(ISD::CTTZ_ZERO_UNDEF);
+  setTargetDAGCombine(ISD::CTLZ);
+  setTargetDAGCombine(ISD::CTLZ_ZERO_UNDEF);
 
   // We have target-specific dag combine patterns for the following nodes:
   setTargetDAGCombine(ISD::VECTOR_SHUFFLE);
@@ -2321,6 +2337,8 @@ X86TargetLowering::LowerFormalArguments(SDValue Chain,
         RC = &X86::FR64RegClass;
       else if (RegVT.is512BitVector())
         RC = &X86::VR512RegClass;
+      else if (RegVT.isParabixVector() && RegVT.is256BitVector())
+        RC = &X86::VR256PXRegClass;
       else if (RegVT.is256BitVector())
         RC = &X86::VR256RegClass;
       else if (RegVT.isParabixVector() && RegVT.is128BitVector())
@@ -14532,7 +14550,8 @@ SDValue X86TargetLowering::LowerOperation(SDValue Op, SelectionDAG &DAG) const {
   // SETCC would always return i1 vector, but it may not be parabix op
   if (Op.getOpcode() != ISD::SETCC && Op.getValueType().isParabixVector())
     return LowerParabixOperation(Op, DAG);
-  if (Op.getOpcode() == ISD::MUL && Op.getSimpleValueType() == MVT::v16i8)
+  if (Op.getOpcode() == ISD::MUL && (Op.getSimpleValueType() == MVT::v16i8 ||
+                                     Op.getSimpleValueType() == MVT::v32i8))
     return LowerParabixOperation(Op, DAG);
   if (Op.getOpcode() == ISD::EXTRACT_VECTOR_ELT &&
       Op.getOperand(0).getValueType().isParabixVector())
@@ -14540,6 +14559,10 @@ SDValue X86TargetLowering::LowerOperation(SDValue Op, SelectionDAG &DAG) const {
   if (Op.getOpcode() == ISD::SETCC &&
       Op.getOperand(0).getValueType().isParabixVector())
     return LowerParabixOperation(Op, DAG);
+  if (Op.getOpcode() == ISD::INTRINSIC_WO_CHAIN &&
+      Op.getNumOperands() > 1 &&
+      Op.getOperand(1).getValueType().isParabixVector())
+    return LowerParabixOperation(Op, DAG);
   if (Op.getOpcode() == ISD::VSELECT &&
       Op.getOperand(0).getSimpleValueType() == MVT::v32i1 &&
       Op.getOperand(1).getSimpleValueType() == MVT::v32i8 &&
@@ -845,6 +845,60 @@ namespace llvm {
       LegalFPImmediates.push_back(Imm);
     }
 
+    /// PXLegalizeAction - How LowerParabixOperation lowers an (opcode, type)
+    /// pair of a Parabix vector. PXCustom falls through to the PXLower*
+    /// functions.
+    enum PXLegalizeAction {
+      PXCustom,         // Hand written PXLower* function.
+      PXCastAndOp,      // Bitcast to the full register type, do one op.
+      PXInPlacePromote, // Double the field width within the same register.
+      PXGenerated       // Function from ParabixGeneratedFuncs.h.
+    };
+
+    typedef SDValue (*PXLowerFn)(SDValue Op, SelectionDAG &DAG);
+
+    /// PXOpAction - One entry of the Parabix lowering table. Data is the
+    /// replacement opcode for PXCastAndOp and an index into PXGenLowerFns
+    /// for PXGenerated.
+    struct PXOpAction {
+      uint8_t Action;
+      uint16_t Data;
+    };
+
+    /// PXOpActions - Parabix lowering policy for each (type, opcode) pair,
+    /// laid out like OpActions. Zero-initialized entries are PXCustom.
+    PXOpAction PXOpActions[MVT::LAST_VALUETYPE][ISD::BUILTIN_OP_END];
+
+    /// PXGenLowerFns - Generated lowering functions referenced by PXGenerated
+    /// entries of PXOpActions.
+    SmallVector<PXLowerFn, 16> PXGenLowerFns;
+
+    void setPXOperationAction(unsigned Op, MVT VT, PXLegalizeAction Action,
+                              unsigned Data = 0) {
+      assert(Op < array_lengthof(PXOpActions[0]) && "Table isn't big enough!");
+      PXOpActions[VT.SimpleTy][Op].Action = (uint8_t)Action;
+      PXOpActions[VT.SimpleTy][Op].Data = (uint16_t)Data;
+    }
+
+    /// addCastAndOpKind - Lower Op on VT by bitcasting the operands to the
+    /// full register type and doing ReplaceOp there.
+    void addCastAndOpKind(unsigned Op, MVT VT, unsigned ReplaceOp) {
+      setPXOperationAction(Op, VT, PXCastAndOp, ReplaceOp);
+    }
+
+    /// addGeneratedOpKind - Lower Op on VT with the generated function Fn.
+    void addGeneratedOpKind(unsigned Op, MVT VT, PXLowerFn Fn) {
+      unsigned Idx = std::find(PXGenLowerFns.begin(), PXGenLowerFns.end(), Fn) -
+                     PXGenLowerFns.begin();
+      if (Idx == PXGenLowerFns.size())
+        PXGenLowerFns.push_back(Fn);
+      setPXOperationAction(Op, VT, PXGenerated, Idx);
+    }
+
+    /// resetParabixOperations - Fill PXOpActions. Defined in
+    /// X86ParabixISelLowering.cpp next to the generated functions.
+    void resetParabixOperations();
+
     SDValue LowerCallResult(SDValue Chain, SDValue InFlag,
                             CallingConv::ID CallConv, bool isVarArg,
                             const SmallVectorImpl<ISD::InputArg> &Ins,
@@ -4393,6 +4393,26 @@ MachineInstr* X86InstrInfo::foldMemoryOperandImpl(MachineFunction &MF,
   // Check switch flag
   if (NoFusing) return nullptr;
 
+  // A copy of a loaded value into a register class holding the same
+  // registers, like the COPY_TO_REGCLASS of a Parabix load, is just the load
+  // defining the copy's destination.
+  if (MI->isCopy() && Ops.size() == 1 && Ops[0] == 1 &&
+      LoadMI->hasOneMemOperand()) {
+    const MachineRegisterInfo &MRI = MF.getRegInfo();
+    unsigned DstReg = MI->getOperand(0).getReg();
+    unsigned SrcReg = LoadMI->getOperand(0).getReg();
+    if (!TargetRegisterInfo::isVirtualRegister(DstReg) ||
+        MI->getOperand(0).getSubReg() || MI->getOperand(1).getSubReg())
+      return nullptr;
+    const TargetRegisterClass *DstRC = MRI.getRegClass(DstReg);
+    const TargetRegisterClass *SrcRC = MRI.getRegClass(SrcReg);
+    if (!DstRC->hasSubClassEq(SrcRC) || !SrcRC->hasSubClassEq(DstRC))
+      return nullptr;
+    MachineInstr *NewMI = MF.CloneMachineInstr(LoadMI);
+    NewMI->getOperand(0).setReg(DstReg);
+    return NewMI;
+  }
+
   // Unless optimizing for size, don't fold to avoid partial
   // register update stalls
   if (!MF.getFunction()->getAttributes().
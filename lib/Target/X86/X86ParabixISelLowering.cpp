@@ -11,10 +11,11 @@
 // selection DAG on X86.
 //
 // Lowering Strategy Sequence:
-// For LowerParabixOperation, we check if the op fits in CastAndOpKind first. If fits,
-// lowering process is done and terminated. Otherwise, we would check those general
-// policies (like in-place vector promotion). If fail again, custom lowering code will
-// be executed (like PXLowerADD).
+// For LowerParabixOperation, we look up the (type, opcode) pair in the per
+// X86TargetLowering PXOpActions table, filled by resetParabixOperations. The
+// entry picks a policy: cast and op, general policies (like in-place vector
+// promotion) or a generated function. Pairs without an entry fall through to
+// the custom lowering code (like PXLowerADD).
 //
 //===----------------------------------------------------------------------------===//
 
@@ -58,13 +59,12 @@
 #include "ParabixGeneratedFuncs.h"
 #include <bitset>
 #include <cctype>
-#include <map>
 #include <string>
 using namespace llvm;
 
 #define DEBUG_TYPE "parabix"
 
-//v32i1 => i32, v32i2 => i64, etc
+//v32i1 => i32, v32i2 => i64, v256i1 => v4i64, etc
 MVT getFullRegisterType(MVT VT) {
   MVT castType;
   if (VT.is32BitVector())
@@ -73,36 +73,21 @@ MVT getFullRegisterType(MVT VT) {
     castType = MVT::i64;
   else if (VT.is128BitVector())
     castType = MVT::v2i64;
+  else if (VT.is256BitVector())
+    castType = MVT::v4i64;
   else
     llvm_unreachable("unsupported parabix vector width");
 
   return castType;
 }
 
-typedef std::pair<ISD::NodeType, MVT> CastAndOpKind;
-static std::map<CastAndOpKind, ISD::NodeType> CAOops;
-
-enum PXLegalizeAction {
-  InPlacePromote
-};
-
-typedef CastAndOpKind OpKind;
-static std::map<OpKind, PXLegalizeAction> OpKindActions;
-
-static void addCastAndOpKind(ISD::NodeType Op, MVT VT, ISD::NodeType ReplaceOp)
-{
-  CAOops[std::make_pair(Op, VT)] = ReplaceOp;
-}
-
-static void addOpKindAction(ISD::NodeType Op, MVT VT, PXLegalizeAction action)
-{
-  OpKindActions[std::make_pair(Op, VT)] = action;
-}
-
-static void resetOperations()
+//Fill the Parabix lowering table. An (opcode, type) pair without an entry is
+//lowered by the PXLower* functions in LowerParabixOperation.
+void X86TargetLowering::resetParabixOperations()
 {
   //NEED: setOperationAction in X86ISelLowering with Custom
-  CAOops.clear();
+  memset(PXOpActions, 0, sizeof(PXOpActions));
+  PXGenLowerFns.clear();
 
   //use XOR to simulate ADD on v32i1
   addCastAndOpKind(ISD::ADD, MVT::v32i1, ISD::XOR);
@@ -129,6 +114,14 @@ static void resetOperations()
   addCastAndOpKind(ISD::OR,  MVT::v128i1, ISD::OR);
   addCastAndOpKind(ISD::MULHU,  MVT::v128i1, ISD::AND);
 
+  addCastAndOpKind(ISD::ADD, MVT::v256i1, ISD::XOR);
+  addCastAndOpKind(ISD::SUB, MVT::v256i1, ISD::XOR);
+  addCastAndOpKind(ISD::MUL, MVT::v256i1, ISD::AND);
+  addCastAndOpKind(ISD::AND, MVT::v256i1, ISD::AND);
+  addCastAndOpKind(ISD::XOR, MVT::v256i1, ISD::XOR);
+  addCastAndOpKind(ISD::OR,  MVT::v256i1, ISD::OR);
+  addCastAndOpKind(ISD::MULHU,  MVT::v256i1, ISD::AND);
+
   //cast v64i2 to v2i64 to lower logic ops.
   addCastAndOpKind(ISD::AND, MVT::v64i2, ISD::AND);
   addCastAndOpKind(ISD::XOR, MVT::v64i2, ISD::XOR);
@@ -138,15 +131,36 @@ static void resetOperations()
   addCastAndOpKind(ISD::XOR, MVT::v32i4, ISD::XOR);
   addCastAndOpKind(ISD::OR,  MVT::v32i4, ISD::OR);
 
-  //A custom lowering for v32i4 add is implmented. So ADD is not here.
-  addOpKindAction(ISD::SUB, MVT::v32i4, InPlacePromote);
-  addOpKindAction(ISD::MUL, MVT::v32i4, InPlacePromote);
-  addOpKindAction(ISD::SHL, MVT::v32i4, InPlacePromote);
-  addOpKindAction(ISD::SRL, MVT::v32i4, InPlacePromote);
-  addOpKindAction(ISD::SRA, MVT::v32i4, InPlacePromote);
-  addOpKindAction(ISD::SETCC, MVT::v32i4, InPlacePromote);
+  //cast v128i2 and v64i4 to v4i64 to lower logic ops.
+  addCastAndOpKind(ISD::AND, MVT::v128i2, ISD::AND);
+  addCastAndOpKind(ISD::XOR, MVT::v128i2, ISD::XOR);
+  addCastAndOpKind(ISD::OR,  MVT::v128i2, ISD::OR);
+
+  addCastAndOpKind(ISD::AND, MVT::v64i4, ISD::AND);
+  addCastAndOpKind(ISD::XOR, MVT::v64i4, ISD::XOR);
+  addCastAndOpKind(ISD::OR,  MVT::v64i4, ISD::OR);
+
+  //i4 multiply works on i8 fields in place; SETCC is dispatched on the
+  //condition code in PXLowerSETCC.
+  setPXOperationAction(ISD::MUL, MVT::v32i4, PXInPlacePromote);
+  setPXOperationAction(ISD::MUL, MVT::v64i4, PXInPlacePromote);
+
+  //i2, i4 and i8 arithmetic comes from ParabixGeneratedFuncs.h, which is
+  //generated by utils/parabix-gen-funcs.py at build time.
+  MVT GenVTs[] = { MVT::v64i2, MVT::v128i2, MVT::v32i4, MVT::v64i4 };
+  for (unsigned i = 0; i < array_lengthof(GenVTs); i++) {
+    MVT VT = GenVTs[i];
+    addGeneratedOpKind(ISD::ADD, VT, GENLowerADD);
+    addGeneratedOpKind(ISD::SUB, VT, GENLowerSUB);
+    addGeneratedOpKind(ISD::SHL, VT, GENLowerSHL);
+    addGeneratedOpKind(ISD::SRL, VT, GENLowerLSHR);
+    addGeneratedOpKind(ISD::SRA, VT, GENLowerASHR);
+  }
 
-  addOpKindAction(ISD::MUL, MVT::v16i8, InPlacePromote);
+  addGeneratedOpKind(ISD::MUL, MVT::v64i2, GENLowerMUL);
+  addGeneratedOpKind(ISD::MUL, MVT::v128i2, GENLowerMUL);
+  addGeneratedOpKind(ISD::MUL, MVT::v16i8, GENLowerMUL);
+  addGeneratedOpKind(ISD::MUL, MVT::v32i8, GENLowerMUL);
 }
 
 static SDValue getFullRegister(SDValue Op, SelectionDAG &DAG) {
@@ -167,95 +181,68 @@ static MVT PromoteTypeDouble(MVT VT) {
   return ToVT;
 }
 
-//Root function for general policy lowering. Register the OpKind in resetOperations,
-//then the policy will be executed here.
-static SDValue lowerWithOpAction(SDValue Op, SelectionDAG &DAG) {
+//Promote the op in place: compute the high and low fields of each double
+//width field separately and merge them with IFH1.
+static SDValue lowerWithInPlacePromote(SDValue Op, SelectionDAG &DAG) {
   MVT VT = Op.getSimpleValueType();
-  OpKind kind = std::make_pair((ISD::NodeType)Op.getOpcode(), VT);
   SDNodeTreeBuilder b(Op, &DAG);
   unsigned RegisterWidth = VT.getSizeInBits();
   unsigned FieldWidth = VT.getScalarSizeInBits();
   SDValue Op0 = Op.getOperand(0);
   SDValue Op1 = Op.getOperand(1);
 
-  switch (OpKindActions[kind]) {
-  default: llvm_unreachable("Unknown OpAction to lower parabix op");
-  case InPlacePromote:
-    MVT DoubleVT = PromoteTypeDouble(VT);
-    SDValue Himask = b.HiMask(RegisterWidth, FieldWidth * 2);
-    SDValue Lowmask = b.NOT(Himask);
-    SDValue HiBits, LowBits;
-
-    Op0 = getFullRegister(Op0, DAG);
-    Op1 = getFullRegister(Op1, DAG);
-
-    if (Op.getOpcode() == ISD::MUL) {
-      //MUL is a little different, needs to shift right high bits before calc
-      HiBits = b.SHL(FieldWidth, b.DoOp(DoubleVT,
-                                        b.SRL(FieldWidth, b.BITCAST(Op0, DoubleVT)),
-                                        b.SRL(FieldWidth, b.BITCAST(Op1, DoubleVT))));
-    } else if (Op.getOpcode() == ISD::SHL) {
-      // shift left
-      HiBits = b.DoOp(DoubleVT, b.AND(Op0, Himask),
-                      b.SRL(FieldWidth, b.BITCAST(Op1, DoubleVT)));
-    } else if (Op.getOpcode() == ISD::SRL || Op.getOpcode() == ISD::SRA) {
-      // shift right, logic or arithmetic are the same
-      HiBits = b.DoOp(DoubleVT,
-                      Op0, b.SRL(FieldWidth, b.BITCAST(Op1, DoubleVT)));
-    } else {
-      HiBits = b.DoOp(DoubleVT, b.AND(Op0, Himask), b.AND(Op1, Himask));
-    }
-
-    if (Op.getOpcode() == ISD::SETCC) {
-      //SETCC needs to shift the lowbits left, to properly set the sign bit.
-      LowBits = b.DoOp(DoubleVT,
-                       b.SHL(FieldWidth, b.BITCAST(Op0, DoubleVT)),
-                       b.SHL(FieldWidth, b.BITCAST(Op1, DoubleVT)));
-    } else if (Op.getOpcode() == ISD::SHL) {
-      //shift left
-      LowBits = b.DoOp(DoubleVT, Op0, b.AND(Op1, Lowmask));
-    } else if (Op.getOpcode() == ISD::SRL) {
-      //shift right logic
-      LowBits = b.DoOp(DoubleVT, b.AND(Op0, Lowmask), b.AND(Op1, Lowmask));
-    } else if (Op.getOpcode() == ISD::SRA) {
-      //shift right arithmetic. Need to shift left low half to high half to set sign bit
-      LowBits = b.SRL(FieldWidth,
-                      b.DoOp(DoubleVT, b.SHL(FieldWidth, b.BITCAST(Op0, DoubleVT)),
-                             b.AND(Op1, Lowmask)));
-
-    } else {
-      LowBits = b.DoOp(DoubleVT, Op0, Op1);
-    }
-
-    SDValue R = b.IFH1(Himask, HiBits, LowBits);
-    return b.BITCAST(R, VT);
+  MVT DoubleVT = PromoteTypeDouble(VT);
+  SDValue Himask = b.HiMask(RegisterWidth, FieldWidth * 2);
+  SDValue Lowmask = b.NOT(Himask);
+  SDValue HiBits, LowBits;
+
+  Op0 = getFullRegister(Op0, DAG);
+  Op1 = getFullRegister(Op1, DAG);
+
+  if (Op.getOpcode() == ISD::MUL) {
+    //MUL is a little different, needs to shift right high bits before calc
+    HiBits = b.SHL(FieldWidth, b.DoOp(DoubleVT,
+                                      b.SRL(FieldWidth, b.BITCAST(Op0, DoubleVT)),
+                                      b.SRL(FieldWidth, b.BITCAST(Op1, DoubleVT))));
+  } else if (Op.getOpcode() == ISD::SHL) {
+    // shift left
+    HiBits = b.DoOp(DoubleVT, b.AND(Op0, Himask),
+                    b.SRL(FieldWidth, b.BITCAST(Op1, DoubleVT)));
+  } else if (Op.getOpcode() == ISD::SRL || Op.getOpcode() == ISD::SRA) {
+    // shift right, logic or arithmetic are the same
+    HiBits = b.DoOp(DoubleVT,
+                    Op0, b.SRL(FieldWidth, b.BITCAST(Op1, DoubleVT)));
+  } else {
+    HiBits = b.DoOp(DoubleVT, b.AND(Op0, Himask), b.AND(Op1, Himask));
   }
 
-  llvm_unreachable("Reach the end of lowerWithOpAction");
-  return SDValue();
-}
+  if (Op.getOpcode() == ISD::SETCC) {
+    //SETCC needs to shift the lowbits left, to properly set the sign bit.
+    LowBits = b.DoOp(DoubleVT,
+                     b.SHL(FieldWidth, b.BITCAST(Op0, DoubleVT)),
+                     b.SHL(FieldWidth, b.BITCAST(Op1, DoubleVT)));
+  } else if (Op.getOpcode() == ISD::SHL) {
+    //shift left
+    LowBits = b.DoOp(DoubleVT, Op0, b.AND(Op1, Lowmask));
+  } else if (Op.getOpcode() == ISD::SRL) {
+    //shift right logic
+    LowBits = b.DoOp(DoubleVT, b.AND(Op0, Lowmask), b.AND(Op1, Lowmask));
+  } else if (Op.getOpcode() == ISD::SRA) {
+    //shift right arithmetic. Need to shift left low half to high half to set sign bit
+    LowBits = b.SRL(FieldWidth,
+                    b.DoOp(DoubleVT, b.SHL(FieldWidth, b.BITCAST(Op0, DoubleVT)),
+                           b.AND(Op1, Lowmask)));
 
-//Bitcast this vector to a full length integer and then do one op
-//Lookup op in CAOops map
-static SDValue lowerWithCastAndOp(SDValue Op, SelectionDAG &DAG) {
-  SDLoc dl(Op);
-  MVT VT = Op.getSimpleValueType();
-  SDValue A = Op.getOperand(0);
-  SDValue B = Op.getOperand(1);
-  CastAndOpKind kind = std::make_pair((ISD::NodeType)Op.getOpcode(), VT);
-
-  assert(CAOops.find(kind) != CAOops.end() && "Undefined cast and op kind");
-
-  MVT castType = getFullRegisterType(VT);
-  SDValue transA = DAG.getNode(ISD::BITCAST, dl, castType, A);
-  SDValue transB = DAG.getNode(ISD::BITCAST, dl, castType, B);
-  SDValue res = DAG.getNode(CAOops[kind], dl, castType, transA, transB);
+  } else {
+    LowBits = b.DoOp(DoubleVT, Op0, Op1);
+  }
 
-  return DAG.getNode(ISD::BITCAST, dl, VT, res);
+  SDValue R = b.IFH1(Himask, HiBits, LowBits);
+  return b.BITCAST(R, VT);
 }
 
-//Don't do the lookup, use NewOp on casted operands.
-//If swap is set true, will swap operands
+//Bitcast this vector to a full length integer and then use NewOp on the
+//casted operands. If swap is set true, will swap operands
 static SDValue lowerWithCastAndOp(SDValue Op, SelectionDAG &DAG,
                                   ISD::NodeType NewOp, bool Swap=false) {
   SDLoc dl(Op);
@@ -295,69 +282,12 @@ static SDValue PXLowerShift(SDValue Op, SelectionDAG &DAG) {
   else if (VectorEleType == MVT::i1 && Op.getOpcode() == ISD::SRA) {
     return A;
   }
-  else if (VT == MVT::v64i2) {
-    if (Op.getOpcode() == ISD::SHL)
-      return GENLowerSHL(Op, DAG);
-    else if (Op.getOpcode() == ISD::SRL)
-      return GENLowerLSHR(Op, DAG);
-    else
-      return GENLowerASHR(Op, DAG);
-  } else
+  else
     llvm_unreachable("lowering undefined parabix shift ops");
 
   return DAG.getNode(ISD::BITCAST, dl, VT, res);
 }
 
-static SDValue PXLowerADD(SDValue Op, SelectionDAG &DAG) {
-  MVT VT = Op.getSimpleValueType();
-  SDNodeTreeBuilder b(Op, &DAG);
-  SDValue Op0 = Op.getOperand(0);
-  SDValue Op1 = Op.getOperand(1);
-
-  if (VT == MVT::v64i2) {
-    return GENLowerADD(Op, DAG);
-  }
-  else if (VT == MVT::v32i4) {
-    // Use mask = 0x8888... to mask out high bits and then we can do the i4 add
-    // with only one paddb.
-    std::string mask = "";
-    for (unsigned int i = 0; i < 16; i++) mask += "1000";
-    SDValue Mask = b.Constant(mask, MVT::v2i64);
-
-    MVT DoubleVT = MVT::v16i8;
-
-    SDValue Ah = b.AND(Mask, b.BITCAST(Op0, MVT::v2i64));
-    SDValue Bh = b.AND(Mask, b.BITCAST(Op1, MVT::v2i64));
-    SDValue R = b.DoOp(DoubleVT,
-                       b.AND(b.BITCAST(Op0, MVT::v2i64), b.NOT(Ah)),
-                       b.AND(b.BITCAST(Op1, MVT::v2i64), b.NOT(Bh)));
-    R = b.XOR(R, b.BITCAST(b.XOR(Ah, Bh), DoubleVT));
-
-    return b.BITCAST(R, VT);
-  }
-
-  llvm_unreachable("lowering add for unsupported type");
-  return SDValue();
-}
-
-static SDValue PXLowerSUB(SDValue Op, SelectionDAG &DAG) {
-  if (Op.getSimpleValueType() == MVT::v64i2) {
-    return GENLowerSUB(Op, DAG);
-  }
-
-  llvm_unreachable("lowering sub for unsupported type");
-  return SDValue();
-}
-
-static SDValue PXLowerMUL(SDValue Op, SelectionDAG &DAG) {
-  if (Op.getSimpleValueType() == MVT::v64i2) {
-    return GENLowerMUL(Op, DAG);
-  }
-
-  llvm_unreachable("only lowering parabix MUL");
-  return SDValue();
-}
-
 static SDValue getTruncateOrZeroExtend(SDValue V, SelectionDAG &DAG, MVT ToVT)
 {
   SDNodeTreeBuilder b(V, &DAG);
@@ -571,6 +501,97 @@ static SDValue getPXOnesVector(EVT VT, SDNodeTreeBuilder b) {
   return b.BITCAST(Vec, VT.getSimpleVT());
 }
 
+//Build 16 elements of an i1 BUILD_VECTOR, starting from First, as an i16.
+//Constant bits become an immediate. A few variable bits are shifted into
+//place in a GPR; more are gathered in parallel: each element becomes a byte
+//of a v16i8, bit 0 of every byte is moved to bit 7 and PMOVMSKB collects
+//them.
+static SDValue buildI1Chunk(SDValue Op, unsigned First, SelectionDAG &DAG,
+                            const X86Subtarget *Subtarget) {
+  SDNodeTreeBuilder b(Op, &DAG);
+  SDLoc dl(Op);
+
+  uint64_t ConstBits = 0;
+  SmallVector<unsigned, 16> VarIdx;
+  for (unsigned i = 0; i < 16; ++i) {
+    SDValue Elt = Op.getOperand(First + i);
+    if (Elt.getOpcode() == ISD::UNDEF)
+      continue;
+    if (ConstantSDNode *C = dyn_cast<ConstantSDNode>(Elt)) {
+      if (C->getZExtValue() & 1)
+        ConstBits |= 1ULL << i;
+    } else
+      VarIdx.push_back(i);
+  }
+
+  SDValue Res = b.Constant(ConstBits, MVT::i16);
+  if (VarIdx.empty())
+    return Res;
+
+  if (VarIdx.size() <= 3 || !Subtarget->hasSSE2()) {
+    for (unsigned i = 0; i < VarIdx.size(); ++i) {
+      SDValue Elt = DAG.getAnyExtOrTrunc(Op.getOperand(First + VarIdx[i]), dl,
+                                         MVT::i8);
+      SDValue Bit = b.ZERO_EXTEND(b.AND(Elt, b.Constant(1, MVT::i8)), MVT::i16);
+      Res = b.OR(Res, b.SHL(Bit, b.Constant(VarIdx[i], MVT::i16)));
+    }
+    return Res;
+  }
+
+  //Constant lanes are left undef so the byte vector is cheaper to build;
+  //their bits come from ConstBits.
+  SmallVector<SDValue, 16> Bytes(16, b.Undef(MVT::i8));
+  uint64_t VarBits = 0;
+  for (unsigned i = 0; i < VarIdx.size(); ++i) {
+    Bytes[VarIdx[i]] = DAG.getAnyExtOrTrunc(Op.getOperand(First + VarIdx[i]),
+                                            dl, MVT::i8);
+    VarBits |= 1ULL << VarIdx[i];
+  }
+
+  SDValue V = b.BITCAST(b.BUILD_VECTOR(MVT::v16i8, Bytes), MVT::v8i16);
+  SDValue Gathered = b.TRUNCATE(b.SignMask16x8(b.SHL<7>(V)), MVT::i16);
+  if (VarBits == 0xffff)
+    return Gathered;
+
+  return b.OR(b.AND(Gathered, b.Constant(VarBits, MVT::i16)), Res);
+}
+
+//Lower BUILD_VECTOR of i1 elements 16 elements at a time, then assemble the
+//i16 pieces in a GPR (v32i1, v64i1) or in a v8i16 / v16i16 register.
+static SDValue PXLowerBUILD_VECTORi1(SDValue Op, SelectionDAG &DAG,
+                                     const X86Subtarget *Subtarget) {
+  MVT VT = Op.getSimpleValueType();
+  MVT FullVT = getFullRegisterType(VT);
+  unsigned NumElems = VT.getVectorNumElements();
+  SDNodeTreeBuilder b(Op, &DAG);
+
+  SmallVector<SDValue, 16> Chunks;
+  for (unsigned i = 0; i < NumElems; i += 16)
+    Chunks.push_back(buildI1Chunk(Op, i, DAG, Subtarget));
+
+  if (!FullVT.isVector()) {
+    SDValue Res = b.ZERO_EXTEND(Chunks[0], FullVT);
+    for (unsigned i = 1; i < Chunks.size(); ++i)
+      Res = b.OR(Res, b.SHL(b.ZERO_EXTEND(Chunks[i], FullVT),
+                            b.Constant(i * 16, FullVT)));
+    return b.BITCAST(Res, VT);
+  }
+
+  //Constant pieces are loaded as one vector, variable ones go in with pinsrw.
+  MVT I16VecType = MVT::getVectorVT(MVT::i16, Chunks.size());
+  SmallVector<SDValue, 16> ConstChunks;
+  for (unsigned i = 0; i < Chunks.size(); ++i)
+    ConstChunks.push_back(isa<ConstantSDNode>(Chunks[i]) ?
+                          Chunks[i] : b.Constant(0, MVT::i16));
+
+  SDValue Res = b.BUILD_VECTOR(I16VecType, ConstChunks);
+  for (unsigned i = 0; i < Chunks.size(); ++i)
+    if (!isa<ConstantSDNode>(Chunks[i]))
+      Res = b.INSERT_VECTOR_ELT(Res, Chunks[i], DAG.getIntPtrConstant(i));
+
+  return b.BITCAST(Res, VT);
+}
+
 SDValue
 X86TargetLowering::PXLowerBUILD_VECTOR(SDValue Op, SelectionDAG &DAG) const {
   SDLoc dl(Op);
@@ -593,27 +614,15 @@ X86TargetLowering::PXLowerBUILD_VECTOR(SDValue Op, SelectionDAG &DAG) const {
     return getPXOnesVector(VT, b);
   }
 
-  if (VT == MVT::v32i1 || VT == MVT::v64i1 || VT == MVT::v128i1) {
-    //Brutely insert element
-    //TODO: improve efficiency of v128i1
-    MVT FullVT = getFullRegisterType(VT);
-    SDValue Base = DAG.getNode(ISD::BITCAST, dl, VT,
-                               DAG.getConstant(0, FullVT));
-    for (unsigned i = 0; i < NumElems; ++i) {
-      SDValue Elt = Op.getOperand(i);
-      if (Elt.getOpcode() == ISD::UNDEF)
-        continue;
-      Base = DAG.getNode(ISD::INSERT_VECTOR_ELT, dl, VT, Base, Elt,
-                         DAG.getConstant(i, MVT::i32));
-    }
+  if (VT == MVT::v32i1 || VT == MVT::v64i1 || VT == MVT::v128i1 ||
+      VT == MVT::v256i1)
+    return PXLowerBUILD_VECTORi1(Op, DAG, Subtarget);
 
-    return Base;
-  }
-
-  if (VT == MVT::v64i2) {
+  if (VT == MVT::v64i2 || VT == MVT::v128i2) {
     //Rearrange index and do 4 shifts and or
-    SmallVector<SmallVector<SDValue, 16>, 4> RearrangedVectors;
-    SmallVector<SDValue, 16> RV;
+    MVT ByteVT = MVT::getVectorVT(MVT::i8, NumElems / 4);
+    SmallVector<SmallVector<SDValue, 32>, 4> RearrangedVectors;
+    SmallVector<SDValue, 32> RV;
     for (unsigned vi = 0; vi < 4; vi++) {
       RV.clear();
       for (unsigned i = vi; i < NumElems; i += 4) {
@@ -623,31 +632,33 @@ X86TargetLowering::PXLowerBUILD_VECTOR(SDValue Op, SelectionDAG &DAG) const {
       RearrangedVectors.push_back(RV);
     }
 
-    //i2 is not legal on X86, so the 64 operands are all i8
-    SDValue V0 = b.BUILD_VECTOR(MVT::v16i8, RearrangedVectors[0]);
-    SDValue V1 = b.BUILD_VECTOR(MVT::v16i8, RearrangedVectors[1]);
-    SDValue V2 = b.BUILD_VECTOR(MVT::v16i8, RearrangedVectors[2]);
-    SDValue V3 = b.BUILD_VECTOR(MVT::v16i8, RearrangedVectors[3]);
+    //i2 is not legal on X86, so the operands are all i8
+    SDValue V0 = b.BUILD_VECTOR(ByteVT, RearrangedVectors[0]);
+    SDValue V1 = b.BUILD_VECTOR(ByteVT, RearrangedVectors[1]);
+    SDValue V2 = b.BUILD_VECTOR(ByteVT, RearrangedVectors[2]);
+    SDValue V3 = b.BUILD_VECTOR(ByteVT, RearrangedVectors[3]);
 
     return b.BITCAST(b.OR(b.OR(b.OR(V0, b.SHL<2>(V1)), b.SHL<4>(V2)), b.SHL<6>(V3)),
-                     MVT::v64i2);
+                     VT);
   }
 
-  if (VT == MVT::v32i4) {
+  if (VT == MVT::v32i4 || VT == MVT::v64i4) {
     //Rearrange index and do 2 shifts and or
     //We have 32 x i8 as build_vector oprand, we build 2 v16i8, V0 and V1, then
     //we can return the result as V0 | (V1 << 4), where
     //V0 = build_vector(Op0, Op2, Op4, ... , Op30)
     //V1 = build_vector(Op1, Op3, Op5, ... , Op31)
+    //v64i4 is handled the same way with two v32i8.
+    MVT ByteVT = MVT::getVectorVT(MVT::i8, NumElems / 2);
     SmallVector<SDValue, 2> V;
-    SmallVector<SDValue, 16> RowV;
+    SmallVector<SDValue, 32> RowV;
     for (unsigned vi = 0; vi < 2; vi ++) {
       RowV.clear();
       for (unsigned i = vi; i < NumElems; i += 2) {
         RowV.push_back(Op.getOperand(i));
       }
 
-      V.push_back(b.BUILD_VECTOR(MVT::v16i8, RowV));
+      V.push_back(b.BUILD_VECTOR(ByteVT, RowV));
     }
 
     return b.BITCAST(b.OR(V[0], b.SHL<4>(V[1])), VT);
@@ -667,7 +678,8 @@ static SDValue PXLowerSETCC(SDValue Op, SelectionDAG &DAG) {
   SDValue NEVec, TransA, TransB, Res, NotOp1, NotOp0;
   SDNodeTreeBuilder b(Op, &DAG);
 
-  if (VT == MVT::v32i1 || VT == MVT::v64i1 || VT == MVT::v128i1) {
+  if (VT == MVT::v32i1 || VT == MVT::v64i1 || VT == MVT::v128i1 ||
+      VT == MVT::v256i1) {
     switch (CC) {
     default: llvm_unreachable("Can't lower this parabix SETCC");
     case ISD::SETNE:    return lowerWithCastAndOp(Op, DAG, ISD::XOR);
@@ -697,7 +709,8 @@ static SDValue PXLowerSETCC(SDValue Op, SelectionDAG &DAG) {
       return DAG.getNOT(dl, Res, VT);
     }
   }
-  else if (VT == MVT::v64i2) {
+  else if (VT == MVT::v64i2 || VT == MVT::v128i2 ||
+           VT == MVT::v32i4 || VT == MVT::v64i4) {
     switch (CC) {
     default: llvm_unreachable("Can't lower this parabix SETCC");
     case ISD::SETEQ:  return GENLowerICMP_EQ(Op, DAG);
@@ -727,33 +740,197 @@ static SDValue PXLowerSETCC(SDValue Op, SelectionDAG &DAG) {
   return SDValue();
 }
 
+//hsimd<16>::packh: the high byte of every 16-bit field of A, then of B.
+//Like PACKUS, this works within each 128-bit lane.
+static SDValue PXPackH16(SDValue A, SDValue B, SelectionDAG &DAG, SDLoc dl) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  MVT ByteVT = A.getSimpleValueType();
+  MVT WordVT = MVT::getVectorVT(MVT::i16, ByteVT.getVectorNumElements() / 2);
+
+  return DAG.getNode(X86ISD::PACKUS, dl, ByteVT,
+                     b.SRL<8>(b.BITCAST(A, WordVT)),
+                     b.SRL<8>(b.BITCAST(B, WordVT)));
+}
+
+//hsimd<16>::packl: the low byte of every 16-bit field of A, then of B.
+static SDValue PXPackL16(SDValue A, SDValue B, SelectionDAG &DAG, SDLoc dl) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  MVT ByteVT = A.getSimpleValueType();
+  MVT WordVT = MVT::getVectorVT(MVT::i16, ByteVT.getVectorNumElements() / 2);
+  MVT I64VT = MVT::getVectorVT(MVT::i64, ByteVT.getSizeInBits() / 64);
+  SDValue LowMask = b.BITCAST(b.Splat64(0x00FF00FF00FF00FFULL, I64VT), WordVT);
+
+  return DAG.getNode(X86ISD::PACKUS, dl, ByteVT,
+                     b.AND(LowMask, b.BITCAST(A, WordVT)),
+                     b.AND(LowMask, b.BITCAST(B, WordVT)));
+}
+
+//One step of the ideal s2p transposition. T0 / T1 gather the odd / even
+//bytes of S0:S1, then their bits are merged in fields of 2 * Shift bits:
+//P0 keeps the high half of every field of both, P1 the low half.
+static void PXS2PStep(SDValue S0, SDValue S1, unsigned Shift,
+                      SDValue &P0, SDValue &P1, SelectionDAG &DAG, SDLoc dl) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  MVT ByteVT = S0.getSimpleValueType();
+  MVT WordVT = MVT::getVectorVT(MVT::i16, ByteVT.getVectorNumElements() / 2);
+  SDValue Mask = b.HiMask(ByteVT.getSizeInBits(), 2 * Shift);
+
+  SDValue T0 = PXPackH16(S0, S1, DAG, dl);
+  SDValue T1 = PXPackL16(S0, S1, DAG, dl);
+  P0 = b.IFH1(Mask, T0, b.SRL(Shift, b.BITCAST(T1, WordVT)));
+  P1 = b.IFH1(Mask, b.BITCAST(b.SHL(Shift, b.BITCAST(T0, WordVT)), ByteVT),
+              T1);
+}
+
+//Inverse of PXS2PStep: split the fields of P0 and P1 back into the odd and
+//even bytes and interleave them into S0:S1.
+static void PXP2SStep(SDValue P0, SDValue P1, unsigned Shift,
+                      SDValue &S0, SDValue &S1, SelectionDAG &DAG, SDLoc dl) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  MVT ByteVT = P0.getSimpleValueType();
+  MVT WordVT = MVT::getVectorVT(MVT::i16, ByteVT.getVectorNumElements() / 2);
+  SDValue Mask = b.HiMask(ByteVT.getSizeInBits(), 2 * Shift);
+
+  SDValue T0 = b.IFH1(Mask, P0, b.SRL(Shift, b.BITCAST(P1, WordVT)));
+  SDValue T1 = b.IFH1(Mask, b.BITCAST(b.SHL(Shift, b.BITCAST(P0, WordVT)),
+                                      ByteVT), P1);
+
+  //punpcklbw / punpckhbw T1, T0, within each 128-bit lane
+  unsigned NumElts = ByteVT.getVectorNumElements();
+  SmallVector<int, 32> LoMask, HiMask;
+  for (unsigned Lane = 0; Lane < NumElts; Lane += 16)
+    for (unsigned i = 0; i < 8; ++i) {
+      LoMask.push_back(Lane + i);
+      LoMask.push_back(Lane + i + NumElts);
+      HiMask.push_back(Lane + i + 8);
+      HiMask.push_back(Lane + i + 8 + NumElts);
+    }
+  S0 = DAG.getVectorShuffle(ByteVT, dl, T1, T0, &LoMask[0]);
+  S1 = DAG.getVectorShuffle(ByteVT, dl, T1, T0, &HiMask[0]);
+}
+
+//The pack and unpack steps above never cross a 128-bit lane, so for 256-bit
+//vectors lane 0 of all eight registers has to hold the first 128 bytes of
+//the stream and lane 1 the rest. Moves between that order and the natural
+//one, in either direction: R[2i], R[2i+1] <-> V[i], V[4+i].
+static void PXSwapStreamLanes(SDValue *V, bool ToLaneOrder,
+                              SelectionDAG &DAG, SDLoc dl) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  MVT ByteVT = V[0].getSimpleValueType();
+  static const int LoLanes[] = {0, 1, 4, 5};
+  static const int HiLanes[] = {2, 3, 6, 7};
+
+  SDValue R[8];
+  for (unsigned i = 0; i < 4; ++i) {
+    SDValue A = b.BITCAST(ToLaneOrder ? V[i] : V[2 * i], MVT::v4i64);
+    SDValue B = b.BITCAST(ToLaneOrder ? V[4 + i] : V[2 * i + 1], MVT::v4i64);
+    SDValue Lo = b.BITCAST(DAG.getVectorShuffle(MVT::v4i64, dl, A, B, LoLanes),
+                           ByteVT);
+    SDValue Hi = b.BITCAST(DAG.getVectorShuffle(MVT::v4i64, dl, A, B, HiLanes),
+                           ByteVT);
+    R[ToLaneOrder ? 2 * i : i] = Lo;
+    R[ToLaneOrder ? 2 * i + 1 : 4 + i] = Hi;
+  }
+  std::copy(R, R + 8, V);
+}
+
+//llvm.x86.parabix.s2p: lane i of basis stream k is bit 7 - k of stream byte
+//i, where the stream is the eight operands one after the other. Three rounds
+//of PXS2PStep split the bits 1, 2 and then 4 at a time.
+static SDValue PXLowerS2P(SDValue Op, SelectionDAG &DAG) {
+  SDLoc dl(Op);
+  SDNodeTreeBuilder b(Op, &DAG);
+  MVT VT = Op.getSimpleValueType();
+  MVT ByteVT = Op.getOperand(1).getSimpleValueType();
+
+  SDValue S[8];
+  for (unsigned i = 0; i < 8; ++i)
+    S[i] = Op.getOperand(i + 1);
+  if (ByteVT.is256BitVector())
+    PXSwapStreamLanes(S, true, DAG, dl);
+
+  //bits 7531 and 6420 of each byte, in 2-bit fields
+  SDValue Bit7531[4], Bit6420[4];
+  for (unsigned i = 0; i < 4; ++i)
+    PXS2PStep(S[2 * i], S[2 * i + 1], 1, Bit7531[i], Bit6420[i], DAG, dl);
+
+  //bits 73, 51, 62 and 40 of each byte, in 4-bit fields
+  SDValue Bit73[2], Bit51[2], Bit62[2], Bit40[2];
+  for (unsigned i = 0; i < 2; ++i) {
+    PXS2PStep(Bit7531[2 * i], Bit7531[2 * i + 1], 2, Bit73[i], Bit51[i], DAG, dl);
+    PXS2PStep(Bit6420[2 * i], Bit6420[2 * i + 1], 2, Bit62[i], Bit40[i], DAG, dl);
+  }
+
+  SDValue P[8];
+  PXS2PStep(Bit73[0], Bit73[1], 4, P[0], P[4], DAG, dl);
+  PXS2PStep(Bit62[0], Bit62[1], 4, P[1], P[5], DAG, dl);
+  PXS2PStep(Bit51[0], Bit51[1], 4, P[2], P[6], DAG, dl);
+  PXS2PStep(Bit40[0], Bit40[1], 4, P[3], P[7], DAG, dl);
+
+  for (unsigned i = 0; i < 8; ++i)
+    P[i] = b.BITCAST(P[i], VT);
+  return b.MergeValues(P);
+}
+
+//llvm.x86.parabix.p2s: the inverse of PXLowerS2P.
+static SDValue PXLowerP2S(SDValue Op, SelectionDAG &DAG) {
+  SDLoc dl(Op);
+  SDNodeTreeBuilder b(Op, &DAG);
+  MVT ByteVT = Op.getSimpleValueType();
+
+  SDValue P[8];
+  for (unsigned i = 0; i < 8; ++i)
+    P[i] = b.BITCAST(Op.getOperand(i + 1), ByteVT);
+
+  SDValue Bit73[2], Bit51[2], Bit62[2], Bit40[2];
+  PXP2SStep(P[0], P[4], 4, Bit73[0], Bit73[1], DAG, dl);
+  PXP2SStep(P[1], P[5], 4, Bit62[0], Bit62[1], DAG, dl);
+  PXP2SStep(P[2], P[6], 4, Bit51[0], Bit51[1], DAG, dl);
+  PXP2SStep(P[3], P[7], 4, Bit40[0], Bit40[1], DAG, dl);
+
+  SDValue Bit7531[4], Bit6420[4];
+  for (unsigned i = 0; i < 2; ++i) {
+    PXP2SStep(Bit73[i], Bit51[i], 2, Bit7531[2 * i], Bit7531[2 * i + 1], DAG, dl);
+    PXP2SStep(Bit62[i], Bit40[i], 2, Bit6420[2 * i], Bit6420[2 * i + 1], DAG, dl);
+  }
+
+  SDValue S[8];
+  for (unsigned i = 0; i < 4; ++i)
+    PXP2SStep(Bit7531[i], Bit6420[i], 1, S[2 * i], S[2 * i + 1], DAG, dl);
+
+  if (ByteVT.is256BitVector())
+    PXSwapStreamLanes(S, false, DAG, dl);
+  return b.MergeValues(S);
+}
+
+static SDValue PXLowerINTRINSIC_WO_CHAIN(SDValue Op, SelectionDAG &DAG) {
+  unsigned IntNo = cast<ConstantSDNode>(Op.getOperand(0))->getZExtValue();
+  switch (IntNo) {
+  default: llvm_unreachable("Not a parabix intrinsic");
+  case Intrinsic::x86_parabix_s2p:
+  case Intrinsic::x86_parabix_s2p_256:  return PXLowerS2P(Op, DAG);
+  case Intrinsic::x86_parabix_p2s:
+  case Intrinsic::x86_parabix_p2s_256:  return PXLowerP2S(Op, DAG);
+  }
+}
+
 ///Entrance for parabix lowering.
 SDValue X86TargetLowering::LowerParabixOperation(SDValue Op, SelectionDAG &DAG) const {
   //NEED: setOperationAction in target specific lowering (X86ISelLowering.cpp)
   DEBUG(dbgs() << "Parabix Lowering:" << "\n"; Op.dump());
 
-  //Only resetOperations for the first time.
-  static bool FirstTimeThrough = true;
-  if (FirstTimeThrough) {
-    //dbgs() << "Parabix Lowering:" << "\n"; Op.dump();
-    resetOperations();
-    FirstTimeThrough = false;
-  }
-
   MVT VT = Op.getSimpleValueType();
-  //Check if we have registered CastAndOp action
-  CastAndOpKind kind = std::make_pair((ISD::NodeType)Op.getOpcode(), VT);
-  if (CAOops.find(kind) != CAOops.end())
-    return lowerWithCastAndOp(Op, DAG);
-  //Check general policy
-  if (OpKindActions.find((OpKind) kind) != OpKindActions.end())
-    return lowerWithOpAction(Op, DAG);
+  const PXOpAction &Entry = PXOpActions[VT.SimpleTy][Op.getOpcode()];
+  switch ((PXLegalizeAction)Entry.Action) {
+  case PXCustom:          break;
+  case PXCastAndOp:
+    return lowerWithCastAndOp(Op, DAG, (ISD::NodeType)Entry.Data);
+  case PXInPlacePromote:  return lowerWithInPlacePromote(Op, DAG);
+  case PXGenerated:       return PXGenLowerFns[Entry.Data](Op, DAG);
+  }
 
   switch (Op.getOpcode()) {
   default: llvm_unreachable("[ROOT SWITCH] Should not custom lower this parabix op!");
-  case ISD::ADD:                return PXLowerADD(Op, DAG);
-  case ISD::SUB:                return PXLowerSUB(Op, DAG);
-  case ISD::MUL:                return PXLowerMUL(Op, DAG);
   case ISD::BUILD_VECTOR:       return PXLowerBUILD_VECTOR(Op, DAG);
   case ISD::SHL:
   case ISD::SRA:
@@ -762,6 +939,7 @@ SDValue X86TargetLowering::LowerParabixOperation(SDValue Op, SelectionDAG &DAG)
   case ISD::EXTRACT_VECTOR_ELT: return PXLowerEXTRACT_VECTOR_ELT(Op, DAG);
   case ISD::SCALAR_TO_VECTOR:   return PXLowerSCALAR_TO_VECTOR(Op, DAG);
   case ISD::SETCC:              return PXLowerSETCC(Op, DAG);
+  case ISD::INTRINSIC_WO_CHAIN: return PXLowerINTRINSIC_WO_CHAIN(Op, DAG);
   }
 }
 
@@ -776,10 +954,12 @@ static SDValue PXPerformVSELECTCombine(SDNode *N, SelectionDAG &DAG,
   SDNodeTreeBuilder b(&DAG, dl);
 
   if (DCI.isBeforeLegalize()) {
-    //v128i1 (select v128i1, v128i1, v128i1) can be combined into logical ops
-    if (MaskTy == MVT::v128i1 && VT == MVT::v128i1) {
-      DEBUG(dbgs() << "Combining select v128i1 \n");
-      return b.IFH1(Mask, N->getOperand(0), N->getOperand(1));
+    //v128i1 (select v128i1, v128i1, v128i1) can be combined into logical ops,
+    //so does v256i1.
+    if ((MaskTy == MVT::v128i1 && VT == MVT::v128i1) ||
+        (MaskTy == MVT::v256i1 && VT == MVT::v256i1 && Subtarget->hasAVX2())) {
+      DEBUG(dbgs() << "Combining select " << EVT(VT).getEVTString() << "\n");
+      return b.IFH1(Mask, N->getOperand(1), N->getOperand(2));
    }
   }
 
@@ -832,6 +1012,73 @@ static bool isPackHighMask(ShuffleVectorSDNode *SVOp) {
   return true;
 }
 
+//Check whether the shuffle node is same as IDISA esimd<1>::mergel
+//Interleave the low halves of both vectors, V1 in the even elements
+static bool isMergeLowMask(ShuffleVectorSDNode *SVOp) {
+  EVT VT = SVOp->getValueType(0);
+  unsigned NumElems = VT.getVectorNumElements();
+
+  //v32i1 (shufflevector v32i1, v32i1, <0, 32, 1, 33, ..., 15, 47>)
+  for (unsigned i = 0; i < NumElems; i++) {
+    unsigned Src = (i % 2) * NumElems + i / 2;
+    if (!isUndefOrEqual(SVOp->getMaskElt(i), Src))
+      return false;
+  }
+
+  return true;
+}
+
+//Check whether the shuffle node is same as IDISA esimd<1>::mergeh
+//Interleave the high halves of both vectors, V1 in the even elements
+static bool isMergeHighMask(ShuffleVectorSDNode *SVOp) {
+  EVT VT = SVOp->getValueType(0);
+  unsigned NumElems = VT.getVectorNumElements();
+
+  //v32i1 (shufflevector v32i1, v32i1, <16, 48, 17, 49, ..., 31, 63>)
+  for (unsigned i = 0; i < NumElems; i++) {
+    unsigned Src = (i % 2) * NumElems + NumElems / 2 + i / 2;
+    if (!isUndefOrEqual(SVOp->getMaskElt(i), Src))
+      return false;
+  }
+
+  return true;
+}
+
+//Pack and merge of bit streams in a general purpose register are bit
+//extract and bit deposit with the alternating mask, one per operand.
+static SDValue PXCombineGPRBitShuffle(ShuffleVectorSDNode *SVOp,
+                                      SelectionDAG &DAG) {
+  MVT VT = SVOp->getSimpleValueType(0);
+  MVT FullVT = getFullRegisterType(VT);
+  unsigned Half = VT.getSizeInBits() / 2;
+  SDNodeTreeBuilder b(&DAG, SDLoc(SVOp));
+
+  SDValue V1 = b.BITCAST(SVOp->getOperand(0), FullVT);
+  SDValue V2 = b.BITCAST(SVOp->getOperand(1), FullVT);
+  uint64_t EvenBits = FullVT == MVT::i32 ? 0x55555555ULL : 0x5555555555555555ULL;
+  SDValue Even = b.Constant(EvenBits, FullVT);
+  SDValue Odd = b.Constant(EvenBits << 1, FullVT);
+  SDValue HalfAmt = b.Constant(Half, FullVT);
+
+  SDValue R;
+  if (isPackLowMask(SVOp) || isPackHighMask(SVOp)) {
+    //esimd<1>::packl / packh: even or odd bits of V1 in the low half, of V2
+    //in the high half
+    SDValue Mask = isPackLowMask(SVOp) ? Even : Odd;
+    R = b.OR(b.PEXT(V1, Mask), b.SHL(b.PEXT(V2, Mask), HalfAmt));
+  } else if (isMergeLowMask(SVOp) || isMergeHighMask(SVOp)) {
+    //esimd<1>::mergel / mergeh: PDEP only reads the low Half bits
+    if (isMergeHighMask(SVOp)) {
+      V1 = b.SRL(V1, HalfAmt);
+      V2 = b.SRL(V2, HalfAmt);
+    }
+    R = b.OR(b.PDEP(V1, Even), b.PDEP(V2, Odd));
+  } else
+    return SDValue();
+
+  return b.BITCAST(R, VT);
+}
+
 static SDValue PXPerformVECTOR_SHUFFLECombine(SDNode *N, SelectionDAG &DAG,
                                     TargetLowering::DAGCombinerInfo &DCI,
                                     const X86Subtarget *Subtarget) {
@@ -940,10 +1187,10 @@ static SDValue PXPerformVECTOR_SHUFFLECombine(SDNode *N, SelectionDAG &DAG,
     //There are 2 ways of implementation at this point. OR/SHL is the first one.
     //It will generate 3 more ops for each packh/l, but have better performance
     //for whole transposition.
-    SDValue P0 = b.OR(b.PEXT64(A0, MaskNode),
-                      b.SHL(b.PEXT64(A1, MaskNode), b.Constant(32, MVT::i64)));
-    SDValue P1 = b.OR(b.PEXT64(B0, MaskNode),
-                      b.SHL(b.PEXT64(B1, MaskNode), b.Constant(32, MVT::i64)));
+    SDValue P0 = b.OR(b.PEXT(A0, MaskNode),
+                      b.SHL(b.PEXT(A1, MaskNode), b.Constant(32, MVT::i64)));
+    SDValue P1 = b.OR(b.PEXT(B0, MaskNode),
+                      b.SHL(b.PEXT(B1, MaskNode), b.Constant(32, MVT::i64)));
     SDValue P[] = {P0, P1};
     return b.BITCAST(b.BUILD_VECTOR(MVT::v2i64, P), VT);
 
@@ -951,15 +1198,26 @@ static SDValue PXPerformVECTOR_SHUFFLECombine(SDNode *N, SelectionDAG &DAG,
     //Below is the second implementation. Less instructions will be generated,
     //but hurt the whole performance.
 
-    //SDValue P0 = b.TRUNCATE(b.PEXT64(A0, MaskNode), MVT::i32);
-    //SDValue P1 = b.TRUNCATE(b.PEXT64(A1, MaskNode), MVT::i32);
-    //SDValue P2 = b.TRUNCATE(b.PEXT64(B0, MaskNode), MVT::i32);
-    //SDValue P3 = b.TRUNCATE(b.PEXT64(B1, MaskNode), MVT::i32);
+    //SDValue P0 = b.TRUNCATE(b.PEXT(A0, MaskNode), MVT::i32);
+    //SDValue P1 = b.TRUNCATE(b.PEXT(A1, MaskNode), MVT::i32);
+    //SDValue P2 = b.TRUNCATE(b.PEXT(B0, MaskNode), MVT::i32);
+    //SDValue P3 = b.TRUNCATE(b.PEXT(B1, MaskNode), MVT::i32);
 
     //SDValue P[] = {P0, P1, P2, P3};
     //return b.BITCAST(b.BUILD_VECTOR(MVT::v4i32, P), VT);
   }
 
+  //PEXT and PDEP for esimd<1>::packl, packh, mergel and mergeh on streams
+  //that live in GR32X / GR64X
+  if (Subtarget->hasBMI2() &&
+      (VT == MVT::v32i1 || (VT == MVT::v64i1 && Subtarget->is64Bit()))) {
+    SDValue R = PXCombineGPRBitShuffle(SVOp, DAG);
+    if (R.getNode()) {
+      DEBUG(dbgs() << "Parabix combine: \n"; N->dumpr());
+      return R;
+    }
+  }
+
   return SDValue();
 }
 
@@ -996,6 +1254,57 @@ static bool isImmediateShiftingMask(SDValue Mask, int &imm) {
   return true;
 }
 
+//v64i2, v128i2, v32i4 and v64i4 live in XMM / YMM registers.
+static bool isSubByteFieldVT(MVT VT, const X86Subtarget *Subtarget) {
+  if (VT == MVT::v64i2 || VT == MVT::v32i4)
+    return Subtarget->hasSSE2();
+  if (VT == MVT::v128i2 || VT == MVT::v64i4)
+    return Subtarget->hasAVX2();
+  return false;
+}
+
+//Repeat the FieldWidth-bit pattern Bits across an i64.
+static uint64_t splatFieldBits(uint64_t Bits, unsigned FieldWidth) {
+  uint64_t R = 0;
+  for (unsigned i = 0; i < 64; i += FieldWidth)
+    R |= Bits << i;
+  return R;
+}
+
+//Shift every field of V by Imm. SRA fills the vacated high bits with
+//S - (S >> Imm), shifted up by one, where S holds the sign bit of every
+//field; the subtraction never borrows across fields.
+static SDValue PXLowerImmediateShift(unsigned Opcode, SDValue V, int Imm,
+                                     MVT VT, SDNodeTreeBuilder &b) {
+  unsigned FieldWidth = VT.getScalarSizeInBits();
+  MVT I16VecType = MVT::getVectorVT(MVT::i16, VT.getSizeInBits() / 16);
+  MVT I64VecType = MVT::getVectorVT(MVT::i64, VT.getSizeInBits() / 64);
+  uint64_t FieldMask = (1ULL << FieldWidth) - 1;
+
+  if (Imm == 0)
+    return V;
+  if (Imm >= (int)FieldWidth)
+    return b.BITCAST(b.Splat64(0, I64VecType), VT);
+
+  SDValue A = b.BITCAST(V, I16VecType);
+  SDValue R;
+  if (Opcode == ISD::SHL) {
+    uint64_t Mask = splatFieldBits((FieldMask << Imm) & FieldMask, FieldWidth);
+    R = b.AND(b.SHL(Imm, A), b.BITCAST(b.Splat64(Mask, I64VecType), I16VecType));
+  } else {
+    uint64_t Mask = splatFieldBits(FieldMask >> Imm, FieldWidth);
+    R = b.AND(b.SRL(Imm, A), b.BITCAST(b.Splat64(Mask, I64VecType), I16VecType));
+  }
+
+  if (Opcode == ISD::SRA) {
+    uint64_t SignMask = splatFieldBits(1ULL << (FieldWidth - 1), FieldWidth);
+    SDValue S = b.AND(A, b.BITCAST(b.Splat64(SignMask, I64VecType), I16VecType));
+    R = b.OR(R, b.SHL<1>(b.SUB(S, b.SRL(Imm, S))));
+  }
+
+  return b.BITCAST(R, VT);
+}
+
 static SDValue PXPerformShiftCombine(SDNode *N, SelectionDAG &DAG,
                                      TargetLowering::DAGCombinerInfo &DCI,
                                      const X86Subtarget *Subtarget) {
@@ -1010,25 +1319,11 @@ static SDValue PXPerformShiftCombine(SDNode *N, SelectionDAG &DAG,
 
   int imm;
 
-  //Optimize immediate shiftings.
-  if (Subtarget->hasSSE2() && VT == MVT::v32i4 && isImmediateShiftingMask(V2, imm)) {
-
-    MVT I32VecType = MVT::v4i32;
-
-    if (N->getOpcode() == ISD::SHL) {
-      DEBUG(dbgs() << "Parabix combining: "; N->dump());
-
-      SDValue R = b.AND(b.SHL(imm, b.BITCAST(V1, I32VecType)),
-                        b.BITCAST(b.ConstantVector(MVT::v32i4, (15 << imm) & 15), I32VecType));
-      return b.BITCAST(R, VT);
-    }
-    else if (N->getOpcode() == ISD::SRL) {
-      DEBUG(dbgs() << "Parabix combining: "; N->dump());
-
-      SDValue R = b.AND(b.SRL(imm, b.BITCAST(V1, I32VecType)),
-                        b.BITCAST(b.ConstantVector(MVT::v32i4, 15 >> imm), I32VecType));
-      return b.BITCAST(R, VT);
-    }
+  //Shifts of i2 and i4 fields by an immediate: shift the register as i16
+  //fields and mask off the bits that crossed into a neighbouring field.
+  if (isSubByteFieldVT(VT, Subtarget) && isImmediateShiftingMask(V2, imm)) {
+    DEBUG(dbgs() << "Parabix combining: "; N->dump());
+    return PXLowerImmediateShift(N->getOpcode(), V1, imm, VT, b);
   }
 
   // long integer shift for MVT::i128
@@ -1096,13 +1391,114 @@ static SDValue PXPerformShiftCombine(SDNode *N, SelectionDAG &DAG,
   return SDValue();
 }
 
-static SDValue LongStreamAddition(MVT VT, SDValue V1, SDValue V2, SDValue Vcarryin, SDNodeTreeBuilder &b) {
+//Spread the low Lanes bits of Bits (i32) into a <Lanes x i64> vector of
+//0s and 1s, one bit per 64-bit field. Lanes can be 2 or 4.
+static SDValue SpreadBitsTo64(SDValue Bits, unsigned Lanes, SDNodeTreeBuilder &b) {
+  MVT VXi64Ty = MVT::getVectorVT(MVT::i64, Lanes);
+
+  if (Lanes == 2) {
+    // <2 x i1> increments to <2 x i64>
+    SDValue spreadV2I16 = b.BITCAST(b.AND(b.MUL(Bits, b.Constant(0x8001, MVT::i32)),
+                                          b.Constant(0x10001, MVT::i32)), MVT::v2i16);
+    return b.ZERO_EXTEND(spreadV2I16, VXi64Ty);
+  }
+
+  assert(Lanes == 4 && "Unexpected number of 64-bit fields");
+  SDValue Bits64 = b.ZERO_EXTEND(Bits, MVT::i64);
+  SDValue spreadV4I16 = b.BITCAST(b.AND(b.MUL(Bits64,
+                                              b.Constant(0x0000200040008001ull, MVT::i64)),
+                                        b.Constant(0x0001000100010001ull, MVT::i64)),
+                                  MVT::v4i16);
+  return b.ZERO_EXTEND(spreadV4I16, VXi64Ty);
+}
+
+//uadd.with.overflow for i512, i1024, i2048 and i4096. The operands are split
+//into YMM registers, the per-field carry and bubble masks of all registers
+//are packed into a single i64 and one MatchStar resolves the carries across
+//the whole stream. With only XMM registers this loses to the adc chain, so
+//it is AVX2 only.
+static SDValue MultiRegisterStreamAddition(EVT VT, SDValue V1, SDValue V2,
+                                           SDValue Vcarryin, SelectionDAG &DAG,
+                                           SDLoc dl) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  unsigned f = VT.getSizeInBits() / 64;
+  const unsigned Lanes = 4;
+  unsigned NumRegs = f / Lanes;
+  MVT RegTy = MVT::getVectorVT(MVT::i64, Lanes);
+  //i2048 and i4096 have no simple vector counterpart, so stay with EVT here.
+  EVT VXi64Ty = EVT::getVectorVT(*DAG.getContext(), MVT::i64, f);
+
+  SDValue X = DAG.getNode(ISD::BITCAST, dl, VXi64Ty, V1);
+  SDValue Y = DAG.getNode(ISD::BITCAST, dl, VXi64Ty, V2);
+
+  SDValue Ones = getPXOnesVector(RegTy, b);
+
+  //x, y, r and bubble hold one bit per 64-bit field, field 0 in bit 0.
+  SmallVector<SDValue, 16> R;
+  SDValue x, y, r, bubble;
+  for (unsigned i = 0; i < NumRegs; i++) {
+    SDValue Idx = DAG.getIntPtrConstant(i * Lanes);
+    SDValue Xi = DAG.getNode(ISD::EXTRACT_SUBVECTOR, dl, RegTy, X, Idx);
+    SDValue Yi = DAG.getNode(ISD::EXTRACT_SUBVECTOR, dl, RegTy, Y, Idx);
+    SDValue Ri = b.ADD(Xi, Yi);
+    R.push_back(Ri);
+
+    SDValue Bubble = b.SIGN_EXTEND(b.SETCC(Ri, Ones, ISD::SETEQ), RegTy);
+    SDValue Shift = b.Constant(i * Lanes, MVT::i64);
+    SDValue xi = b.SHL(b.ZERO_EXTEND(b.SignMask4x64(Xi), MVT::i64), Shift);
+    SDValue yi = b.SHL(b.ZERO_EXTEND(b.SignMask4x64(Yi), MVT::i64), Shift);
+    SDValue ri = b.SHL(b.ZERO_EXTEND(b.SignMask4x64(Ri), MVT::i64), Shift);
+    SDValue bi = b.SHL(b.ZERO_EXTEND(b.SignMask4x64(Bubble), MVT::i64), Shift);
+
+    if (i == 0) {
+      x = xi; y = yi; r = ri; bubble = bi;
+    } else {
+      x = b.OR(x, xi); y = b.OR(y, yi); r = b.OR(r, ri); bubble = b.OR(bubble, bi);
+    }
+  }
+
+  SDValue carry = b.OR(b.AND(x, y), b.AND(b.OR(x, y), b.NOT(r)));
+
+  SDValue M = b.SHL(carry, b.Constant(1, MVT::i64));
+  if (Vcarryin.getNode())
+    M = b.OR(M, b.ZERO_EXTEND(Vcarryin, MVT::i64));
+
+  //MatchStar(M, C) = (((M & C) + C) ^ C) | M, spelled out so that the carry
+  //out of the i4096 case (bit 64) can be recovered from the partial terms.
+  SDValue A = b.AND(M, bubble);
+  SDValue T = b.ADD(A, bubble);
+  SDValue increments = b.OR(b.XOR(T, bubble), M);
+
+  SDValue carry_out;
+  if (f < 64) {
+    carry_out = b.TRUNCATE(b.SRL(increments, b.Constant(f, MVT::i64)), MVT::i1);
+  } else {
+    //bit 64 of increments: carry out of field 63, or carry out of A + C.
+    SDValue C64 = b.OR(carry, b.OR(A, b.AND(bubble, b.NOT(T))));
+    carry_out = b.TRUNCATE(b.SRL(C64, b.Constant(63, MVT::i64)), MVT::i1);
+  }
+
+  SmallVector<SDValue, 16> Sums;
+  for (unsigned i = 0; i < NumRegs; i++) {
+    SDValue Bits = b.TRUNCATE(b.SRL(increments, b.Constant(i * Lanes, MVT::i64)),
+                              MVT::i32);
+    Bits = b.AND(Bits, b.Constant((1 << Lanes) - 1, MVT::i32));
+    Sums.push_back(b.ADD(R[i], SpreadBitsTo64(Bits, Lanes, b)));
+  }
+
+  SDValue sum = DAG.getNode(ISD::BITCAST, dl, VT,
+                            DAG.getNode(ISD::CONCAT_VECTORS, dl, VXi64Ty, Sums));
+
+  SDValue Pool[] = {sum, carry_out};
+  return b.MergeValues(Pool);
+}
+
+static SDValue LongStreamAddition(MVT VT, SDValue V1, SDValue V2, SDValue Vcarryin,
+                                  SDNodeTreeBuilder &b) {
   //general logic for uadd.with.overflow.iXXX
   int RegisterWidth = VT.getSizeInBits();
   int f = RegisterWidth / 64;
   MVT VXi64Ty = MVT::getVectorVT(MVT::i64, f);
-  MVT MaskTy = MVT::getIntegerVT(f);
-  MVT MaskVecTy = MVT::getVectorVT(MVT::i1, f);
 
   SDValue X = b.BITCAST(V1, VXi64Ty);
   SDValue Y = b.BITCAST(V2, VXi64Ty);
@@ -1119,22 +1515,13 @@ static SDValue LongStreamAddition(MVT VT, SDValue V1, SDValue V2, SDValue Vcarry
     r = b.SignMask2x64(R);
     bubble = b.SignMask2x64(b.SIGN_EXTEND(b.SETCC(R, Ones, ISD::SETEQ), VXi64Ty));
   }
-  else if (f == 4) {
+  else {
     //i256
     x = b.SignMask4x64(X);
     y = b.SignMask4x64(Y);
     r = b.SignMask4x64(R);
     bubble = b.SignMask4x64(b.SIGN_EXTEND(b.SETCC(R, Ones, ISD::SETEQ), VXi64Ty));
   }
-  else
-  {
-    //i512, i1024, ..., i4096
-    SDValue Zero = getPXZeroVector(VXi64Ty, b);
-    x = b.ZERO_EXTEND(b.BITCAST(b.SETCC(X, Zero, ISD::SETLT), MaskTy), MVT::i32);
-    y = b.ZERO_EXTEND(b.BITCAST(b.SETCC(Y, Zero, ISD::SETLT), MaskTy), MVT::i32);
-    r = b.ZERO_EXTEND(b.BITCAST(b.SETCC(R, Zero, ISD::SETLT), MaskTy), MVT::i32);
-    bubble = b.ZERO_EXTEND(b.BITCAST(b.SETCC(R, Ones, ISD::SETEQ), MaskTy), MVT::i32);
-  }
 
   SDValue carry = b.OR(b.AND(x, y), b.AND(b.OR(x, y), b.NOT(r)));
 
@@ -1149,78 +1536,546 @@ static SDValue LongStreamAddition(MVT VT, SDValue V1, SDValue V2, SDValue Vcarry
 
   SDValue carry_out = b.TRUNCATE(b.SRL(increments, b.Constant(f, MVT::i32)), MVT::i1);
 
-  SDValue spread;
+  SDValue spread = SpreadBitsTo64(increments, f, b);
+  SDValue sum = b.BITCAST(b.ADD(R, spread), VT);
 
-  if (f == 2) {
-    // <2 x i1> increments to <2 x i64>
-    SDValue spreadV2I16 = b.BITCAST(b.AND(b.MUL(increments, b.Constant(0x8001, MVT::i32)),
-                                          b.Constant(0x10001, MVT::i32)), MVT::v2i16);
-    spread = b.ZERO_EXTEND(spreadV2I16, VXi64Ty);
-  }
-  else if (f == 4) {
-    SDValue increments64 = b.ZERO_EXTEND(increments, MVT::i64);
-    SDValue spreadV4I16 = b.BITCAST(b.AND(b.MUL(increments64,
-                                                b.Constant(0x0000200040008001ull, MVT::i64)),
-                                          b.Constant(0x0001000100010001ull, MVT::i64)),
-                                    MVT::v4i16);
-    spread = b.ZERO_EXTEND(spreadV4I16, VXi64Ty);
+  SDValue Pool[] = {sum, carry_out};
+  return b.MergeValues(Pool);
+}
+
+//Types handled by the long stream addition in one piece: i128 (SSE2), i256
+//(AVX) and i512 up to i4096 (AVX2).
+static bool isLongStreamType(EVT VT, const X86Subtarget *Subtarget) {
+  if (!VT.isInteger() || VT.isVector())
+    return false;
+
+  switch (VT.getSizeInBits()) {
+  case 128:
+    return Subtarget->hasSSE2();
+  case 256:
+    return Subtarget->hasAVX();
+  case 512:
+  case 1024:
+  case 2048:
+  case 4096:
+    return Subtarget->hasAVX2() && Subtarget->is64Bit();
+  default:
+    return false;
   }
-  else
-  {
-    // calc spread with zero extend: e.g. <4 x i1> to <4 x i64>
-    spread = b.ZERO_EXTEND(b.BITCAST(b.TRUNCATE(increments, MaskTy), MaskVecTy), VXi64Ty);
+}
+
+//Types that ChainedStreamAddition splits into long stream pieces. Plain
+//uadd.with.overflow of these is left to the adc chain.
+static bool isChainedStreamType(EVT VT, const X86Subtarget *Subtarget) {
+  if (!VT.isInteger() || VT.isVector() || !Subtarget->hasSSE2())
+    return false;
+
+  unsigned Size = VT.getSizeInBits();
+  return Size >= 256 && Size <= 4096 && isPowerOf2_32(Size);
+}
+
+//Long stream addition for types that are too wide for the registers at
+//hand: add the widest pieces LongStreamAddition handles, low piece first,
+//with the carry out of each piece going into the next.
+static SDValue ChainedStreamAddition(EVT VT, SDValue V1, SDValue V2,
+                                     SDValue Vcarryin, SelectionDAG &DAG,
+                                     SDLoc dl, const X86Subtarget *Subtarget) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  MVT PieceTy = Subtarget->hasAVX() ? MVT::i256 : MVT::i128;
+  unsigned Lanes = PieceTy.getSizeInBits() / 64;
+  unsigned NumPieces = VT.getSizeInBits() / PieceTy.getSizeInBits();
+  MVT PieceVecTy = MVT::getVectorVT(MVT::i64, Lanes);
+  EVT VXi64Ty = EVT::getVectorVT(*DAG.getContext(), MVT::i64,
+                                 VT.getSizeInBits() / 64);
+
+  SDValue X = DAG.getNode(ISD::BITCAST, dl, VXi64Ty, V1);
+  SDValue Y = DAG.getNode(ISD::BITCAST, dl, VXi64Ty, V2);
+
+  SDValue Carry = Vcarryin;
+  SmallVector<SDValue, 16> Sums;
+  for (unsigned i = 0; i < NumPieces; i++) {
+    SDValue Idx = DAG.getIntPtrConstant(i * Lanes);
+    SDValue Xi = DAG.getNode(ISD::EXTRACT_SUBVECTOR, dl, PieceVecTy, X, Idx);
+    SDValue Yi = DAG.getNode(ISD::EXTRACT_SUBVECTOR, dl, PieceVecTy, Y, Idx);
+    SDValue R = LongStreamAddition(PieceTy, b.BITCAST(Xi, PieceTy),
+                                   b.BITCAST(Yi, PieceTy), Carry, b);
+    Sums.push_back(b.BITCAST(R.getValue(0), PieceVecTy));
+    Carry = R.getValue(1);
   }
-  SDValue sum = b.BITCAST(b.ADD(R, spread), VT);
 
-  SDValue Pool[] = {sum, carry_out};
+  SDValue Sum = DAG.getNode(ISD::BITCAST, dl, VT,
+                            DAG.getNode(ISD::CONCAT_VECTORS, dl, VXi64Ty, Sums));
+
+  SDValue Pool[] = {Sum, Carry};
   return b.MergeValues(Pool);
 }
 
+static SDValue PerformLongStreamAddition(SDNode *N, SDValue Vcarryin,
+                                         SelectionDAG &DAG,
+                                         const X86Subtarget *Subtarget) {
+  EVT VT = N->getValueType(0);
+  SDLoc dl(N);
+  SDValue V1 = N->getOperand(0);
+  SDValue V2 = N->getOperand(1);
+
+  DEBUG(dbgs() << "Parabix combining: "; N->dump());
+
+  SDValue Ret;
+  if (!isLongStreamType(VT, Subtarget))
+    Ret = ChainedStreamAddition(VT, V1, V2, Vcarryin, DAG, dl, Subtarget);
+  else if (VT.getSizeInBits() > 256)
+    Ret = MultiRegisterStreamAddition(VT, V1, V2, Vcarryin, DAG, dl);
+  else {
+    SDNodeTreeBuilder b(&DAG, dl);
+    Ret = LongStreamAddition(VT.getSimpleVT(), V1, V2, Vcarryin, b);
+  }
+
+  DEBUG(dbgs() << "Combined into: \n"; Ret.dumpr());
+  return Ret;
+}
+
 //Perform combine for @llvm.uadd.with.overflow
 static SDValue PXPerformUADDO(SDNode *N, SelectionDAG &DAG,
                                      TargetLowering::DAGCombinerInfo &DCI,
                                      const X86Subtarget *Subtarget) {
-  MVT VT = N->getSimpleValueType(0);
-  SDLoc dl(N);
-  SDValue V1 = N->getOperand(0);
-  SDValue V2 = N->getOperand(1);
-  SDNodeTreeBuilder b(&DAG, dl);
+  if (DCI.isBeforeLegalize() && isLongStreamType(N->getValueType(0), Subtarget))
+    return PerformLongStreamAddition(N, SDValue(), DAG, Subtarget);
 
+  return SDValue();
+}
+
+//Perform combine for @llvm.uadd.with.overflow.carryin and the Parabix
+//bitstream intrinsics. The legalizer can't expand a UADDE with an i1 carry,
+//so types without a single long stream addition are chained.
+static SDValue PXPerformUADDE(SDNode *N, SelectionDAG &DAG,
+                                     TargetLowering::DAGCombinerInfo &DCI,
+                                     const X86Subtarget *Subtarget) {
+  EVT VT = N->getValueType(0);
   if (DCI.isBeforeLegalize() &&
-      ((Subtarget->hasSSE2() && VT == MVT::i128) || (Subtarget->hasAVX() && VT == MVT::i256))) {
-    DEBUG(dbgs() << "Parabix combining: "; N->dump());
+      (isLongStreamType(VT, Subtarget) || isChainedStreamType(VT, Subtarget)))
+    return PerformLongStreamAddition(N, N->getOperand(2), DAG, Subtarget);
 
-    SDValue Ret = LongStreamAddition(VT, V1, V2, SDValue(), b);
+  return SDValue();
+}
 
-    DEBUG(dbgs() << "Combined into: \n"; Ret.dumpr());
-    return Ret;
+//Register type for the advance of a long stream: YMM with AVX2, XMM
+//otherwise (AVX has no 256-bit integer shifts).
+static MVT getAdvanceRegisterType(EVT VT, const X86Subtarget *Subtarget) {
+  if (Subtarget->hasAVX2() && VT.getSizeInBits() >= 256)
+    return MVT::v4i64;
+  return MVT::v2i64;
+}
+
+//Split an iN stream into registers of RegTy, lowest first.
+static void splitStream(SDValue V, MVT RegTy, SmallVectorImpl<SDValue> &Regs,
+                        SelectionDAG &DAG, SDLoc dl) {
+  EVT VT = V.getValueType();
+  unsigned Lanes = RegTy.getVectorNumElements();
+  unsigned NumRegs = VT.getSizeInBits() / RegTy.getSizeInBits();
+  if (NumRegs == 1) {
+    Regs.push_back(DAG.getNode(ISD::BITCAST, dl, RegTy, V));
+    return;
   }
 
-  return SDValue();
+  EVT VXi64Ty = EVT::getVectorVT(*DAG.getContext(), MVT::i64,
+                                 VT.getSizeInBits() / 64);
+  SDValue X = DAG.getNode(ISD::BITCAST, dl, VXi64Ty, V);
+  for (unsigned i = 0; i < NumRegs; i++)
+    Regs.push_back(DAG.getNode(ISD::EXTRACT_SUBVECTOR, dl, RegTy, X,
+                               DAG.getIntPtrConstant(i * Lanes)));
 }
 
-//Perform combine for @llvm.uadd.with.overflow.carryin
-static SDValue PXPerformUADDE(SDNode *N, SelectionDAG &DAG,
+//Inverse of splitStream.
+static SDValue concatStream(ArrayRef<SDValue> Regs, EVT VT, SelectionDAG &DAG,
+                            SDLoc dl) {
+  if (Regs.size() == 1)
+    return DAG.getNode(ISD::BITCAST, dl, VT, Regs[0]);
+
+  EVT VXi64Ty = EVT::getVectorVT(*DAG.getContext(), MVT::i64,
+                                 VT.getSizeInBits() / 64);
+  return DAG.getNode(ISD::BITCAST, dl, VT,
+                     DAG.getNode(ISD::CONCAT_VECTORS, dl, VXi64Ty, Regs));
+}
+
+//The register's worth of 64-bit words of Regs starting at word Start.
+static SDValue getStreamWindow(ArrayRef<SDValue> Regs, unsigned Start,
+                               SDNodeTreeBuilder &b) {
+  unsigned Lanes = Regs[0].getSimpleValueType().getVectorNumElements();
+  unsigned Reg = Start / Lanes, Offset = Start % Lanes;
+  if (Offset == 0)
+    return Regs[Reg];
+
+  SmallVector<int, 4> Mask;
+  for (unsigned i = 0; i < Lanes; i++)
+    Mask.push_back(Offset + i);
+  return b.VECTOR_SHUFFLE(Regs[Reg], Regs[Reg + 1], &Mask[0]);
+}
+
+//Advance(S, Shift) with the bits shifted in taken from the previous block
+//Carry: (S << Shift) | (Carry >> (N - Shift)), for 0 <= Shift <= N.
+//
+//Seen as 64-bit words, Carry's first and S's after, every result register
+//is a window of consecutive words shifted left by Shift % 64, ORed with the
+//window one word lower shifted right by 64 - Shift % 64. A window that
+//straddles two registers is a shuffle (palignr, vperm2i128 / vpalignr).
+static SDValue PXAdvanceByImm(SDValue S, SDValue Carry, unsigned Shift,
+                              EVT VT, SelectionDAG &DAG, SDLoc dl,
+                              const X86Subtarget *Subtarget) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  unsigned Size = VT.getSizeInBits();
+  if (Shift > Size)
+    return DAG.getUNDEF(VT);
+
+  MVT RegTy = getAdvanceRegisterType(VT, Subtarget);
+  unsigned Lanes = RegTy.getVectorNumElements();
+  SmallVector<SDValue, 16> Regs;
+  splitStream(Carry, RegTy, Regs, DAG, dl);
+  splitStream(S, RegTy, Regs, DAG, dl);
+  unsigned NumRegs = Regs.size() / 2;
+
+  unsigned WordShift = Shift / 64, BitShift = Shift % 64;
+  SmallVector<SDValue, 8> Res;
+  for (unsigned i = 0; i < NumRegs; i++) {
+    unsigned Start = i * Lanes + Size / 64 - WordShift;
+    SDValue Hi = getStreamWindow(Regs, Start, b);
+    if (BitShift == 0) {
+      Res.push_back(Hi);
+      continue;
+    }
+    SDValue Lo = getStreamWindow(Regs, Start - 1, b);
+    Res.push_back(b.OR(b.SHL(BitShift, Hi), b.SRL(64 - BitShift, Lo)));
+  }
+
+  return concatStream(Res, VT, DAG, dl);
+}
+
+//The v2i64 count operand of X86ISD::VSHL / VSRL for an i32 shift amount.
+static SDValue getShiftCountVector(SDValue Amt, SDNodeTreeBuilder &b) {
+  SDValue Ops[] = {Amt, b.Constant(0, MVT::i32), b.Undef(MVT::i32),
+                   b.Undef(MVT::i32)};
+  return b.BITCAST(b.BUILD_VECTOR(MVT::v4i32, Ops), MVT::v2i64);
+}
+
+//PXAdvanceByImm for a shift amount in a register. Carry:S is stored to the
+//stack behind a zero register, and the Hi / Lo windows of every result
+//register are loaded from an offset computed from Shift.
+static SDValue PXAdvanceByVar(SDValue S, SDValue Carry, SDValue Shift,
+                              EVT VT, SelectionDAG &DAG, SDLoc dl,
+                              const X86Subtarget *Subtarget) {
+  SDNodeTreeBuilder b(&DAG, dl);
+  unsigned Size = VT.getSizeInBits();
+  MVT RegTy = getAdvanceRegisterType(VT, Subtarget);
+  unsigned RegBytes = RegTy.getSizeInBits() / 8;
+  EVT PtrVT = DAG.getTargetLoweringInfo().getPointerTy();
+
+  SmallVector<SDValue, 16> Regs;
+  Regs.push_back(getPXZeroVector(RegTy, b));
+  splitStream(Carry, RegTy, Regs, DAG, dl);
+  splitStream(S, RegTy, Regs, DAG, dl);
+  unsigned NumRegs = (Regs.size() - 1) / 2;
+
+  MachineFunction &MF = DAG.getMachineFunction();
+  int SSFI = MF.getFrameInfo()->CreateStackObject(Regs.size() * RegBytes,
+                                                  RegBytes, false);
+  SDValue Slot = DAG.getFrameIndex(SSFI, PtrVT);
+  SmallVector<SDValue, 16> Stores;
+  for (unsigned i = 0; i < Regs.size(); i++) {
+    SDValue Ptr = DAG.getNode(ISD::ADD, dl, PtrVT, Slot,
+                              DAG.getConstant(i * RegBytes, PtrVT));
+    Stores.push_back(DAG.getStore(DAG.getEntryNode(), dl, Regs[i], Ptr,
+                                  MachinePointerInfo(), false, false,
+                                  RegBytes));
+  }
+  SDValue Chain = DAG.getNode(ISD::TokenFactor, dl, MVT::Other, Stores);
+
+  //S starts Size / 8 bytes after Carry; every 64 bits of Shift move the
+  //windows down by a word.
+  SDValue Shift32 = DAG.getZExtOrTrunc(Shift, dl, MVT::i32);
+  SDValue Offset = b.SUB(b.Constant(Size / 8 + RegBytes, MVT::i32),
+                         b.AND(b.SRL(Shift32, b.Constant(3, MVT::i32)),
+                               b.Constant(~7U, MVT::i32)));
+  SDValue Base = DAG.getNode(ISD::ADD, dl, PtrVT, Slot,
+                             DAG.getZExtOrTrunc(Offset, dl, PtrVT));
+
+  //psllq / psrlq by an xmm count: the count is the low quadword, and counts
+  //of 64 shift everything out, so Lo >> (64 - BitShift) is 0 for BitShift 0.
+  SDValue BitShift = b.AND(Shift32, b.Constant(63, MVT::i32));
+  SDValue HiShift = getShiftCountVector(BitShift, b);
+  SDValue LoShift = getShiftCountVector(
+      b.SUB(b.Constant(64, MVT::i32), BitShift), b);
+
+  SmallVector<SDValue, 8> Res;
+  for (unsigned i = 0; i < NumRegs; i++) {
+    SDValue HiPtr = DAG.getNode(ISD::ADD, dl, PtrVT, Base,
+                                DAG.getConstant(i * RegBytes, PtrVT));
+    SDValue LoPtr = DAG.getNode(ISD::SUB, dl, PtrVT, HiPtr,
+                                DAG.getConstant(8, PtrVT));
+    SDValue Hi = DAG.getLoad(RegTy, dl, Chain, HiPtr, MachinePointerInfo(),
+                             false, false, false, 8);
+    SDValue Lo = DAG.getLoad(RegTy, dl, Chain, LoPtr, MachinePointerInfo(),
+                             false, false, false, 8);
+    Res.push_back(b.OR(DAG.getNode(X86ISD::VSHL, dl, RegTy, Hi, HiShift),
+                       DAG.getNode(X86ISD::VSRL, dl, RegTy, Lo, LoShift)));
+  }
+
+  return concatStream(Res, VT, DAG, dl);
+}
+
+//Perform combine for @llvm.parabix.advance: returns the advanced stream and
+//S, the carry for the next block.
+static SDValue PXPerformAdvance(SDNode *N, SelectionDAG &DAG,
+                                TargetLowering::DAGCombinerInfo &DCI,
+                                const X86Subtarget *Subtarget) {
+  EVT VT = N->getValueType(0);
+  unsigned Size = VT.getSizeInBits();
+  if (!DCI.isBeforeLegalize() || !Subtarget->hasSSE2() ||
+      Size < 128 || Size > 4096 || !isPowerOf2_32(Size))
+    return SDValue();
+
+  SDLoc dl(N);
+  SDValue S = N->getOperand(1);
+  SDValue Carry = N->getOperand(2);
+  SDValue Shift = N->getOperand(3);
+
+  DEBUG(dbgs() << "Parabix combining: "; N->dump());
+
+  SDValue Res;
+  if (ConstantSDNode *C = dyn_cast<ConstantSDNode>(Shift))
+    Res = PXAdvanceByImm(S, Carry, C->getZExtValue(), VT, DAG, dl, Subtarget);
+  else
+    Res = PXAdvanceByVar(S, Carry, Shift, VT, DAG, dl, Subtarget);
+
+  SDValue Pool[] = {Res, S};
+  return DAG.getMergeValues(Pool, dl);
+}
+
+//Without AVX2 the 256-bit parabix types are not legal and the type legalizer
+//does not know how to split llvm.x86.parabix.s2p.256 / p2s.256. Transpose
+//with two 128-bit intrinsics instead: one for the first 128 bytes of the
+//stream, which are the low halves of the basis streams, and one for the rest.
+static SDValue PXPerformTranspose256(SDNode *N, SelectionDAG &DAG,
                                      TargetLowering::DAGCombinerInfo &DCI,
                                      const X86Subtarget *Subtarget) {
-  MVT VT = N->getSimpleValueType(0);
+  if (!DCI.isBeforeLegalize() || Subtarget->hasAVX2() || !Subtarget->hasSSE2())
+    return SDValue();
+
   SDLoc dl(N);
-  SDValue V1 = N->getOperand(0);
-  SDValue V2 = N->getOperand(1);
-  SDValue Vcarryin = N->getOperand(2);
+  bool IsS2P = cast<ConstantSDNode>(N->getOperand(0))->getZExtValue() ==
+               Intrinsic::x86_parabix_s2p_256;
+  unsigned HalfIntNo = IsS2P ? Intrinsic::x86_parabix_s2p
+                             : Intrinsic::x86_parabix_p2s;
+  MVT InVT = N->getOperand(1).getSimpleValueType();
+  MVT OutVT = N->getSimpleValueType(0);
+  unsigned HalfInElts = InVT.getVectorNumElements() / 2;
+  MVT HalfInVT = MVT::getVectorVT(InVT.getVectorElementType(), HalfInElts);
+  MVT HalfOutVT = MVT::getVectorVT(OutVT.getVectorElementType(),
+                                   OutVT.getVectorNumElements() / 2);
+
+  DEBUG(dbgs() << "Parabix combining: "; N->dump());
+
+  //The byte stream is in stream order: byte register i is halves 2i and 2i+1
+  //of the stream, and half j goes to operand j % 8 of call j / 8. The basis
+  //streams are in lane order: call 0 gets every low half, call 1 every high.
+  SDValue Ops[2][9];
+  Ops[0][0] = Ops[1][0] = DAG.getTargetConstant(HalfIntNo,
+                                                N->getOperand(0).getValueType());
+  for (unsigned i = 0; i < 8; ++i) {
+    SDValue V = N->getOperand(i + 1);
+    SDValue Lo = DAG.getNode(ISD::EXTRACT_SUBVECTOR, dl, HalfInVT, V,
+                             DAG.getIntPtrConstant(0));
+    SDValue Hi = DAG.getNode(ISD::EXTRACT_SUBVECTOR, dl, HalfInVT, V,
+                             DAG.getIntPtrConstant(HalfInElts));
+    if (IsS2P) {
+      Ops[i / 4][1 + 2 * (i % 4)] = Lo;
+      Ops[i / 4][2 + 2 * (i % 4)] = Hi;
+    } else {
+      Ops[0][1 + i] = Lo;
+      Ops[1][1 + i] = Hi;
+    }
+  }
+
+  SmallVector<EVT, 8> HalfVTs(8, HalfOutVT);
+  SDVTList VTs = DAG.getVTList(HalfVTs);
+  SDValue R[2];
+  for (unsigned i = 0; i < 2; ++i)
+    R[i] = DAG.getNode(ISD::INTRINSIC_WO_CHAIN, dl, VTs, Ops[i]);
+
+  SDValue Res[8];
+  for (unsigned i = 0; i < 8; ++i) {
+    SDValue Lo = IsS2P ? R[0].getValue(i) : R[i / 4].getValue(2 * (i % 4));
+    SDValue Hi = IsS2P ? R[1].getValue(i) : R[i / 4].getValue(2 * (i % 4) + 1);
+    Res[i] = DAG.getNode(ISD::CONCAT_VECTORS, dl, OutVT, Lo, Hi);
+  }
+  return DAG.getMergeValues(Res, dl);
+}
+
+//The 64-bit words of a long integer, lowest first. A stream that is a
+//bitcast vector is read lane by lane, anything else (e.g. a load) is split
+//with shifts the type legalizer turns into picking the i64 parts.
+static void getStreamWords(SDValue V, SmallVectorImpl<SDValue> &Words,
+                           SelectionDAG &DAG, SDLoc dl) {
   SDNodeTreeBuilder b(&DAG, dl);
+  EVT VT = V.getValueType();
+  unsigned NumWords = VT.getSizeInBits() / 64;
+
+  if (V.getOpcode() == ISD::BITCAST &&
+      V.getOperand(0).getValueType().isVector()) {
+    EVT VXi64Ty = EVT::getVectorVT(*DAG.getContext(), MVT::i64, NumWords);
+    SDValue X = DAG.getNode(ISD::BITCAST, dl, VXi64Ty, V);
+    for (unsigned i = 0; i < NumWords; i++)
+      Words.push_back(DAG.getNode(ISD::EXTRACT_VECTOR_ELT, dl, MVT::i64, X,
+                                  DAG.getIntPtrConstant(i)));
+    return;
+  }
 
-  if (DCI.isBeforeLegalize() &&
-      ((Subtarget->hasSSE2() && VT == MVT::i128) || (Subtarget->hasAVX() && VT == MVT::i256))) {
-    DEBUG(dbgs() << "Parabix combining: "; N->dump());
+  for (unsigned i = 0; i < NumWords; i++) {
+    SDValue W = i ? DAG.getNode(ISD::SRL, dl, VT, V,
+                                DAG.getConstant(i * 64, MVT::i32))
+                  : V;
+    Words.push_back(DAG.getNode(ISD::TRUNCATE, dl, MVT::i64, W));
+  }
+}
 
-    SDValue Ret = LongStreamAddition(VT, V1, V2, Vcarryin, b);
+//Byte-wise population count of a v2i64, as v16i8. pshufb on a nibble table
+//with SSSE3, the usual SWAR reduction otherwise.
+static SDValue PXBytePopcount(SDValue V, SelectionDAG &DAG, SDLoc dl,
+                              const X86Subtarget *Subtarget) {
+  SDNodeTreeBuilder b(&DAG, dl);
 
-    DEBUG(dbgs() << "Combined into: \n"; Ret.dumpr());
-    return Ret;
+  if (Subtarget->hasSSSE3()) {
+    static const uint8_t NibbleCount[] = {0, 1, 1, 2, 1, 2, 2, 3,
+                                          1, 2, 2, 3, 2, 3, 3, 4};
+    SmallVector<SDValue, 16> Pool;
+    for (unsigned i = 0; i < 16; i++)
+      Pool.push_back(b.Constant(NibbleCount[i], MVT::i8));
+    SDValue Table = b.BUILD_VECTOR(MVT::v16i8, Pool);
+    SDValue LowMask = b.Splat64(0x0f0f0f0f0f0f0f0fULL, MVT::v2i64);
+    SDValue Lo = b.BITCAST(b.AND(V, LowMask), MVT::v16i8);
+    SDValue Hi = b.BITCAST(b.AND(b.SRL<4>(V), LowMask), MVT::v16i8);
+    return b.ADD(DAG.getNode(X86ISD::PSHUFB, dl, MVT::v16i8, Table, Lo),
+                 DAG.getNode(X86ISD::PSHUFB, dl, MVT::v16i8, Table, Hi));
   }
 
-  return SDValue();
+  SDValue X = b.SUB(V, b.AND(b.SRL<1>(V), b.Splat64(0x5555555555555555ULL,
+                                                    MVT::v2i64)));
+  SDValue M2 = b.Splat64(0x3333333333333333ULL, MVT::v2i64);
+  X = b.ADD(b.AND(X, M2), b.AND(b.SRL<2>(X), M2));
+  X = b.AND(b.ADD(X, b.SRL<4>(X)), b.Splat64(0x0f0f0f0f0f0f0f0fULL,
+                                              MVT::v2i64));
+  return b.BITCAST(X, MVT::v16i8);
+}
+
+//Perform combine for ctpop / cttz / ctlz of i128 and i256. The count fits
+//in an i64, so it is computed on the 64-bit words (popcnt, tzcnt / bsf,
+//lzcnt / bsr) and zero extended, instead of the default expansion that
+//carries through iN halves. Without popcnt, the words are counted in XMM
+//registers and summed with psadbw.
+static SDValue PXPerformBitCount(SDNode *N, SelectionDAG &DAG,
+                                 TargetLowering::DAGCombinerInfo &DCI,
+                                 const X86Subtarget *Subtarget) {
+  MVT VT = N->getSimpleValueType(0);
+  if (!DCI.isBeforeLegalize() || !Subtarget->is64Bit() ||
+      !Subtarget->hasSSE2() || (VT != MVT::i128 && VT != MVT::i256))
+    return SDValue();
+
+  SDLoc dl(N);
+  SDNodeTreeBuilder b(&DAG, dl);
+  SDValue V = N->getOperand(0);
+  unsigned Opc = N->getOpcode();
+
+  DEBUG(dbgs() << "Parabix combining: "; N->dump());
+
+  if (Opc == ISD::CTPOP && !Subtarget->hasPOPCNT()) {
+    SmallVector<SDValue, 2> Regs;
+    splitStream(V, MVT::v2i64, Regs, DAG, dl);
+    SDValue Bytes = PXBytePopcount(Regs[0], DAG, dl, Subtarget);
+    for (unsigned i = 1; i < Regs.size(); i++)
+      Bytes = b.ADD(Bytes, PXBytePopcount(Regs[i], DAG, dl, Subtarget));
+
+    SDValue Sums = DAG.getNode(ISD::INTRINSIC_WO_CHAIN, dl, MVT::v2i64,
+                               b.Constant(Intrinsic::x86_sse2_psad_bw),
+                               Bytes, getPXZeroVector(MVT::v16i8, b));
+    const int HiMask[] = {1, -1};
+    SDValue Sum = b.ADD(Sums, b.VECTOR_SHUFFLE(Sums, b.Undef(MVT::v2i64),
+                                               HiMask));
+    return b.ZERO_EXTEND(b.EXTRACT_VECTOR_ELT(Sum, 0), VT);
+  }
+
+  SmallVector<SDValue, 4> Words;
+  getStreamWords(V, Words, DAG, dl);
+  unsigned NumWords = Words.size();
+
+  SDValue Res;
+  switch (Opc) {
+  default: llvm_unreachable("unexpected bit count");
+  case ISD::CTPOP:
+    Res = DAG.getNode(ISD::CTPOP, dl, MVT::i64, Words[0]);
+    for (unsigned i = 1; i < NumWords; i++)
+      Res = b.ADD(Res, DAG.getNode(ISD::CTPOP, dl, MVT::i64, Words[i]));
+    break;
+  case ISD::CTTZ:
+  case ISD::CTTZ_ZERO_UNDEF:
+  case ISD::CTLZ:
+  case ISD::CTLZ_ZERO_UNDEF: {
+    //Start from the far word, whose count also covers the all zero input
+    //unless it is undefined, then let every nearer non-zero word override.
+    bool Trailing = Opc == ISD::CTTZ || Opc == ISD::CTTZ_ZERO_UNDEF;
+    unsigned ZeroUndefOpc = Trailing ? ISD::CTTZ_ZERO_UNDEF
+                                     : ISD::CTLZ_ZERO_UNDEF;
+    for (unsigned k = NumWords; k-- > 0; ) {
+      SDValue W = Words[Trailing ? k : NumWords - 1 - k];
+      SDValue Count = b.ADD(DAG.getNode(Res.getNode() ? ZeroUndefOpc : Opc,
+                                        dl, MVT::i64, W),
+                            b.Constant(k * 64, MVT::i64));
+      if (!Res.getNode()) {
+        Res = Count;
+        continue;
+      }
+      SDValue NonZero = DAG.getSetCC(dl, MVT::i1, W,
+                                     b.Constant(0, MVT::i64), ISD::SETNE);
+      Res = DAG.getNode(ISD::SELECT, dl, MVT::i64, NonZero, Count, Res);
+    }
+    break;
+  }
+  }
+
+  return b.ZERO_EXTEND(Res, VT);
+}
+
+//Perform combine for the stream-is-empty test (setcc eq/ne iN X, 0) of a
+//vector stream without SSE4.1, which would otherwise move every word to a
+//GPR: or the XMM registers together, pcmpeqb with zero and pmovmskb. With
+//SSE4.1 the generic lowering already gives ptest / vptest.
+static SDValue PXPerformAnySetCC(SDNode *N, SelectionDAG &DAG,
+                                 TargetLowering::DAGCombinerInfo &DCI,
+                                 const X86Subtarget *Subtarget) {
+  SDValue X = N->getOperand(0);
+  EVT VT = X.getValueType();
+  ISD::CondCode CC = cast<CondCodeSDNode>(N->getOperand(2))->get();
+  if (!DCI.isBeforeLegalize() || !Subtarget->hasSSE2() ||
+      Subtarget->hasSSE41() || (VT != MVT::i128 && VT != MVT::i256) ||
+      (CC != ISD::SETEQ && CC != ISD::SETNE) ||
+      !X86::isZeroNode(N->getOperand(1)) ||
+      X.getOpcode() != ISD::BITCAST ||
+      !X.getOperand(0).getValueType().isVector())
+    return SDValue();
+
+  SDLoc dl(N);
+  SDNodeTreeBuilder b(&DAG, dl);
+
+  DEBUG(dbgs() << "Parabix combining: "; N->dump());
+
+  SmallVector<SDValue, 2> Regs;
+  splitStream(X, MVT::v2i64, Regs, DAG, dl);
+  SDValue Any = Regs[0];
+  for (unsigned i = 1; i < Regs.size(); i++)
+    Any = b.OR(Any, Regs[i]);
+
+  SDValue ZeroBytes = DAG.getNode(X86ISD::PCMPEQ, dl, MVT::v16i8,
+                                  b.BITCAST(Any, MVT::v16i8),
+                                  getPXZeroVector(MVT::v16i8, b));
+  return DAG.getSetCC(dl, N->getValueType(0), b.SignMask16x8(ZeroBytes),
+                      b.Constant(0xffff, MVT::i32), CC);
 }
 
 static SDValue PXPerformLogic(SDNode *N, SelectionDAG &DAG,
@@ -1236,116 +2091,26 @@ static SDValue PXPerformLogic(SDNode *N, SelectionDAG &DAG,
           (N->getOpcode() == ISD::XOR)) &&
          "PXPerformLogic only works for AND / OR / XOR");
 
-  /* Support for simd<128>::dslli<n>(A, B): long shift left for A, with shift-in bits in B
-   * Pattern: OR(SHL(i128 A, n), SHR(i128 B, 128 - n))
+  /* Support for simd<128>::dslli<n>(A, B) and simd<256>::dslli<n>(A, B): long
+   * shift left for A, with shift-in bits in B
+   * Pattern: OR(SHL(iN A, n), SHR(iN B, N - n)), N = 128 or 256
    */
-  if (N->getOpcode() == ISD::OR && VT == MVT::i128 &&
+  if (N->getOpcode() == ISD::OR && (VT == MVT::i128 || VT == MVT::i256) &&
      ((V1.getOpcode() == ISD::SHL && V2.getOpcode() == ISD::SRL) ||
       (V1.getOpcode() == ISD::SRL && V2.getOpcode() == ISD::SHL))) {
     //possibly it's advance with carry
-    //now check if the shl amount + shr amount is 128
+    //now check if the shl amount + shr amount is N
     if (V1.getOpcode() != ISD::SHL) {
       std::swap(V1, V2);
     }
 
     int immLeft, immRight;
     if (isImmediateShiftingMask(V1.getOperand(1), immLeft) &&
-        isImmediateShiftingMask(V2.getOperand(1), immRight))
-    {
-      if (immLeft + immRight == 128) {
-        //finally, it is advance with carry
-        SDValue A = b.BITCAST(V1.getOperand(0), MVT::v2i64);
-        SDValue B = b.BITCAST(V2.getOperand(0), MVT::v2i64);
-
-        int pool[] = {1, 2};
-        SDValue C = b.VECTOR_SHUFFLE(B, A, pool);
-        if (immLeft < 64) {
-          SDValue D = b.SHL(immLeft, A);
-          SDValue E = b.SRL(64 - immLeft, C);
-          SDValue R = b.OR(D, E);
-          return b.BITCAST(R, VT);
-        }
-        else
-        {
-          SDValue D = b.SHL(immLeft - 64, C);
-          SDValue E = b.SRL(128 - immLeft, B);
-          SDValue R = b.OR(D, E);
-          return b.BITCAST(R, VT);
-        }
-      }
-    }
-  }
-
-  /* Support for simd<256>::dslli<n>(A, B): long shift left for A, with shift-in bits in B
-   * Pattern: OR(SHL(i256 A, n), SHR(i256 B, 256 - n))
-   */
-  if (N->getOpcode() == ISD::OR && VT == MVT::i256 &&
-     ((V1.getOpcode() == ISD::SHL && V2.getOpcode() == ISD::SRL) ||
-      (V1.getOpcode() == ISD::SRL && V2.getOpcode() == ISD::SHL))) {
-    //possibly it's advance with carry
-    //now check if the shl amount + shr amount is 256
-    if (V1.getOpcode() != ISD::SHL) {
-      std::swap(V1, V2);
-    }
-
-    int immLeft, immRight;
-    if (isImmediateShiftingMask(V1.getOperand(1), immLeft) &&
-        isImmediateShiftingMask(V2.getOperand(1), immRight))
-    {
-      if (immLeft + immRight == 256) {
-        //finally, it is advance with carry
-        SDValue A = b.BITCAST(V1.getOperand(0), MVT::v4i64);
-        SDValue B = b.BITCAST(V2.getOperand(0), MVT::v4i64);
-
-        if (immLeft < 64) {
-          int pool[] = {3, 4, 5, 6};
-          SDValue C = b.VECTOR_SHUFFLE(B, A, pool);
-
-          SDValue D = b.SHL(immLeft, A);
-          SDValue E = b.SRL(64 - immLeft, C);
-          SDValue R = b.OR(D, E);
-          return b.BITCAST(R, VT);
-        }
-        else if (immLeft >= 64 && immLeft < 128)
-        {
-          int apool[] = {3, 4, 5, 6};
-          SDValue NA = b.VECTOR_SHUFFLE(B, A, apool);
-
-          int pool[] = {2, 3, 4, 5};
-          SDValue C = b.VECTOR_SHUFFLE(B, A, pool);
-
-          SDValue D = b.SHL(immLeft - 64, NA);
-          SDValue E = b.SRL(128 - immLeft, C);
-          SDValue R = b.OR(D, E);
-          return b.BITCAST(R, VT);
-        }
-        else if (immLeft >= 128 && immLeft < 192)
-        {
-          int apool[] = {2, 3, 4, 5};
-          SDValue NA = b.VECTOR_SHUFFLE(B, A, apool);
-
-          int pool[] = {1, 2, 3, 4};
-          SDValue C = b.VECTOR_SHUFFLE(B, A, pool);
-
-          SDValue D = b.SHL(immLeft - 128, NA);
-          SDValue E = b.SRL(192 - immLeft, C);
-          SDValue R = b.OR(D, E);
-
-          return b.BITCAST(R, VT);
-        }
-        else
-        {
-          //immLeft >= 192 && immLeft <= 256
-          int apool[] = {1, 2, 3, 4};
-          A = b.VECTOR_SHUFFLE(B, A, apool);
-
-          SDValue D = b.SHL(immLeft - 192, A);
-          SDValue E = b.SRL(256 - immLeft, B);
-          SDValue R = b.OR(D, E);
-
-          return b.BITCAST(R, VT);
-        }
-      }
+        isImmediateShiftingMask(V2.getOperand(1), immRight) &&
+        immLeft + immRight == (int)VT.getSizeInBits()) {
+      //finally, it is advance with carry
+      return PXAdvanceByImm(V1.getOperand(0), V2.getOperand(0), immLeft,
+                            VT, DAG, dl, Subtarget);
     }
   }
 
@@ -1365,21 +2130,43 @@ static SDValue PXPerformLogic(SDNode *N, SelectionDAG &DAG,
 
 SDValue X86TargetLowering::PerformParabixDAGCombine(SDNode *N, DAGCombinerInfo &DCI) const
 {
+  SelectionDAG &DAG = DCI.DAG;
+
+  //Long stream additions go up to i4096, which has no simple value type.
+  if (N->getOpcode() == ISD::UADDO)
+    return PXPerformUADDO(N, DAG, DCI, Subtarget);
+  if (N->getOpcode() == ISD::UADDE)
+    return PXPerformUADDE(N, DAG, DCI, Subtarget);
+  if (N->getOpcode() == ISD::INTRINSIC_WO_CHAIN &&
+      cast<ConstantSDNode>(N->getOperand(0))->getZExtValue() ==
+        Intrinsic::parabix_advance)
+    return PXPerformAdvance(N, DAG, DCI, Subtarget);
+  if (N->getOpcode() == ISD::INTRINSIC_WO_CHAIN &&
+      (cast<ConstantSDNode>(N->getOperand(0))->getZExtValue() ==
+         Intrinsic::x86_parabix_s2p_256 ||
+       cast<ConstantSDNode>(N->getOperand(0))->getZExtValue() ==
+         Intrinsic::x86_parabix_p2s_256))
+    return PXPerformTranspose256(N, DAG, DCI, Subtarget);
+
   //For now, only combine simple value type.
   if (!N->getValueType(0).isSimple()) return SDValue();
 
-  SelectionDAG &DAG = DCI.DAG;
   switch (N->getOpcode()) {
   default: break;
   case ISD::VSELECT:            return PXPerformVSELECTCombine(N, DAG, DCI, Subtarget);
   case ISD::VECTOR_SHUFFLE:     return PXPerformVECTOR_SHUFFLECombine(N, DAG, DCI, Subtarget);
   case ISD::SHL:
+  case ISD::SRA:
   case ISD::SRL:                return PXPerformShiftCombine(N, DAG, DCI, Subtarget);
-  case ISD::UADDO:              return PXPerformUADDO(N, DAG, DCI, Subtarget);
-  case ISD::UADDE:              return PXPerformUADDE(N, DAG, DCI, Subtarget);
   case ISD::AND:
   case ISD::XOR:
   case ISD::OR:                 return PXPerformLogic(N, DAG, DCI, Subtarget);
+  case ISD::CTPOP:
+  case ISD::CTTZ:
+  case ISD::CTTZ_ZERO_UNDEF:
+  case ISD::CTLZ:
+  case ISD::CTLZ_ZERO_UNDEF:    return PXPerformBitCount(N, DAG, DCI, Subtarget);
+  case ISD::SETCC:              return PXPerformAnySetCC(N, DAG, DCI, Subtarget);
   }
 
   return SDValue();
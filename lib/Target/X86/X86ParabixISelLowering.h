@@ -79,6 +79,18 @@ namespace llvm {
       return BUILD_VECTOR(NumType, Pool);
     }
 
+    SDValue Splat64(uint64_t Num, MVT NumType) {
+      assert(NumType.getScalarType() == MVT::i64 &&
+             "Splat64 should build vNi64");
+
+      SDValue Elem = DAG->getConstant(Num, MVT::i64);
+      SmallVector<SDValue, 4> Pool;
+      for (unsigned i = 0; i < NumType.getVectorNumElements(); ++i)
+        Pool.push_back(Elem);
+
+      return BUILD_VECTOR(NumType, Pool);
+    }
+
     SDValue ConstantVector(MVT VT, int ElemVal) {
       assert(VT.isVector() && "ConstantVector only return vector type");
 
@@ -158,6 +170,11 @@ namespace llvm {
       return DAG->getNode(ISD::ADD, dl, VT, A, B);
     }
 
+    SDValue SUB(SDValue A, SDValue B) {
+      MVT VT = A.getSimpleValueType();
+      return DAG->getNode(ISD::SUB, dl, VT, A, B);
+    }
+
     SDValue AND(SDValue A, SDValue B) {
       MVT VT = A.getSimpleValueType();
       return DAG->getNode(ISD::AND, dl, VT, A, B);
@@ -298,14 +315,35 @@ namespace llvm {
     }
 
     //X86 specific function
-    SDValue PEXT64(SDValue A, SDValue B) {
-      assert(A.getSimpleValueType() == MVT::i64 &&
-             B.getSimpleValueType() == MVT::i64 &&
-             "PEXT64 only take i64 operands");
+    //BMI2 parallel bit extract; i32 operands use the 32-bit form
+    SDValue PEXT(SDValue A, SDValue B) {
+      MVT VT = A.getSimpleValueType();
+      assert((VT == MVT::i32 || VT == MVT::i64) &&
+             B.getSimpleValueType() == VT &&
+             "PEXT only takes i32 or i64 operands");
 
+      unsigned IID = VT == MVT::i32 ? Intrinsic::x86_bmi_pext_32
+                                    : Intrinsic::x86_bmi_pext_64;
       SDValue V = DAG->getNode(ISD::INTRINSIC_WO_CHAIN, dl,
-                              MVT::i64,
-                              DAG->getConstant(Intrinsic::x86_bmi_pext_64, MVT::i32),
+                              VT,
+                              DAG->getConstant(IID, MVT::i32),
+                              A,B);
+      return V;
+    }
+
+    //X86 specific function
+    //BMI2 parallel bit deposit; i32 operands use the 32-bit form
+    SDValue PDEP(SDValue A, SDValue B) {
+      MVT VT = A.getSimpleValueType();
+      assert((VT == MVT::i32 || VT == MVT::i64) &&
+             B.getSimpleValueType() == VT &&
+             "PDEP only takes i32 or i64 operands");
+
+      unsigned IID = VT == MVT::i32 ? Intrinsic::x86_bmi_pdep_32
+                                    : Intrinsic::x86_bmi_pdep_64;
+      SDValue V = DAG->getNode(ISD::INTRINSIC_WO_CHAIN, dl,
+                              VT,
+                              DAG->getConstant(IID, MVT::i32),
                               A,B);
       return V;
     }
@@ -340,6 +378,21 @@ namespace llvm {
       return V;
     }
 
+    //X86 specific function
+    //Collect sign bit of each 8-bit field into i32
+    SDValue SignMask16x8(SDValue A) {
+      assert(A.getSimpleValueType().getSizeInBits() == 128 &&
+             "SignMask get wrong sized type.");
+      if (A.getSimpleValueType() != MVT::v16i8)
+        A = BITCAST(A, MVT::v16i8);
+
+      SDValue V = DAG->getNode(ISD::INTRINSIC_WO_CHAIN, dl,
+                               MVT::i32,
+                               DAG->getConstant(Intrinsic::x86_sse2_pmovmskb_128, MVT::i32),
+                               A);
+      return V;
+    }
+
     //X86 Specific function
     //Shift left the i128 or i256 operand A by immInByte * 8 bits.
     //Return v2i64 for i128
@@ -381,18 +434,19 @@ namespace llvm {
 
 
     //simd<1>::ifh
-    //just like SELECT, but for v128i1 vectors. if Mask[i] == 1, A[i] is chosen.
-    //return with the same ValueType of A.
+    //just like SELECT, but for v128i1 / v256i1 vectors. if Mask[i] == 1, A[i]
+    //is chosen. return with the same ValueType of A.
     SDValue IFH1(SDValue Mask, SDValue A, SDValue B) {
-      assert(A.getValueType().is128BitVector() &&
-             B.getValueType().is128BitVector() &&
-             Mask.getValueType().is128BitVector() &&
-             "IFH1 only take 128 bit vectors");
-
       MVT VT = A.getSimpleValueType();
-      SDValue NewMask = BITCAST(Mask, MVT::v4i32);
-      SDValue NewOp1  = BITCAST(A, MVT::v4i32);
-      SDValue NewOp2  = BITCAST(B, MVT::v4i32);
+      assert((VT.is128BitVector() || VT.is256BitVector()) &&
+             B.getValueType().getSizeInBits() == VT.getSizeInBits() &&
+             Mask.getValueType().getSizeInBits() == VT.getSizeInBits() &&
+             "IFH1 only take 128 or 256 bit vectors");
+
+      MVT IntVT = VT.is128BitVector() ? MVT::v4i32 : MVT::v8i32;
+      SDValue NewMask = BITCAST(Mask, IntVT);
+      SDValue NewOp1  = BITCAST(A, IntVT);
+      SDValue NewOp2  = BITCAST(B, IntVT);
 
       // (NewMask & NewOp1) || (~NewMask & NewOp2)
       SDValue R = OR(AND(NewMask, NewOp1), AND(NOT(NewMask), NewOp2));
@@ -181,6 +181,119 @@ unsigned X86TTI::getArithmeticInstrCost(unsigned Opcode, Type *Ty,
   int ISD = TLI->InstructionOpcodeToISD(Opcode);
   assert(ISD && "Invalid opcode");
 
+  static const CostTblEntry<MVT::SimpleValueType>
+  ParabixUniformConstCostTable[] = {
+    // Parabix fields narrower than a byte are shifted as i16 and masked.
+    { ISD::SHL,  MVT::v64i2,   2 }, // psllw, pand.
+    { ISD::SHL,  MVT::v32i4,   2 },
+    { ISD::SHL,  MVT::v128i2,  2 },
+    { ISD::SHL,  MVT::v64i4,   2 },
+    { ISD::SRL,  MVT::v64i2,   2 }, // psrlw, pand.
+    { ISD::SRL,  MVT::v32i4,   2 },
+    { ISD::SRL,  MVT::v128i2,  2 },
+    { ISD::SRL,  MVT::v64i4,   2 },
+    { ISD::SRA,  MVT::v64i2,   7 }, // psrlw, pand, sign fill.
+    { ISD::SRA,  MVT::v32i4,   7 },
+    { ISD::SRA,  MVT::v128i2,  7 },
+    { ISD::SRA,  MVT::v64i4,   7 },
+  };
+
+  if (Op2Info == TargetTransformInfo::OK_UniformConstantValue) {
+    int Idx = CostTableLookup(ParabixUniformConstCostTable, ISD, LT.second);
+    if (Idx != -1)
+      return LT.first * ParabixUniformConstCostTable[Idx].Cost;
+  }
+
+  static const CostTblEntry<MVT::SimpleValueType> ParabixCostTable[] = {
+    // Logic on any Parabix type is one full register instruction.
+    { ISD::AND,  MVT::v32i1,   1 },
+    { ISD::AND,  MVT::v64i1,   1 },
+    { ISD::AND,  MVT::v128i1,  1 },
+    { ISD::AND,  MVT::v256i1,  1 },
+    { ISD::AND,  MVT::v64i2,   1 },
+    { ISD::AND,  MVT::v128i2,  1 },
+    { ISD::AND,  MVT::v32i4,   1 },
+    { ISD::AND,  MVT::v64i4,   1 },
+    { ISD::OR,   MVT::v32i1,   1 },
+    { ISD::OR,   MVT::v64i1,   1 },
+    { ISD::OR,   MVT::v128i1,  1 },
+    { ISD::OR,   MVT::v256i1,  1 },
+    { ISD::OR,   MVT::v64i2,   1 },
+    { ISD::OR,   MVT::v128i2,  1 },
+    { ISD::OR,   MVT::v32i4,   1 },
+    { ISD::OR,   MVT::v64i4,   1 },
+    { ISD::XOR,  MVT::v32i1,   1 },
+    { ISD::XOR,  MVT::v64i1,   1 },
+    { ISD::XOR,  MVT::v128i1,  1 },
+    { ISD::XOR,  MVT::v256i1,  1 },
+    { ISD::XOR,  MVT::v64i2,   1 },
+    { ISD::XOR,  MVT::v128i2,  1 },
+    { ISD::XOR,  MVT::v32i4,   1 },
+    { ISD::XOR,  MVT::v64i4,   1 },
+
+    // i1 add and sub are xor, mul is and.
+    { ISD::ADD,  MVT::v32i1,   1 },
+    { ISD::ADD,  MVT::v64i1,   1 },
+    { ISD::ADD,  MVT::v128i1,  1 },
+    { ISD::ADD,  MVT::v256i1,  1 },
+    { ISD::SUB,  MVT::v32i1,   1 },
+    { ISD::SUB,  MVT::v64i1,   1 },
+    { ISD::SUB,  MVT::v128i1,  1 },
+    { ISD::SUB,  MVT::v256i1,  1 },
+    { ISD::MUL,  MVT::v32i1,   1 },
+    { ISD::MUL,  MVT::v64i1,   1 },
+    { ISD::MUL,  MVT::v128i1,  1 },
+    { ISD::MUL,  MVT::v256i1,  1 },
+
+    // i2 and i4 arithmetic uses the sequences in ParabixGeneratedFuncs.h;
+    // i4 mul is promoted to i8 fields in place.
+    { ISD::ADD,  MVT::v64i2,  10 },
+    { ISD::ADD,  MVT::v128i2,  9 },
+    { ISD::ADD,  MVT::v32i4,   9 },
+    { ISD::ADD,  MVT::v64i4,   9 },
+    { ISD::SUB,  MVT::v64i2,  10 },
+    { ISD::SUB,  MVT::v128i2,  9 },
+    { ISD::SUB,  MVT::v32i4,   9 },
+    { ISD::SUB,  MVT::v64i4,   9 },
+    { ISD::MUL,  MVT::v64i2,  25 },
+    { ISD::MUL,  MVT::v128i2, 20 },
+    { ISD::MUL,  MVT::v32i4,  29 },
+    { ISD::MUL,  MVT::v64i4,  26 },
+
+    // Only a shift by 0 is defined for i1 fields.
+    { ISD::SHL,  MVT::v32i1,   1 }, // andn.
+    { ISD::SHL,  MVT::v64i1,   1 },
+    { ISD::SHL,  MVT::v128i1,  1 },
+    { ISD::SHL,  MVT::v256i1,  1 },
+    { ISD::SRL,  MVT::v32i1,   1 },
+    { ISD::SRL,  MVT::v64i1,   1 },
+    { ISD::SRL,  MVT::v128i1,  1 },
+    { ISD::SRL,  MVT::v256i1,  1 },
+    { ISD::SRA,  MVT::v32i1,   0 },
+    { ISD::SRA,  MVT::v64i1,   0 },
+    { ISD::SRA,  MVT::v128i1,  0 },
+    { ISD::SRA,  MVT::v256i1,  0 },
+
+    // Per-field shift amounts use the generated shift-and-select sequences
+    // from ParabixGeneratedFuncs.h, one stage per bit of the amount.
+    { ISD::SHL,  MVT::v64i2,  13 },
+    { ISD::SHL,  MVT::v128i2, 13 },
+    { ISD::SRL,  MVT::v64i2,  14 },
+    { ISD::SRL,  MVT::v128i2, 14 },
+    { ISD::SRA,  MVT::v64i2,  12 },
+    { ISD::SRA,  MVT::v128i2, 12 },
+    { ISD::SHL,  MVT::v32i4,  29 },
+    { ISD::SHL,  MVT::v64i4,  29 },
+    { ISD::SRL,  MVT::v32i4,  29 },
+    { ISD::SRL,  MVT::v64i4,  29 },
+    { ISD::SRA,  MVT::v32i4,  37 },
+    { ISD::SRA,  MVT::v64i4,  37 },
+  };
+
+  int ParabixIdx = CostTableLookup(ParabixCostTable, ISD, LT.second);
+  if (ParabixIdx != -1)
+    return LT.first * ParabixCostTable[ParabixIdx].Cost;
+
   static const CostTblEntry<MVT::SimpleValueType>
   AVX2UniformConstCostTable[] = {
     { ISD::SDIV, MVT::v16i16,  6 }, // vpmulhw sequence
@@ -400,11 +513,48 @@ unsigned X86TTI::getArithmeticInstrCost(unsigned Opcode, Type *Ty,
 
 unsigned X86TTI::getShuffleCost(ShuffleKind Kind, Type *Tp, int Index,
                                 Type *SubTp) const {
+  std::pair<unsigned, MVT> LT = TLI->getTypeLegalizationCost(Tp);
+
+  // Parabix fields are not byte addressable, so anything but a broadcast
+  // moves every field on its own.
+  static const CostTblEntry<MVT::SimpleValueType> ParabixBroadcastTbl[] = {
+    { ISD::VECTOR_SHUFFLE, MVT::v32i1,   10 },
+    { ISD::VECTOR_SHUFFLE, MVT::v64i1,   15 },
+    { ISD::VECTOR_SHUFFLE, MVT::v128i1,  16 },
+    { ISD::VECTOR_SHUFFLE, MVT::v256i1,  43 },
+    { ISD::VECTOR_SHUFFLE, MVT::v64i2,   16 },
+    { ISD::VECTOR_SHUFFLE, MVT::v128i2,  14 },
+    { ISD::VECTOR_SHUFFLE, MVT::v32i4,    9 },
+    { ISD::VECTOR_SHUFFLE, MVT::v64i4,    8 },
+  };
+
+  static const CostTblEntry<MVT::SimpleValueType> ParabixReverseTbl[] = {
+    { ISD::VECTOR_SHUFFLE, MVT::v32i1,  161 },
+    { ISD::VECTOR_SHUFFLE, MVT::v64i1,  326 },
+    { ISD::VECTOR_SHUFFLE, MVT::v128i1, 643 },
+    { ISD::VECTOR_SHUFFLE, MVT::v256i1, 1064 },
+    { ISD::VECTOR_SHUFFLE, MVT::v64i2,  366 },
+    { ISD::VECTOR_SHUFFLE, MVT::v128i2, 566 },
+    { ISD::VECTOR_SHUFFLE, MVT::v32i4,  149 },
+    { ISD::VECTOR_SHUFFLE, MVT::v64i4,  250 },
+  };
+
+  if (Kind == SK_Broadcast) {
+    int Idx = CostTableLookup(ParabixBroadcastTbl, ISD::VECTOR_SHUFFLE,
+                              LT.second);
+    if (Idx != -1)
+      return LT.first * ParabixBroadcastTbl[Idx].Cost;
+  } else if (Kind == SK_Reverse) {
+    int Idx = CostTableLookup(ParabixReverseTbl, ISD::VECTOR_SHUFFLE,
+                              LT.second);
+    if (Idx != -1)
+      return LT.first * ParabixReverseTbl[Idx].Cost;
+  }
+
   // We only estimate the cost of reverse shuffles.
   if (Kind != SK_Reverse)
     return TargetTransformInfo::getShuffleCost(Kind, Tp, Index, SubTp);
 
-  std::pair<unsigned, MVT> LT = TLI->getTypeLegalizationCost(Tp);
   unsigned Cost = 1;
   if (LT.second.getSizeInBits() > 128)
     Cost = 3; // Extract + insert + copy.
@@ -458,6 +608,31 @@ unsigned X86TTI::getCastInstrCost(unsigned Opcode, Type *Dst, Type *Src) const {
   if (!SrcTy.isSimple() || !DstTy.isSimple())
     return TargetTransformInfo::getCastInstrCost(Opcode, Dst, Src);
 
+  // Parabix bit vectors to and from one byte per bit.
+  static const TypeConversionCostTblEntry<MVT::SimpleValueType>
+  ParabixConversionTbl[] = {
+    { ISD::SIGN_EXTEND, MVT::v32i8,  MVT::v32i1,  165 },
+    { ISD::SIGN_EXTEND, MVT::v64i8,  MVT::v64i1,  169 },
+    { ISD::SIGN_EXTEND, MVT::v128i8, MVT::v128i1, 340 },
+    { ISD::ZERO_EXTEND, MVT::v32i8,  MVT::v32i1,  159 },
+    { ISD::ZERO_EXTEND, MVT::v64i8,  MVT::v64i1,  163 },
+    { ISD::ZERO_EXTEND, MVT::v128i8, MVT::v128i1, 328 },
+    { ISD::TRUNCATE,    MVT::v32i1,  MVT::v32i8,   95 },
+    { ISD::TRUNCATE,    MVT::v64i1,  MVT::v64i8,  193 },
+    { ISD::TRUNCATE,    MVT::v128i1, MVT::v128i8, 386 },
+  };
+
+  int ParabixIdx = ConvertCostTableLookup(ParabixConversionTbl, ISD,
+                                          DstTy.getSimpleVT(),
+                                          SrcTy.getSimpleVT());
+  if (ParabixIdx != -1)
+    return ParabixConversionTbl[ParabixIdx].Cost;
+
+  // A Parabix vector of 128 or 256 bits moves to GPRs one i64 at a time.
+  if (ISD == ISD::BITCAST && !DstTy.isVector() && SrcTy.isVector() &&
+      SrcTy.getScalarSizeInBits() < 8 && TLI->isTypeLegal(SrcTy))
+    return LTDest.first;
+
   static const TypeConversionCostTblEntry<MVT::SimpleValueType>
   AVX2ConversionTbl[] = {
     { ISD::SIGN_EXTEND, MVT::v16i16, MVT::v16i8,  1 },
@@ -583,6 +758,27 @@ unsigned X86TTI::getCmpSelInstrCost(unsigned Opcode, Type *ValTy,
   int ISD = TLI->InstructionOpcodeToISD(Opcode);
   assert(ISD && "Invalid opcode");
 
+  // Parabix compares and selects. Selects only take an i1 mask of the
+  // same width, which is the IFH1 and / andn / or sequence.
+  static const CostTblEntry<MVT::SimpleValueType> ParabixCostTbl[] = {
+    { ISD::SETCC,   MVT::v32i1,   2 },
+    { ISD::SETCC,   MVT::v64i1,   2 },
+    { ISD::SETCC,   MVT::v128i1,  2 },
+    { ISD::SETCC,   MVT::v256i1,  2 },
+    { ISD::SETCC,   MVT::v64i2,  15 },
+    { ISD::SETCC,   MVT::v128i2, 13 },
+    { ISD::SETCC,   MVT::v32i4,  25 },
+    { ISD::SETCC,   MVT::v64i4,  19 },
+    { ISD::SELECT,  MVT::v32i1,   3 },
+    { ISD::SELECT,  MVT::v64i1,   3 },
+    { ISD::SELECT,  MVT::v128i1,  3 },
+    { ISD::SELECT,  MVT::v256i1,  3 },
+  };
+
+  int ParabixIdx = CostTableLookup(ParabixCostTbl, ISD, MTy);
+  if (ParabixIdx != -1)
+    return LT.first * ParabixCostTbl[ParabixIdx].Cost;
+
   static const CostTblEntry<MVT::SimpleValueType> SSE42CostTbl[] = {
     { ISD::SETCC,   MVT::v2f64,   1 },
     { ISD::SETCC,   MVT::v4f32,   1 },
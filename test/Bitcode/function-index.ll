@@ -0,0 +1,36 @@
+; RUN: llvm-as -enable-bc-function-index < %s | llvm-bcanalyzer -dump | FileCheck %s -check-prefix=BC
+; RUN: llvm-as -enable-bc-function-index < %s | llvm-dis | FileCheck %s
+; RUN: llvm-as < %s | llvm-bcanalyzer -dump | FileCheck %s -check-prefix=NOINDEX
+
+; The index follows the prototypes and has an offset for each of the two
+; bodies, but none for the declaration.
+; BC: <FUNCTION op0=
+; BC: <FUNCTION op0=
+; BC: <FUNCTION op0=
+; BC-NEXT: <FUNCTION_INDEX_BLOCK
+; BC-NEXT: <OFFSETS abbrevid=4 op0={{[1-9][0-9]*}} op1={{[1-9][0-9]*}}/>
+; BC-NEXT: </FUNCTION_INDEX_BLOCK>
+; BC: <FUNCTION_BLOCK
+; BC: <FUNCTION_BLOCK
+
+; NOINDEX-NOT: FUNCTION_INDEX_BLOCK
+
+; CHECK: define i32 @first(i32 %x)
+; CHECK-NEXT: %y = add i32 %x, 1
+; CHECK: declare i32 @external(i32)
+; CHECK: define i32 @second(i32 %x)
+; CHECK-NEXT: %y = call i32 @first(i32 %x)
+; CHECK-NEXT: %z = call i32 @external(i32 %y)
+
+define i32 @first(i32 %x) {
+  %y = add i32 %x, 1
+  ret i32 %y
+}
+
+declare i32 @external(i32)
+
+define i32 @second(i32 %x) {
+  %y = call i32 @first(i32 %x)
+  %z = call i32 @external(i32 %y)
+  ret i32 %z
+}
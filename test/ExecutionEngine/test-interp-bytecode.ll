@@ -0,0 +1,189 @@
+; RUN: %lli -force-interpreter %s | FileCheck %s
+; RUN: %lli -force-interpreter -interpreter-bytecode %s | FileCheck %s
+
+; Runs the same program through the IR interpreter and through the bytecode.
+; @sum_vec uses a vector, so it stays in the IR interpreter even with
+; -interpreter-bytecode, and calls back into @fib.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+%pair = type { i8, i32, [3 x i16] }
+
+@fmt = internal constant [4 x i8] c"%d\0A\00"
+@fmtl = internal constant [6 x i8] c"%lld\0A\00"
+@fmtf = internal constant [4 x i8] c"%g\0A\00"
+@table = global [4 x i32] [i32 10, i32 20, i32 30, i32 40]
+
+declare i32 @printf(i8*, ...)
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8*, i8*, i64, i32, i1)
+declare void @llvm.memset.p0i8.i64(i8*, i8, i64, i32, i1)
+
+define void @print(i32 %x) {
+  %f = getelementptr [4 x i8]* @fmt, i64 0, i64 0
+  %r = call i32 (i8*, ...)* @printf(i8* %f, i32 %x)
+  ret void
+}
+
+define void @printl(i64 %x) {
+  %f = getelementptr [6 x i8]* @fmtl, i64 0, i64 0
+  %r = call i32 (i8*, ...)* @printf(i8* %f, i64 %x)
+  ret void
+}
+
+define i32 @fib(i32 %n) {
+entry:
+  %small = icmp slt i32 %n, 2
+  br i1 %small, label %done, label %rec
+rec:
+  %n1 = sub i32 %n, 1
+  %n2 = sub i32 %n, 2
+  %f1 = call i32 @fib(i32 %n1)
+  %f2 = call i32 @fib(i32 %n2)
+  %s = add i32 %f1, %f2
+  ret i32 %s
+done:
+  ret i32 %n
+}
+
+define i32 @sum_vec(i32 %a) {
+  %v = insertelement <2 x i32> <i32 0, i32 100>, i32 %a, i32 0
+  %x = extractelement <2 x i32> %v, i32 0
+  %y = extractelement <2 x i32> %v, i32 1
+  %f = call i32 @fib(i32 %x)
+  %s = add i32 %f, %y
+  ret i32 %s
+}
+
+; Swaps %a and %b on every iteration, which takes the PHI moves through
+; temporaries.
+define i32 @swap_loop(i32 %n) {
+entry:
+  br label %loop
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i1, %loop ]
+  %a = phi i32 [ 1, %entry ], [ %b, %loop ]
+  %b = phi i32 [ 2, %entry ], [ %a, %loop ]
+  %i1 = add i32 %i, 1
+  %c = icmp ult i32 %i1, %n
+  br i1 %c, label %loop, label %exit
+exit:
+  %r = mul i32 %a, 10
+  %s = add i32 %r, %b
+  ret i32 %s
+}
+
+define i32 @classify(i32 %x) {
+  switch i32 %x, label %other [ i32 1, label %one
+                                i32 7, label %seven ]
+one:
+  br label %join
+seven:
+  br label %join
+other:
+  br label %join
+join:
+  %r = phi i32 [ 100, %one ], [ 700, %seven ], [ -1, %other ]
+  ret i32 %r
+}
+
+define i32 @main() {
+  ; Integer widths wrap and sign-extend.
+  %a8 = add i8 -56, 100
+  %z8 = zext i8 %a8 to i32
+  call void @print(i32 %z8)
+  %s8 = sext i8 %a8 to i32
+  call void @print(i32 %s8)
+  %d16 = sdiv i16 -30000, 7
+  %e16 = sext i16 %d16 to i32
+  call void @print(i32 %e16)
+  %r16 = srem i16 -30000, 7
+  %f16 = sext i16 %r16 to i32
+  call void @print(i32 %f16)
+  %sh = ashr i32 -64, 3
+  call void @print(i32 %sh)
+  %lsh = lshr i32 -64, 28
+  call void @print(i32 %lsh)
+  %shl = shl i64 3, 40
+  call void @printl(i64 %shl)
+  %cmp = icmp sgt i8 -1, 1
+  %cz = zext i1 %cmp to i32
+  call void @print(i32 %cz)
+  %cmpu = icmp ugt i8 -1, 1
+  %cuz = zext i1 %cmpu to i32
+  call void @print(i32 %cuz)
+  %big = mul i64 123456789, 1000003
+  call void @printl(i64 %big)
+; CHECK: 44
+; CHECK-NEXT: 44
+; CHECK-NEXT: -4285
+; CHECK-NEXT: -5
+; CHECK-NEXT: -8
+; CHECK-NEXT: 15
+; CHECK-NEXT: 3298534883328
+; CHECK-NEXT: 0
+; CHECK-NEXT: 1
+; CHECK-NEXT: 123457159370367
+
+  ; Floating point.
+  %fa = fadd double 1.5, 2.25
+  %fm = fmul double %fa, 2.0
+  %fc = fcmp ogt double %fm, 7.0
+  %fs = select i1 %fc, double %fm, double 0.0
+  %ft = fptrunc double %fs to float
+  %fd = fdiv float %ft, 4.0
+  %fe = fpext float %fd to double
+  %ff = getelementptr [4 x i8]* @fmtf, i64 0, i64 0
+  %fp = call i32 (i8*, ...)* @printf(i8* %ff, double %fe)
+  %fi = fptosi double -7.9 to i32
+  call void @print(i32 %fi)
+  %fu = uitofp i8 200 to float
+  %fb = bitcast float %fu to i32
+  call void @print(i32 %fb)
+; CHECK-NEXT: 1.875
+; CHECK-NEXT: -7
+; CHECK-NEXT: 1128792064
+
+  ; Memory: globals, allocas, struct and array GEPs, memcpy and memset.
+  %i = add i64 0, 2
+  %tp = getelementptr [4 x i32]* @table, i64 0, i64 %i
+  %tv = load i32* %tp
+  call void @print(i32 %tv)
+  %p = alloca %pair
+  %p8 = bitcast %pair* %p to i8*
+  call void @llvm.memset.p0i8.i64(i8* %p8, i8 0, i64 16, i32 4, i1 false)
+  %pi = getelementptr %pair* %p, i64 0, i32 2, i64 %i
+  store i16 -2, i16* %pi
+  %q = alloca %pair
+  %q8 = bitcast %pair* %q to i8*
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* %q8, i8* %p8, i64 16, i32 4, i1 false)
+  %qi = getelementptr %pair* %q, i64 0, i32 2, i64 2
+  %qv = load i16* %qi
+  %qz = zext i16 %qv to i32
+  call void @print(i32 %qz)
+  %qa = ptrtoint i16* %qi to i64
+  %qb = ptrtoint %pair* %q to i64
+  %qo = sub i64 %qa, %qb
+  call void @printl(i64 %qo)
+; CHECK-NEXT: 30
+; CHECK-NEXT: 65534
+; CHECK-NEXT: 12
+
+  ; Control flow and calls.
+  %sw = call i32 @swap_loop(i32 4)
+  call void @print(i32 %sw)
+  %c1 = call i32 @classify(i32 7)
+  call void @print(i32 %c1)
+  %c2 = call i32 @classify(i32 3)
+  call void @print(i32 %c2)
+  %fp1 = select i1 true, i32 (i32)* @fib, i32 (i32)* @classify
+  %fibr = call i32 %fp1(i32 15)
+  call void @print(i32 %fibr)
+  %sv = call i32 @sum_vec(i32 10)
+  call void @print(i32 %sv)
+; CHECK-NEXT: 21
+; CHECK-NEXT: 700
+; CHECK-NEXT: -1
+; CHECK-NEXT: 610
+; CHECK-NEXT: 155
+  ret i32 0
+}
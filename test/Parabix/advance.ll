@@ -0,0 +1,115 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 | FileCheck %s -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=-sse2 | FileCheck %s -check-prefix=NOSSE
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -O0 -mattr=-sse2 | FileCheck %s -check-prefix=NOSSE
+
+declare {i64, i64} @llvm.parabix.advance.i64(i64, i64, i32)
+declare {i128, i128} @llvm.parabix.advance.i128(i128, i128, i32)
+declare {i256, i256} @llvm.parabix.advance.i256(i256, i256, i32)
+declare {i512, i512} @llvm.parabix.advance.i512(i512, i512, i32)
+
+define void @advance_i128(<2 x i64>* %p, <2 x i64>* %q) {
+  %a = load <2 x i64>* %p
+  %s = bitcast <2 x i64> %a to i128
+  %b = load <2 x i64>* %q
+  %c = bitcast <2 x i64> %b to i128
+  %r = call {i128, i128} @llvm.parabix.advance.i128(i128 %s, i128 %c, i32 3)
+  %v = extractvalue {i128, i128} %r, 0
+  %co = extractvalue {i128, i128} %r, 1
+  %vv = bitcast i128 %v to <2 x i64>
+  %cc = bitcast i128 %co to <2 x i64>
+  store <2 x i64> %vv, <2 x i64>* %p
+  store <2 x i64> %cc, <2 x i64>* %q
+  ret void
+}
+; SSE2-LABEL: advance_i128:
+; SSE2-DAG: psrlq $61
+; SSE2-DAG: psllq $3
+; SSE2: por
+; SSE2-NOT: shldq
+; NOSSE-LABEL: advance_i128:
+; NOSSE: shldq $3
+; NOSSE: retq
+
+define void @advance_i256(<4 x i64>* %p, <4 x i64>* %q) {
+  %a = load <4 x i64>* %p
+  %s = bitcast <4 x i64> %a to i256
+  %b = load <4 x i64>* %q
+  %c = bitcast <4 x i64> %b to i256
+  %r = call {i256, i256} @llvm.parabix.advance.i256(i256 %s, i256 %c, i32 65)
+  %v = extractvalue {i256, i256} %r, 0
+  %vv = bitcast i256 %v to <4 x i64>
+  store <4 x i64> %vv, <4 x i64>* %p
+  ret void
+}
+; AVX2-LABEL: advance_i256:
+; AVX2: vinsertf128
+; AVX2-DAG: vpsllq $1, %ymm
+; AVX2-DAG: vpsrlq $63, %ymm
+; AVX2: vpor
+; AVX2-NOT: shldq
+
+define void @advance_i512_var(<8 x i64>* %p, <8 x i64>* %q, i32 %n) {
+  %a = load <8 x i64>* %p
+  %s = bitcast <8 x i64> %a to i512
+  %b = load <8 x i64>* %q
+  %c = bitcast <8 x i64> %b to i512
+  %r = call {i512, i512} @llvm.parabix.advance.i512(i512 %s, i512 %c, i32 %n)
+  %v = extractvalue {i512, i512} %r, 0
+  %vv = bitcast i512 %v to <8 x i64>
+  store <8 x i64> %vv, <8 x i64>* %p
+  ret void
+}
+; SSE2-LABEL: advance_i512_var:
+; SSE2: movdqu
+; SSE2: psrlq %xmm
+; SSE2: psllq %xmm
+; SSE2-NOT: shlq %cl
+; AVX2-LABEL: advance_i512_var:
+; AVX2: vmovdqu {{.*}}, %ymm
+; AVX2: vpsrlq %xmm{{[0-9]+}}, %ymm
+; AVX2: vpsllq %xmm{{[0-9]+}}, %ymm
+; AVX2-NOT: shlq %cl
+
+; Widths the target has no long stream lowering for are plain shifts, with
+; Shift == N selecting the carry.
+define i64 @advance_i64(i64 %s, i64 %c) {
+  %r = call {i64, i64} @llvm.parabix.advance.i64(i64 %s, i64 %c, i32 5)
+  %v = extractvalue {i64, i64} %r, 0
+  ret i64 %v
+}
+; SSE2-LABEL: advance_i64:
+; SSE2: shldq $5
+; AVX2-LABEL: advance_i64:
+; AVX2: shldq $5
+; NOSSE-LABEL: advance_i64:
+; NOSSE: shldq $5
+
+define i64 @advance_i64_var(i64 %s, i64 %c, i32 %n, i64* %co) {
+  %r = call {i64, i64} @llvm.parabix.advance.i64(i64 %s, i64 %c, i32 %n)
+  %v = extractvalue {i64, i64} %r, 0
+  %x = extractvalue {i64, i64} %r, 1
+  store i64 %x, i64* %co
+  ret i64 %v
+}
+; SSE2-LABEL: advance_i64_var:
+; SSE2: shlq %cl
+; SSE2: shrq %cl
+; SSE2: cmpl $64
+; SSE2: cmoveq
+; NOSSE-LABEL: advance_i64_var:
+; NOSSE: shlq %cl
+; NOSSE: shrq %cl
+
+define void @advance_i128_var(i128* %sp, i128* %cp, i32 %n, i128* %out) {
+  %s = load i128* %sp
+  %c = load i128* %cp
+  %r = call {i128, i128} @llvm.parabix.advance.i128(i128 %s, i128 %c, i32 %n)
+  %v = extractvalue {i128, i128} %r, 0
+  store i128 %v, i128* %out
+  ret void
+}
+; NOSSE-LABEL: advance_i128_var:
+; NOSSE: shldq %cl
+; NOSSE: shrdq %cl
+; NOSSE: retq
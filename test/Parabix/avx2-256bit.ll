@@ -0,0 +1,68 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-unknown -mattr=+avx2 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-unknown-unknown -mattr=+avx | FileCheck %s -check-prefix=AVX1
+
+; 256-bit parabix vectors live in YMM registers on AVX2, so logic ops on them
+; are a single instruction.
+
+define <256 x i1> @xor_v256i1(<256 x i1> %a, <256 x i1> %b) {
+; CHECK-LABEL: xor_v256i1:
+; CHECK: {{vxorps|vpxor}} %ymm1, %ymm0, %ymm0
+; CHECK-NEXT: ret
+; Without AVX2 the vector is split into two XMM halves.
+; AVX1-LABEL: xor_v256i1:
+; AVX1: vxorps %xmm2, %xmm0, %xmm0
+; AVX1: vxorps %xmm3, %xmm1, %xmm1
+  %r = xor <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+
+define <256 x i1> @add_v256i1(<256 x i1> %a, <256 x i1> %b) {
+; CHECK-LABEL: add_v256i1:
+; CHECK: {{vxorps|vpxor}} %ymm1, %ymm0, %ymm0
+; CHECK-NEXT: ret
+  %r = add <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+
+define <256 x i1> @and_v256i1(<256 x i1> %a, <256 x i1> %b) {
+; CHECK-LABEL: and_v256i1:
+; CHECK: {{vandps|vpand}} %ymm1, %ymm0, %ymm0
+; CHECK-NEXT: ret
+  %r = and <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+
+define <128 x i2> @or_v128i2(<128 x i2> %a, <128 x i2> %b) {
+; CHECK-LABEL: or_v128i2:
+; CHECK: {{vorps|vpor}} %ymm1, %ymm0, %ymm0
+; CHECK-NEXT: ret
+  %r = or <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+
+define <128 x i2> @add_v128i2(<128 x i2> %a, <128 x i2> %b) {
+; CHECK-LABEL: add_v128i2:
+; CHECK-NOT: xmm
+; CHECK: vpsllq $1, {{.*}}%ymm
+; CHECK-NOT: xmm
+; CHECK: ret
+  %r = add <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+
+define <64 x i4> @add_v64i4(<64 x i4> %a, <64 x i4> %b) {
+; CHECK-LABEL: add_v64i4:
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: ret
+  %r = add <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+
+define void @store_v256i1(<256 x i1>* %p, <256 x i1> %a, <256 x i1> %b) {
+; CHECK-LABEL: store_v256i1:
+; CHECK: {{vxorps|vpxor}} %ymm1, %ymm0, [[R:%ymm[0-9]+]]
+; CHECK: vmov{{.*}} [[R]], (%rdi)
+  %r = xor <256 x i1> %a, %b
+  store <256 x i1> %r, <256 x i1>* %p
+  ret void
+}
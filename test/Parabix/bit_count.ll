@@ -0,0 +1,96 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+ssse3 | FileCheck %s -check-prefix=SSSE3
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+popcnt,+bmi,+lzcnt | FileCheck %s -check-prefix=AVX2
+
+declare i128 @llvm.ctpop.i128(i128)
+declare i256 @llvm.ctpop.i256(i256)
+declare i256 @llvm.cttz.i256(i256, i1)
+declare i128 @llvm.ctlz.i128(i128, i1)
+
+define i128 @popcount_i128(<128 x i1> %a, <128 x i1> %b) {
+  %c = and <128 x i1> %a, %b
+  %x = bitcast <128 x i1> %c to i128
+  %r = call i128 @llvm.ctpop.i128(i128 %x)
+  ret i128 %r
+}
+; SSE2-LABEL: popcount_i128:
+; SSE2-NOT: imul
+; SSE2: psadbw
+; SSE2: punpckhqdq
+; SSE2: paddq
+; SSE2: xorl %edx, %edx
+; SSSE3-LABEL: popcount_i128:
+; SSSE3: pshufb
+; SSSE3: pshufb
+; SSSE3: psadbw
+; AVX2-LABEL: popcount_i128:
+; AVX2: popcntq
+; AVX2: popcntq
+; AVX2: addq
+
+define void @popcount_i256(i256* %p, i256* %o) {
+  %x = load i256* %p
+  %r = call i256 @llvm.ctpop.i256(i256 %x)
+  store i256 %r, i256* %o
+  ret void
+}
+; AVX2-LABEL: popcount_i256:
+; AVX2: popcntq
+; AVX2: popcntq
+; AVX2: popcntq
+; AVX2: popcntq
+; AVX2-NOT: sbbq
+; AVX2: movq $0
+
+define i256 @cttz_i256(<256 x i1> %a) {
+  %x = bitcast <256 x i1> %a to i256
+  %r = call i256 @llvm.cttz.i256(i256 %x, i1 false)
+  ret i256 %r
+}
+; AVX2-LABEL: cttz_i256:
+; AVX2: tzcntq
+; AVX2: tzcntq
+; AVX2: tzcntq
+; AVX2: tzcntq
+; AVX2-NOT: sbbq
+; AVX2: retq
+
+define i128 @ctlz_i128(<2 x i64> %a) {
+  %x = bitcast <2 x i64> %a to i128
+  %r = call i128 @llvm.ctlz.i128(i128 %x, i1 false)
+  ret i128 %r
+}
+; AVX2-LABEL: ctlz_i128:
+; AVX2: lzcntq
+; AVX2: lzcntq
+; AVX2: cmov
+
+define i1 @any_i128(<128 x i1> %a, <128 x i1> %b) {
+  %c = and <128 x i1> %a, %b
+  %x = bitcast <128 x i1> %c to i128
+  %r = icmp ne i128 %x, 0
+  ret i1 %r
+}
+; SSE2-LABEL: any_i128:
+; SSE2: pcmpeqb
+; SSE2-NEXT: pmovmskb
+; SSE2-NEXT: cmpl $65535
+; SSE2-NEXT: setne
+; AVX2-LABEL: any_i128:
+; AVX2: vptest %xmm0, %xmm0
+; AVX2-NEXT: setne
+
+define i1 @none_i256(<4 x i64> %a) {
+  %x = bitcast <4 x i64> %a to i256
+  %r = icmp eq i256 %x, 0
+  ret i1 %r
+}
+; SSE2-LABEL: none_i256:
+; SSE2: por
+; SSE2: pcmpeqb
+; SSE2-NEXT: pmovmskb
+; SSE2-NEXT: cmpl $65535
+; SSE2-NEXT: sete
+; AVX2-LABEL: none_i256:
+; AVX2: vptest %ymm0, %ymm0
+; AVX2-NEXT: sete
@@ -0,0 +1,165 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+bmi,+bmi2 | FileCheck %s -check-prefix=BMI
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s -check-prefix=NOBMI
+
+; Bit stream idioms on v32i1 / v64i1 (GR32X / GR64X) select to BMI1 and
+; BMI2 instructions.
+
+define <64 x i1> @andn64(<64 x i1> %b, <64 x i1>* %p) {
+  %a = load <64 x i1>* %p
+  %nb = xor <64 x i1> %b, <i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                           i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                           i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                           i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                           i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                           i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                           i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                           i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1>
+  %r = and <64 x i1> %a, %nb
+  ret <64 x i1> %r
+}
+; BMI-LABEL: andn64:
+; BMI: andnq (%rsi), %rdi, %rax
+; BMI-NEXT: retq
+
+define <32 x i1> @shl32(<32 x i1> %a, <32 x i1> %b) {
+  %r = shl <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; BMI-LABEL: shl32:
+; BMI: andnl %edi, %esi, %eax
+; BMI-NEXT: retq
+
+define <64 x i1> @lshr64(<64 x i1> %a, <64 x i1> %b) {
+  %r = lshr <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; BMI-LABEL: lshr64:
+; BMI: andnq %rdi, %rsi, %rax
+; BMI-NEXT: retq
+
+define <32 x i1> @slt32(<32 x i1> %a, <32 x i1> %b) {
+  %r = icmp slt <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; BMI-LABEL: slt32:
+; BMI: andnl %edi, %esi, %eax
+; BMI-NEXT: retq
+
+define <64 x i1> @ult64(<64 x i1> %a, <64 x i1> %b) {
+  %r = icmp ult <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; BMI-LABEL: ult64:
+; BMI: andnq %rsi, %rdi, %rax
+; BMI-NEXT: retq
+
+define <64 x i1> @blsr64(<64 x i1>* %p) {
+  %a = load <64 x i1>* %p
+  %i = bitcast <64 x i1> %a to i64
+  %m = add i64 %i, -1
+  %mv = bitcast i64 %m to <64 x i1>
+  %r = and <64 x i1> %a, %mv
+  ret <64 x i1> %r
+}
+; BMI-LABEL: blsr64:
+; BMI: blsrq (%rdi), %rax
+; BMI-NEXT: retq
+
+define <32 x i1> @blsi32(<32 x i1> %a) {
+  %i = bitcast <32 x i1> %a to i32
+  %m = sub i32 0, %i
+  %mv = bitcast i32 %m to <32 x i1>
+  %r = and <32 x i1> %a, %mv
+  ret <32 x i1> %r
+}
+; BMI-LABEL: blsi32:
+; BMI: blsil %edi, %eax
+; BMI-NEXT: retq
+
+define <64 x i1> @blsmsk64(<64 x i1> %a) {
+  %i = bitcast <64 x i1> %a to i64
+  %m = add i64 %i, -1
+  %mv = bitcast i64 %m to <64 x i1>
+  %r = xor <64 x i1> %a, %mv
+  ret <64 x i1> %r
+}
+; BMI-LABEL: blsmsk64:
+; BMI: blsmskq %rdi, %rax
+; BMI-NEXT: retq
+
+; esimd<1>::packl / packh are bit extracts, mergel / mergeh bit deposits.
+
+define <32 x i1> @packl32(<32 x i1> %a, <32 x i1> %b) {
+  %r = shufflevector <32 x i1> %a, <32 x i1> %b, <32 x i32> <i32 0, i32 2, i32 4, i32 6, i32 8, i32 10, i32 12, i32 14,
+                                                             i32 16, i32 18, i32 20, i32 22, i32 24, i32 26, i32 28, i32 30,
+                                                             i32 32, i32 34, i32 36, i32 38, i32 40, i32 42, i32 44, i32 46,
+                                                             i32 48, i32 50, i32 52, i32 54, i32 56, i32 58, i32 60, i32 62>
+  ret <32 x i1> %r
+}
+; BMI-LABEL: packl32:
+; BMI: movl $1431655765, [[M:%e[a-z]+]]
+; BMI-NEXT: pextl [[M]], %edi
+; BMI-NEXT: pextl [[M]], %esi
+; BMI-NEXT: shll $16
+; BMI-NEXT: orl
+; BMI-NEXT: retq
+; NOBMI-LABEL: packl32:
+; NOBMI-NOT: pext
+; NOBMI: retq
+
+define <64 x i1> @packh64(<64 x i1> %a, <64 x i1> %b) {
+  %r = shufflevector <64 x i1> %a, <64 x i1> %b, <64 x i32> <i32 1, i32 3, i32 5, i32 7, i32 9, i32 11, i32 13, i32 15,
+                                                             i32 17, i32 19, i32 21, i32 23, i32 25, i32 27, i32 29, i32 31,
+                                                             i32 33, i32 35, i32 37, i32 39, i32 41, i32 43, i32 45, i32 47,
+                                                             i32 49, i32 51, i32 53, i32 55, i32 57, i32 59, i32 61, i32 63,
+                                                             i32 65, i32 67, i32 69, i32 71, i32 73, i32 75, i32 77, i32 79,
+                                                             i32 81, i32 83, i32 85, i32 87, i32 89, i32 91, i32 93, i32 95,
+                                                             i32 97, i32 99, i32 101, i32 103, i32 105, i32 107, i32 109, i32 111,
+                                                             i32 113, i32 115, i32 117, i32 119, i32 121, i32 123, i32 125, i32 127>
+  ret <64 x i1> %r
+}
+; BMI-LABEL: packh64:
+; BMI: movabsq $-6148914691236517206, [[M:%r[a-z]+]]
+; BMI-NEXT: pextq [[M]], %rdi
+; BMI-NEXT: pextq [[M]], %rsi
+; BMI-NEXT: shlq $32
+; BMI-NEXT: orq
+; BMI-NEXT: retq
+
+define <64 x i1> @mergel64(<64 x i1> %a, <64 x i1> %b) {
+  %r = shufflevector <64 x i1> %a, <64 x i1> %b, <64 x i32> <i32 0, i32 64, i32 1, i32 65, i32 2, i32 66, i32 3, i32 67,
+                                                             i32 4, i32 68, i32 5, i32 69, i32 6, i32 70, i32 7, i32 71,
+                                                             i32 8, i32 72, i32 9, i32 73, i32 10, i32 74, i32 11, i32 75,
+                                                             i32 12, i32 76, i32 13, i32 77, i32 14, i32 78, i32 15, i32 79,
+                                                             i32 16, i32 80, i32 17, i32 81, i32 18, i32 82, i32 19, i32 83,
+                                                             i32 20, i32 84, i32 21, i32 85, i32 22, i32 86, i32 23, i32 87,
+                                                             i32 24, i32 88, i32 25, i32 89, i32 26, i32 90, i32 27, i32 91,
+                                                             i32 28, i32 92, i32 29, i32 93, i32 30, i32 94, i32 31, i32 95>
+  ret <64 x i1> %r
+}
+; BMI-LABEL: mergel64:
+; BMI: pdepq {{%r[a-z]+}}, %rsi
+; BMI-NEXT: movabsq
+; BMI-NEXT: pdepq {{%r[a-z]+}}, %rdi
+; BMI-NEXT: orq
+; BMI-NEXT: retq
+; NOBMI-LABEL: mergel64:
+; NOBMI-NOT: pdep
+; NOBMI: retq
+
+define <32 x i1> @mergeh32(<32 x i1> %a, <32 x i1> %b) {
+  %r = shufflevector <32 x i1> %a, <32 x i1> %b, <32 x i32> <i32 16, i32 48, i32 17, i32 49, i32 18, i32 50, i32 19, i32 51,
+                                                             i32 20, i32 52, i32 21, i32 53, i32 22, i32 54, i32 23, i32 55,
+                                                             i32 24, i32 56, i32 25, i32 57, i32 26, i32 58, i32 27, i32 59,
+                                                             i32 28, i32 60, i32 29, i32 61, i32 30, i32 62, i32 31, i32 63>
+  ret <32 x i1> %r
+}
+; BMI-LABEL: mergeh32:
+; BMI: shrl $16, %esi
+; BMI-NEXT: movl
+; BMI-NEXT: pdepl
+; BMI-NEXT: shrl $16, %edi
+; BMI-NEXT: movl
+; BMI-NEXT: pdepl
+; BMI-NEXT: orl
+; BMI-NEXT: retq
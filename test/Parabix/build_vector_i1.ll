@@ -0,0 +1,752 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | grep pmovmskb | count 3
+
+; 32 variable bits are gathered 16 at a time and combined in a GPR.
+define void @build_v32i1_var(i8* %in, <32 x i1>* %out) {
+entry:
+  ;CHECK-LABEL: build_v32i1_var
+  %p0 = getelementptr i8* %in, i32 0
+  %l0 = load i8* %p0
+  %t0 = trunc i8 %l0 to i1
+  %v0 = insertelement <32 x i1> undef, i1 %t0, i32 0
+  %p1 = getelementptr i8* %in, i32 1
+  %l1 = load i8* %p1
+  %t1 = trunc i8 %l1 to i1
+  %v1 = insertelement <32 x i1> %v0, i1 %t1, i32 1
+  %p2 = getelementptr i8* %in, i32 2
+  %l2 = load i8* %p2
+  %t2 = trunc i8 %l2 to i1
+  %v2 = insertelement <32 x i1> %v1, i1 %t2, i32 2
+  %p3 = getelementptr i8* %in, i32 3
+  %l3 = load i8* %p3
+  %t3 = trunc i8 %l3 to i1
+  %v3 = insertelement <32 x i1> %v2, i1 %t3, i32 3
+  %p4 = getelementptr i8* %in, i32 4
+  %l4 = load i8* %p4
+  %t4 = trunc i8 %l4 to i1
+  %v4 = insertelement <32 x i1> %v3, i1 %t4, i32 4
+  %p5 = getelementptr i8* %in, i32 5
+  %l5 = load i8* %p5
+  %t5 = trunc i8 %l5 to i1
+  %v5 = insertelement <32 x i1> %v4, i1 %t5, i32 5
+  %p6 = getelementptr i8* %in, i32 6
+  %l6 = load i8* %p6
+  %t6 = trunc i8 %l6 to i1
+  %v6 = insertelement <32 x i1> %v5, i1 %t6, i32 6
+  %p7 = getelementptr i8* %in, i32 7
+  %l7 = load i8* %p7
+  %t7 = trunc i8 %l7 to i1
+  %v7 = insertelement <32 x i1> %v6, i1 %t7, i32 7
+  %p8 = getelementptr i8* %in, i32 8
+  %l8 = load i8* %p8
+  %t8 = trunc i8 %l8 to i1
+  %v8 = insertelement <32 x i1> %v7, i1 %t8, i32 8
+  %p9 = getelementptr i8* %in, i32 9
+  %l9 = load i8* %p9
+  %t9 = trunc i8 %l9 to i1
+  %v9 = insertelement <32 x i1> %v8, i1 %t9, i32 9
+  %p10 = getelementptr i8* %in, i32 10
+  %l10 = load i8* %p10
+  %t10 = trunc i8 %l10 to i1
+  %v10 = insertelement <32 x i1> %v9, i1 %t10, i32 10
+  %p11 = getelementptr i8* %in, i32 11
+  %l11 = load i8* %p11
+  %t11 = trunc i8 %l11 to i1
+  %v11 = insertelement <32 x i1> %v10, i1 %t11, i32 11
+  %p12 = getelementptr i8* %in, i32 12
+  %l12 = load i8* %p12
+  %t12 = trunc i8 %l12 to i1
+  %v12 = insertelement <32 x i1> %v11, i1 %t12, i32 12
+  %p13 = getelementptr i8* %in, i32 13
+  %l13 = load i8* %p13
+  %t13 = trunc i8 %l13 to i1
+  %v13 = insertelement <32 x i1> %v12, i1 %t13, i32 13
+  %p14 = getelementptr i8* %in, i32 14
+  %l14 = load i8* %p14
+  %t14 = trunc i8 %l14 to i1
+  %v14 = insertelement <32 x i1> %v13, i1 %t14, i32 14
+  %p15 = getelementptr i8* %in, i32 15
+  %l15 = load i8* %p15
+  %t15 = trunc i8 %l15 to i1
+  %v15 = insertelement <32 x i1> %v14, i1 %t15, i32 15
+  %p16 = getelementptr i8* %in, i32 16
+  %l16 = load i8* %p16
+  %t16 = trunc i8 %l16 to i1
+  %v16 = insertelement <32 x i1> %v15, i1 %t16, i32 16
+  %p17 = getelementptr i8* %in, i32 17
+  %l17 = load i8* %p17
+  %t17 = trunc i8 %l17 to i1
+  %v17 = insertelement <32 x i1> %v16, i1 %t17, i32 17
+  %p18 = getelementptr i8* %in, i32 18
+  %l18 = load i8* %p18
+  %t18 = trunc i8 %l18 to i1
+  %v18 = insertelement <32 x i1> %v17, i1 %t18, i32 18
+  %p19 = getelementptr i8* %in, i32 19
+  %l19 = load i8* %p19
+  %t19 = trunc i8 %l19 to i1
+  %v19 = insertelement <32 x i1> %v18, i1 %t19, i32 19
+  %p20 = getelementptr i8* %in, i32 20
+  %l20 = load i8* %p20
+  %t20 = trunc i8 %l20 to i1
+  %v20 = insertelement <32 x i1> %v19, i1 %t20, i32 20
+  %p21 = getelementptr i8* %in, i32 21
+  %l21 = load i8* %p21
+  %t21 = trunc i8 %l21 to i1
+  %v21 = insertelement <32 x i1> %v20, i1 %t21, i32 21
+  %p22 = getelementptr i8* %in, i32 22
+  %l22 = load i8* %p22
+  %t22 = trunc i8 %l22 to i1
+  %v22 = insertelement <32 x i1> %v21, i1 %t22, i32 22
+  %p23 = getelementptr i8* %in, i32 23
+  %l23 = load i8* %p23
+  %t23 = trunc i8 %l23 to i1
+  %v23 = insertelement <32 x i1> %v22, i1 %t23, i32 23
+  %p24 = getelementptr i8* %in, i32 24
+  %l24 = load i8* %p24
+  %t24 = trunc i8 %l24 to i1
+  %v24 = insertelement <32 x i1> %v23, i1 %t24, i32 24
+  %p25 = getelementptr i8* %in, i32 25
+  %l25 = load i8* %p25
+  %t25 = trunc i8 %l25 to i1
+  %v25 = insertelement <32 x i1> %v24, i1 %t25, i32 25
+  %p26 = getelementptr i8* %in, i32 26
+  %l26 = load i8* %p26
+  %t26 = trunc i8 %l26 to i1
+  %v26 = insertelement <32 x i1> %v25, i1 %t26, i32 26
+  %p27 = getelementptr i8* %in, i32 27
+  %l27 = load i8* %p27
+  %t27 = trunc i8 %l27 to i1
+  %v27 = insertelement <32 x i1> %v26, i1 %t27, i32 27
+  %p28 = getelementptr i8* %in, i32 28
+  %l28 = load i8* %p28
+  %t28 = trunc i8 %l28 to i1
+  %v28 = insertelement <32 x i1> %v27, i1 %t28, i32 28
+  %p29 = getelementptr i8* %in, i32 29
+  %l29 = load i8* %p29
+  %t29 = trunc i8 %l29 to i1
+  %v29 = insertelement <32 x i1> %v28, i1 %t29, i32 29
+  %p30 = getelementptr i8* %in, i32 30
+  %l30 = load i8* %p30
+  %t30 = trunc i8 %l30 to i1
+  %v30 = insertelement <32 x i1> %v29, i1 %t30, i32 30
+  %p31 = getelementptr i8* %in, i32 31
+  %l31 = load i8* %p31
+  %t31 = trunc i8 %l31 to i1
+  %v31 = insertelement <32 x i1> %v30, i1 %t31, i32 31
+  store <32 x i1> %v31, <32 x i1>* %out
+  ;CHECK: psllw $7
+  ;CHECK: pmovmskb
+  ;CHECK: psllw $7
+  ;CHECK: pmovmskb
+  ;CHECK: orl
+  ;CHECK-NOT: pextrw
+  ;CHECK: ret
+  ret void
+}
+
+; Constant lanes inside a gathered chunk are merged in as an immediate and the
+; all-constant chunks come from the constant pool.
+define void @build_v128i1_chunk(i8* %in, <128 x i1>* %out) {
+entry:
+  ;CHECK-LABEL: build_v128i1_chunk
+  %p0 = getelementptr i8* %in, i32 0
+  %l0 = load i8* %p0
+  %t0 = trunc i8 %l0 to i1
+  %v0 = insertelement <128 x i1> undef, i1 %t0, i32 0
+  %p1 = getelementptr i8* %in, i32 1
+  %l1 = load i8* %p1
+  %t1 = trunc i8 %l1 to i1
+  %v1 = insertelement <128 x i1> %v0, i1 %t1, i32 1
+  %p2 = getelementptr i8* %in, i32 2
+  %l2 = load i8* %p2
+  %t2 = trunc i8 %l2 to i1
+  %v2 = insertelement <128 x i1> %v1, i1 %t2, i32 2
+  %v3 = insertelement <128 x i1> %v2, i1 true, i32 3
+  %p4 = getelementptr i8* %in, i32 4
+  %l4 = load i8* %p4
+  %t4 = trunc i8 %l4 to i1
+  %v4 = insertelement <128 x i1> %v3, i1 %t4, i32 4
+  %p5 = getelementptr i8* %in, i32 5
+  %l5 = load i8* %p5
+  %t5 = trunc i8 %l5 to i1
+  %v5 = insertelement <128 x i1> %v4, i1 %t5, i32 5
+  %p6 = getelementptr i8* %in, i32 6
+  %l6 = load i8* %p6
+  %t6 = trunc i8 %l6 to i1
+  %v6 = insertelement <128 x i1> %v5, i1 %t6, i32 6
+  %p7 = getelementptr i8* %in, i32 7
+  %l7 = load i8* %p7
+  %t7 = trunc i8 %l7 to i1
+  %v7 = insertelement <128 x i1> %v6, i1 %t7, i32 7
+  %p8 = getelementptr i8* %in, i32 8
+  %l8 = load i8* %p8
+  %t8 = trunc i8 %l8 to i1
+  %v8 = insertelement <128 x i1> %v7, i1 %t8, i32 8
+  %v9 = insertelement <128 x i1> %v8, i1 true, i32 9
+  %p10 = getelementptr i8* %in, i32 10
+  %l10 = load i8* %p10
+  %t10 = trunc i8 %l10 to i1
+  %v10 = insertelement <128 x i1> %v9, i1 %t10, i32 10
+  %p11 = getelementptr i8* %in, i32 11
+  %l11 = load i8* %p11
+  %t11 = trunc i8 %l11 to i1
+  %v11 = insertelement <128 x i1> %v10, i1 %t11, i32 11
+  %v12 = insertelement <128 x i1> %v11, i1 false, i32 12
+  %p13 = getelementptr i8* %in, i32 13
+  %l13 = load i8* %p13
+  %t13 = trunc i8 %l13 to i1
+  %v13 = insertelement <128 x i1> %v12, i1 %t13, i32 13
+  %p14 = getelementptr i8* %in, i32 14
+  %l14 = load i8* %p14
+  %t14 = trunc i8 %l14 to i1
+  %v14 = insertelement <128 x i1> %v13, i1 %t14, i32 14
+  %p15 = getelementptr i8* %in, i32 15
+  %l15 = load i8* %p15
+  %t15 = trunc i8 %l15 to i1
+  %v15 = insertelement <128 x i1> %v14, i1 %t15, i32 15
+  %v16 = insertelement <128 x i1> %v15, i1 true, i32 16
+  %v17 = insertelement <128 x i1> %v16, i1 false, i32 17
+  %v18 = insertelement <128 x i1> %v17, i1 false, i32 18
+  %v19 = insertelement <128 x i1> %v18, i1 true, i32 19
+  %v20 = insertelement <128 x i1> %v19, i1 false, i32 20
+  %v21 = insertelement <128 x i1> %v20, i1 false, i32 21
+  %v22 = insertelement <128 x i1> %v21, i1 true, i32 22
+  %v23 = insertelement <128 x i1> %v22, i1 false, i32 23
+  %v24 = insertelement <128 x i1> %v23, i1 false, i32 24
+  %v25 = insertelement <128 x i1> %v24, i1 true, i32 25
+  %v26 = insertelement <128 x i1> %v25, i1 false, i32 26
+  %v27 = insertelement <128 x i1> %v26, i1 false, i32 27
+  %v28 = insertelement <128 x i1> %v27, i1 true, i32 28
+  %v29 = insertelement <128 x i1> %v28, i1 false, i32 29
+  %v30 = insertelement <128 x i1> %v29, i1 false, i32 30
+  %v31 = insertelement <128 x i1> %v30, i1 true, i32 31
+  %v32 = insertelement <128 x i1> %v31, i1 false, i32 32
+  %v33 = insertelement <128 x i1> %v32, i1 false, i32 33
+  %v34 = insertelement <128 x i1> %v33, i1 true, i32 34
+  %v35 = insertelement <128 x i1> %v34, i1 false, i32 35
+  %v36 = insertelement <128 x i1> %v35, i1 false, i32 36
+  %v37 = insertelement <128 x i1> %v36, i1 true, i32 37
+  %v38 = insertelement <128 x i1> %v37, i1 false, i32 38
+  %v39 = insertelement <128 x i1> %v38, i1 false, i32 39
+  %v40 = insertelement <128 x i1> %v39, i1 true, i32 40
+  %v41 = insertelement <128 x i1> %v40, i1 false, i32 41
+  %v42 = insertelement <128 x i1> %v41, i1 false, i32 42
+  %v43 = insertelement <128 x i1> %v42, i1 true, i32 43
+  %v44 = insertelement <128 x i1> %v43, i1 false, i32 44
+  %v45 = insertelement <128 x i1> %v44, i1 false, i32 45
+  %v46 = insertelement <128 x i1> %v45, i1 true, i32 46
+  %v47 = insertelement <128 x i1> %v46, i1 false, i32 47
+  %v48 = insertelement <128 x i1> %v47, i1 false, i32 48
+  %v49 = insertelement <128 x i1> %v48, i1 true, i32 49
+  %v50 = insertelement <128 x i1> %v49, i1 false, i32 50
+  %v51 = insertelement <128 x i1> %v50, i1 false, i32 51
+  %v52 = insertelement <128 x i1> %v51, i1 true, i32 52
+  %v53 = insertelement <128 x i1> %v52, i1 false, i32 53
+  %v54 = insertelement <128 x i1> %v53, i1 false, i32 54
+  %v55 = insertelement <128 x i1> %v54, i1 true, i32 55
+  %v56 = insertelement <128 x i1> %v55, i1 false, i32 56
+  %v57 = insertelement <128 x i1> %v56, i1 false, i32 57
+  %v58 = insertelement <128 x i1> %v57, i1 true, i32 58
+  %v59 = insertelement <128 x i1> %v58, i1 false, i32 59
+  %v60 = insertelement <128 x i1> %v59, i1 false, i32 60
+  %v61 = insertelement <128 x i1> %v60, i1 true, i32 61
+  %v62 = insertelement <128 x i1> %v61, i1 false, i32 62
+  %v63 = insertelement <128 x i1> %v62, i1 false, i32 63
+  %v64 = insertelement <128 x i1> %v63, i1 true, i32 64
+  %v65 = insertelement <128 x i1> %v64, i1 false, i32 65
+  %v66 = insertelement <128 x i1> %v65, i1 false, i32 66
+  %v67 = insertelement <128 x i1> %v66, i1 true, i32 67
+  %v68 = insertelement <128 x i1> %v67, i1 false, i32 68
+  %v69 = insertelement <128 x i1> %v68, i1 false, i32 69
+  %v70 = insertelement <128 x i1> %v69, i1 true, i32 70
+  %v71 = insertelement <128 x i1> %v70, i1 false, i32 71
+  %v72 = insertelement <128 x i1> %v71, i1 false, i32 72
+  %v73 = insertelement <128 x i1> %v72, i1 true, i32 73
+  %v74 = insertelement <128 x i1> %v73, i1 false, i32 74
+  %v75 = insertelement <128 x i1> %v74, i1 false, i32 75
+  %v76 = insertelement <128 x i1> %v75, i1 true, i32 76
+  %v77 = insertelement <128 x i1> %v76, i1 false, i32 77
+  %v78 = insertelement <128 x i1> %v77, i1 false, i32 78
+  %v79 = insertelement <128 x i1> %v78, i1 true, i32 79
+  %v80 = insertelement <128 x i1> %v79, i1 false, i32 80
+  %v81 = insertelement <128 x i1> %v80, i1 false, i32 81
+  %v82 = insertelement <128 x i1> %v81, i1 true, i32 82
+  %v83 = insertelement <128 x i1> %v82, i1 false, i32 83
+  %v84 = insertelement <128 x i1> %v83, i1 false, i32 84
+  %v85 = insertelement <128 x i1> %v84, i1 true, i32 85
+  %v86 = insertelement <128 x i1> %v85, i1 false, i32 86
+  %v87 = insertelement <128 x i1> %v86, i1 false, i32 87
+  %v88 = insertelement <128 x i1> %v87, i1 true, i32 88
+  %v89 = insertelement <128 x i1> %v88, i1 false, i32 89
+  %v90 = insertelement <128 x i1> %v89, i1 false, i32 90
+  %v91 = insertelement <128 x i1> %v90, i1 true, i32 91
+  %v92 = insertelement <128 x i1> %v91, i1 false, i32 92
+  %v93 = insertelement <128 x i1> %v92, i1 false, i32 93
+  %v94 = insertelement <128 x i1> %v93, i1 true, i32 94
+  %v95 = insertelement <128 x i1> %v94, i1 false, i32 95
+  %v96 = insertelement <128 x i1> %v95, i1 false, i32 96
+  %v97 = insertelement <128 x i1> %v96, i1 true, i32 97
+  %v98 = insertelement <128 x i1> %v97, i1 false, i32 98
+  %v99 = insertelement <128 x i1> %v98, i1 false, i32 99
+  %v100 = insertelement <128 x i1> %v99, i1 true, i32 100
+  %v101 = insertelement <128 x i1> %v100, i1 false, i32 101
+  %v102 = insertelement <128 x i1> %v101, i1 false, i32 102
+  %v103 = insertelement <128 x i1> %v102, i1 true, i32 103
+  %v104 = insertelement <128 x i1> %v103, i1 false, i32 104
+  %v105 = insertelement <128 x i1> %v104, i1 false, i32 105
+  %v106 = insertelement <128 x i1> %v105, i1 true, i32 106
+  %v107 = insertelement <128 x i1> %v106, i1 false, i32 107
+  %v108 = insertelement <128 x i1> %v107, i1 false, i32 108
+  %v109 = insertelement <128 x i1> %v108, i1 true, i32 109
+  %v110 = insertelement <128 x i1> %v109, i1 false, i32 110
+  %v111 = insertelement <128 x i1> %v110, i1 false, i32 111
+  %v112 = insertelement <128 x i1> %v111, i1 true, i32 112
+  %v113 = insertelement <128 x i1> %v112, i1 false, i32 113
+  %v114 = insertelement <128 x i1> %v113, i1 false, i32 114
+  %v115 = insertelement <128 x i1> %v114, i1 true, i32 115
+  %v116 = insertelement <128 x i1> %v115, i1 false, i32 116
+  %v117 = insertelement <128 x i1> %v116, i1 false, i32 117
+  %v118 = insertelement <128 x i1> %v117, i1 true, i32 118
+  %v119 = insertelement <128 x i1> %v118, i1 false, i32 119
+  %v120 = insertelement <128 x i1> %v119, i1 false, i32 120
+  %v121 = insertelement <128 x i1> %v120, i1 true, i32 121
+  %v122 = insertelement <128 x i1> %v121, i1 false, i32 122
+  %v123 = insertelement <128 x i1> %v122, i1 false, i32 123
+  %v124 = insertelement <128 x i1> %v123, i1 true, i32 124
+  %v125 = insertelement <128 x i1> %v124, i1 false, i32 125
+  %v126 = insertelement <128 x i1> %v125, i1 false, i32 126
+  %v127 = insertelement <128 x i1> %v126, i1 true, i32 127
+  store <128 x i1> %v127, <128 x i1>* %out
+  ;CHECK: pmovmskb
+  ;CHECK: andl $60919
+  ;CHECK: orl $520
+  ;CHECK: pinsrw $0
+  ;CHECK-NOT: pextrw
+  ;CHECK: ret
+  ret void
+}
+
+; Two variable lanes are shifted into place in a GPR, no gather needed.
+define void @build_v128i1_sparse(i8* %in, <128 x i1>* %out) {
+entry:
+  ;CHECK-LABEL: build_v128i1_sparse
+  %v0 = insertelement <128 x i1> undef, i1 true, i32 0
+  %p1 = getelementptr i8* %in, i32 1
+  %l1 = load i8* %p1
+  %t1 = trunc i8 %l1 to i1
+  %v1 = insertelement <128 x i1> %v0, i1 %t1, i32 1
+  %v2 = insertelement <128 x i1> %v1, i1 false, i32 2
+  %v3 = insertelement <128 x i1> %v2, i1 false, i32 3
+  %v4 = insertelement <128 x i1> %v3, i1 false, i32 4
+  %v5 = insertelement <128 x i1> %v4, i1 true, i32 5
+  %v6 = insertelement <128 x i1> %v5, i1 false, i32 6
+  %v7 = insertelement <128 x i1> %v6, i1 false, i32 7
+  %v8 = insertelement <128 x i1> %v7, i1 false, i32 8
+  %v9 = insertelement <128 x i1> %v8, i1 false, i32 9
+  %v10 = insertelement <128 x i1> %v9, i1 true, i32 10
+  %v11 = insertelement <128 x i1> %v10, i1 false, i32 11
+  %v12 = insertelement <128 x i1> %v11, i1 false, i32 12
+  %v13 = insertelement <128 x i1> %v12, i1 false, i32 13
+  %v14 = insertelement <128 x i1> %v13, i1 false, i32 14
+  %v15 = insertelement <128 x i1> %v14, i1 true, i32 15
+  %v16 = insertelement <128 x i1> %v15, i1 false, i32 16
+  %v17 = insertelement <128 x i1> %v16, i1 false, i32 17
+  %v18 = insertelement <128 x i1> %v17, i1 false, i32 18
+  %v19 = insertelement <128 x i1> %v18, i1 false, i32 19
+  %v20 = insertelement <128 x i1> %v19, i1 true, i32 20
+  %v21 = insertelement <128 x i1> %v20, i1 false, i32 21
+  %v22 = insertelement <128 x i1> %v21, i1 false, i32 22
+  %v23 = insertelement <128 x i1> %v22, i1 false, i32 23
+  %v24 = insertelement <128 x i1> %v23, i1 false, i32 24
+  %v25 = insertelement <128 x i1> %v24, i1 true, i32 25
+  %v26 = insertelement <128 x i1> %v25, i1 false, i32 26
+  %v27 = insertelement <128 x i1> %v26, i1 false, i32 27
+  %v28 = insertelement <128 x i1> %v27, i1 false, i32 28
+  %v29 = insertelement <128 x i1> %v28, i1 false, i32 29
+  %v30 = insertelement <128 x i1> %v29, i1 true, i32 30
+  %v31 = insertelement <128 x i1> %v30, i1 false, i32 31
+  %v32 = insertelement <128 x i1> %v31, i1 false, i32 32
+  %v33 = insertelement <128 x i1> %v32, i1 false, i32 33
+  %v34 = insertelement <128 x i1> %v33, i1 false, i32 34
+  %v35 = insertelement <128 x i1> %v34, i1 true, i32 35
+  %v36 = insertelement <128 x i1> %v35, i1 false, i32 36
+  %v37 = insertelement <128 x i1> %v36, i1 false, i32 37
+  %v38 = insertelement <128 x i1> %v37, i1 false, i32 38
+  %v39 = insertelement <128 x i1> %v38, i1 false, i32 39
+  %v40 = insertelement <128 x i1> %v39, i1 true, i32 40
+  %v41 = insertelement <128 x i1> %v40, i1 false, i32 41
+  %v42 = insertelement <128 x i1> %v41, i1 false, i32 42
+  %v43 = insertelement <128 x i1> %v42, i1 false, i32 43
+  %v44 = insertelement <128 x i1> %v43, i1 false, i32 44
+  %v45 = insertelement <128 x i1> %v44, i1 true, i32 45
+  %v46 = insertelement <128 x i1> %v45, i1 false, i32 46
+  %v47 = insertelement <128 x i1> %v46, i1 false, i32 47
+  %v48 = insertelement <128 x i1> %v47, i1 false, i32 48
+  %v49 = insertelement <128 x i1> %v48, i1 false, i32 49
+  %v50 = insertelement <128 x i1> %v49, i1 true, i32 50
+  %v51 = insertelement <128 x i1> %v50, i1 false, i32 51
+  %v52 = insertelement <128 x i1> %v51, i1 false, i32 52
+  %v53 = insertelement <128 x i1> %v52, i1 false, i32 53
+  %v54 = insertelement <128 x i1> %v53, i1 false, i32 54
+  %v55 = insertelement <128 x i1> %v54, i1 true, i32 55
+  %v56 = insertelement <128 x i1> %v55, i1 false, i32 56
+  %v57 = insertelement <128 x i1> %v56, i1 false, i32 57
+  %v58 = insertelement <128 x i1> %v57, i1 false, i32 58
+  %v59 = insertelement <128 x i1> %v58, i1 false, i32 59
+  %v60 = insertelement <128 x i1> %v59, i1 true, i32 60
+  %v61 = insertelement <128 x i1> %v60, i1 false, i32 61
+  %v62 = insertelement <128 x i1> %v61, i1 false, i32 62
+  %v63 = insertelement <128 x i1> %v62, i1 false, i32 63
+  %v64 = insertelement <128 x i1> %v63, i1 false, i32 64
+  %v65 = insertelement <128 x i1> %v64, i1 true, i32 65
+  %v66 = insertelement <128 x i1> %v65, i1 false, i32 66
+  %v67 = insertelement <128 x i1> %v66, i1 false, i32 67
+  %v68 = insertelement <128 x i1> %v67, i1 false, i32 68
+  %v69 = insertelement <128 x i1> %v68, i1 false, i32 69
+  %p70 = getelementptr i8* %in, i32 70
+  %l70 = load i8* %p70
+  %t70 = trunc i8 %l70 to i1
+  %v70 = insertelement <128 x i1> %v69, i1 %t70, i32 70
+  %v71 = insertelement <128 x i1> %v70, i1 false, i32 71
+  %v72 = insertelement <128 x i1> %v71, i1 false, i32 72
+  %v73 = insertelement <128 x i1> %v72, i1 false, i32 73
+  %v74 = insertelement <128 x i1> %v73, i1 false, i32 74
+  %v75 = insertelement <128 x i1> %v74, i1 true, i32 75
+  %v76 = insertelement <128 x i1> %v75, i1 false, i32 76
+  %v77 = insertelement <128 x i1> %v76, i1 false, i32 77
+  %v78 = insertelement <128 x i1> %v77, i1 false, i32 78
+  %v79 = insertelement <128 x i1> %v78, i1 false, i32 79
+  %v80 = insertelement <128 x i1> %v79, i1 true, i32 80
+  %v81 = insertelement <128 x i1> %v80, i1 false, i32 81
+  %v82 = insertelement <128 x i1> %v81, i1 false, i32 82
+  %v83 = insertelement <128 x i1> %v82, i1 false, i32 83
+  %v84 = insertelement <128 x i1> %v83, i1 false, i32 84
+  %v85 = insertelement <128 x i1> %v84, i1 true, i32 85
+  %v86 = insertelement <128 x i1> %v85, i1 false, i32 86
+  %v87 = insertelement <128 x i1> %v86, i1 false, i32 87
+  %v88 = insertelement <128 x i1> %v87, i1 false, i32 88
+  %v89 = insertelement <128 x i1> %v88, i1 false, i32 89
+  %v90 = insertelement <128 x i1> %v89, i1 true, i32 90
+  %v91 = insertelement <128 x i1> %v90, i1 false, i32 91
+  %v92 = insertelement <128 x i1> %v91, i1 false, i32 92
+  %v93 = insertelement <128 x i1> %v92, i1 false, i32 93
+  %v94 = insertelement <128 x i1> %v93, i1 false, i32 94
+  %v95 = insertelement <128 x i1> %v94, i1 true, i32 95
+  %v96 = insertelement <128 x i1> %v95, i1 false, i32 96
+  %v97 = insertelement <128 x i1> %v96, i1 false, i32 97
+  %v98 = insertelement <128 x i1> %v97, i1 false, i32 98
+  %v99 = insertelement <128 x i1> %v98, i1 false, i32 99
+  %v100 = insertelement <128 x i1> %v99, i1 true, i32 100
+  %v101 = insertelement <128 x i1> %v100, i1 false, i32 101
+  %v102 = insertelement <128 x i1> %v101, i1 false, i32 102
+  %v103 = insertelement <128 x i1> %v102, i1 false, i32 103
+  %v104 = insertelement <128 x i1> %v103, i1 false, i32 104
+  %v105 = insertelement <128 x i1> %v104, i1 true, i32 105
+  %v106 = insertelement <128 x i1> %v105, i1 false, i32 106
+  %v107 = insertelement <128 x i1> %v106, i1 false, i32 107
+  %v108 = insertelement <128 x i1> %v107, i1 false, i32 108
+  %v109 = insertelement <128 x i1> %v108, i1 false, i32 109
+  %v110 = insertelement <128 x i1> %v109, i1 true, i32 110
+  %v111 = insertelement <128 x i1> %v110, i1 false, i32 111
+  %v112 = insertelement <128 x i1> %v111, i1 false, i32 112
+  %v113 = insertelement <128 x i1> %v112, i1 false, i32 113
+  %v114 = insertelement <128 x i1> %v113, i1 false, i32 114
+  %v115 = insertelement <128 x i1> %v114, i1 true, i32 115
+  %v116 = insertelement <128 x i1> %v115, i1 false, i32 116
+  %v117 = insertelement <128 x i1> %v116, i1 false, i32 117
+  %v118 = insertelement <128 x i1> %v117, i1 false, i32 118
+  %v119 = insertelement <128 x i1> %v118, i1 false, i32 119
+  %v120 = insertelement <128 x i1> %v119, i1 true, i32 120
+  %v121 = insertelement <128 x i1> %v120, i1 false, i32 121
+  %v122 = insertelement <128 x i1> %v121, i1 false, i32 122
+  %v123 = insertelement <128 x i1> %v122, i1 false, i32 123
+  %v124 = insertelement <128 x i1> %v123, i1 false, i32 124
+  %v125 = insertelement <128 x i1> %v124, i1 true, i32 125
+  %v126 = insertelement <128 x i1> %v125, i1 false, i32 126
+  %v127 = insertelement <128 x i1> %v126, i1 false, i32 127
+  store <128 x i1> %v127, <128 x i1>* %out
+  ;CHECK-NOT: pmovmskb
+  ;CHECK: movdqa .LCPI
+  ;CHECK: pinsrw $0
+  ;CHECK: pinsrw $4
+  ;CHECK-NOT: pextrw
+  ;CHECK: ret
+  ret void
+}
+
+; v256i1 is built the same way, one pinsrw per variable piece in each half.
+define void @build_v256i1_sparse(i8* %in, <256 x i1>* %out) {
+entry:
+  ;CHECK-LABEL: build_v256i1_sparse
+  %v0 = insertelement <256 x i1> undef, i1 true, i32 0
+  %p1 = getelementptr i8* %in, i32 1
+  %l1 = load i8* %p1
+  %t1 = trunc i8 %l1 to i1
+  %v1 = insertelement <256 x i1> %v0, i1 %t1, i32 1
+  %v2 = insertelement <256 x i1> %v1, i1 false, i32 2
+  %v3 = insertelement <256 x i1> %v2, i1 false, i32 3
+  %v4 = insertelement <256 x i1> %v3, i1 false, i32 4
+  %v5 = insertelement <256 x i1> %v4, i1 true, i32 5
+  %v6 = insertelement <256 x i1> %v5, i1 false, i32 6
+  %v7 = insertelement <256 x i1> %v6, i1 false, i32 7
+  %v8 = insertelement <256 x i1> %v7, i1 false, i32 8
+  %v9 = insertelement <256 x i1> %v8, i1 false, i32 9
+  %v10 = insertelement <256 x i1> %v9, i1 true, i32 10
+  %v11 = insertelement <256 x i1> %v10, i1 false, i32 11
+  %v12 = insertelement <256 x i1> %v11, i1 false, i32 12
+  %v13 = insertelement <256 x i1> %v12, i1 false, i32 13
+  %v14 = insertelement <256 x i1> %v13, i1 false, i32 14
+  %v15 = insertelement <256 x i1> %v14, i1 true, i32 15
+  %v16 = insertelement <256 x i1> %v15, i1 false, i32 16
+  %v17 = insertelement <256 x i1> %v16, i1 false, i32 17
+  %v18 = insertelement <256 x i1> %v17, i1 false, i32 18
+  %v19 = insertelement <256 x i1> %v18, i1 false, i32 19
+  %v20 = insertelement <256 x i1> %v19, i1 true, i32 20
+  %v21 = insertelement <256 x i1> %v20, i1 false, i32 21
+  %v22 = insertelement <256 x i1> %v21, i1 false, i32 22
+  %v23 = insertelement <256 x i1> %v22, i1 false, i32 23
+  %v24 = insertelement <256 x i1> %v23, i1 false, i32 24
+  %v25 = insertelement <256 x i1> %v24, i1 true, i32 25
+  %v26 = insertelement <256 x i1> %v25, i1 false, i32 26
+  %v27 = insertelement <256 x i1> %v26, i1 false, i32 27
+  %v28 = insertelement <256 x i1> %v27, i1 false, i32 28
+  %v29 = insertelement <256 x i1> %v28, i1 false, i32 29
+  %v30 = insertelement <256 x i1> %v29, i1 true, i32 30
+  %v31 = insertelement <256 x i1> %v30, i1 false, i32 31
+  %v32 = insertelement <256 x i1> %v31, i1 false, i32 32
+  %v33 = insertelement <256 x i1> %v32, i1 false, i32 33
+  %v34 = insertelement <256 x i1> %v33, i1 false, i32 34
+  %v35 = insertelement <256 x i1> %v34, i1 true, i32 35
+  %v36 = insertelement <256 x i1> %v35, i1 false, i32 36
+  %v37 = insertelement <256 x i1> %v36, i1 false, i32 37
+  %v38 = insertelement <256 x i1> %v37, i1 false, i32 38
+  %v39 = insertelement <256 x i1> %v38, i1 false, i32 39
+  %v40 = insertelement <256 x i1> %v39, i1 true, i32 40
+  %v41 = insertelement <256 x i1> %v40, i1 false, i32 41
+  %v42 = insertelement <256 x i1> %v41, i1 false, i32 42
+  %v43 = insertelement <256 x i1> %v42, i1 false, i32 43
+  %v44 = insertelement <256 x i1> %v43, i1 false, i32 44
+  %v45 = insertelement <256 x i1> %v44, i1 true, i32 45
+  %v46 = insertelement <256 x i1> %v45, i1 false, i32 46
+  %v47 = insertelement <256 x i1> %v46, i1 false, i32 47
+  %v48 = insertelement <256 x i1> %v47, i1 false, i32 48
+  %v49 = insertelement <256 x i1> %v48, i1 false, i32 49
+  %v50 = insertelement <256 x i1> %v49, i1 true, i32 50
+  %v51 = insertelement <256 x i1> %v50, i1 false, i32 51
+  %v52 = insertelement <256 x i1> %v51, i1 false, i32 52
+  %v53 = insertelement <256 x i1> %v52, i1 false, i32 53
+  %v54 = insertelement <256 x i1> %v53, i1 false, i32 54
+  %v55 = insertelement <256 x i1> %v54, i1 true, i32 55
+  %v56 = insertelement <256 x i1> %v55, i1 false, i32 56
+  %v57 = insertelement <256 x i1> %v56, i1 false, i32 57
+  %v58 = insertelement <256 x i1> %v57, i1 false, i32 58
+  %v59 = insertelement <256 x i1> %v58, i1 false, i32 59
+  %v60 = insertelement <256 x i1> %v59, i1 true, i32 60
+  %v61 = insertelement <256 x i1> %v60, i1 false, i32 61
+  %v62 = insertelement <256 x i1> %v61, i1 false, i32 62
+  %v63 = insertelement <256 x i1> %v62, i1 false, i32 63
+  %v64 = insertelement <256 x i1> %v63, i1 false, i32 64
+  %v65 = insertelement <256 x i1> %v64, i1 true, i32 65
+  %v66 = insertelement <256 x i1> %v65, i1 false, i32 66
+  %v67 = insertelement <256 x i1> %v66, i1 false, i32 67
+  %v68 = insertelement <256 x i1> %v67, i1 false, i32 68
+  %v69 = insertelement <256 x i1> %v68, i1 false, i32 69
+  %v70 = insertelement <256 x i1> %v69, i1 true, i32 70
+  %v71 = insertelement <256 x i1> %v70, i1 false, i32 71
+  %v72 = insertelement <256 x i1> %v71, i1 false, i32 72
+  %v73 = insertelement <256 x i1> %v72, i1 false, i32 73
+  %v74 = insertelement <256 x i1> %v73, i1 false, i32 74
+  %v75 = insertelement <256 x i1> %v74, i1 true, i32 75
+  %v76 = insertelement <256 x i1> %v75, i1 false, i32 76
+  %v77 = insertelement <256 x i1> %v76, i1 false, i32 77
+  %v78 = insertelement <256 x i1> %v77, i1 false, i32 78
+  %v79 = insertelement <256 x i1> %v78, i1 false, i32 79
+  %v80 = insertelement <256 x i1> %v79, i1 true, i32 80
+  %v81 = insertelement <256 x i1> %v80, i1 false, i32 81
+  %v82 = insertelement <256 x i1> %v81, i1 false, i32 82
+  %v83 = insertelement <256 x i1> %v82, i1 false, i32 83
+  %v84 = insertelement <256 x i1> %v83, i1 false, i32 84
+  %v85 = insertelement <256 x i1> %v84, i1 true, i32 85
+  %v86 = insertelement <256 x i1> %v85, i1 false, i32 86
+  %v87 = insertelement <256 x i1> %v86, i1 false, i32 87
+  %v88 = insertelement <256 x i1> %v87, i1 false, i32 88
+  %v89 = insertelement <256 x i1> %v88, i1 false, i32 89
+  %v90 = insertelement <256 x i1> %v89, i1 true, i32 90
+  %v91 = insertelement <256 x i1> %v90, i1 false, i32 91
+  %v92 = insertelement <256 x i1> %v91, i1 false, i32 92
+  %v93 = insertelement <256 x i1> %v92, i1 false, i32 93
+  %v94 = insertelement <256 x i1> %v93, i1 false, i32 94
+  %v95 = insertelement <256 x i1> %v94, i1 true, i32 95
+  %v96 = insertelement <256 x i1> %v95, i1 false, i32 96
+  %v97 = insertelement <256 x i1> %v96, i1 false, i32 97
+  %v98 = insertelement <256 x i1> %v97, i1 false, i32 98
+  %v99 = insertelement <256 x i1> %v98, i1 false, i32 99
+  %v100 = insertelement <256 x i1> %v99, i1 true, i32 100
+  %v101 = insertelement <256 x i1> %v100, i1 false, i32 101
+  %v102 = insertelement <256 x i1> %v101, i1 false, i32 102
+  %v103 = insertelement <256 x i1> %v102, i1 false, i32 103
+  %v104 = insertelement <256 x i1> %v103, i1 false, i32 104
+  %v105 = insertelement <256 x i1> %v104, i1 true, i32 105
+  %v106 = insertelement <256 x i1> %v105, i1 false, i32 106
+  %v107 = insertelement <256 x i1> %v106, i1 false, i32 107
+  %v108 = insertelement <256 x i1> %v107, i1 false, i32 108
+  %v109 = insertelement <256 x i1> %v108, i1 false, i32 109
+  %v110 = insertelement <256 x i1> %v109, i1 true, i32 110
+  %v111 = insertelement <256 x i1> %v110, i1 false, i32 111
+  %v112 = insertelement <256 x i1> %v111, i1 false, i32 112
+  %v113 = insertelement <256 x i1> %v112, i1 false, i32 113
+  %v114 = insertelement <256 x i1> %v113, i1 false, i32 114
+  %v115 = insertelement <256 x i1> %v114, i1 true, i32 115
+  %v116 = insertelement <256 x i1> %v115, i1 false, i32 116
+  %v117 = insertelement <256 x i1> %v116, i1 false, i32 117
+  %v118 = insertelement <256 x i1> %v117, i1 false, i32 118
+  %v119 = insertelement <256 x i1> %v118, i1 false, i32 119
+  %v120 = insertelement <256 x i1> %v119, i1 true, i32 120
+  %v121 = insertelement <256 x i1> %v120, i1 false, i32 121
+  %v122 = insertelement <256 x i1> %v121, i1 false, i32 122
+  %v123 = insertelement <256 x i1> %v122, i1 false, i32 123
+  %v124 = insertelement <256 x i1> %v123, i1 false, i32 124
+  %v125 = insertelement <256 x i1> %v124, i1 true, i32 125
+  %v126 = insertelement <256 x i1> %v125, i1 false, i32 126
+  %v127 = insertelement <256 x i1> %v126, i1 false, i32 127
+  %v128 = insertelement <256 x i1> %v127, i1 false, i32 128
+  %v129 = insertelement <256 x i1> %v128, i1 false, i32 129
+  %v130 = insertelement <256 x i1> %v129, i1 true, i32 130
+  %v131 = insertelement <256 x i1> %v130, i1 false, i32 131
+  %v132 = insertelement <256 x i1> %v131, i1 false, i32 132
+  %v133 = insertelement <256 x i1> %v132, i1 false, i32 133
+  %v134 = insertelement <256 x i1> %v133, i1 false, i32 134
+  %v135 = insertelement <256 x i1> %v134, i1 true, i32 135
+  %v136 = insertelement <256 x i1> %v135, i1 false, i32 136
+  %v137 = insertelement <256 x i1> %v136, i1 false, i32 137
+  %v138 = insertelement <256 x i1> %v137, i1 false, i32 138
+  %v139 = insertelement <256 x i1> %v138, i1 false, i32 139
+  %v140 = insertelement <256 x i1> %v139, i1 true, i32 140
+  %v141 = insertelement <256 x i1> %v140, i1 false, i32 141
+  %v142 = insertelement <256 x i1> %v141, i1 false, i32 142
+  %v143 = insertelement <256 x i1> %v142, i1 false, i32 143
+  %v144 = insertelement <256 x i1> %v143, i1 false, i32 144
+  %v145 = insertelement <256 x i1> %v144, i1 true, i32 145
+  %v146 = insertelement <256 x i1> %v145, i1 false, i32 146
+  %v147 = insertelement <256 x i1> %v146, i1 false, i32 147
+  %v148 = insertelement <256 x i1> %v147, i1 false, i32 148
+  %v149 = insertelement <256 x i1> %v148, i1 false, i32 149
+  %v150 = insertelement <256 x i1> %v149, i1 true, i32 150
+  %v151 = insertelement <256 x i1> %v150, i1 false, i32 151
+  %v152 = insertelement <256 x i1> %v151, i1 false, i32 152
+  %v153 = insertelement <256 x i1> %v152, i1 false, i32 153
+  %v154 = insertelement <256 x i1> %v153, i1 false, i32 154
+  %v155 = insertelement <256 x i1> %v154, i1 true, i32 155
+  %v156 = insertelement <256 x i1> %v155, i1 false, i32 156
+  %v157 = insertelement <256 x i1> %v156, i1 false, i32 157
+  %v158 = insertelement <256 x i1> %v157, i1 false, i32 158
+  %v159 = insertelement <256 x i1> %v158, i1 false, i32 159
+  %v160 = insertelement <256 x i1> %v159, i1 true, i32 160
+  %v161 = insertelement <256 x i1> %v160, i1 false, i32 161
+  %v162 = insertelement <256 x i1> %v161, i1 false, i32 162
+  %v163 = insertelement <256 x i1> %v162, i1 false, i32 163
+  %v164 = insertelement <256 x i1> %v163, i1 false, i32 164
+  %v165 = insertelement <256 x i1> %v164, i1 true, i32 165
+  %v166 = insertelement <256 x i1> %v165, i1 false, i32 166
+  %v167 = insertelement <256 x i1> %v166, i1 false, i32 167
+  %v168 = insertelement <256 x i1> %v167, i1 false, i32 168
+  %v169 = insertelement <256 x i1> %v168, i1 false, i32 169
+  %v170 = insertelement <256 x i1> %v169, i1 true, i32 170
+  %v171 = insertelement <256 x i1> %v170, i1 false, i32 171
+  %v172 = insertelement <256 x i1> %v171, i1 false, i32 172
+  %v173 = insertelement <256 x i1> %v172, i1 false, i32 173
+  %v174 = insertelement <256 x i1> %v173, i1 false, i32 174
+  %v175 = insertelement <256 x i1> %v174, i1 true, i32 175
+  %v176 = insertelement <256 x i1> %v175, i1 false, i32 176
+  %v177 = insertelement <256 x i1> %v176, i1 false, i32 177
+  %v178 = insertelement <256 x i1> %v177, i1 false, i32 178
+  %v179 = insertelement <256 x i1> %v178, i1 false, i32 179
+  %v180 = insertelement <256 x i1> %v179, i1 true, i32 180
+  %v181 = insertelement <256 x i1> %v180, i1 false, i32 181
+  %v182 = insertelement <256 x i1> %v181, i1 false, i32 182
+  %v183 = insertelement <256 x i1> %v182, i1 false, i32 183
+  %v184 = insertelement <256 x i1> %v183, i1 false, i32 184
+  %v185 = insertelement <256 x i1> %v184, i1 true, i32 185
+  %v186 = insertelement <256 x i1> %v185, i1 false, i32 186
+  %v187 = insertelement <256 x i1> %v186, i1 false, i32 187
+  %v188 = insertelement <256 x i1> %v187, i1 false, i32 188
+  %v189 = insertelement <256 x i1> %v188, i1 false, i32 189
+  %v190 = insertelement <256 x i1> %v189, i1 true, i32 190
+  %v191 = insertelement <256 x i1> %v190, i1 false, i32 191
+  %v192 = insertelement <256 x i1> %v191, i1 false, i32 192
+  %v193 = insertelement <256 x i1> %v192, i1 false, i32 193
+  %v194 = insertelement <256 x i1> %v193, i1 false, i32 194
+  %v195 = insertelement <256 x i1> %v194, i1 true, i32 195
+  %v196 = insertelement <256 x i1> %v195, i1 false, i32 196
+  %v197 = insertelement <256 x i1> %v196, i1 false, i32 197
+  %v198 = insertelement <256 x i1> %v197, i1 false, i32 198
+  %v199 = insertelement <256 x i1> %v198, i1 false, i32 199
+  %p200 = getelementptr i8* %in, i32 200
+  %l200 = load i8* %p200
+  %t200 = trunc i8 %l200 to i1
+  %v200 = insertelement <256 x i1> %v199, i1 %t200, i32 200
+  %v201 = insertelement <256 x i1> %v200, i1 false, i32 201
+  %v202 = insertelement <256 x i1> %v201, i1 false, i32 202
+  %v203 = insertelement <256 x i1> %v202, i1 false, i32 203
+  %v204 = insertelement <256 x i1> %v203, i1 false, i32 204
+  %v205 = insertelement <256 x i1> %v204, i1 true, i32 205
+  %v206 = insertelement <256 x i1> %v205, i1 false, i32 206
+  %v207 = insertelement <256 x i1> %v206, i1 false, i32 207
+  %v208 = insertelement <256 x i1> %v207, i1 false, i32 208
+  %v209 = insertelement <256 x i1> %v208, i1 false, i32 209
+  %v210 = insertelement <256 x i1> %v209, i1 true, i32 210
+  %v211 = insertelement <256 x i1> %v210, i1 false, i32 211
+  %v212 = insertelement <256 x i1> %v211, i1 false, i32 212
+  %v213 = insertelement <256 x i1> %v212, i1 false, i32 213
+  %v214 = insertelement <256 x i1> %v213, i1 false, i32 214
+  %v215 = insertelement <256 x i1> %v214, i1 true, i32 215
+  %v216 = insertelement <256 x i1> %v215, i1 false, i32 216
+  %v217 = insertelement <256 x i1> %v216, i1 false, i32 217
+  %v218 = insertelement <256 x i1> %v217, i1 false, i32 218
+  %v219 = insertelement <256 x i1> %v218, i1 false, i32 219
+  %v220 = insertelement <256 x i1> %v219, i1 true, i32 220
+  %v221 = insertelement <256 x i1> %v220, i1 false, i32 221
+  %v222 = insertelement <256 x i1> %v221, i1 false, i32 222
+  %v223 = insertelement <256 x i1> %v222, i1 false, i32 223
+  %v224 = insertelement <256 x i1> %v223, i1 false, i32 224
+  %v225 = insertelement <256 x i1> %v224, i1 true, i32 225
+  %v226 = insertelement <256 x i1> %v225, i1 false, i32 226
+  %v227 = insertelement <256 x i1> %v226, i1 false, i32 227
+  %v228 = insertelement <256 x i1> %v227, i1 false, i32 228
+  %v229 = insertelement <256 x i1> %v228, i1 false, i32 229
+  %v230 = insertelement <256 x i1> %v229, i1 true, i32 230
+  %v231 = insertelement <256 x i1> %v230, i1 false, i32 231
+  %v232 = insertelement <256 x i1> %v231, i1 false, i32 232
+  %v233 = insertelement <256 x i1> %v232, i1 false, i32 233
+  %v234 = insertelement <256 x i1> %v233, i1 false, i32 234
+  %v235 = insertelement <256 x i1> %v234, i1 true, i32 235
+  %v236 = insertelement <256 x i1> %v235, i1 false, i32 236
+  %v237 = insertelement <256 x i1> %v236, i1 false, i32 237
+  %v238 = insertelement <256 x i1> %v237, i1 false, i32 238
+  %v239 = insertelement <256 x i1> %v238, i1 false, i32 239
+  %v240 = insertelement <256 x i1> %v239, i1 true, i32 240
+  %v241 = insertelement <256 x i1> %v240, i1 false, i32 241
+  %v242 = insertelement <256 x i1> %v241, i1 false, i32 242
+  %v243 = insertelement <256 x i1> %v242, i1 false, i32 243
+  %v244 = insertelement <256 x i1> %v243, i1 false, i32 244
+  %v245 = insertelement <256 x i1> %v244, i1 true, i32 245
+  %v246 = insertelement <256 x i1> %v245, i1 false, i32 246
+  %v247 = insertelement <256 x i1> %v246, i1 false, i32 247
+  %v248 = insertelement <256 x i1> %v247, i1 false, i32 248
+  %v249 = insertelement <256 x i1> %v248, i1 false, i32 249
+  %v250 = insertelement <256 x i1> %v249, i1 true, i32 250
+  %v251 = insertelement <256 x i1> %v250, i1 false, i32 251
+  %v252 = insertelement <256 x i1> %v251, i1 false, i32 252
+  %v253 = insertelement <256 x i1> %v252, i1 false, i32 253
+  %v254 = insertelement <256 x i1> %v253, i1 false, i32 254
+  %v255 = insertelement <256 x i1> %v254, i1 true, i32 255
+  store <256 x i1> %v255, <256 x i1>* %out
+  ;CHECK-NOT: pmovmskb
+  ;CHECK: movdqa .LCPI
+  ;CHECK: pinsrw $0
+  ;CHECK: movdqa .LCPI
+  ;CHECK: pinsrw $4
+  ;CHECK-NOT: pextrw
+  ;CHECK: ret
+  ret void
+}
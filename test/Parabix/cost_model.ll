@@ -0,0 +1,67 @@
+; RUN: opt < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 -cost-model -analyze | FileCheck %s
+; RUN: opt < %s -mtriple=x86_64-unknown-linux-gnu -mcpu=core-avx2 -cost-model -analyze | FileCheck %s
+
+; Costs of Parabix vector operations as seen by the vectorizers.
+
+define <128 x i1> @and_v128i1(<128 x i1> %a, <128 x i1> %b) {
+  %r = and <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'and_v128i1':
+; CHECK: Found an estimated cost of 1 for instruction:   %r
+
+define <64 x i1> @add_v64i1(<64 x i1> %a, <64 x i1> %b) {
+  %r = add <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'add_v64i1':
+; CHECK: Found an estimated cost of 1 for instruction:   %r
+
+define <32 x i4> @add_v32i4(<32 x i4> %a, <32 x i4> %b) {
+  %r = add <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'add_v32i4':
+; CHECK: Found an estimated cost of 9 for instruction:   %r
+
+define <128 x i1> @select_v128i1(<128 x i1> %c, <128 x i1> %a, <128 x i1> %b) {
+  %r = select <128 x i1> %c, <128 x i1> %a, <128 x i1> %b
+  ret <128 x i1> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'select_v128i1':
+; CHECK: Found an estimated cost of 3 for instruction:   %r
+
+define <128 x i1> @icmp_v128i1(<128 x i1> %a, <128 x i1> %b) {
+  %r = icmp eq <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'icmp_v128i1':
+; CHECK: Found an estimated cost of 2 for instruction:   %r
+
+define i128 @bitcast_v128i1(<128 x i1> %a) {
+  %r = bitcast <128 x i1> %a to i128
+  ret i128 %r
+}
+; CHECK: 'Cost Model Analysis' for function 'bitcast_v128i1':
+; CHECK: Found an estimated cost of 2 for instruction:   %r
+
+define <32 x i8> @sext_v32i1(<32 x i1> %a) {
+  %r = sext <32 x i1> %a to <32 x i8>
+  ret <32 x i8> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'sext_v32i1':
+; CHECK: Found an estimated cost of 165 for instruction:   %r
+
+define <32 x i4> @reverse_v32i4(<32 x i4> %a) {
+  %r = shufflevector <32 x i4> %a, <32 x i4> undef, <32 x i32> <i32 31, i32 30, i32 29, i32 28, i32 27, i32 26, i32 25, i32 24, i32 23, i32 22, i32 21, i32 20, i32 19, i32 18, i32 17, i32 16, i32 15, i32 14, i32 13, i32 12, i32 11, i32 10, i32 9, i32 8, i32 7, i32 6, i32 5, i32 4, i32 3, i32 2, i32 1, i32 0>
+  ret <32 x i4> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'reverse_v32i4':
+; CHECK: Found an estimated cost of 149 for instruction:   %r
+
+define <128 x i1> @load_v128i1(<128 x i1>* %p) {
+  %r = load <128 x i1>* %p
+  ret <128 x i1> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'load_v128i1':
+; CHECK: Found an estimated cost of 1 for instruction:   %r
@@ -0,0 +1,83 @@
+; RUN: llc < %s -O0 -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s -check-prefix=SSE2
+; RUN: llc < %s -O0 -fast-isel-abort -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 | FileCheck %s -check-prefix=AVX2
+
+; Loads, stores, logic, i1 add/sub and bitcasts of Parabix streams are
+; selected by FastISel without falling back to SelectionDAG. Without AVX2
+; there are no 256-bit stream registers, so only the AVX2 run can abort on
+; a FastISel miss.
+
+define void @logic128(<128 x i1>* %a, <128 x i1>* %b, <128 x i1>* %c) {
+  %x = load <128 x i1>* %a
+  %y = load <128 x i1>* %b, align 1
+  %and = and <128 x i1> %x, %y
+  %or = or <128 x i1> %and, %x
+  %sum = add <128 x i1> %or, %y
+  store <128 x i1> %sum, <128 x i1>* %c
+  ret void
+}
+; SSE2-LABEL: logic128:
+; SSE2: movdqa (%rdi), [[X:%xmm[0-9]+]]
+; SSE2: movdqu (%rsi), [[Y:%xmm[0-9]+]]
+; SSE2: pand
+; SSE2: por
+; SSE2: pxor
+; SSE2: movdqa {{%xmm[0-9]+}}, (%rdx)
+; AVX2-LABEL: logic128:
+; AVX2: vmovdqa (%rdi)
+; AVX2: vmovdqu (%rsi)
+; AVX2: vpand
+; AVX2: vpor
+; AVX2: vpxor
+; AVX2: vmovdqa {{%xmm[0-9]+}}, (%rdx)
+
+define void @sub256(<256 x i1>* %a, <256 x i1>* %c) {
+  %x = load <256 x i1>* %a, align 32
+  %d = sub <256 x i1> %x, zeroinitializer
+  store <256 x i1> %d, <256 x i1>* %c, align 32
+  ret void
+}
+; AVX2-LABEL: sub256:
+; AVX2: vmovdqa (%rdi), %ymm
+; AVX2: vpxor
+; AVX2: vmovdqa %ymm{{[0-9]+}}, (%rsi)
+
+define void @not64(<64 x i1>* %a, <64 x i1>* %c) {
+  %x = load <64 x i1>* %a
+  %n = xor <64 x i1> %x, <i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                          i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                          i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                          i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                          i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                          i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                          i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1,
+                          i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1, i1 1>
+  store <64 x i1> %n, <64 x i1>* %c
+  ret void
+}
+; SSE2-LABEL: not64:
+; SSE2-DAG: movq $-1, [[ONES:%r[a-z0-9]+]]
+; SSE2-DAG: movq (%rdi), [[X:%r[a-z0-9]+]]
+; SSE2: xorq
+; SSE2: movq {{%r[a-z0-9]+}}, (%rsi)
+
+define i32 @bitcast32(<32 x i1>* %a, i32 %m) {
+  %x = load <32 x i1>* %a
+  %mv = bitcast i32 %m to <32 x i1>
+  %y = and <32 x i1> %x, %mv
+  %r = bitcast <32 x i1> %y to i32
+  ret i32 %r
+}
+; SSE2-LABEL: bitcast32:
+; SSE2: movl (%rdi), %eax
+; SSE2-NEXT: andl %esi, %eax
+; SSE2-NEXT: retq
+
+define void @bitcast_v2i64(<128 x i1>* %a, <2 x i64>* %c) {
+  %x = load <128 x i1>* %a
+  %v = bitcast <128 x i1> %x to <2 x i64>
+  store <2 x i64> %v, <2 x i64>* %c
+  ret void
+}
+; SSE2-LABEL: bitcast_v2i64:
+; SSE2: movdqa (%rdi), [[V:%xmm[0-9]+]]
+; SSE2-NEXT: movdqa [[V]], (%rsi)
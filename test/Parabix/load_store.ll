@@ -0,0 +1,67 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 | FileCheck %s -check-prefix=AVX2
+
+define void @xor128_mem(<128 x i1>* %p, <128 x i1>* %q, <128 x i1> %a) {
+  %b = load <128 x i1>* %q
+  %c = xor <128 x i1> %a, %b
+  store <128 x i1> %c, <128 x i1>* %p
+  ret void
+}
+; SSE2-LABEL: xor128_mem:
+; SSE2: {{xorps|pxor}} (%rsi), %xmm0
+; SSE2-NEXT: {{movaps|movdqa}} %xmm0, (%rdi)
+; SSE2-NEXT: retq
+; AVX2-LABEL: xor128_mem:
+; AVX2: {{vxorps|vpxor}} (%rsi), %xmm0, %xmm0
+
+define void @xor256_mem(<256 x i1>* %p, <256 x i1>* %q, <256 x i1> %a) {
+  %b = load <256 x i1>* %q, align 32
+  %c = xor <256 x i1> %a, %b
+  store <256 x i1> %c, <256 x i1>* %p, align 32
+  ret void
+}
+; AVX2-LABEL: xor256_mem:
+; AVX2: {{vxorps|vpxor}} (%rsi), %ymm0, %ymm0
+; AVX2-NEXT: {{vmovaps|vmovdqa}} %ymm0, (%rdi)
+
+define void @and64_mem(<64 x i1>* %p, <64 x i1>* %q, <64 x i1> %a) {
+  %b = load <64 x i1>* %q
+  %c = and <64 x i1> %a, %b
+  store <64 x i1> %c, <64 x i1>* %p
+  ret void
+}
+; SSE2-LABEL: and64_mem:
+; SSE2: andq (%rsi), %rdx
+; SSE2-NEXT: movq %rdx, (%rdi)
+
+define <128 x i1> @load128_unaligned(<128 x i1>* %p) {
+  %v = load <128 x i1>* %p, align 1
+  ret <128 x i1> %v
+}
+; SSE2-LABEL: load128_unaligned:
+; SSE2: {{movups|movdqu}} (%rdi), %xmm0
+; SSE2-NEXT: retq
+
+define <64 x i1> @load64(<64 x i1>* %p) {
+  %v = load <64 x i1>* %p
+  ret <64 x i1> %v
+}
+; SSE2-LABEL: load64:
+; SSE2: movq (%rdi), %rax
+; SSE2-NEXT: retq
+
+define void @store32(<32 x i1>* %p, <32 x i1> %v) {
+  store <32 x i1> %v, <32 x i1>* %p
+  ret void
+}
+; SSE2-LABEL: store32:
+; SSE2: movl %esi, (%rdi)
+; SSE2-NEXT: retq
+
+define <64 x i4> @load256_unaligned(<64 x i4>* %p) {
+  %v = load <64 x i4>* %p, align 1
+  ret <64 x i4> %v
+}
+; AVX2-LABEL: load256_unaligned:
+; AVX2: {{vmovups|vmovdqu}} (%rdi), %ymm0
+; AVX2-NEXT: retq
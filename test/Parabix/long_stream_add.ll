@@ -0,0 +1,108 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-unknown -mattr=+avx2 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-unknown-unknown -mattr=+sse2 | FileCheck %s -check-prefix=SSE2
+
+; Long stream additions from i512 up to i4096 are split over YMM registers
+; and the carries are resolved with a single MatchStar on an i64 mask.
+; Without AVX2 the default adc chain is kept.
+
+declare {i512, i1} @llvm.uadd.with.overflow.i512(i512 %a, i512 %b)
+
+define i1 @uadd_with_overflow_i512(<8 x i64>* %pa, <8 x i64>* %pb, <8 x i64>* %ps) {
+entry:
+; CHECK-LABEL: uadd_with_overflow_i512:
+; CHECK-NOT: adcq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: vmovmskpd %ymm
+; CHECK: imulq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: ret
+; SSE2-LABEL: uadd_with_overflow_i512:
+; SSE2: adcq
+  %a = load <8 x i64>* %pa
+  %b = load <8 x i64>* %pb
+  %aa = bitcast <8 x i64> %a to i512
+  %bb = bitcast <8 x i64> %b to i512
+
+  %res = call {i512, i1} @llvm.uadd.with.overflow.i512(i512 %aa, i512 %bb)
+  %sum = extractvalue {i512, i1} %res, 0
+  %obit = extractvalue {i512, i1} %res, 1
+
+  %sum1 = bitcast i512 %sum to <8 x i64>
+  store <8 x i64> %sum1, <8 x i64>* %ps
+  ret i1 %obit
+}
+
+declare {i1024, i1} @llvm.uadd.with.overflow.i1024(i1024 %a, i1024 %b)
+
+define i1 @uadd_with_overflow_i1024(<16 x i64>* %pa, <16 x i64>* %pb, <16 x i64>* %ps) {
+entry:
+; CHECK-LABEL: uadd_with_overflow_i1024:
+; CHECK-NOT: adcq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: vmovmskpd %ymm
+; CHECK: imulq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: ret
+  %a = load <16 x i64>* %pa
+  %b = load <16 x i64>* %pb
+  %aa = bitcast <16 x i64> %a to i1024
+  %bb = bitcast <16 x i64> %b to i1024
+
+  %res = call {i1024, i1} @llvm.uadd.with.overflow.i1024(i1024 %aa, i1024 %bb)
+  %sum = extractvalue {i1024, i1} %res, 0
+  %obit = extractvalue {i1024, i1} %res, 1
+
+  %sum1 = bitcast i1024 %sum to <16 x i64>
+  store <16 x i64> %sum1, <16 x i64>* %ps
+  ret i1 %obit
+}
+
+declare {i2048, i1} @llvm.uadd.with.overflow.i2048(i2048 %a, i2048 %b)
+
+define i1 @uadd_with_overflow_i2048(<32 x i64>* %pa, <32 x i64>* %pb, <32 x i64>* %ps) {
+entry:
+; CHECK-LABEL: uadd_with_overflow_i2048:
+; CHECK-NOT: adcq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: vmovmskpd %ymm
+; CHECK: imulq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: ret
+  %a = load <32 x i64>* %pa
+  %b = load <32 x i64>* %pb
+  %aa = bitcast <32 x i64> %a to i2048
+  %bb = bitcast <32 x i64> %b to i2048
+
+  %res = call {i2048, i1} @llvm.uadd.with.overflow.i2048(i2048 %aa, i2048 %bb)
+  %sum = extractvalue {i2048, i1} %res, 0
+  %obit = extractvalue {i2048, i1} %res, 1
+
+  %sum1 = bitcast i2048 %sum to <32 x i64>
+  store <32 x i64> %sum1, <32 x i64>* %ps
+  ret i1 %obit
+}
+
+declare {i4096, i1} @llvm.uadd.with.overflow.i4096(i4096 %a, i4096 %b)
+
+define i1 @uadd_with_overflow_i4096(<64 x i64>* %pa, <64 x i64>* %pb, <64 x i64>* %ps) {
+entry:
+; CHECK-LABEL: uadd_with_overflow_i4096:
+; CHECK-NOT: adcq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: vmovmskpd %ymm
+; CHECK: imulq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: ret
+  %a = load <64 x i64>* %pa
+  %b = load <64 x i64>* %pb
+  %aa = bitcast <64 x i64> %a to i4096
+  %bb = bitcast <64 x i64> %b to i4096
+
+  %res = call {i4096, i1} @llvm.uadd.with.overflow.i4096(i4096 %aa, i4096 %bb)
+  %sum = extractvalue {i4096, i1} %res, 0
+  %obit = extractvalue {i4096, i1} %res, 1
+
+  %sum1 = bitcast i4096 %sum to <64 x i64>
+  store <64 x i64> %sum1, <64 x i64>* %ps
+  ret i1 %obit
+}
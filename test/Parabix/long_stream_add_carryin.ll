@@ -0,0 +1,23 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-unknown -mattr=+avx2 | FileCheck %s
+
+declare {i1024, i1} @llvm.uadd.with.overflow.carryin.i1024(i1024 %a, i1024 %b, i1 %carryin)
+
+define i1 @uadd_with_overflow_carryin_i1024(<16 x i64>* %pa, <16 x i64>* %pb, <16 x i64>* %ps, i1 %carryin) {
+entry:
+; CHECK-LABEL: uadd_with_overflow_carryin_i1024:
+; CHECK-NOT: adcq
+; CHECK: vpaddq {{.*}}%ymm
+; CHECK: ret
+  %a = load <16 x i64>* %pa
+  %b = load <16 x i64>* %pb
+  %aa = bitcast <16 x i64> %a to i1024
+  %bb = bitcast <16 x i64> %b to i1024
+
+  %res = call {i1024, i1} @llvm.uadd.with.overflow.carryin.i1024(i1024 %aa, i1024 %bb, i1 %carryin)
+  %sum = extractvalue {i1024, i1} %res, 0
+  %obit = extractvalue {i1024, i1} %res, 1
+
+  %sum1 = bitcast i1024 %sum to <16 x i64>
+  store <16 x i64> %sum1, <16 x i64>* %ps
+  ret i1 %obit
+}
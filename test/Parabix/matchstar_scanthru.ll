@@ -0,0 +1,143 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 | FileCheck %s -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=-sse2 | FileCheck %s -check-prefix=NOSSE
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -O0 -mattr=-sse2 | FileCheck %s -check-prefix=NOSSE
+
+declare {i64, i1} @llvm.parabix.matchstar.i64(i64, i64, i1)
+declare {i96, i1} @llvm.parabix.scanthru.i96(i96, i96, i1)
+declare {i128, i1} @llvm.parabix.matchstar.i128(i128, i128, i1)
+declare {i128, i1} @llvm.parabix.scanthru.i128(i128, i128, i1)
+declare {i256, i1} @llvm.parabix.matchstar.i256(i256, i256, i1)
+declare {i512, i1} @llvm.parabix.scanthru.i512(i512, i512, i1)
+
+define i1 @matchstar_i128(i128* %mp, i128* %cp, i1 %cin, i128* %out) {
+  %m = load i128* %mp
+  %c = load i128* %cp
+  %r = call {i128, i1} @llvm.parabix.matchstar.i128(i128 %m, i128 %c, i1 %cin)
+  %v = extractvalue {i128, i1} %r, 0
+  %co = extractvalue {i128, i1} %r, 1
+  store i128 %v, i128* %out
+  ret i1 %co
+}
+; SSE2-LABEL: matchstar_i128:
+; SSE2: movmskpd
+; SSE2: paddq
+; SSE2: pxor
+; SSE2: por
+; SSE2-NOT: adcq
+; NOSSE-LABEL: matchstar_i128:
+; NOSSE: addq
+; NOSSE: adcq
+; NOSSE: retq
+
+define i1 @scanthru_i128(i128* %mp, i128* %cp, i1 %cin, i128* %out) {
+  %m = load i128* %mp
+  %c = load i128* %cp
+  %r = call {i128, i1} @llvm.parabix.scanthru.i128(i128 %m, i128 %c, i1 %cin)
+  %v = extractvalue {i128, i1} %r, 0
+  %co = extractvalue {i128, i1} %r, 1
+  store i128 %v, i128* %out
+  ret i1 %co
+}
+; SSE2-LABEL: scanthru_i128:
+; SSE2: movmskpd
+; SSE2: paddq
+; SSE2: pandn
+; SSE2-NOT: adcq
+
+; Widths without a long stream addition are plain adds and compares.
+define i1 @matchstar_i64(i64 %m, i64 %c, i1 %cin, i64* %out) {
+  %r = call {i64, i1} @llvm.parabix.matchstar.i64(i64 %m, i64 %c, i1 %cin)
+  %v = extractvalue {i64, i1} %r, 0
+  %co = extractvalue {i64, i1} %r, 1
+  store i64 %v, i64* %out
+  ret i1 %co
+}
+; SSE2-LABEL: matchstar_i64:
+; SSE2: andq
+; SSE2: addq
+; SSE2: orq
+; NOSSE-LABEL: matchstar_i64:
+; NOSSE: andq
+; NOSSE: retq
+
+define i1 @scanthru_i96(i96* %mp, i96* %cp, i1 %cin, i96* %out) {
+  %m = load i96* %mp
+  %c = load i96* %cp
+  %r = call {i96, i1} @llvm.parabix.scanthru.i96(i96 %m, i96 %c, i1 %cin)
+  %v = extractvalue {i96, i1} %r, 0
+  %co = extractvalue {i96, i1} %r, 1
+  store i96 %v, i96* %out
+  ret i1 %co
+}
+; SSE2-LABEL: scanthru_i96:
+; SSE2: addq
+; SSE2: adcq
+; SSE2: movl {{.*}}, 8(%rcx)
+; NOSSE-LABEL: scanthru_i96:
+; NOSSE: adcq
+; NOSSE: retq
+
+; Without AVX the i256 addition is two i128 long stream additions, the carry
+; of the first going into the second.
+define i1 @matchstar_i256(i256* %mp, i256* %cp, i1 %cin, i256* %out) {
+  %m = load i256* %mp
+  %c = load i256* %cp
+  %r = call {i256, i1} @llvm.parabix.matchstar.i256(i256 %m, i256 %c, i1 %cin)
+  %v = extractvalue {i256, i1} %r, 0
+  %co = extractvalue {i256, i1} %r, 1
+  store i256 %v, i256* %out
+  ret i1 %co
+}
+; SSE2-LABEL: matchstar_i256:
+; SSE2: paddq
+; SSE2: movmskpd
+; SSE2: paddq
+; SSE2: movmskpd
+; AVX2-LABEL: matchstar_i256:
+; AVX2: vpaddq %ymm
+; AVX2: vmovmskpd %ymm
+; AVX2-NOT: adcq
+
+define i1 @scanthru_i512(i512* %mp, i512* %cp, i1 %cin, i512* %out) {
+  %m = load i512* %mp
+  %c = load i512* %cp
+  %r = call {i512, i1} @llvm.parabix.scanthru.i512(i512 %m, i512 %c, i1 %cin)
+  %v = extractvalue {i512, i1} %r, 0
+  %co = extractvalue {i512, i1} %r, 1
+  store i512 %v, i512* %out
+  ret i1 %co
+}
+; AVX2-LABEL: scanthru_i512:
+; AVX2: vpaddq %ymm
+; AVX2: vpaddq %ymm
+; AVX2-NOT: adcq
+
+; The carry between blocks stays in a register.
+define void @matchstar_loop(i128* %mp, i128* %cp, i128* %out, i64 %n) {
+entry:
+  br label %body
+
+body:
+  %i = phi i64 [ 0, %entry ], [ %next, %body ]
+  %carry = phi i1 [ false, %entry ], [ %co, %body ]
+  %mi = getelementptr i128* %mp, i64 %i
+  %ci = getelementptr i128* %cp, i64 %i
+  %oi = getelementptr i128* %out, i64 %i
+  %m = load i128* %mi
+  %c = load i128* %ci
+  %r = call {i128, i1} @llvm.parabix.matchstar.i128(i128 %m, i128 %c, i1 %carry)
+  %v = extractvalue {i128, i1} %r, 0
+  %co = extractvalue {i128, i1} %r, 1
+  store i128 %v, i128* %oi
+  %next = add i64 %i, 1
+  %again = icmp ult i64 %next, %n
+  br i1 %again, label %body, label %done
+
+done:
+  ret void
+}
+; SSE2-LABEL: matchstar_loop:
+; SSE2: paddq
+; SSE2-NOT: (%rsp)
+; SSE2: jb
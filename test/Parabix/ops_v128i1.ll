@@ -0,0 +1,224 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+bmi,+bmi2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=BMI2
+
+; Instruction sequences for every <128 x i1> stream operation.
+; Generated by utils/parabix-update-tests.py; regenerate instead of editing.
+
+define <128 x i1> @v128i1_add(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = add <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_add:
+; SSE2-NEXT: xorps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_add:
+; AVXANY-NEXT: vxorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_sub(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = sub <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_sub:
+; SSE2-NEXT: xorps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_sub:
+; AVXANY-NEXT: vxorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_mul(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = mul <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_mul:
+; SSE2-NEXT: andps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_mul:
+; AVXANY-NEXT: vandps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_and(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = and <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_and:
+; SSE2-NEXT: andps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_and:
+; AVXANY-NEXT: vandps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_or(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = or <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_or:
+; SSE2-NEXT: orps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_or:
+; AVXANY-NEXT: vorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_xor(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = xor <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_xor:
+; SSE2-NEXT: xorps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_xor:
+; AVXANY-NEXT: vxorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_eq(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp eq <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_eq:
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: pcmpeqd %xmm1, %xmm1
+; SSE2-NEXT: pxor %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_eq:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_ne(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp ne <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_ne:
+; SSE2-NEXT: xorps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_ne:
+; AVXANY-NEXT: vxorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_ult(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp ult <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_ult:
+; SSE2-NEXT: andnps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_ult:
+; AVXANY-NEXT: vandnps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_ugt(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp ugt <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_ugt:
+; SSE2-NEXT: andnps %xmm0, %xmm1
+; SSE2-NEXT: movaps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_ugt:
+; AVXANY-NEXT: vandnps %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_ule(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp ule <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_ule:
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: pcmpeqd %xmm0, %xmm0
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_ule:
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_uge(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp uge <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_uge:
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: pcmpeqd %xmm1, %xmm1
+; SSE2-NEXT: pxor %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_uge:
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_slt(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp slt <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_slt:
+; SSE2-NEXT: andnps %xmm0, %xmm1
+; SSE2-NEXT: movaps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_slt:
+; AVXANY-NEXT: vandnps %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_sgt(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp sgt <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_sgt:
+; SSE2-NEXT: andnps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_sgt:
+; AVXANY-NEXT: vandnps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_sle(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp sle <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_sle:
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: pcmpeqd %xmm1, %xmm1
+; SSE2-NEXT: pxor %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_sle:
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_icmp_sge(<128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = icmp sge <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_icmp_sge:
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: pcmpeqd %xmm0, %xmm0
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_icmp_sge:
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <128 x i1> @v128i1_select(<128 x i1> %m, <128 x i1> %a, <128 x i1> %b) nounwind {
+  %r = select <128 x i1> %m, <128 x i1> %a, <128 x i1> %b
+  ret <128 x i1> %r
+}
+; SSE2-LABEL: v128i1_select:
+; SSE2-NEXT: movaps %xmm0, %xmm3
+; SSE2-NEXT: andnps %xmm2, %xmm3
+; SSE2-NEXT: andps %xmm1, %xmm0
+; SSE2-NEXT: orps %xmm3, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v128i1_select:
+; AVXANY-NEXT: vandnps %xmm2, %xmm0, %xmm2
+; AVXANY-NEXT: vandps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vorps %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
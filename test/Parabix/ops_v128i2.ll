@@ -0,0 +1,385 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 -asm-verbose=false | FileCheck %s -check-prefix=AVX2ANY -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+bmi,+bmi2 -asm-verbose=false | FileCheck %s -check-prefix=AVX2ANY -check-prefix=BMI2
+
+; Instruction sequences for every <128 x i2> stream operation.
+; Generated by utils/parabix-update-tests.py; regenerate instead of editing.
+; 256-bit streams are only legal with AVX2.
+
+define <128 x i2> @v128i2_add(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = add <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_add:
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_sub(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = sub <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_sub:
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_mul(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = mul <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_mul:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm4, %ymm5
+; AVX2ANY-NEXT: vpor %ymm3, %ymm5, %ymm3
+; AVX2ANY-NEXT: vpsllq $1, %ymm1, %ymm5
+; AVX2ANY-NEXT: vpand %ymm3, %ymm5, %ymm3
+; AVX2ANY-NEXT: vpand %ymm3, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm6
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm5, %ymm2
+; AVX2ANY-NEXT: vpor %ymm2, %ymm6, %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpor %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpand %ymm2, %ymm3, %ymm2
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_and(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = and <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_and:
+; AVX2ANY-NEXT: vandps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_or(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = or <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_or:
+; AVX2ANY-NEXT: vorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_xor(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = xor <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_xor:
+; AVX2ANY-NEXT: vxorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_shl(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = shl <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_shl:
+; AVX2ANY-NEXT: vpsllq $1, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm2, %ymm3
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpand %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpor %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpand %ymm2, %ymm3, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_lshr(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = lshr <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_lshr:
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpand %ymm1, %ymm3, %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpandn %ymm2, %ymm3, %ymm2
+; AVX2ANY-NEXT: vpsllq $1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpand %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_ashr(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = ashr <128 x i2> %a, %b
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_ashr:
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpand %ymm3, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm2, %ymm1
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm2, %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_shl_1(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = shl <128 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_shl_1:
+; AVX2ANY-NEXT: vpsllw $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_lshr_1(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = lshr <128 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_lshr_1:
+; AVX2ANY-NEXT: vpsrlw $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_ashr_1(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = ashr <128 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_ashr_1:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsrlw $1, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsubw %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpsllw $1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpsrlw $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_eq(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp eq <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_eq:
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_ne(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp ne <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_ne:
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm0, %ymm2, %ymm3
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_ult(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp ult <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_ult:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpor %ymm1, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpand %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_ugt(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp ugt <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_ugt:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpand %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_ule(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp ule <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_ule:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpor %ymm0, %ymm3, %ymm3
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpand %ymm3, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_uge(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp uge <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_uge:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpor %ymm1, %ymm3, %ymm3
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpand %ymm3, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_slt(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp slt <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_slt:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpsllq $1, %ymm3, %ymm3
+; AVX2ANY-NEXT: vpand %ymm2, %ymm3, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_sgt(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp sgt <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_sgt:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpor %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpsllq $1, %ymm3, %ymm3
+; AVX2ANY-NEXT: vpand %ymm2, %ymm3, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_sle(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp sle <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_sle:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpsllq $1, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpand %ymm3, %ymm4, %ymm3
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm3, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_icmp_sge(<128 x i2> %a, <128 x i2> %b) nounwind {
+  %c = icmp sge <128 x i2> %a, %b
+  %r = sext <128 x i1> %c to <128 x i2>
+  ret <128 x i2> %r
+}
+; AVX2ANY-LABEL: v128i2_icmp_sge:
+; AVX2ANY-NEXT: vpcmpeqd %ymm2, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpsllq $1, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpand %ymm3, %ymm4, %ymm3
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm3, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm0, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <128 x i2> @v128i2_select(<128 x i1> %m, <128 x i2> %a, <128 x i2> %b) nounwind {
+  %r = select <128 x i1> %m, <128 x i2> %a, <128 x i2> %b
+  ret <128 x i2> %r
+}
+; AVX2-LABEL: v128i2_select:
+; 1966 lines, scalarized; not pinned.
+; BMI2-LABEL: v128i2_select:
+; 1585 lines, scalarized; not pinned.
@@ -0,0 +1,154 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 -asm-verbose=false | FileCheck %s -check-prefix=AVX2ANY -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+bmi,+bmi2 -asm-verbose=false | FileCheck %s -check-prefix=AVX2ANY -check-prefix=BMI2
+
+; Instruction sequences for every <256 x i1> stream operation.
+; Generated by utils/parabix-update-tests.py; regenerate instead of editing.
+; 256-bit streams are only legal with AVX2.
+
+define <256 x i1> @v256i1_add(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = add <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_add:
+; AVX2ANY-NEXT: vxorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_sub(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = sub <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_sub:
+; AVX2ANY-NEXT: vxorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_mul(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = mul <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_mul:
+; AVX2ANY-NEXT: vandps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_and(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = and <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_and:
+; AVX2ANY-NEXT: vandps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_or(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = or <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_or:
+; AVX2ANY-NEXT: vorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_xor(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = xor <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_xor:
+; AVX2ANY-NEXT: vxorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_eq(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp eq <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_eq:
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_ne(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp ne <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_ne:
+; AVX2ANY-NEXT: vxorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_ult(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp ult <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_ult:
+; AVX2ANY-NEXT: vandnps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_ugt(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp ugt <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_ugt:
+; AVX2ANY-NEXT: vandnps %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_ule(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp ule <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_ule:
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_uge(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp uge <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_uge:
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_slt(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp slt <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_slt:
+; AVX2ANY-NEXT: vandnps %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_sgt(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp sgt <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_sgt:
+; AVX2ANY-NEXT: vandnps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_sle(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp sle <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_sle:
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_icmp_sge(<256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = icmp sge <256 x i1> %a, %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_icmp_sge:
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <256 x i1> @v256i1_select(<256 x i1> %m, <256 x i1> %a, <256 x i1> %b) nounwind {
+  %r = select <256 x i1> %m, <256 x i1> %a, <256 x i1> %b
+  ret <256 x i1> %r
+}
+; AVX2ANY-LABEL: v256i1_select:
+; AVX2ANY-NEXT: vandnps %ymm2, %ymm0, %ymm2
+; AVX2ANY-NEXT: vandps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vorps %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
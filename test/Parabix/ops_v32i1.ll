@@ -0,0 +1,311 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+bmi,+bmi2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=BMI2
+
+; Instruction sequences for every <32 x i1> stream operation.
+; Generated by utils/parabix-update-tests.py; regenerate instead of editing.
+
+define <32 x i1> @v32i1_add(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = add <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; CHECK-LABEL: v32i1_add:
+; CHECK-NEXT: xorl %esi, %edi
+; CHECK-NEXT: movl %edi, %eax
+; CHECK-NEXT: retq
+
+define <32 x i1> @v32i1_sub(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = sub <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; CHECK-LABEL: v32i1_sub:
+; CHECK-NEXT: xorl %esi, %edi
+; CHECK-NEXT: movl %edi, %eax
+; CHECK-NEXT: retq
+
+define <32 x i1> @v32i1_mul(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = mul <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; CHECK-LABEL: v32i1_mul:
+; CHECK-NEXT: andl %esi, %edi
+; CHECK-NEXT: movl %edi, %eax
+; CHECK-NEXT: retq
+
+define <32 x i1> @v32i1_and(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = and <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; CHECK-LABEL: v32i1_and:
+; CHECK-NEXT: andl %esi, %edi
+; CHECK-NEXT: movl %edi, %eax
+; CHECK-NEXT: retq
+
+define <32 x i1> @v32i1_or(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = or <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; CHECK-LABEL: v32i1_or:
+; CHECK-NEXT: orl %esi, %edi
+; CHECK-NEXT: movl %edi, %eax
+; CHECK-NEXT: retq
+
+define <32 x i1> @v32i1_xor(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = xor <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; CHECK-LABEL: v32i1_xor:
+; CHECK-NEXT: xorl %esi, %edi
+; CHECK-NEXT: movl %edi, %eax
+; CHECK-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_eq(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp eq <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; CHECK-LABEL: v32i1_icmp_eq:
+; CHECK-NEXT: xorl %esi, %edi
+; CHECK-NEXT: notl %edi
+; CHECK-NEXT: movl %edi, %eax
+; CHECK-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_ne(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp ne <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; CHECK-LABEL: v32i1_icmp_ne:
+; CHECK-NEXT: xorl %esi, %edi
+; CHECK-NEXT: movl %edi, %eax
+; CHECK-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_ult(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp ult <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_icmp_ult:
+; SSE2-NEXT: notl %edi
+; SSE2-NEXT: andl %esi, %edi
+; SSE2-NEXT: movl %edi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_icmp_ult:
+; AVX-NEXT: notl %edi
+; AVX-NEXT: andl %esi, %edi
+; AVX-NEXT: movl %edi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_icmp_ult:
+; AVX2-NEXT: notl %edi
+; AVX2-NEXT: andl %esi, %edi
+; AVX2-NEXT: movl %edi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_icmp_ult:
+; BMI2-NEXT: andnl %esi, %edi, %eax
+; BMI2-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_ugt(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp ugt <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_icmp_ugt:
+; SSE2-NEXT: notl %esi
+; SSE2-NEXT: andl %edi, %esi
+; SSE2-NEXT: movl %esi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_icmp_ugt:
+; AVX-NEXT: notl %esi
+; AVX-NEXT: andl %edi, %esi
+; AVX-NEXT: movl %esi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_icmp_ugt:
+; AVX2-NEXT: notl %esi
+; AVX2-NEXT: andl %edi, %esi
+; AVX2-NEXT: movl %esi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_icmp_ugt:
+; BMI2-NEXT: andnl %edi, %esi, %eax
+; BMI2-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_ule(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp ule <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_icmp_ule:
+; SSE2-NEXT: notl %esi
+; SSE2-NEXT: andl %edi, %esi
+; SSE2-NEXT: notl %esi
+; SSE2-NEXT: movl %esi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_icmp_ule:
+; AVX-NEXT: notl %esi
+; AVX-NEXT: andl %edi, %esi
+; AVX-NEXT: notl %esi
+; AVX-NEXT: movl %esi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_icmp_ule:
+; AVX2-NEXT: notl %esi
+; AVX2-NEXT: andl %edi, %esi
+; AVX2-NEXT: notl %esi
+; AVX2-NEXT: movl %esi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_icmp_ule:
+; BMI2-NEXT: andnl %edi, %esi, %eax
+; BMI2-NEXT: notl %eax
+; BMI2-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_uge(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp uge <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_icmp_uge:
+; SSE2-NEXT: notl %edi
+; SSE2-NEXT: andl %esi, %edi
+; SSE2-NEXT: notl %edi
+; SSE2-NEXT: movl %edi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_icmp_uge:
+; AVX-NEXT: notl %edi
+; AVX-NEXT: andl %esi, %edi
+; AVX-NEXT: notl %edi
+; AVX-NEXT: movl %edi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_icmp_uge:
+; AVX2-NEXT: notl %edi
+; AVX2-NEXT: andl %esi, %edi
+; AVX2-NEXT: notl %edi
+; AVX2-NEXT: movl %edi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_icmp_uge:
+; BMI2-NEXT: andnl %esi, %edi, %eax
+; BMI2-NEXT: notl %eax
+; BMI2-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_slt(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp slt <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_icmp_slt:
+; SSE2-NEXT: notl %esi
+; SSE2-NEXT: andl %edi, %esi
+; SSE2-NEXT: movl %esi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_icmp_slt:
+; AVX-NEXT: notl %esi
+; AVX-NEXT: andl %edi, %esi
+; AVX-NEXT: movl %esi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_icmp_slt:
+; AVX2-NEXT: notl %esi
+; AVX2-NEXT: andl %edi, %esi
+; AVX2-NEXT: movl %esi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_icmp_slt:
+; BMI2-NEXT: andnl %edi, %esi, %eax
+; BMI2-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_sgt(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp sgt <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_icmp_sgt:
+; SSE2-NEXT: notl %edi
+; SSE2-NEXT: andl %esi, %edi
+; SSE2-NEXT: movl %edi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_icmp_sgt:
+; AVX-NEXT: notl %edi
+; AVX-NEXT: andl %esi, %edi
+; AVX-NEXT: movl %edi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_icmp_sgt:
+; AVX2-NEXT: notl %edi
+; AVX2-NEXT: andl %esi, %edi
+; AVX2-NEXT: movl %edi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_icmp_sgt:
+; BMI2-NEXT: andnl %esi, %edi, %eax
+; BMI2-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_sle(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp sle <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_icmp_sle:
+; SSE2-NEXT: notl %edi
+; SSE2-NEXT: andl %esi, %edi
+; SSE2-NEXT: notl %edi
+; SSE2-NEXT: movl %edi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_icmp_sle:
+; AVX-NEXT: notl %edi
+; AVX-NEXT: andl %esi, %edi
+; AVX-NEXT: notl %edi
+; AVX-NEXT: movl %edi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_icmp_sle:
+; AVX2-NEXT: notl %edi
+; AVX2-NEXT: andl %esi, %edi
+; AVX2-NEXT: notl %edi
+; AVX2-NEXT: movl %edi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_icmp_sle:
+; BMI2-NEXT: andnl %esi, %edi, %eax
+; BMI2-NEXT: notl %eax
+; BMI2-NEXT: retq
+
+define <32 x i1> @v32i1_icmp_sge(<32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = icmp sge <32 x i1> %a, %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_icmp_sge:
+; SSE2-NEXT: notl %esi
+; SSE2-NEXT: andl %edi, %esi
+; SSE2-NEXT: notl %esi
+; SSE2-NEXT: movl %esi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_icmp_sge:
+; AVX-NEXT: notl %esi
+; AVX-NEXT: andl %edi, %esi
+; AVX-NEXT: notl %esi
+; AVX-NEXT: movl %esi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_icmp_sge:
+; AVX2-NEXT: notl %esi
+; AVX2-NEXT: andl %edi, %esi
+; AVX2-NEXT: notl %esi
+; AVX2-NEXT: movl %esi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_icmp_sge:
+; BMI2-NEXT: andnl %edi, %esi, %eax
+; BMI2-NEXT: notl %eax
+; BMI2-NEXT: retq
+
+define <32 x i1> @v32i1_select(<32 x i1> %m, <32 x i1> %a, <32 x i1> %b) nounwind {
+  %r = select <32 x i1> %m, <32 x i1> %a, <32 x i1> %b
+  ret <32 x i1> %r
+}
+; SSE2-LABEL: v32i1_select:
+; SSE2-NEXT: andl %edi, %esi
+; SSE2-NEXT: notl %edi
+; SSE2-NEXT: andl %edx, %edi
+; SSE2-NEXT: orl %esi, %edi
+; SSE2-NEXT: movl %edi, %eax
+; SSE2-NEXT: retq
+; AVX-LABEL: v32i1_select:
+; AVX-NEXT: andl %edi, %esi
+; AVX-NEXT: notl %edi
+; AVX-NEXT: andl %edx, %edi
+; AVX-NEXT: orl %esi, %edi
+; AVX-NEXT: movl %edi, %eax
+; AVX-NEXT: retq
+; AVX2-LABEL: v32i1_select:
+; AVX2-NEXT: andl %edi, %esi
+; AVX2-NEXT: notl %edi
+; AVX2-NEXT: andl %edx, %edi
+; AVX2-NEXT: orl %esi, %edi
+; AVX2-NEXT: movl %edi, %eax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v32i1_select:
+; BMI2-NEXT: andnl %edx, %edi, %eax
+; BMI2-NEXT: andl %edi, %esi
+; BMI2-NEXT: orl %esi, %eax
+; BMI2-NEXT: retq
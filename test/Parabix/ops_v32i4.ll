@@ -0,0 +1,899 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+bmi,+bmi2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=BMI2
+
+; Instruction sequences for every <32 x i4> stream operation.
+; Generated by utils/parabix-update-tests.py; regenerate instead of editing.
+
+define <32 x i4> @v32i4_add(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = add <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_add:
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: pand %xmm2, %xmm3
+; SSE2-NEXT: pand %xmm0, %xmm2
+; SSE2-NEXT: paddq %xmm3, %xmm2
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: pxor %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_add:
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; AVXANY-NEXT: vpand %xmm2, %xmm1, %xmm3
+; AVXANY-NEXT: vpand %xmm2, %xmm0, %xmm2
+; AVXANY-NEXT: vpaddq %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpxor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_sub(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = sub <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_sub:
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pxor %xmm0, %xmm2
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: pandn %xmm3, %xmm2
+; SSE2-NEXT: por %xmm3, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: psubq %xmm1, %xmm0
+; SSE2-NEXT: pxor %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_sub:
+; AVXANY-NEXT: vpxor %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpandn %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpor %xmm3, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_mul(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = mul <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_mul:
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: psrlw $4, %xmm3
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; SSE2-NEXT: pand %xmm2, %xmm3
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm4
+; SSE2-NEXT: movdqa %xmm3, %xmm5
+; SSE2-NEXT: pand %xmm4, %xmm5
+; SSE2-NEXT: movdqa %xmm1, %xmm6
+; SSE2-NEXT: psrlw $4, %xmm6
+; SSE2-NEXT: pand %xmm2, %xmm6
+; SSE2-NEXT: pmullw %xmm6, %xmm3
+; SSE2-NEXT: psrlw $8, %xmm6
+; SSE2-NEXT: pmullw %xmm5, %xmm6
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: pand %xmm5, %xmm3
+; SSE2-NEXT: por %xmm6, %xmm3
+; SSE2-NEXT: psllw $4, %xmm3
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; SSE2-NEXT: pand %xmm2, %xmm3
+; SSE2-NEXT: pand %xmm0, %xmm4
+; SSE2-NEXT: pmullw %xmm1, %xmm0
+; SSE2-NEXT: psrlw $8, %xmm1
+; SSE2-NEXT: pmullw %xmm4, %xmm1
+; SSE2-NEXT: pand %xmm5, %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: por %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_mul:
+; AVXANY-NEXT: vpsrlw $4, %xmm0, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpand %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm4
+; AVXANY-NEXT: vpand %xmm4, %xmm2, %xmm5
+; AVXANY-NEXT: vpsrlw $4, %xmm1, %xmm6
+; AVXANY-NEXT: vpand %xmm3, %xmm6, %xmm3
+; AVXANY-NEXT: vpsrlw $8, %xmm3, %xmm6
+; AVXANY-NEXT: vpmullw %xmm6, %xmm5, %xmm5
+; AVXANY-NEXT: vpmullw %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpand %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpor %xmm5, %xmm2, %xmm2
+; AVXANY-NEXT: vpsllw $4, %xmm2, %xmm2
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; AVXANY-NEXT: vpand %xmm2, %xmm5, %xmm2
+; AVXANY-NEXT: vpand %xmm4, %xmm0, %xmm4
+; AVXANY-NEXT: vpsrlw $8, %xmm1, %xmm6
+; AVXANY-NEXT: vpmullw %xmm6, %xmm4, %xmm4
+; AVXANY-NEXT: vpmullw %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm3, %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm4, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm5, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_and(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = and <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_and:
+; SSE2-NEXT: andps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_and:
+; AVXANY-NEXT: vandps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_or(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = or <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_or:
+; SSE2-NEXT: orps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_or:
+; AVXANY-NEXT: vorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_xor(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = xor <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_xor:
+; SSE2-NEXT: xorps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_xor:
+; AVXANY-NEXT: vxorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_shl(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = shl <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_shl:
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: psllq $3, %xmm2
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm4
+; SSE2-NEXT: psrlq $3, %xmm4
+; SSE2-NEXT: movdqa %xmm2, %xmm5
+; SSE2-NEXT: psubq %xmm4, %xmm5
+; SSE2-NEXT: por %xmm2, %xmm5
+; SSE2-NEXT: movdqa %xmm5, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: psllq $1, %xmm0
+; SSE2-NEXT: pand %xmm5, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: psllq $2, %xmm1
+; SSE2-NEXT: pand %xmm3, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: psrlq $3, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: psubq %xmm2, %xmm3
+; SSE2-NEXT: por %xmm1, %xmm3
+; SSE2-NEXT: movdqa %xmm3, %xmm1
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: psllq $2, %xmm0
+; SSE2-NEXT: pand %xmm3, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_shl:
+; AVXANY-NEXT: vpsllq $3, %xmm1, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpand %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpsrlq $3, %xmm2, %xmm4
+; AVXANY-NEXT: vpsubq %xmm4, %xmm2, %xmm4
+; AVXANY-NEXT: vpor %xmm4, %xmm2, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm2, %xmm4
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm4, %xmm0, %xmm0
+; AVXANY-NEXT: vpsllq $2, %xmm1, %xmm1
+; AVXANY-NEXT: vpand %xmm3, %xmm1, %xmm1
+; AVXANY-NEXT: vpsrlq $3, %xmm1, %xmm2
+; AVXANY-NEXT: vpsubq %xmm2, %xmm1, %xmm2
+; AVXANY-NEXT: vpor %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsllq $2, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_lshr(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = lshr <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_lshr:
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: psllq $3, %xmm2
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm4
+; SSE2-NEXT: psrlq $3, %xmm4
+; SSE2-NEXT: movdqa %xmm2, %xmm5
+; SSE2-NEXT: psubq %xmm4, %xmm5
+; SSE2-NEXT: por %xmm2, %xmm5
+; SSE2-NEXT: movdqa %xmm5, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: psrlq $1, %xmm0
+; SSE2-NEXT: pand %xmm5, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: psllq $2, %xmm1
+; SSE2-NEXT: pand %xmm3, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: psrlq $3, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: psubq %xmm2, %xmm3
+; SSE2-NEXT: por %xmm1, %xmm3
+; SSE2-NEXT: movdqa %xmm3, %xmm1
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: psrlq $2, %xmm0
+; SSE2-NEXT: pand %xmm3, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_lshr:
+; AVXANY-NEXT: vpsllq $3, %xmm1, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpand %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpsrlq $3, %xmm2, %xmm4
+; AVXANY-NEXT: vpsubq %xmm4, %xmm2, %xmm4
+; AVXANY-NEXT: vpor %xmm4, %xmm2, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm2, %xmm4
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm4, %xmm0, %xmm0
+; AVXANY-NEXT: vpsllq $2, %xmm1, %xmm1
+; AVXANY-NEXT: vpand %xmm3, %xmm1, %xmm1
+; AVXANY-NEXT: vpsrlq $3, %xmm1, %xmm2
+; AVXANY-NEXT: vpsubq %xmm2, %xmm1, %xmm2
+; AVXANY-NEXT: vpor %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsrlq $2, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_ashr(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = ashr <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_ashr:
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: psllq $3, %xmm2
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm4
+; SSE2-NEXT: psrlq $3, %xmm4
+; SSE2-NEXT: movdqa %xmm2, %xmm5
+; SSE2-NEXT: psubq %xmm4, %xmm5
+; SSE2-NEXT: por %xmm2, %xmm5
+; SSE2-NEXT: movdqa %xmm5, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm4
+; SSE2-NEXT: pand %xmm3, %xmm4
+; SSE2-NEXT: psrlq $1, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: por %xmm4, %xmm0
+; SSE2-NEXT: pand %xmm5, %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm4
+; SSE2-NEXT: psrlq $2, %xmm4
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm4
+; SSE2-NEXT: por %xmm2, %xmm4
+; SSE2-NEXT: psrlq $1, %xmm2
+; SSE2-NEXT: por %xmm4, %xmm2
+; SSE2-NEXT: psllq $2, %xmm1
+; SSE2-NEXT: pand %xmm3, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: psrlq $3, %xmm3
+; SSE2-NEXT: movdqa %xmm1, %xmm4
+; SSE2-NEXT: psubq %xmm3, %xmm4
+; SSE2-NEXT: por %xmm1, %xmm4
+; SSE2-NEXT: pand %xmm4, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm4
+; SSE2-NEXT: por %xmm4, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_ashr:
+; AVXANY-NEXT: vpsllq $3, %xmm1, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpand %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpsrlq $3, %xmm2, %xmm4
+; AVXANY-NEXT: vpsubq %xmm4, %xmm2, %xmm4
+; AVXANY-NEXT: vpor %xmm4, %xmm2, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm2, %xmm4
+; AVXANY-NEXT: vpand %xmm3, %xmm0, %xmm5
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm5, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: vpor %xmm4, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm3, %xmm0, %xmm2
+; AVXANY-NEXT: vpsrlq $2, %xmm0, %xmm4
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm4, %xmm4
+; AVXANY-NEXT: vpor %xmm2, %xmm4, %xmm4
+; AVXANY-NEXT: vpsrlq $1, %xmm2, %xmm2
+; AVXANY-NEXT: vpor %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpsllq $2, %xmm1, %xmm1
+; AVXANY-NEXT: vpand %xmm3, %xmm1, %xmm1
+; AVXANY-NEXT: vpsrlq $3, %xmm1, %xmm3
+; AVXANY-NEXT: vpsubq %xmm3, %xmm1, %xmm3
+; AVXANY-NEXT: vpor %xmm3, %xmm1, %xmm1
+; AVXANY-NEXT: vpand %xmm2, %xmm1, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_shl_1(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = shl <32 x i4> %a, <i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_shl_1:
+; SSE2-NEXT: psllw $1, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_shl_1:
+; AVXANY-NEXT: vpsllw $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_lshr_1(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = lshr <32 x i4> %a, <i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_lshr_1:
+; SSE2-NEXT: psrlw $1, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_lshr_1:
+; AVXANY-NEXT: vpsrlw $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_ashr_1(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = ashr <32 x i4> %a, <i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_ashr_1:
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: pand %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: psrlw $1, %xmm2
+; SSE2-NEXT: psubw %xmm2, %xmm1
+; SSE2-NEXT: psllw $1, %xmm1
+; SSE2-NEXT: psrlw $1, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_ashr_1:
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm1
+; AVXANY-NEXT: vpsrlw $1, %xmm1, %xmm2
+; AVXANY-NEXT: vpsubw %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpsllw $1, %xmm1, %xmm1
+; AVXANY-NEXT: vpsrlw $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_eq(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp eq <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_eq:
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pand %xmm1, %xmm2
+; SSE2-NEXT: paddq %xmm1, %xmm2
+; SSE2-NEXT: por %xmm0, %xmm2
+; SSE2-NEXT: pandn {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm1
+; SSE2-NEXT: psrlq $3, %xmm1
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: psubq %xmm1, %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_eq:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm1, %xmm0, %xmm2
+; AVXANY-NEXT: vpaddq %xmm1, %xmm2, %xmm1
+; AVXANY-NEXT: vpor %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpandn {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_ne(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp ne <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_ne:
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pand %xmm1, %xmm2
+; SSE2-NEXT: paddq %xmm1, %xmm2
+; SSE2-NEXT: por %xmm0, %xmm2
+; SSE2-NEXT: pandn {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: psrlq $3, %xmm0
+; SSE2-NEXT: movdqa %xmm2, %xmm1
+; SSE2-NEXT: psubq %xmm0, %xmm1
+; SSE2-NEXT: por %xmm2, %xmm1
+; SSE2-NEXT: pcmpeqd %xmm0, %xmm0
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_ne:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm1, %xmm0, %xmm2
+; AVXANY-NEXT: vpaddq %xmm1, %xmm2, %xmm1
+; AVXANY-NEXT: vpor %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpandn {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_ult(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp ult <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_ult:
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pxor %xmm0, %xmm2
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: pandn %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm4
+; SSE2-NEXT: por %xmm3, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: pand %xmm1, %xmm5
+; SSE2-NEXT: psubq %xmm5, %xmm4
+; SSE2-NEXT: pxor %xmm2, %xmm4
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: pxor %xmm0, %xmm2
+; SSE2-NEXT: por %xmm1, %xmm2
+; SSE2-NEXT: pand %xmm4, %xmm2
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: pand %xmm3, %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: psrlq $3, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm1
+; SSE2-NEXT: psubq %xmm2, %xmm1
+; SSE2-NEXT: por %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_ult:
+; AVXANY-NEXT: vpxor %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpandn %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpor %xmm3, %xmm0, %xmm4
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1, %xmm5
+; AVXANY-NEXT: vpsubq %xmm5, %xmm4, %xmm4
+; AVXANY-NEXT: vpxor %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpcmpeqd %xmm4, %xmm4, %xmm4
+; AVXANY-NEXT: vpxor %xmm4, %xmm0, %xmm4
+; AVXANY-NEXT: vpor %xmm1, %xmm4, %xmm4
+; AVXANY-NEXT: vpand %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm3, %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_ugt(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp ugt <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_ugt:
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pxor %xmm1, %xmm2
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: pandn %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm4
+; SSE2-NEXT: por %xmm3, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: pand %xmm0, %xmm5
+; SSE2-NEXT: psubq %xmm5, %xmm4
+; SSE2-NEXT: pxor %xmm2, %xmm4
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: pxor %xmm1, %xmm2
+; SSE2-NEXT: por %xmm0, %xmm2
+; SSE2-NEXT: pand %xmm4, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: por %xmm2, %xmm1
+; SSE2-NEXT: pand %xmm3, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: psrlq $3, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: psubq %xmm2, %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_ugt:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpandn %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpor %xmm3, %xmm1, %xmm4
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm5
+; AVXANY-NEXT: vpsubq %xmm5, %xmm4, %xmm4
+; AVXANY-NEXT: vpxor %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpcmpeqd %xmm4, %xmm4, %xmm4
+; AVXANY-NEXT: vpxor %xmm4, %xmm1, %xmm4
+; AVXANY-NEXT: vpor %xmm0, %xmm4, %xmm4
+; AVXANY-NEXT: vpand %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm3, %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_ule(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp ule <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_ule:
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pxor %xmm1, %xmm2
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: pandn %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm4
+; SSE2-NEXT: por %xmm3, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: pand %xmm0, %xmm5
+; SSE2-NEXT: psubq %xmm5, %xmm4
+; SSE2-NEXT: pxor %xmm2, %xmm4
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm5
+; SSE2-NEXT: pxor %xmm2, %xmm5
+; SSE2-NEXT: por %xmm0, %xmm5
+; SSE2-NEXT: pand %xmm4, %xmm5
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: por %xmm5, %xmm1
+; SSE2-NEXT: pand %xmm3, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: psrlq $3, %xmm0
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: psubq %xmm0, %xmm3
+; SSE2-NEXT: por %xmm1, %xmm3
+; SSE2-NEXT: pxor %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_ule:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpandn %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpor %xmm3, %xmm1, %xmm4
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm5
+; AVXANY-NEXT: vpsubq %xmm5, %xmm4, %xmm4
+; AVXANY-NEXT: vpxor %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpcmpeqd %xmm4, %xmm4, %xmm4
+; AVXANY-NEXT: vpxor %xmm4, %xmm1, %xmm5
+; AVXANY-NEXT: vpor %xmm0, %xmm5, %xmm5
+; AVXANY-NEXT: vpand %xmm2, %xmm5, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm3, %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpxor %xmm4, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_uge(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp uge <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_uge:
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pxor %xmm0, %xmm2
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: pandn %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm4
+; SSE2-NEXT: por %xmm3, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: pand %xmm1, %xmm5
+; SSE2-NEXT: psubq %xmm5, %xmm4
+; SSE2-NEXT: pxor %xmm2, %xmm4
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm5
+; SSE2-NEXT: pxor %xmm2, %xmm5
+; SSE2-NEXT: por %xmm1, %xmm5
+; SSE2-NEXT: pand %xmm4, %xmm5
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: por %xmm5, %xmm0
+; SSE2-NEXT: pand %xmm3, %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: psrlq $3, %xmm3
+; SSE2-NEXT: movdqa %xmm0, %xmm1
+; SSE2-NEXT: psubq %xmm3, %xmm1
+; SSE2-NEXT: por %xmm0, %xmm1
+; SSE2-NEXT: pxor %xmm2, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_uge:
+; AVXANY-NEXT: vpxor %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpandn %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vpor %xmm3, %xmm0, %xmm4
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1, %xmm5
+; AVXANY-NEXT: vpsubq %xmm5, %xmm4, %xmm4
+; AVXANY-NEXT: vpxor %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpcmpeqd %xmm4, %xmm4, %xmm4
+; AVXANY-NEXT: vpxor %xmm4, %xmm0, %xmm5
+; AVXANY-NEXT: vpor %xmm1, %xmm5, %xmm5
+; AVXANY-NEXT: vpand %xmm2, %xmm5, %xmm2
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm3, %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpxor %xmm4, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_slt(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp slt <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_slt:
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pxor %xmm3, %xmm2
+; SSE2-NEXT: pxor %xmm3, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm4
+; SSE2-NEXT: pxor %xmm2, %xmm4
+; SSE2-NEXT: pandn %xmm3, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: movdqa %xmm1, %xmm6
+; SSE2-NEXT: pand %xmm5, %xmm6
+; SSE2-NEXT: movdqa %xmm2, %xmm7
+; SSE2-NEXT: por %xmm3, %xmm7
+; SSE2-NEXT: psubq %xmm6, %xmm7
+; SSE2-NEXT: pxor %xmm4, %xmm7
+; SSE2-NEXT: pxor %xmm5, %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: pand %xmm7, %xmm0
+; SSE2-NEXT: pandn %xmm1, %xmm2
+; SSE2-NEXT: por %xmm0, %xmm2
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm1
+; SSE2-NEXT: psrlq $3, %xmm1
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: psubq %xmm1, %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_slt:
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm3
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm3, %xmm1, %xmm4
+; AVXANY-NEXT: vpandn %xmm2, %xmm4, %xmm4
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; AVXANY-NEXT: vpand %xmm5, %xmm1, %xmm6
+; AVXANY-NEXT: vpor %xmm2, %xmm3, %xmm7
+; AVXANY-NEXT: vpsubq %xmm6, %xmm7, %xmm6
+; AVXANY-NEXT: vpxor %xmm4, %xmm6, %xmm4
+; AVXANY-NEXT: vpxor %xmm5, %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm4, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm1, %xmm3, %xmm1
+; AVXANY-NEXT: vpor %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpand %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_sgt(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp sgt <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_sgt:
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pxor %xmm3, %xmm2
+; SSE2-NEXT: pxor %xmm3, %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm4
+; SSE2-NEXT: pxor %xmm2, %xmm4
+; SSE2-NEXT: pandn %xmm3, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: movdqa %xmm0, %xmm6
+; SSE2-NEXT: pand %xmm5, %xmm6
+; SSE2-NEXT: movdqa %xmm2, %xmm7
+; SSE2-NEXT: por %xmm3, %xmm7
+; SSE2-NEXT: psubq %xmm6, %xmm7
+; SSE2-NEXT: pxor %xmm4, %xmm7
+; SSE2-NEXT: pxor %xmm5, %xmm1
+; SSE2-NEXT: por %xmm0, %xmm1
+; SSE2-NEXT: pand %xmm7, %xmm1
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: por %xmm1, %xmm2
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm1
+; SSE2-NEXT: psrlq $3, %xmm1
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: psubq %xmm1, %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_sgt:
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm3
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpxor %xmm3, %xmm0, %xmm4
+; AVXANY-NEXT: vpandn %xmm2, %xmm4, %xmm4
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; AVXANY-NEXT: vpand %xmm5, %xmm0, %xmm6
+; AVXANY-NEXT: vpor %xmm2, %xmm3, %xmm7
+; AVXANY-NEXT: vpsubq %xmm6, %xmm7, %xmm6
+; AVXANY-NEXT: vpxor %xmm4, %xmm6, %xmm4
+; AVXANY-NEXT: vpxor %xmm5, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm0, %xmm1, %xmm1
+; AVXANY-NEXT: vpand %xmm4, %xmm1, %xmm1
+; AVXANY-NEXT: vpandn %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_sle(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp sle <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_sle:
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pxor %xmm3, %xmm2
+; SSE2-NEXT: pxor %xmm3, %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm4
+; SSE2-NEXT: pxor %xmm2, %xmm4
+; SSE2-NEXT: pandn %xmm3, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: movdqa %xmm0, %xmm6
+; SSE2-NEXT: pand %xmm5, %xmm6
+; SSE2-NEXT: movdqa %xmm2, %xmm7
+; SSE2-NEXT: por %xmm3, %xmm7
+; SSE2-NEXT: psubq %xmm6, %xmm7
+; SSE2-NEXT: pxor %xmm4, %xmm7
+; SSE2-NEXT: pxor %xmm5, %xmm1
+; SSE2-NEXT: por %xmm0, %xmm1
+; SSE2-NEXT: pand %xmm7, %xmm1
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: por %xmm1, %xmm2
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: psrlq $3, %xmm0
+; SSE2-NEXT: movdqa %xmm2, %xmm1
+; SSE2-NEXT: psubq %xmm0, %xmm1
+; SSE2-NEXT: por %xmm2, %xmm1
+; SSE2-NEXT: pcmpeqd %xmm0, %xmm0
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_sle:
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm3
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpxor %xmm3, %xmm0, %xmm4
+; AVXANY-NEXT: vpandn %xmm2, %xmm4, %xmm4
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; AVXANY-NEXT: vpand %xmm5, %xmm0, %xmm6
+; AVXANY-NEXT: vpor %xmm2, %xmm3, %xmm7
+; AVXANY-NEXT: vpsubq %xmm6, %xmm7, %xmm6
+; AVXANY-NEXT: vpxor %xmm4, %xmm6, %xmm4
+; AVXANY-NEXT: vpxor %xmm5, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm0, %xmm1, %xmm1
+; AVXANY-NEXT: vpand %xmm4, %xmm1, %xmm1
+; AVXANY-NEXT: vpandn %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_icmp_sge(<32 x i4> %a, <32 x i4> %b) nounwind {
+  %c = icmp sge <32 x i4> %a, %b
+  %r = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_icmp_sge:
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pxor %xmm3, %xmm2
+; SSE2-NEXT: pxor %xmm3, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm4
+; SSE2-NEXT: pxor %xmm2, %xmm4
+; SSE2-NEXT: pandn %xmm3, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; SSE2-NEXT: movdqa %xmm1, %xmm6
+; SSE2-NEXT: pand %xmm5, %xmm6
+; SSE2-NEXT: movdqa %xmm2, %xmm7
+; SSE2-NEXT: por %xmm3, %xmm7
+; SSE2-NEXT: psubq %xmm6, %xmm7
+; SSE2-NEXT: pxor %xmm4, %xmm7
+; SSE2-NEXT: pxor %xmm5, %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: pand %xmm7, %xmm0
+; SSE2-NEXT: pandn %xmm1, %xmm2
+; SSE2-NEXT: por %xmm0, %xmm2
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: psrlq $3, %xmm0
+; SSE2-NEXT: movdqa %xmm2, %xmm1
+; SSE2-NEXT: psubq %xmm0, %xmm1
+; SSE2-NEXT: por %xmm2, %xmm1
+; SSE2-NEXT: pcmpeqd %xmm0, %xmm0
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v32i4_icmp_sge:
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm3
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm3, %xmm1, %xmm4
+; AVXANY-NEXT: vpandn %xmm2, %xmm4, %xmm4
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm5
+; AVXANY-NEXT: vpand %xmm5, %xmm1, %xmm6
+; AVXANY-NEXT: vpor %xmm2, %xmm3, %xmm7
+; AVXANY-NEXT: vpsubq %xmm6, %xmm7, %xmm6
+; AVXANY-NEXT: vpxor %xmm4, %xmm6, %xmm4
+; AVXANY-NEXT: vpxor %xmm5, %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand %xmm4, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm1, %xmm3, %xmm1
+; AVXANY-NEXT: vpor %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpand %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vpsrlq $3, %xmm0, %xmm1
+; AVXANY-NEXT: vpsubq %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <32 x i4> @v32i4_select(<32 x i1> %m, <32 x i4> %a, <32 x i4> %b) nounwind {
+  %r = select <32 x i1> %m, <32 x i4> %a, <32 x i4> %b
+  ret <32 x i4> %r
+}
+; SSE2-LABEL: v32i4_select:
+; 525 lines, scalarized; not pinned.
+; AVX-LABEL: v32i4_select:
+; 482 lines, scalarized; not pinned.
+; AVX2-LABEL: v32i4_select:
+; 482 lines, scalarized; not pinned.
+; BMI2-LABEL: v32i4_select:
+; 418 lines, scalarized; not pinned.
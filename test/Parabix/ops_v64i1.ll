@@ -0,0 +1,311 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+bmi,+bmi2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=BMI2
+
+; Instruction sequences for every <64 x i1> stream operation.
+; Generated by utils/parabix-update-tests.py; regenerate instead of editing.
+
+define <64 x i1> @v64i1_add(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = add <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK-LABEL: v64i1_add:
+; CHECK-NEXT: xorq %rsi, %rdi
+; CHECK-NEXT: movq %rdi, %rax
+; CHECK-NEXT: retq
+
+define <64 x i1> @v64i1_sub(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = sub <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK-LABEL: v64i1_sub:
+; CHECK-NEXT: xorq %rsi, %rdi
+; CHECK-NEXT: movq %rdi, %rax
+; CHECK-NEXT: retq
+
+define <64 x i1> @v64i1_mul(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = mul <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK-LABEL: v64i1_mul:
+; CHECK-NEXT: andq %rsi, %rdi
+; CHECK-NEXT: movq %rdi, %rax
+; CHECK-NEXT: retq
+
+define <64 x i1> @v64i1_and(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = and <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK-LABEL: v64i1_and:
+; CHECK-NEXT: andq %rsi, %rdi
+; CHECK-NEXT: movq %rdi, %rax
+; CHECK-NEXT: retq
+
+define <64 x i1> @v64i1_or(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = or <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK-LABEL: v64i1_or:
+; CHECK-NEXT: orq %rsi, %rdi
+; CHECK-NEXT: movq %rdi, %rax
+; CHECK-NEXT: retq
+
+define <64 x i1> @v64i1_xor(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = xor <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK-LABEL: v64i1_xor:
+; CHECK-NEXT: xorq %rsi, %rdi
+; CHECK-NEXT: movq %rdi, %rax
+; CHECK-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_eq(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp eq <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK-LABEL: v64i1_icmp_eq:
+; CHECK-NEXT: xorq %rsi, %rdi
+; CHECK-NEXT: notq %rdi
+; CHECK-NEXT: movq %rdi, %rax
+; CHECK-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_ne(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp ne <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; CHECK-LABEL: v64i1_icmp_ne:
+; CHECK-NEXT: xorq %rsi, %rdi
+; CHECK-NEXT: movq %rdi, %rax
+; CHECK-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_ult(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp ult <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_icmp_ult:
+; SSE2-NEXT: notq %rdi
+; SSE2-NEXT: andq %rsi, %rdi
+; SSE2-NEXT: movq %rdi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_icmp_ult:
+; AVX-NEXT: notq %rdi
+; AVX-NEXT: andq %rsi, %rdi
+; AVX-NEXT: movq %rdi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_icmp_ult:
+; AVX2-NEXT: notq %rdi
+; AVX2-NEXT: andq %rsi, %rdi
+; AVX2-NEXT: movq %rdi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_icmp_ult:
+; BMI2-NEXT: andnq %rsi, %rdi, %rax
+; BMI2-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_ugt(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp ugt <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_icmp_ugt:
+; SSE2-NEXT: notq %rsi
+; SSE2-NEXT: andq %rdi, %rsi
+; SSE2-NEXT: movq %rsi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_icmp_ugt:
+; AVX-NEXT: notq %rsi
+; AVX-NEXT: andq %rdi, %rsi
+; AVX-NEXT: movq %rsi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_icmp_ugt:
+; AVX2-NEXT: notq %rsi
+; AVX2-NEXT: andq %rdi, %rsi
+; AVX2-NEXT: movq %rsi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_icmp_ugt:
+; BMI2-NEXT: andnq %rdi, %rsi, %rax
+; BMI2-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_ule(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp ule <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_icmp_ule:
+; SSE2-NEXT: notq %rsi
+; SSE2-NEXT: andq %rdi, %rsi
+; SSE2-NEXT: notq %rsi
+; SSE2-NEXT: movq %rsi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_icmp_ule:
+; AVX-NEXT: notq %rsi
+; AVX-NEXT: andq %rdi, %rsi
+; AVX-NEXT: notq %rsi
+; AVX-NEXT: movq %rsi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_icmp_ule:
+; AVX2-NEXT: notq %rsi
+; AVX2-NEXT: andq %rdi, %rsi
+; AVX2-NEXT: notq %rsi
+; AVX2-NEXT: movq %rsi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_icmp_ule:
+; BMI2-NEXT: andnq %rdi, %rsi, %rax
+; BMI2-NEXT: notq %rax
+; BMI2-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_uge(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp uge <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_icmp_uge:
+; SSE2-NEXT: notq %rdi
+; SSE2-NEXT: andq %rsi, %rdi
+; SSE2-NEXT: notq %rdi
+; SSE2-NEXT: movq %rdi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_icmp_uge:
+; AVX-NEXT: notq %rdi
+; AVX-NEXT: andq %rsi, %rdi
+; AVX-NEXT: notq %rdi
+; AVX-NEXT: movq %rdi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_icmp_uge:
+; AVX2-NEXT: notq %rdi
+; AVX2-NEXT: andq %rsi, %rdi
+; AVX2-NEXT: notq %rdi
+; AVX2-NEXT: movq %rdi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_icmp_uge:
+; BMI2-NEXT: andnq %rsi, %rdi, %rax
+; BMI2-NEXT: notq %rax
+; BMI2-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_slt(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp slt <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_icmp_slt:
+; SSE2-NEXT: notq %rsi
+; SSE2-NEXT: andq %rdi, %rsi
+; SSE2-NEXT: movq %rsi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_icmp_slt:
+; AVX-NEXT: notq %rsi
+; AVX-NEXT: andq %rdi, %rsi
+; AVX-NEXT: movq %rsi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_icmp_slt:
+; AVX2-NEXT: notq %rsi
+; AVX2-NEXT: andq %rdi, %rsi
+; AVX2-NEXT: movq %rsi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_icmp_slt:
+; BMI2-NEXT: andnq %rdi, %rsi, %rax
+; BMI2-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_sgt(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp sgt <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_icmp_sgt:
+; SSE2-NEXT: notq %rdi
+; SSE2-NEXT: andq %rsi, %rdi
+; SSE2-NEXT: movq %rdi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_icmp_sgt:
+; AVX-NEXT: notq %rdi
+; AVX-NEXT: andq %rsi, %rdi
+; AVX-NEXT: movq %rdi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_icmp_sgt:
+; AVX2-NEXT: notq %rdi
+; AVX2-NEXT: andq %rsi, %rdi
+; AVX2-NEXT: movq %rdi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_icmp_sgt:
+; BMI2-NEXT: andnq %rsi, %rdi, %rax
+; BMI2-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_sle(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp sle <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_icmp_sle:
+; SSE2-NEXT: notq %rdi
+; SSE2-NEXT: andq %rsi, %rdi
+; SSE2-NEXT: notq %rdi
+; SSE2-NEXT: movq %rdi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_icmp_sle:
+; AVX-NEXT: notq %rdi
+; AVX-NEXT: andq %rsi, %rdi
+; AVX-NEXT: notq %rdi
+; AVX-NEXT: movq %rdi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_icmp_sle:
+; AVX2-NEXT: notq %rdi
+; AVX2-NEXT: andq %rsi, %rdi
+; AVX2-NEXT: notq %rdi
+; AVX2-NEXT: movq %rdi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_icmp_sle:
+; BMI2-NEXT: andnq %rsi, %rdi, %rax
+; BMI2-NEXT: notq %rax
+; BMI2-NEXT: retq
+
+define <64 x i1> @v64i1_icmp_sge(<64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = icmp sge <64 x i1> %a, %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_icmp_sge:
+; SSE2-NEXT: notq %rsi
+; SSE2-NEXT: andq %rdi, %rsi
+; SSE2-NEXT: notq %rsi
+; SSE2-NEXT: movq %rsi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_icmp_sge:
+; AVX-NEXT: notq %rsi
+; AVX-NEXT: andq %rdi, %rsi
+; AVX-NEXT: notq %rsi
+; AVX-NEXT: movq %rsi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_icmp_sge:
+; AVX2-NEXT: notq %rsi
+; AVX2-NEXT: andq %rdi, %rsi
+; AVX2-NEXT: notq %rsi
+; AVX2-NEXT: movq %rsi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_icmp_sge:
+; BMI2-NEXT: andnq %rdi, %rsi, %rax
+; BMI2-NEXT: notq %rax
+; BMI2-NEXT: retq
+
+define <64 x i1> @v64i1_select(<64 x i1> %m, <64 x i1> %a, <64 x i1> %b) nounwind {
+  %r = select <64 x i1> %m, <64 x i1> %a, <64 x i1> %b
+  ret <64 x i1> %r
+}
+; SSE2-LABEL: v64i1_select:
+; SSE2-NEXT: andq %rdi, %rsi
+; SSE2-NEXT: notq %rdi
+; SSE2-NEXT: andq %rdx, %rdi
+; SSE2-NEXT: orq %rsi, %rdi
+; SSE2-NEXT: movq %rdi, %rax
+; SSE2-NEXT: retq
+; AVX-LABEL: v64i1_select:
+; AVX-NEXT: andq %rdi, %rsi
+; AVX-NEXT: notq %rdi
+; AVX-NEXT: andq %rdx, %rdi
+; AVX-NEXT: orq %rsi, %rdi
+; AVX-NEXT: movq %rdi, %rax
+; AVX-NEXT: retq
+; AVX2-LABEL: v64i1_select:
+; AVX2-NEXT: andq %rdi, %rsi
+; AVX2-NEXT: notq %rdi
+; AVX2-NEXT: andq %rdx, %rdi
+; AVX2-NEXT: orq %rsi, %rdi
+; AVX2-NEXT: movq %rdi, %rax
+; AVX2-NEXT: retq
+; BMI2-LABEL: v64i1_select:
+; BMI2-NEXT: andnq %rdx, %rdi, %rax
+; BMI2-NEXT: andq %rdi, %rsi
+; BMI2-NEXT: orq %rsi, %rax
+; BMI2-NEXT: retq
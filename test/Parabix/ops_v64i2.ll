@@ -0,0 +1,682 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+bmi,+bmi2 -asm-verbose=false | FileCheck %s -check-prefix=CHECK -check-prefix=AVXANY -check-prefix=AVX2ANY -check-prefix=BMI2
+
+; Instruction sequences for every <64 x i2> stream operation.
+; Generated by utils/parabix-update-tests.py; regenerate instead of editing.
+
+define <64 x i2> @v64i2_add(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = add <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_add:
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pxor %xmm1, %xmm2
+; SSE2-NEXT: pand %xmm1, %xmm0
+; SSE2-NEXT: psllq $1, %xmm0
+; SSE2-NEXT: pxor %xmm2, %xmm0
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: pand %xmm1, %xmm0
+; SSE2-NEXT: pandn %xmm2, %xmm1
+; SSE2-NEXT: por %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_add:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm2
+; AVXANY-NEXT: vpand %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpxor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpandn %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_sub(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = sub <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_sub:
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pxor %xmm1, %xmm2
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: psllq $1, %xmm0
+; SSE2-NEXT: pxor %xmm2, %xmm0
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: pand %xmm1, %xmm0
+; SSE2-NEXT: pandn %xmm2, %xmm1
+; SSE2-NEXT: por %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_sub:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm2
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpxor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpandn %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_mul(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = mul <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_mul:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: pxor %xmm2, %xmm3
+; SSE2-NEXT: movdqa %xmm0, %xmm4
+; SSE2-NEXT: psllq $1, %xmm4
+; SSE2-NEXT: movdqa %xmm4, %xmm5
+; SSE2-NEXT: pxor %xmm2, %xmm5
+; SSE2-NEXT: por %xmm3, %xmm5
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: psllq $1, %xmm3
+; SSE2-NEXT: pand %xmm3, %xmm5
+; SSE2-NEXT: pand %xmm0, %xmm5
+; SSE2-NEXT: movdqa %xmm0, %xmm6
+; SSE2-NEXT: pxor %xmm2, %xmm6
+; SSE2-NEXT: pxor %xmm2, %xmm3
+; SSE2-NEXT: por %xmm6, %xmm3
+; SSE2-NEXT: pand %xmm1, %xmm3
+; SSE2-NEXT: pand %xmm4, %xmm3
+; SSE2-NEXT: por %xmm5, %xmm3
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; SSE2-NEXT: pand %xmm2, %xmm3
+; SSE2-NEXT: pand %xmm1, %xmm0
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: por %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_mul:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm3
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm4
+; AVXANY-NEXT: vpxor %xmm2, %xmm4, %xmm5
+; AVXANY-NEXT: vpor %xmm3, %xmm5, %xmm3
+; AVXANY-NEXT: vpsllq $1, %xmm1, %xmm5
+; AVXANY-NEXT: vpand %xmm3, %xmm5, %xmm3
+; AVXANY-NEXT: vpand %xmm3, %xmm0, %xmm3
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm6
+; AVXANY-NEXT: vpxor %xmm2, %xmm5, %xmm2
+; AVXANY-NEXT: vpor %xmm2, %xmm6, %xmm2
+; AVXANY-NEXT: vpand %xmm2, %xmm1, %xmm2
+; AVXANY-NEXT: vpand %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpor %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpand %xmm2, %xmm3, %xmm2
+; AVXANY-NEXT: vpand %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_and(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = and <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_and:
+; SSE2-NEXT: andps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_and:
+; AVXANY-NEXT: vandps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_or(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = or <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_or:
+; SSE2-NEXT: orps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_or:
+; AVXANY-NEXT: vorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_xor(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = xor <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_xor:
+; SSE2-NEXT: xorps %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_xor:
+; AVXANY-NEXT: vxorps %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_shl(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = shl <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_shl:
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: psllq $1, %xmm3
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: psllq $1, %xmm2
+; SSE2-NEXT: pand %xmm3, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm3
+; SSE2-NEXT: por %xmm2, %xmm3
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; SSE2-NEXT: pand %xmm2, %xmm3
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: pandn %xmm1, %xmm2
+; SSE2-NEXT: por %xmm3, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_shl:
+; AVXANY-NEXT: vpsllq $1, %xmm1, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm2, %xmm3
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm4
+; AVXANY-NEXT: vpand %xmm2, %xmm4, %xmm2
+; AVXANY-NEXT: vpor %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpand %xmm2, %xmm3, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_lshr(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = lshr <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_lshr:
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: psrlq $1, %xmm3
+; SSE2-NEXT: pand %xmm1, %xmm3
+; SSE2-NEXT: por %xmm2, %xmm3
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm4
+; SSE2-NEXT: pandn %xmm3, %xmm4
+; SSE2-NEXT: psllq $1, %xmm1
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: pand %xmm1, %xmm2
+; SSE2-NEXT: por %xmm4, %xmm2
+; SSE2-NEXT: movdqa %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_lshr:
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm3
+; AVXANY-NEXT: vpand %xmm1, %xmm3, %xmm3
+; AVXANY-NEXT: vpor %xmm3, %xmm2, %xmm2
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm3
+; AVXANY-NEXT: vpandn %xmm2, %xmm3, %xmm2
+; AVXANY-NEXT: vpsllq $1, %xmm1, %xmm1
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpand %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_ashr(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = ashr <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_ashr:
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: psrlq $1, %xmm3
+; SSE2-NEXT: pand %xmm1, %xmm3
+; SSE2-NEXT: por %xmm2, %xmm3
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pandn %xmm3, %xmm2
+; SSE2-NEXT: pand %xmm0, %xmm1
+; SSE2-NEXT: por %xmm2, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_ashr:
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm3
+; AVXANY-NEXT: vpand %xmm3, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm2, %xmm1
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; AVXANY-NEXT: vpandn %xmm1, %xmm2, %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_shl_1(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = shl <64 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_shl_1:
+; SSE2-NEXT: psllw $1, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_shl_1:
+; AVXANY-NEXT: vpsllw $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_lshr_1(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = lshr <64 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_lshr_1:
+; SSE2-NEXT: psrlw $1, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_lshr_1:
+; AVXANY-NEXT: vpsrlw $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_ashr_1(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = ashr <64 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_ashr_1:
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: pand %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: psrlw $1, %xmm2
+; SSE2-NEXT: psubw %xmm2, %xmm1
+; SSE2-NEXT: psllw $1, %xmm1
+; SSE2-NEXT: psrlw $1, %xmm0
+; SSE2-NEXT: pand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_ashr_1:
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm1
+; AVXANY-NEXT: vpsrlw $1, %xmm1, %xmm2
+; AVXANY-NEXT: vpsubw %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpsllw $1, %xmm1, %xmm1
+; AVXANY-NEXT: vpsrlw $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_eq(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp eq <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_eq:
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: pcmpeqd %xmm1, %xmm1
+; SSE2-NEXT: pxor %xmm0, %xmm1
+; SSE2-NEXT: psllq $1, %xmm0
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pand %xmm0, %xmm2
+; SSE2-NEXT: psrlq $1, %xmm0
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: por %xmm2, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_eq:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm1
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_ne(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp ne <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_ne:
+; SSE2-NEXT: pxor %xmm1, %xmm0
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm1
+; SSE2-NEXT: pxor %xmm2, %xmm1
+; SSE2-NEXT: psllq $1, %xmm0
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: pand %xmm0, %xmm3
+; SSE2-NEXT: psrlq $1, %xmm0
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: por %xmm3, %xmm1
+; SSE2-NEXT: pxor %xmm2, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_ne:
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpcmpeqd %xmm1, %xmm1, %xmm1
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm2
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm2
+; AVXANY-NEXT: vpand %xmm0, %xmm2, %xmm3
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpxor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_ult(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp ult <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_ult:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: pxor %xmm0, %xmm2
+; SSE2-NEXT: por %xmm1, %xmm2
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm1
+; SSE2-NEXT: psllq $1, %xmm1
+; SSE2-NEXT: pand %xmm2, %xmm1
+; SSE2-NEXT: por %xmm0, %xmm1
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pand %xmm1, %xmm2
+; SSE2-NEXT: psrlq $1, %xmm1
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_ult:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm2
+; AVXANY-NEXT: vpor %xmm1, %xmm2, %xmm2
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm1
+; AVXANY-NEXT: vpand %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_ugt(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp ugt <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_ugt:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: pxor %xmm1, %xmm2
+; SSE2-NEXT: por %xmm0, %xmm2
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: psllq $1, %xmm3
+; SSE2-NEXT: pand %xmm2, %xmm3
+; SSE2-NEXT: por %xmm1, %xmm3
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm1
+; SSE2-NEXT: pand %xmm3, %xmm1
+; SSE2-NEXT: psrlq $1, %xmm3
+; SSE2-NEXT: pandn %xmm3, %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_ugt:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm2
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm1
+; AVXANY-NEXT: vpand %xmm2, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_ule(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp ule <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_ule:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: pxor %xmm2, %xmm3
+; SSE2-NEXT: por %xmm0, %xmm3
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm4
+; SSE2-NEXT: psllq $1, %xmm4
+; SSE2-NEXT: pand %xmm3, %xmm4
+; SSE2-NEXT: por %xmm1, %xmm4
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm1
+; SSE2-NEXT: pand %xmm4, %xmm1
+; SSE2-NEXT: psrlq $1, %xmm4
+; SSE2-NEXT: pandn %xmm4, %xmm0
+; SSE2-NEXT: por %xmm1, %xmm0
+; SSE2-NEXT: pxor %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_ule:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm3
+; AVXANY-NEXT: vpor %xmm0, %xmm3, %xmm3
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm1
+; AVXANY-NEXT: vpand %xmm3, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm3
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_uge(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp uge <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_uge:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: pxor %xmm2, %xmm3
+; SSE2-NEXT: por %xmm1, %xmm3
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm1
+; SSE2-NEXT: psllq $1, %xmm1
+; SSE2-NEXT: pand %xmm3, %xmm1
+; SSE2-NEXT: por %xmm0, %xmm1
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: pand %xmm1, %xmm3
+; SSE2-NEXT: psrlq $1, %xmm1
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: por %xmm3, %xmm0
+; SSE2-NEXT: pxor %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_uge:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm3
+; AVXANY-NEXT: vpor %xmm1, %xmm3, %xmm3
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpsllq $1, %xmm0, %xmm1
+; AVXANY-NEXT: vpand %xmm3, %xmm1, %xmm1
+; AVXANY-NEXT: vpor %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm3
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_slt(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp slt <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_slt:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: pxor %xmm1, %xmm2
+; SSE2-NEXT: por %xmm0, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: pandn %xmm1, %xmm3
+; SSE2-NEXT: psllq $1, %xmm3
+; SSE2-NEXT: pand %xmm2, %xmm3
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: por %xmm3, %xmm1
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm2
+; SSE2-NEXT: pand %xmm1, %xmm2
+; SSE2-NEXT: psrlq $1, %xmm1
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: por %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_slt:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm2
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm2
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm3
+; AVXANY-NEXT: vpsllq $1, %xmm3, %xmm3
+; AVXANY-NEXT: vpand %xmm2, %xmm3, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_sgt(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp sgt <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_sgt:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: pxor %xmm0, %xmm2
+; SSE2-NEXT: por %xmm1, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: pandn %xmm0, %xmm3
+; SSE2-NEXT: psllq $1, %xmm3
+; SSE2-NEXT: pand %xmm2, %xmm3
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: por %xmm3, %xmm0
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm2
+; SSE2-NEXT: pand %xmm0, %xmm2
+; SSE2-NEXT: psrlq $1, %xmm0
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: por %xmm2, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_sgt:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm2
+; AVXANY-NEXT: vpor %xmm2, %xmm1, %xmm2
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm3
+; AVXANY-NEXT: vpsllq $1, %xmm3, %xmm3
+; AVXANY-NEXT: vpand %xmm2, %xmm3, %xmm2
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm2
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm2, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_sle(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp sle <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_sle:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: pxor %xmm2, %xmm3
+; SSE2-NEXT: por %xmm1, %xmm3
+; SSE2-NEXT: movdqa %xmm1, %xmm4
+; SSE2-NEXT: pandn %xmm0, %xmm4
+; SSE2-NEXT: psllq $1, %xmm4
+; SSE2-NEXT: pand %xmm3, %xmm4
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: por %xmm4, %xmm0
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: pand %xmm0, %xmm3
+; SSE2-NEXT: psrlq $1, %xmm0
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: por %xmm3, %xmm1
+; SSE2-NEXT: pxor %xmm2, %xmm1
+; SSE2-NEXT: movdqa %xmm1, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_sle:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm3
+; AVXANY-NEXT: vpor %xmm3, %xmm1, %xmm3
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm4
+; AVXANY-NEXT: vpsllq $1, %xmm4, %xmm4
+; AVXANY-NEXT: vpand %xmm3, %xmm4, %xmm3
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm0
+; AVXANY-NEXT: vpor %xmm3, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm3
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_icmp_sge(<64 x i2> %a, <64 x i2> %b) nounwind {
+  %c = icmp sge <64 x i2> %a, %b
+  %r = sext <64 x i1> %c to <64 x i2>
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_icmp_sge:
+; SSE2-NEXT: pcmpeqd %xmm2, %xmm2
+; SSE2-NEXT: movdqa %xmm1, %xmm3
+; SSE2-NEXT: pxor %xmm2, %xmm3
+; SSE2-NEXT: por %xmm0, %xmm3
+; SSE2-NEXT: movdqa %xmm0, %xmm4
+; SSE2-NEXT: pandn %xmm1, %xmm4
+; SSE2-NEXT: psllq $1, %xmm4
+; SSE2-NEXT: pand %xmm3, %xmm4
+; SSE2-NEXT: pandn %xmm0, %xmm1
+; SSE2-NEXT: por %xmm4, %xmm1
+; SSE2-NEXT: movdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm0
+; SSE2-NEXT: movdqa %xmm0, %xmm3
+; SSE2-NEXT: pand %xmm1, %xmm3
+; SSE2-NEXT: psrlq $1, %xmm1
+; SSE2-NEXT: pandn %xmm1, %xmm0
+; SSE2-NEXT: por %xmm3, %xmm0
+; SSE2-NEXT: pxor %xmm2, %xmm0
+; SSE2-NEXT: retq
+; AVXANY-LABEL: v64i2_icmp_sge:
+; AVXANY-NEXT: vpcmpeqd %xmm2, %xmm2, %xmm2
+; AVXANY-NEXT: vpxor %xmm2, %xmm1, %xmm3
+; AVXANY-NEXT: vpor %xmm3, %xmm0, %xmm3
+; AVXANY-NEXT: vpandn %xmm1, %xmm0, %xmm4
+; AVXANY-NEXT: vpsllq $1, %xmm4, %xmm4
+; AVXANY-NEXT: vpand %xmm3, %xmm4, %xmm3
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm3, %xmm0, %xmm0
+; AVXANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %xmm1
+; AVXANY-NEXT: vpand %xmm0, %xmm1, %xmm3
+; AVXANY-NEXT: vpsrlq $1, %xmm0, %xmm0
+; AVXANY-NEXT: vpandn %xmm0, %xmm1, %xmm0
+; AVXANY-NEXT: vpor %xmm0, %xmm3, %xmm0
+; AVXANY-NEXT: vpxor %xmm2, %xmm0, %xmm0
+; AVXANY-NEXT: retq
+
+define <64 x i2> @v64i2_select(<64 x i1> %m, <64 x i2> %a, <64 x i2> %b) nounwind {
+  %r = select <64 x i1> %m, <64 x i2> %a, <64 x i2> %b
+  ret <64 x i2> %r
+}
+; SSE2-LABEL: v64i2_select:
+; 1007 lines, scalarized; not pinned.
+; AVX-LABEL: v64i2_select:
+; 940 lines, scalarized; not pinned.
+; AVX2-LABEL: v64i2_select:
+; 940 lines, scalarized; not pinned.
+; BMI2-LABEL: v64i2_select:
+; 832 lines, scalarized; not pinned.
@@ -0,0 +1,489 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 -asm-verbose=false | FileCheck %s -check-prefix=AVX2ANY -check-prefix=AVX2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2,+bmi,+bmi2 -asm-verbose=false | FileCheck %s -check-prefix=AVX2ANY -check-prefix=BMI2
+
+; Instruction sequences for every <64 x i4> stream operation.
+; Generated by utils/parabix-update-tests.py; regenerate instead of editing.
+; 256-bit streams are only legal with AVX2.
+
+define <64 x i4> @v64i4_add(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = add <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_add:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpaddq %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_sub(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = sub <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_sub:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpsubq %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm3, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_mul(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = mul <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_mul:
+; AVX2ANY-NEXT: vpsrlw $4, %ymm0, %ymm2
+; AVX2ANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpand %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm4
+; AVX2ANY-NEXT: vpand %ymm4, %ymm2, %ymm5
+; AVX2ANY-NEXT: vpsrlw $4, %ymm1, %ymm6
+; AVX2ANY-NEXT: vpand %ymm3, %ymm6, %ymm3
+; AVX2ANY-NEXT: vpsrlw $8, %ymm3, %ymm6
+; AVX2ANY-NEXT: vpmullw %ymm6, %ymm5, %ymm5
+; AVX2ANY-NEXT: vpmullw %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vmovdqa {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpand %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpor %ymm5, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpsllw $4, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpand {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm5
+; AVX2ANY-NEXT: vpand %ymm2, %ymm5, %ymm2
+; AVX2ANY-NEXT: vpand %ymm4, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpsrlw $8, %ymm1, %ymm6
+; AVX2ANY-NEXT: vpmullw %ymm6, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpmullw %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm3, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm4, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm5, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_and(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = and <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_and:
+; AVX2ANY-NEXT: vandps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_or(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = or <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_or:
+; AVX2ANY-NEXT: vorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_xor(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = xor <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_xor:
+; AVX2ANY-NEXT: vxorps %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_shl(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = shl <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_shl:
+; AVX2ANY-NEXT: vpsllq $3, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpand %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpsrlq $3, %ymm2, %ymm4
+; AVX2ANY-NEXT: vpsubq %ymm4, %ymm2, %ymm4
+; AVX2ANY-NEXT: vpor %ymm4, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm2, %ymm4
+; AVX2ANY-NEXT: vpsllq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm4, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsllq $2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpand %ymm3, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpsrlq $3, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsubq %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpor %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsllq $2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_lshr(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = lshr <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_lshr:
+; AVX2ANY-NEXT: vpsllq $3, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpand %ymm3, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpsrlq $3, %ymm2, %ymm4
+; AVX2ANY-NEXT: vpsubq %ymm4, %ymm2, %ymm4
+; AVX2ANY-NEXT: vpor %ymm4, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm2, %ymm4
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm4, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsllq $2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpand %ymm3, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpsrlq $3, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsubq %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpor %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsrlq $2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_ashr(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = ashr <64 x i4> %a, %b
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_ashr:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpsrlq $1, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm5
+; AVX2ANY-NEXT: vpand %ymm5, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpor %ymm3, %ymm4, %ymm3
+; AVX2ANY-NEXT: vpsllq $3, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpand %ymm2, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpsrlq $3, %ymm4, %ymm5
+; AVX2ANY-NEXT: vpsubq %ymm5, %ymm4, %ymm5
+; AVX2ANY-NEXT: vpor %ymm5, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpand %ymm3, %ymm4, %ymm3
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm4, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpsrlq $2, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm5
+; AVX2ANY-NEXT: vpand %ymm5, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpor %ymm3, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpsrlq $1, %ymm3, %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm4, %ymm3
+; AVX2ANY-NEXT: vpsllq $2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpand %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpsrlq $3, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsubq %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpor %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpand %ymm3, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm0, %ymm2, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_shl_1(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = shl <64 x i4> %a, <i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_shl_1:
+; AVX2ANY-NEXT: vpsllw $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_lshr_1(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = lshr <64 x i4> %a, <i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_lshr_1:
+; AVX2ANY-NEXT: vpsrlw $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_ashr_1(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = ashr <64 x i4> %a, <i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_ashr_1:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsrlw $1, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpsubw %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpsllw $1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpsrlw $1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_eq(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp eq <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_eq:
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpaddq %ymm1, %ymm2, %ymm1
+; AVX2ANY-NEXT: vpor %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_ne(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp ne <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_ne:
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpand %ymm1, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpaddq %ymm1, %ymm2, %ymm1
+; AVX2ANY-NEXT: vpor %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm1
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_ult(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp ult <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_ult:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpsubq %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm0, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpandn %ymm3, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpcmpeqd %ymm4, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpor %ymm1, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpand %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm3, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_ugt(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp ugt <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_ugt:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpsubq %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpandn %ymm3, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpcmpeqd %ymm4, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpor %ymm0, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpand %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm3, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_ule(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp ule <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_ule:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpsubq %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpandn %ymm3, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpcmpeqd %ymm4, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm1, %ymm5
+; AVX2ANY-NEXT: vpor %ymm0, %ymm5, %ymm5
+; AVX2ANY-NEXT: vpand %ymm2, %ymm5, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm3, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_uge(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp uge <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_uge:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpand %ymm2, %ymm1, %ymm2
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm3
+; AVX2ANY-NEXT: vpor %ymm3, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpsubq %ymm2, %ymm4, %ymm2
+; AVX2ANY-NEXT: vpxor %ymm0, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpandn %ymm3, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm2, %ymm2
+; AVX2ANY-NEXT: vpcmpeqd %ymm4, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm0, %ymm5
+; AVX2ANY-NEXT: vpor %ymm1, %ymm5, %ymm5
+; AVX2ANY-NEXT: vpand %ymm2, %ymm5, %ymm2
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm3, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_slt(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp slt <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_slt:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm3, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpandn %ymm2, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm5
+; AVX2ANY-NEXT: vpand %ymm5, %ymm1, %ymm6
+; AVX2ANY-NEXT: vpor %ymm2, %ymm3, %ymm7
+; AVX2ANY-NEXT: vpsubq %ymm6, %ymm7, %ymm6
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm6, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm5, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm4, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm3, %ymm1
+; AVX2ANY-NEXT: vpor %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_sgt(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp sgt <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_sgt:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm3, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpandn %ymm2, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm5
+; AVX2ANY-NEXT: vpand %ymm5, %ymm0, %ymm6
+; AVX2ANY-NEXT: vpor %ymm2, %ymm3, %ymm7
+; AVX2ANY-NEXT: vpsubq %ymm6, %ymm7, %ymm6
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm6, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm5, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm0, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpand %ymm4, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_sle(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp sle <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_sle:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm3
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpxor %ymm3, %ymm0, %ymm4
+; AVX2ANY-NEXT: vpandn %ymm2, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm5
+; AVX2ANY-NEXT: vpand %ymm5, %ymm0, %ymm6
+; AVX2ANY-NEXT: vpor %ymm2, %ymm3, %ymm7
+; AVX2ANY-NEXT: vpsubq %ymm6, %ymm7, %ymm6
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm6, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm5, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpor %ymm0, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpand %ymm4, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpandn %ymm0, %ymm3, %ymm0
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_icmp_sge(<64 x i4> %a, <64 x i4> %b) nounwind {
+  %c = icmp sge <64 x i4> %a, %b
+  %r = sext <64 x i1> %c to <64 x i4>
+  ret <64 x i4> %r
+}
+; AVX2ANY-LABEL: v64i4_icmp_sge:
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm2
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm0, %ymm3
+; AVX2ANY-NEXT: vpxor %ymm2, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm3, %ymm1, %ymm4
+; AVX2ANY-NEXT: vpandn %ymm2, %ymm4, %ymm4
+; AVX2ANY-NEXT: vpbroadcastq {{\.LCPI[0-9]+_[0-9]+}}(%rip), %ymm5
+; AVX2ANY-NEXT: vpand %ymm5, %ymm1, %ymm6
+; AVX2ANY-NEXT: vpor %ymm2, %ymm3, %ymm7
+; AVX2ANY-NEXT: vpsubq %ymm6, %ymm7, %ymm6
+; AVX2ANY-NEXT: vpxor %ymm4, %ymm6, %ymm4
+; AVX2ANY-NEXT: vpxor %ymm5, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpand %ymm4, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpandn %ymm1, %ymm3, %ymm1
+; AVX2ANY-NEXT: vpor %ymm0, %ymm1, %ymm0
+; AVX2ANY-NEXT: vpand %ymm2, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpsrlq $3, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpsubq %ymm1, %ymm0, %ymm1
+; AVX2ANY-NEXT: vpor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: vpcmpeqd %ymm1, %ymm1, %ymm1
+; AVX2ANY-NEXT: vpxor %ymm1, %ymm0, %ymm0
+; AVX2ANY-NEXT: retq
+
+define <64 x i4> @v64i4_select(<64 x i1> %m, <64 x i4> %a, <64 x i4> %b) nounwind {
+  %r = select <64 x i1> %m, <64 x i4> %a, <64 x i4> %b
+  ret <64 x i4> %r
+}
+; AVX2-LABEL: v64i4_select:
+; 1029 lines, scalarized; not pinned.
+; BMI2-LABEL: v64i4_select:
+; 906 lines, scalarized; not pinned.
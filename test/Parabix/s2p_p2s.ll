@@ -0,0 +1,32 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | grep packuswb | count 24
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | grep punpck | count 24
+
+; Bit transposition is three rounds of pack (s2p) or unpack (p2s) steps over
+; the eight registers, 12 steps in all.
+
+declare {<128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>} @llvm.x86.parabix.s2p(<16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>)
+declare {<16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>} @llvm.x86.parabix.p2s(<128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>)
+
+define {<128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>} @s2p_128(<16 x i8> %s0, <16 x i8> %s1, <16 x i8> %s2, <16 x i8> %s3, <16 x i8> %s4, <16 x i8> %s5, <16 x i8> %s6, <16 x i8> %s7) {
+  %r = call {<128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>} @llvm.x86.parabix.s2p(<16 x i8> %s0, <16 x i8> %s1, <16 x i8> %s2, <16 x i8> %s3, <16 x i8> %s4, <16 x i8> %s5, <16 x i8> %s6, <16 x i8> %s7)
+  ret {<128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>, <128 x i1>} %r
+}
+; CHECK-LABEL: s2p_128:
+; CHECK: psrlw $8
+; CHECK: packuswb
+; CHECK: psllw $1
+; CHECK: psllw $2
+; CHECK: psllw $4
+; CHECK: ret
+
+define {<16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>} @p2s_128(<128 x i1> %p0, <128 x i1> %p1, <128 x i1> %p2, <128 x i1> %p3, <128 x i1> %p4, <128 x i1> %p5, <128 x i1> %p6, <128 x i1> %p7) {
+  %r = call {<16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>} @llvm.x86.parabix.p2s(<128 x i1> %p0, <128 x i1> %p1, <128 x i1> %p2, <128 x i1> %p3, <128 x i1> %p4, <128 x i1> %p5, <128 x i1> %p6, <128 x i1> %p7)
+  ret {<16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>, <16 x i8>} %r
+}
+; CHECK-LABEL: p2s_128:
+; CHECK: psrlw $4
+; CHECK: punpcklbw
+; CHECK: punpckhbw
+; CHECK: psrlw $1
+; CHECK: ret
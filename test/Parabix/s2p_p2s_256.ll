@@ -0,0 +1,38 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 | FileCheck %s
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 | grep vpackuswb | count 24
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx2 | grep vperm2i128 | count 16
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | FileCheck %s -check-prefix=SSE2
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 | grep packuswb | count 48
+
+; The 256-bit pack and unpack steps work within 128-bit lanes, so the bytes
+; are regrouped by lane before s2p and after p2s. Without AVX2 each call is
+; done as two 128-bit transpositions.
+
+declare {<256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>} @llvm.x86.parabix.s2p.256(<32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>)
+declare {<32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>} @llvm.x86.parabix.p2s.256(<256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>)
+
+define {<256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>} @s2p_256(<32 x i8> %s0, <32 x i8> %s1, <32 x i8> %s2, <32 x i8> %s3, <32 x i8> %s4, <32 x i8> %s5, <32 x i8> %s6, <32 x i8> %s7) {
+  %r = call {<256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>} @llvm.x86.parabix.s2p.256(<32 x i8> %s0, <32 x i8> %s1, <32 x i8> %s2, <32 x i8> %s3, <32 x i8> %s4, <32 x i8> %s5, <32 x i8> %s6, <32 x i8> %s7)
+  ret {<256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>, <256 x i1>} %r
+}
+; CHECK-LABEL: s2p_256:
+; CHECK: vperm2i128
+; CHECK: vpackuswb
+; CHECK: vpsllw $4
+; CHECK: ret
+; SSE2-LABEL: s2p_256:
+; SSE2: packuswb
+; SSE2: psllw $4
+; SSE2: ret
+
+define {<32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>} @p2s_256(<256 x i1> %p0, <256 x i1> %p1, <256 x i1> %p2, <256 x i1> %p3, <256 x i1> %p4, <256 x i1> %p5, <256 x i1> %p6, <256 x i1> %p7) {
+  %r = call {<32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>} @llvm.x86.parabix.p2s.256(<256 x i1> %p0, <256 x i1> %p1, <256 x i1> %p2, <256 x i1> %p3, <256 x i1> %p4, <256 x i1> %p5, <256 x i1> %p6, <256 x i1> %p7)
+  ret {<32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>, <32 x i8>} %r
+}
+; CHECK-LABEL: p2s_256:
+; CHECK: vpunpcklbw
+; CHECK: vperm2i128
+; CHECK: ret
+; SSE2-LABEL: p2s_256:
+; SSE2: punpcklbw
+; SSE2: ret
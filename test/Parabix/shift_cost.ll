@@ -0,0 +1,56 @@
+; RUN: opt < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+sse2 -cost-model -analyze | FileCheck %s -check-prefix=CHECK -check-prefix=SSE2
+; RUN: opt < %s -mtriple=x86_64-unknown-linux-gnu -mcpu=core-avx2 -cost-model -analyze | FileCheck %s -check-prefix=CHECK -check-prefix=AVX2
+
+; Parabix shifts by a splat immediate are a psllw/psrlw and a mask, so the
+; vectorizers should see them as cheap.
+
+define <32 x i4> @shl_v32i4_imm(<32 x i4> %a) {
+  %r = shl <32 x i4> %a, <i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1>
+  ret <32 x i4> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'shl_v32i4_imm':
+; CHECK: Found an estimated cost of 2 for instruction:   %r
+
+define <64 x i2> @lshr_v64i2_imm(<64 x i2> %a) {
+  %r = lshr <64 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+  ret <64 x i2> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'lshr_v64i2_imm':
+; CHECK: Found an estimated cost of 2 for instruction:   %r
+
+define <32 x i4> @ashr_v32i4_imm(<32 x i4> %a) {
+  %r = ashr <32 x i4> %a, <i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2>
+  ret <32 x i4> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'ashr_v32i4_imm':
+; CHECK: Found an estimated cost of 7 for instruction:   %r
+
+define <32 x i4> @shl_v32i4(<32 x i4> %a, <32 x i4> %b) {
+  %r = shl <32 x i4> %a, %b
+  ret <32 x i4> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'shl_v32i4':
+; CHECK: Found an estimated cost of 29 for instruction:   %r
+
+define <64 x i2> @ashr_v64i2(<64 x i2> %a, <64 x i2> %b) {
+  %r = ashr <64 x i2> %a, %b
+  ret <64 x i2> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'ashr_v64i2':
+; CHECK: Found an estimated cost of 12 for instruction:   %r
+
+define <128 x i1> @shl_v128i1(<128 x i1> %a, <128 x i1> %b) {
+  %r = shl <128 x i1> %a, %b
+  ret <128 x i1> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'shl_v128i1':
+; CHECK: Found an estimated cost of 1 for instruction:   %r
+
+; 256-bit fields are native with AVX2 and split in two on SSE2.
+define <64 x i4> @srl_v64i4_imm(<64 x i4> %a) {
+  %r = lshr <64 x i4> %a, <i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3, i4 3>
+  ret <64 x i4> %r
+}
+; CHECK: 'Cost Model Analysis' for function 'srl_v64i4_imm':
+; SSE2: Found an estimated cost of 4 for instruction:   %r
+; AVX2: Found an estimated cost of 2 for instruction:   %r
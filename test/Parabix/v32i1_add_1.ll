@@ -15,7 +15,7 @@ entry:
   ; CHECK-NOT: addl
   %add = add nsw <32 x i1> %0, %1
   store <32 x i1> %add, <32 x i1>* %c, align 16
-  ; CHECK: movl 180(%esp), %eax
+  ; CHECK: movl {{[0-9]+}}(%esp), %eax
 
   %2 = load i32* %retval, align 4
   ret i32 %2
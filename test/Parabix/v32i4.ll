@@ -6,7 +6,9 @@ entry:
 
   %c = add <32 x i4> %a, %b
   ret <32 x i4> %c
-  ;CHECK: paddb
+  ;CHECK: pand
+  ;CHECK: paddq
+  ;CHECK: pxor
 }
 
 define void @test_logic(<32 x i4>* %P) {
@@ -34,9 +36,9 @@ entry:
 
   %c = mul <16 x i8> %a, %b
   ret <16 x i8> %c
+  ;CHECK: psrlw $8
+  ;CHECK: pmullw
   ;CHECK: pmullw
-  ;CHECK: psrlw
-  ;CHECK: psllw
 }
 
 define <32 x i4> @test_mult_4(<32 x i4> %a, <32 x i4> %b) {
@@ -54,8 +56,46 @@ entry:
   ;CHECK-LABEL: test_shl
   %c = shl <32 x i4> %a, %b
   ret <32 x i4> %c
-  ;CHECK: psllw
-  ;CHECK: psllw
+  ;CHECK: psllq $1
+  ;CHECK: psllq $2
+}
+
+define <32 x i4> @test_sub(<32 x i4> %a, <32 x i4> %b) {
+entry:
+  ;CHECK-LABEL: test_sub
+  %c = sub <32 x i4> %a, %b
+  ret <32 x i4> %c
+  ;CHECK: psubq
+  ;CHECK: pxor
+}
+
+define <32 x i4> @test_lshr(<32 x i4> %a, <32 x i4> %b) {
+entry:
+  ;CHECK-LABEL: test_lshr
+  %c = lshr <32 x i4> %a, %b
+  ret <32 x i4> %c
+  ;CHECK: psrlq $1
+  ;CHECK: psrlq $2
+}
+
+define <32 x i4> @test_ashr(<32 x i4> %a, <32 x i4> %b) {
+entry:
+  ;CHECK-LABEL: test_ashr
+  %c = ashr <32 x i4> %a, %b
+  ret <32 x i4> %c
+  ;CHECK: psrlq $1
+  ;CHECK: psrlq $2
+}
+
+define <32 x i4> @test_ult(<32 x i4> %a, <32 x i4> %b) {
+entry:
+  ;CHECK-LABEL: test_ult
+  %c = icmp ult <32 x i4> %a, %b
+  %d = sext <32 x i1> %c to <32 x i4>
+  ret <32 x i4> %d
+  ;CHECK: psubq
+  ;CHECK: psrlq $3
+  ;CHECK: psubq
 }
 
 define <32 x i4> @test_srli(<32 x i4> %a) {
@@ -63,7 +103,7 @@ entry:
   ;CHECK-LABEL: test_srli
   %c = lshr <32 x i4> %a, <i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2>
 
-  ;CHECK: psrld
+  ;CHECK: psrlw $2
   ;CHECK: pand
   ret <32 x i4> %c
 }
@@ -73,8 +113,23 @@ entry:
   ;CHECK-LABEL: test_shli
   %c = shl <32 x i4> %a, <i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2,i4 2, i4 2, i4 2, i4 2>
 
-  ;CHECK: pslld
+  ;CHECK: psllw $2
+  ;CHECK: pand
+  ret <32 x i4> %c
+}
+
+define <32 x i4> @test_srai(<32 x i4> %a) {
+entry:
+  ;CHECK-LABEL: test_srai
+  %c = ashr <32 x i4> %a, <i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1, i4 1>
+
+  ;CHECK: pand
+  ;CHECK: psrlw $1
+  ;CHECK: psubw
+  ;CHECK: psllw $1
+  ;CHECK: psrlw $1
   ;CHECK: pand
+  ;CHECK: por
   ret <32 x i4> %c
 }
 
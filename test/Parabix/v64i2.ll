@@ -54,3 +54,25 @@ entry:
 
   ret <64 x i2> %d
 }
+
+define <64 x i2> @test_shli(<64 x i2> %a) {
+entry:
+  ;CHECK-LABEL: test_shli
+  %c = shl <64 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+
+  ;CHECK: psllw $1
+  ;CHECK: pand
+  ;CHECK-NEXT: ret
+  ret <64 x i2> %c
+}
+
+define <64 x i2> @test_srli(<64 x i2> %a) {
+entry:
+  ;CHECK-LABEL: test_srli
+  %c = lshr <64 x i2> %a, <i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1, i2 1>
+
+  ;CHECK: psrlw $1
+  ;CHECK: pand
+  ;CHECK-NEXT: ret
+  ret <64 x i2> %c
+}
@@ -0,0 +1,21 @@
+; RUN: not llvm-as < %s -o /dev/null 2>&1 | FileCheck %s
+
+declare {<2 x i64>, i1} @llvm.parabix.matchstar.v2i64(<2 x i64>, <2 x i64>, i1)
+declare {<4 x i32>, i1} @llvm.parabix.scanthru.v4i32(<4 x i32>, <4 x i32>, i1)
+declare {<2 x i64>, <2 x i64>} @llvm.parabix.advance.v2i64(<2 x i64>, <2 x i64>, i32)
+
+define void @f(<2 x i64> %m, <4 x i32> %s, i1 %cin) {
+entry:
+; CHECK: Parabix bitstream intrinsics take a scalar integer block
+; CHECK-NEXT: @llvm.parabix.matchstar.v2i64
+  call {<2 x i64>, i1} @llvm.parabix.matchstar.v2i64(<2 x i64> %m, <2 x i64> %m, i1 %cin)
+
+; CHECK: Parabix bitstream intrinsics take a scalar integer block
+; CHECK-NEXT: @llvm.parabix.scanthru.v4i32
+  call {<4 x i32>, i1} @llvm.parabix.scanthru.v4i32(<4 x i32> %s, <4 x i32> %s, i1 %cin)
+
+; CHECK: Parabix bitstream intrinsics take a scalar integer block
+; CHECK-NEXT: @llvm.parabix.advance.v2i64
+  call {<2 x i64>, <2 x i64>} @llvm.parabix.advance.v2i64(<2 x i64> %m, <2 x i64> %m, i32 1)
+  ret void
+}
@@ -163,6 +163,18 @@ namespace {
                            "(must be user writable)"),
                   cl::init(""));
 
+  cl::opt<bool>
+  PerfMap("perf-map",
+          cl::desc("Tell Linux perf about JITed functions through "
+                   "/tmp/perf-<pid>.map"),
+          cl::init(false));
+
+  cl::opt<bool>
+  PerfJITDump("perf-jitdump",
+              cl::desc("Also write the code and line tables of JITed "
+                       "functions to a jitdump file for perf inject --jit"),
+              cl::init(false));
+
   cl::opt<std::string>
   FakeArgv0("fake-argv0",
             cl::desc("Override the 'argv[0]' value passed into the executing"
@@ -565,11 +577,23 @@ int main(int argc, char **argv, char * const *envp) {
                 JITEventListener::createOProfileJITEventListener());
   EE->RegisterJITEventListener(
                 JITEventListener::createIntelJITEventListener());
-
+  if (PerfMap || PerfJITDump)
+    EE->RegisterJITEventListener(
+                JITEventListener::createPerfJITEventListener(PerfJITDump));
+
+  // MCJIT compiles lazily only when asked to, with
+  // -disable-lazy-compilation=false; lazily compiled functions have no debug
+  // info.
+  if (UseMCJIT && !NoLazyCompilation.getNumOccurrences())
+    NoLazyCompilation = true;
   if (!NoLazyCompilation && RemoteMCJIT) {
     errs() << "warning: remote mcjit does not support lazy compilation\n";
     NoLazyCompilation = true;
   }
+  // MCJIT does not cache the objects of modules it compiles lazily, which
+  // would leave the cache manager with nothing to do.
+  if (UseMCJIT && EnableCacheManager)
+    NoLazyCompilation = true;
   EE->DisableLazyCompilation(NoLazyCompilation);
 
   // If the user specifically requested an argv[0] to pass into the program,
@@ -109,6 +109,7 @@ static const char *GetBlockName(unsigned BlockID,
   case bitc::METADATA_BLOCK_ID:        return "METADATA_BLOCK";
   case bitc::METADATA_ATTACHMENT_ID:   return "METADATA_ATTACHMENT_BLOCK";
   case bitc::USELIST_BLOCK_ID:         return "USELIST_BLOCK_ID";
+  case bitc::FUNCTION_INDEX_BLOCK_ID:  return "FUNCTION_INDEX_BLOCK";
   }
 }
 
@@ -273,6 +274,11 @@ static const char *GetCodeName(unsigned CodeID, unsigned BlockID,
     default:return nullptr;
     case bitc::USELIST_CODE_ENTRY:   return "USELIST_CODE_ENTRY";
     }
+  case bitc::FUNCTION_INDEX_BLOCK_ID:
+    switch(CodeID) {
+    default:return nullptr;
+    case bitc::FUNCTION_INDEX_CODE_OFFSETS: return "OFFSETS";
+    }
   }
 }
 
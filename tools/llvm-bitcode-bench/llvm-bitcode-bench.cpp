@@ -0,0 +1,193 @@
+//===-- llvm-bitcode-bench.cpp - Benchmark lazy bitcode materialization ---===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This program writes a module of generated kernels to bitcode, with and
+// without a function index, and times reading one kernel back lazily, from a
+// buffer and streamed, at positions from the first kernel to the last.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Bitcode/ReaderWriter.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/DataStream.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+using namespace llvm;
+
+static cl::opt<unsigned>
+KernelsCL("kernels", cl::desc("Kernels in the module written to bitcode"),
+          cl::init(10000));
+
+/// Emit a kernel named Name that combines N consecutive words of A and B with
+/// a chain of operations picked by Seed and stores the results to Out. Kernels
+/// with different seeds are different code.
+static void emitKernel(raw_ostream &OS, StringRef Name, unsigned Seed) {
+  static const char *const Ops[] = { "and", "or", "xor", "add", "sub" };
+  const unsigned NumOps = 16;
+
+  OS << "define void @" << Name
+     << "(i64* %a, i64* %b, i64* %out, i64 %n) {\n"
+     << "entry:\n"
+     << "  %empty = icmp eq i64 %n, 0\n"
+     << "  br i1 %empty, label %exit, label %loop\n"
+     << "loop:\n"
+     << "  %i = phi i64 [ 0, %entry ], [ %next, %loop ]\n"
+     << "  %pa = getelementptr i64* %a, i64 %i\n"
+     << "  %pb = getelementptr i64* %b, i64 %i\n"
+     << "  %po = getelementptr i64* %out, i64 %i\n"
+     << "  %v0 = load i64* %pa\n"
+     << "  %y = load i64* %pb\n";
+  for (unsigned k = 0; k != NumOps; ++k) {
+    OS << "  %v" << k + 1 << " = " << Ops[(Seed + k * (Seed / 5 + 1)) % 5]
+       << " i64 %v" << k << ", ";
+    if (k % 3 == 2)
+      OS << "%v" << k / 2;
+    else
+      OS << "%y";
+    OS << '\n';
+  }
+  OS << "  store i64 %v" << NumOps << ", i64* %po\n"
+     << "  %next = add i64 %i, 1\n"
+     << "  %done = icmp eq i64 %next, %n\n"
+     << "  br i1 %done, label %exit, label %loop\n"
+     << "exit:\n"
+     << "  ret void\n"
+     << "}\n\n";
+}
+
+static std::string kernelName(unsigned i) {
+  return "kernel_" + utostr(i);
+}
+
+static double wallTime() {
+  return TimeRecord::getCurrentTime(true).getWallTime();
+}
+
+namespace {
+/// Streams bitcode from memory, as getDataFileStreamer would from a file.
+class BufferStreamer : public DataStreamer {
+  StringRef Data;
+public:
+  BufferStreamer(StringRef Data) : Data(Data) {}
+  size_t GetBytes(unsigned char *Buf, size_t Len) override {
+    size_t N = std::min(Len, Data.size());
+    memcpy(Buf, Data.data(), N);
+    Data = Data.drop_front(N);
+    return N;
+  }
+};
+} // end anonymous namespace
+
+/// Read the module in Bitcode lazily, from a buffer or streamed, materialize
+/// Name and return the seconds taken, or a negative number on failure.
+static double timeMaterialize(StringRef Bitcode, StringRef Name, bool Stream) {
+  LLVMContext Context;
+  double Start = wallTime();
+  std::unique_ptr<Module> M;
+  if (Stream) {
+    M.reset(getStreamedBitcodeModule("bitcode-bench",
+                                     new BufferStreamer(Bitcode), Context));
+  } else {
+    ErrorOr<Module *> ModuleOrErr = getLazyBitcodeModule(
+        MemoryBuffer::getMemBuffer(Bitcode, "bitcode-bench", false), Context);
+    if (ModuleOrErr)
+      M.reset(ModuleOrErr.get());
+  }
+  if (!M)
+    return -1;
+  Function *F = M->getFunction(Name);
+  if (!F || F->Materialize() || F->isDeclaration())
+    return -1;
+  return wallTime() - Start;
+}
+
+/// Write KernelsCL kernels to bitcode with and without a function index, then
+/// time reading a module back lazily and materializing the kernel at each of
+/// several positions. A reader without the index walks every body before the
+/// one it is asked for when it streams, and every body in the module when it
+/// reads a buffer.
+static int runBitcodeMaterialize(const char *Argv0) {
+  const unsigned N = KernelsCL;
+  std::string IR;
+  raw_string_ostream IROS(IR);
+  for (unsigned i = 0; i != N; ++i)
+    emitKernel(IROS, kernelName(i), i);
+  IROS.flush();
+
+  SmallString<0> Bitcode[2];
+  {
+    LLVMContext Context;
+    Module M("bitcode-bench", Context);
+    SMDiagnostic Err;
+    if (!ParseAssemblyString(IR.c_str(), &M, Err, Context)) {
+      Err.print(Argv0, errs());
+      return 1;
+    }
+    for (unsigned Index = 0; Index != 2; ++Index) {
+      raw_svector_ostream OS(Bitcode[Index]);
+      WriteBitcodeToFile(&M, OS, Index);
+    }
+  }
+  outs() << format("%u kernels, %.1f KB of bitcode, %.1f KB with the index\n",
+                   N, Bitcode[0].size() / 1024.0, Bitcode[1].size() / 1024.0);
+
+  // The best of a few runs, since each one is short.
+  const unsigned Runs = 5;
+  outs() << "position  buffer ms  indexed ms  stream ms  indexed ms\n";
+  const unsigned Quarters[] = { 0, 1, 2, 3, 4 };
+  for (unsigned Q : Quarters) {
+    unsigned Pos = std::min(N - 1, N * Q / 4);
+    std::string Name = kernelName(Pos);
+    double Best[4];
+    for (unsigned Mode = 0; Mode != 4; ++Mode) {
+      Best[Mode] = 0;
+      for (unsigned R = 0; R != Runs; ++R) {
+        double T = timeMaterialize(Bitcode[Mode & 1], Name, Mode >> 1);
+        if (T < 0) {
+          errs() << Argv0 << ": could not materialize " << Name << '\n';
+          return 1;
+        }
+        if (!R || T < Best[Mode])
+          Best[Mode] = T;
+      }
+    }
+    outs() << format("%8u %10.3f %11.3f %10.3f %11.3f\n", Pos, Best[0] * 1e3,
+                     Best[1] * 1e3, Best[2] * 1e3, Best[3] * 1e3);
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  sys::PrintStackTraceOnErrorSignal();
+  PrettyStackTraceProgram X(argc, argv);
+  llvm_shutdown_obj Y;  // Call llvm_shutdown() on exit.
+
+  cl::ParseCommandLineOptions(argc, argv,
+                              "llvm lazy bitcode materialization benchmark\n");
+  if (!KernelsCL) {
+    errs() << argv[0] << ": no kernels to write\n";
+    return 1;
+  }
+  return runBitcodeMaterialize(argv[0]);
+}
@@ -0,0 +1,229 @@
+//===-- llvm-interp-bench.cpp - Benchmark the interpreter against MCJIT ---===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This program runs scalar workloads through the interpreter, as
+// lli -force-interpreter would for a kernel too cold to compile, and through
+// MCJIT, checks that both agree and reports how much slower the interpreter
+// is. Add -interpreter-bytecode to measure the bytecode engine rather than the
+// IR interpreter.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/ExecutionEngine/GenericValue.h"
+#include "llvm/ExecutionEngine/Interpreter.h"
+#include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include <memory>
+#include <string>
+#include <vector>
+using namespace llvm;
+
+static cl::opt<std::string>
+MCPU("mcpu", cl::desc("Target a specific cpu type (default: the host cpu)"),
+     cl::value_desc("cpu-name"), cl::init(""));
+
+static cl::list<std::string>
+MAttrs("mattr", cl::CommaSeparated,
+       cl::desc("Target specific attributes (-mattr=help for details)"),
+       cl::value_desc("a1,+a2,-a3,..."));
+
+static cl::opt<unsigned>
+ItersCL("iters", cl::desc("Timed interpreter runs of each workload"),
+        cl::init(20));
+
+static double wallTime() {
+  return TimeRecord::getCurrentTime(true).getWallTime();
+}
+
+/// Create an MCJIT engine around M for the target the command line asks for.
+static ExecutionEngine *createJIT(Module *M, TargetMachine *&TM,
+                                  std::string &ErrorStr) {
+  M->setTargetTriple(sys::getProcessTriple());
+  EngineBuilder Builder(M);
+  Builder.setUseMCJIT(true)
+         .setEngineKind(EngineKind::JIT)
+         .setErrorStr(&ErrorStr)
+         .setMCPU(MCPU.empty() ? sys::getHostCPUName() : StringRef(MCPU))
+         .setMAttrs(MAttrs);
+  TM = Builder.selectTarget();
+  if (!TM)
+    return nullptr;
+  return Builder.create(TM);
+}
+
+/// The scalar workloads: the recursive calls of @fib, and a
+/// ScanThru over 64-bit words with the carry kept in a PHI, which is what the
+/// interpreter spends its time on when a kernel is too cold to compile.
+static const char InterpWorkloadIR[] =
+  "define i32 @fib(i32 %n) {\n"
+  "entry:\n"
+  "  %small = icmp slt i32 %n, 2\n"
+  "  br i1 %small, label %done, label %rec\n"
+  "rec:\n"
+  "  %n1 = sub i32 %n, 1\n"
+  "  %n2 = sub i32 %n, 2\n"
+  "  %f1 = call i32 @fib(i32 %n1)\n"
+  "  %f2 = call i32 @fib(i32 %n2)\n"
+  "  %s = add i32 %f1, %f2\n"
+  "  ret i32 %s\n"
+  "done:\n"
+  "  ret i32 %n\n"
+  "}\n"
+  "define i64 @scanthru(i64* %m, i64* %c, i64* %out, i64 %n) {\n"
+  "entry:\n"
+  "  %empty = icmp eq i64 %n, 0\n"
+  "  br i1 %empty, label %exit, label %loop\n"
+  "loop:\n"
+  "  %i = phi i64 [ 0, %entry ], [ %i1, %loop ]\n"
+  "  %carry = phi i64 [ 0, %entry ], [ %carry1, %loop ]\n"
+  "  %pm = getelementptr i64* %m, i64 %i\n"
+  "  %pc = getelementptr i64* %c, i64 %i\n"
+  "  %mv = load i64* %pm\n"
+  "  %cv = load i64* %pc\n"
+  "  %s = add i64 %mv, %cv\n"
+  "  %o1 = icmp ult i64 %s, %mv\n"
+  "  %s2 = add i64 %s, %carry\n"
+  "  %o2 = icmp ult i64 %s2, %s\n"
+  "  %o = or i1 %o1, %o2\n"
+  "  %carry1 = zext i1 %o to i64\n"
+  "  %nc = xor i64 %cv, -1\n"
+  "  %r = and i64 %s2, %nc\n"
+  "  %po = getelementptr i64* %out, i64 %i\n"
+  "  store i64 %r, i64* %po\n"
+  "  %i1 = add i64 %i, 1\n"
+  "  %more = icmp ult i64 %i1, %n\n"
+  "  br i1 %more, label %loop, label %exit\n"
+  "exit:\n"
+  "  %last = phi i64 [ 0, %entry ], [ %carry1, %loop ]\n"
+  "  ret i64 %last\n"
+  "}\n";
+
+/// Run the workloads ItersCL times through the interpreter and
+/// through MCJIT, check that both give the same results and report how much
+/// slower the interpreter is.
+static int runInterpreterBench(const char *Argv0) {
+  LLVMContext Context;
+  SMDiagnostic Err;
+  std::string ErrorStr;
+  Module *InterpM = ParseAssemblyString(InterpWorkloadIR, nullptr, Err,
+                                        Context);
+  Module *JITM = InterpM ? ParseAssemblyString(InterpWorkloadIR, nullptr, Err,
+                                               Context)
+                         : nullptr;
+  if (!JITM) {
+    delete InterpM;
+    Err.print(Argv0, errs());
+    return 1;
+  }
+  TargetMachine *TM;
+  std::unique_ptr<ExecutionEngine> JIT(createJIT(JITM, TM, ErrorStr));
+  if (!JIT) {
+    errs() << Argv0 << ": " << ErrorStr << '\n';
+    return 1;
+  }
+  // The bytecode engine only runs modules laid out like the host.
+  InterpM->setDataLayout(TM->getDataLayout());
+  std::unique_ptr<ExecutionEngine> Interp(
+      EngineBuilder(InterpM).setEngineKind(EngineKind::Interpreter)
+                            .setErrorStr(&ErrorStr).create());
+  if (!Interp) {
+    errs() << Argv0 << ": " << ErrorStr << '\n';
+    return 1;
+  }
+  JIT->finalizeObject();
+
+  const unsigned FibN = 20;
+  const uint64_t Words = 1024;
+  std::vector<uint64_t> M(Words), C(Words), JITOut(Words), InterpOut(Words);
+  uint64_t Seed = 0x9E3779B97F4A7C15ULL;
+  for (uint64_t i = 0; i != Words; ++i) {
+    Seed ^= Seed << 13; Seed ^= Seed >> 7; Seed ^= Seed << 17;
+    M[i] = Seed & ~(Seed >> 3);
+    C[i] = Seed >> 5 | Seed << 7;
+  }
+
+  int (*Fib)(int) = (int (*)(int))JIT->getFunctionAddress("fib");
+  uint64_t (*ScanThru)(const uint64_t *, const uint64_t *, uint64_t *,
+                       uint64_t) =
+      (uint64_t (*)(const uint64_t *, const uint64_t *, uint64_t *,
+                    uint64_t))JIT->getFunctionAddress("scanthru");
+  Function *InterpFib = InterpM->getFunction("fib");
+  Function *InterpScanThru = InterpM->getFunction("scanthru");
+
+  std::vector<GenericValue> FibArgs(1);
+  FibArgs[0].IntVal = APInt(32, FibN);
+  std::vector<GenericValue> ScanArgs(4);
+  ScanArgs[0] = PTOGV(M.data());
+  ScanArgs[1] = PTOGV(C.data());
+  ScanArgs[2] = PTOGV(InterpOut.data());
+  ScanArgs[3].IntVal = APInt(64, Words);
+
+  outs() << "workload          interp us/run    MCJIT us/run   slowdown\n";
+  unsigned Iters = ItersCL;
+  unsigned Failures = 0;
+  for (unsigned W = 0; W != 2; ++W) {
+    const char *Name = W ? "scanthru-1024" : "fib-20";
+    uint64_t JITResult = 0, InterpResult = 0;
+    double Start = wallTime();
+    for (unsigned i = 0; i != Iters; ++i)
+      InterpResult = W ? Interp->runFunction(InterpScanThru, ScanArgs)
+                             .IntVal.getZExtValue()
+                       : Interp->runFunction(InterpFib, FibArgs)
+                             .IntVal.getZExtValue();
+    double InterpTime = (wallTime() - Start) / Iters;
+
+    // Native runs are short; repeat them to get a measurable time.
+    unsigned JITIters = Iters * 100;
+    Start = wallTime();
+    for (unsigned i = 0; i != JITIters; ++i)
+      JITResult = W ? ScanThru(M.data(), C.data(), JITOut.data(), Words)
+                    : (uint32_t)Fib(FibN);
+    double JITTime = (wallTime() - Start) / JITIters;
+
+    if (InterpResult != JITResult || (W && InterpOut != JITOut)) {
+      errs() << Name << ": MISMATCH between the interpreter and MCJIT\n";
+      ++Failures;
+      continue;
+    }
+    outs() << format("%-16s %14.2f %15.3f %9.0fx\n", Name, InterpTime * 1e6,
+                     JITTime * 1e6, InterpTime / JITTime);
+  }
+  return Failures ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+  sys::PrintStackTraceOnErrorSignal();
+  PrettyStackTraceProgram X(argc, argv);
+  llvm_shutdown_obj Y;  // Call llvm_shutdown() on exit.
+
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+
+  cl::ParseCommandLineOptions(argc, argv,
+                              "llvm interpreter against MCJIT benchmark\n");
+  if (!ItersCL) {
+    errs() << argv[0] << ": -iters must be at least 1\n";
+    return 1;
+  }
+  return runInterpreterBench(argv[0]);
+}
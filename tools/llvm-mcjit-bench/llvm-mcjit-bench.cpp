@@ -0,0 +1,621 @@
+//===-- llvm-mcjit-bench.cpp - Benchmark MCJIT compiling and loading ------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This program measures MCJIT itself rather than the code it generates. The
+// workload is a set of generated kernels shaped like bitstream code: a loop
+// that combines words of two streams with a chain of logic and arithmetic
+// operations and stores the result. Each run picks one measurement:
+//
+//   -threads=N        kernel modules per second one engine compiles and loads
+//                     when 1, 2, 4, ... N threads ask it for kernels at once
+//   -link-modules=N   symbol resolution on an engine holding N small modules
+//   -churn=N          compile, run and remove N kernel modules one after
+//                     another, and report whether the process keeps growing
+//   -lazy             time to the first result and code emitted for a module
+//                     of -kernels kernels, of which one runs, with and without
+//                     lazy compilation
+//   -first-run=file   time at -O0 from creating an engine for an IR file to
+//                     the first results of its functions; run it with and
+//                     without -fast-isel=false to see what FastISel saves
+//
+// In any of them, -arena=MiB has the engines allocate code and data from one
+// arena, and -huge-pages asks for huge pages for it.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Config/config.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/Atomic.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+using namespace llvm;
+
+static cl::opt<std::string>
+MCPU("mcpu", cl::desc("Target a specific cpu type (default: the host cpu)"),
+     cl::value_desc("cpu-name"), cl::init(""));
+
+static cl::list<std::string>
+MAttrs("mattr", cl::CommaSeparated,
+       cl::desc("Target specific attributes (-mattr=help for details)"),
+       cl::value_desc("a1,+a2,-a3,..."));
+
+static cl::opt<unsigned>
+ThreadsCL("threads",
+          cl::desc("Measure JIT throughput from 1 up to this many threads"),
+          cl::init(0));
+
+static cl::opt<unsigned>
+ModulesCL("modules", cl::desc("Kernel modules compiled per thread count with "
+                              "-threads"),
+          cl::init(256));
+
+static cl::opt<unsigned>
+LinkModulesCL("link-modules",
+              cl::desc("Measure symbol resolution across this many small "
+                       "modules"),
+              cl::init(0));
+
+static cl::opt<unsigned>
+ChurnCL("churn",
+        cl::desc("Compile, run and remove this many kernel modules on one "
+                 "engine and report how the peak RSS grows"),
+        cl::init(0));
+
+static cl::opt<bool>
+LazyCL("lazy", cl::desc("Compare eager and lazy compilation of a module of "
+                        "-kernels kernels"));
+
+static cl::opt<unsigned>
+KernelsCL("kernels", cl::desc("Kernels in the module of -lazy"),
+          cl::init(100));
+
+static cl::opt<std::string>
+FirstRunCL("first-run",
+           cl::desc("Time MCJIT at -O0 from creating an engine for this IR "
+                    "file to the first results of its functions, which take "
+                    "two pointers to -size bytes"),
+           cl::value_desc("filename"), cl::init(""));
+
+static cl::opt<unsigned>
+SizeCL("size", cl::desc("Bytes per buffer passed to the functions of "
+                        "-first-run"),
+       cl::init(64 * 1024));
+
+static cl::opt<unsigned>
+ArenaCL("arena", cl::desc("Allocate the code and data of every engine from "
+                          "an arena of this many MiB"),
+        cl::value_desc("MiB"), cl::init(0));
+
+static cl::opt<bool>
+HugePagesCL("huge-pages", cl::desc("Ask for huge pages for the arena of "
+                                   "-arena"));
+
+// Words of each stream a kernel is run over, where it is run.
+static const unsigned KernelWords = 64;
+
+typedef void (*KernelFn)(uint64_t *A, uint64_t *B, uint64_t *Out, uint64_t N);
+
+/// Emit a kernel named Name that combines N consecutive words of A and B with
+/// a chain of operations picked by Seed and stores the results to Out. Kernels
+/// with different seeds are different code.
+static void emitKernel(raw_ostream &OS, StringRef Name, unsigned Seed) {
+  static const char *const Ops[] = { "and", "or", "xor", "add", "sub" };
+  const unsigned NumOps = 16;
+
+  OS << "define void @" << Name
+     << "(i64* %a, i64* %b, i64* %out, i64 %n) {\n"
+     << "entry:\n"
+     << "  %empty = icmp eq i64 %n, 0\n"
+     << "  br i1 %empty, label %exit, label %loop\n"
+     << "loop:\n"
+     << "  %i = phi i64 [ 0, %entry ], [ %next, %loop ]\n"
+     << "  %pa = getelementptr i64* %a, i64 %i\n"
+     << "  %pb = getelementptr i64* %b, i64 %i\n"
+     << "  %po = getelementptr i64* %out, i64 %i\n"
+     << "  %v0 = load i64* %pa\n"
+     << "  %y = load i64* %pb\n";
+  for (unsigned k = 0; k != NumOps; ++k) {
+    OS << "  %v" << k + 1 << " = " << Ops[(Seed + k * (Seed / 5 + 1)) % 5]
+       << " i64 %v" << k << ", ";
+    if (k % 3 == 2)
+      OS << "%v" << k / 2;
+    else
+      OS << "%y";
+    OS << '\n';
+  }
+  OS << "  store i64 %v" << NumOps << ", i64* %po\n"
+     << "  %next = add i64 %i, 1\n"
+     << "  %done = icmp eq i64 %next, %n\n"
+     << "  br i1 %done, label %exit, label %loop\n"
+     << "exit:\n"
+     << "  ret void\n"
+     << "}\n\n";
+}
+
+static std::string kernelName(unsigned i) {
+  return "kernel_" + utostr(i);
+}
+
+static double wallTime() {
+  return TimeRecord::getCurrentTime(true).getWallTime();
+}
+
+/// Create an MCJIT engine, around a module of its own, for the target the
+/// command line asks for. MM, if given, replaces the default memory manager,
+/// which allocates from an arena with -arena.
+static ExecutionEngine *
+createEngine(Module *M, std::string &ErrorStr,
+             RTDyldMemoryManager *MM = nullptr,
+             CodeGenOpt::Level OptLevel = CodeGenOpt::Default) {
+  if (!MM && ArenaCL)
+    MM = new SectionMemoryManager(uintptr_t(ArenaCL) << 20, HugePagesCL);
+  M->setTargetTriple(sys::getProcessTriple());
+  EngineBuilder Builder(M);
+  Builder.setUseMCJIT(true)
+         .setEngineKind(EngineKind::JIT)
+         .setErrorStr(&ErrorStr)
+         .setMCJITMemoryManager(MM)
+         .setOptLevel(OptLevel)
+         .setMCPU(MCPU.empty() ? sys::getHostCPUName() : StringRef(MCPU))
+         .setMAttrs(MAttrs);
+  return Builder.create();
+}
+
+/// Add LinkModulesCL modules to one engine, where module i defines link_i,
+/// which calls abs and link_<i-1> from the previous module, then look up every
+/// link_i in turn. Each lookup resolves abs and link_<i-1> while the later
+/// modules are still waiting to be compiled, which is where searching every
+/// module for a symbol shows.
+static int runLinkStress(const char *Argv0) {
+  // The engine deletes the modules, so the context must outlive it.
+  LLVMContext Context;
+  std::string ErrorStr;
+  std::unique_ptr<ExecutionEngine> EE(
+      createEngine(new Module("mcjit-link-bench", Context), ErrorStr));
+  if (!EE) {
+    errs() << Argv0 << ": " << ErrorStr << '\n';
+    return 1;
+  }
+
+  unsigned N = LinkModulesCL;
+  double Start = wallTime();
+  for (unsigned i = 0; i != N; ++i) {
+    std::string IR;
+    raw_string_ostream OS(IR);
+    OS << "declare i32 @abs(i32)\n";
+    if (i)
+      OS << "declare i32 @link_" << i - 1 << "(i32)\n";
+    OS << "define i32 @link_" << i << "(i32 %x) {\n"
+       << "  %a = call i32 @abs(i32 %x)\n";
+    if (i)
+      OS << "  %r = call i32 @link_" << i - 1 << "(i32 %a)\n"
+         << "  ret i32 %r\n";
+    else
+      OS << "  ret i32 %a\n";
+    OS << "}\n";
+    OS.flush();
+
+    SMDiagnostic Err;
+    Module *M = ParseAssemblyString(IR.c_str(), nullptr, Err, Context);
+    if (!M) {
+      Err.print(Argv0, errs());
+      return 1;
+    }
+    EE->addModule(M);
+  }
+  double AddTime = wallTime() - Start;
+
+  Start = wallTime();
+  int (*Last)(int) = nullptr;
+  for (unsigned i = 0; i != N; ++i) {
+    Last = (int (*)(int))EE->getFunctionAddress("link_" + utostr(i));
+    if (!Last) {
+      errs() << Argv0 << ": link_" << i << " did not compile\n";
+      return 1;
+    }
+  }
+  double LookupTime = wallTime() - Start;
+
+  if (Last && Last(-5) != 5) {
+    errs() << Argv0 << ": link_" << N - 1 << " returned a wrong result\n";
+    return 1;
+  }
+  outs() << format("%u modules: added in %.3f s, looked up in %.3f s "
+                   "(%.1f us per lookup)\n",
+                   N, AddTime, LookupTime, LookupTime * 1e6 / N);
+  return 0;
+}
+
+/// Peak resident set size of the process so far, as getrusage reports it.
+/// Returns 0 where that is not available.
+static long peakRSS() {
+#if defined(HAVE_GETRUSAGE) && defined(HAVE_SYS_RESOURCE_H)
+  struct rusage Usage;
+  if (!getrusage(RUSAGE_SELF, &Usage))
+    return Usage.ru_maxrss;
+#endif
+  return 0;
+}
+
+/// Add ChurnCL kernel modules to one engine one at a time, run each kernel
+/// once and remove its module again, as a service that specializes kernels on
+/// demand does. Once the engine is warm the peak RSS should stop growing; the
+/// growth over the second half of the run is what leaks.
+static int runChurn(const char *Argv0) {
+  LLVMContext Context;
+  std::string ErrorStr;
+  SectionMemoryManager *MM =
+      new SectionMemoryManager(uintptr_t(ArenaCL) << 20, HugePagesCL);
+  MM->setObjectUnloading(true);
+  std::unique_ptr<ExecutionEngine> EE(createEngine(
+      new Module("mcjit-churn-bench", Context), ErrorStr, MM));
+  if (!EE) {
+    errs() << Argv0 << ": " << ErrorStr << '\n';
+    return 1;
+  }
+
+  std::vector<uint64_t> A(KernelWords, 0x5a5a5a5a5a5a5a5aULL),
+      B(KernelWords, 0xc3c3c3c3c3c3c3c3ULL), Out(KernelWords);
+
+  unsigned N = ChurnCL;
+  long HalfRSS = 0;
+  double Start = wallTime();
+  for (unsigned i = 0; i != N; ++i) {
+    // Kernels repeat, as specializations of the same few shapes do.
+    std::string Name = kernelName(i % 100);
+    std::string IR;
+    raw_string_ostream IROS(IR);
+    emitKernel(IROS, Name, i % 100);
+    IROS.flush();
+
+    Module *M = new Module(Name, Context);
+    SMDiagnostic Err;
+    if (!ParseAssemblyString(IR.c_str(), M, Err, Context)) {
+      delete M;
+      Err.print(Argv0, errs());
+      return 1;
+    }
+    EE->addModule(M);
+    KernelFn Fn = (KernelFn)EE->getFunctionAddress(Name);
+    if (!Fn) {
+      errs() << Argv0 << ": " << Name << " did not compile\n";
+      return 1;
+    }
+    Fn(A.data(), B.data(), Out.data(), KernelWords);
+    EE->removeModule(M);
+    delete M;
+
+    if (i + 1 == N / 2)
+      HalfRSS = peakRSS();
+  }
+  double Elapsed = wallTime() - Start;
+
+  long EndRSS = peakRSS();
+  outs() << format("%u modules in %.3f s (%.1f us each); peak RSS %ld KB "
+                   "after half, %ld KB at the end\n",
+                   N, Elapsed, Elapsed * 1e6 / N, HalfRSS, EndRSS);
+  return 0;
+}
+
+namespace {
+/// A SectionMemoryManager that counts the bytes of code it hands out.
+class CodeCountingMemoryManager : public SectionMemoryManager {
+public:
+  CodeCountingMemoryManager()
+    : SectionMemoryManager(uintptr_t(ArenaCL) << 20, HugePagesCL),
+      CodeBytes(0) {}
+
+  uint8_t *allocateCodeSection(uintptr_t Size, unsigned Alignment,
+                               unsigned SectionID,
+                               StringRef SectionName) override {
+    CodeBytes += Size;
+    return SectionMemoryManager::allocateCodeSection(Size, Alignment,
+                                                     SectionID, SectionName);
+  }
+
+  uint64_t CodeBytes;
+};
+} // end anonymous namespace
+
+/// Put KernelsCL kernels into one module, as a generator specializing many
+/// kernels at once would, and run only the first. Then run all of them once.
+/// Each is done with lazy compilation off and on.
+static int runLazy(const char *Argv0) {
+  if (!KernelsCL) {
+    errs() << Argv0 << ": no kernels to compile\n";
+    return 1;
+  }
+  std::string IR;
+  raw_string_ostream IROS(IR);
+  for (unsigned i = 0; i != KernelsCL; ++i)
+    emitKernel(IROS, kernelName(i), i);
+  IROS.flush();
+
+  std::vector<uint64_t> A(KernelWords, 0x5a5a5a5a5a5a5a5aULL),
+      B(KernelWords, 0xc3c3c3c3c3c3c3c3ULL), Out(KernelWords);
+
+  outs() << "mode   first result ms  code KB   all kernels ms  code KB\n";
+  for (unsigned Lazy = 0; Lazy != 2; ++Lazy) {
+    LLVMContext Context;
+    Module *M = new Module("mcjit-lazy-bench", Context);
+    SMDiagnostic Err;
+    if (!ParseAssemblyString(IR.c_str(), M, Err, Context)) {
+      delete M;
+      Err.print(Argv0, errs());
+      return 1;
+    }
+
+    std::string ErrorStr;
+    CodeCountingMemoryManager *MM = new CodeCountingMemoryManager();
+    double Start = wallTime();
+    std::unique_ptr<ExecutionEngine> EE(createEngine(M, ErrorStr, MM));
+    if (!EE) {
+      errs() << Argv0 << ": " << ErrorStr << '\n';
+      return 1;
+    }
+    EE->DisableLazyCompilation(!Lazy);
+
+    double FirstTime = 0;
+    uint64_t FirstBytes = 0;
+    for (unsigned i = 0; i != KernelsCL; ++i) {
+      KernelFn Fn = (KernelFn)EE->getFunctionAddress(kernelName(i));
+      if (!Fn) {
+        errs() << Argv0 << ": " << kernelName(i) << " did not compile\n";
+        return 1;
+      }
+      Fn(A.data(), B.data(), Out.data(), KernelWords);
+      if (!i) {
+        FirstTime = wallTime() - Start;
+        FirstBytes = MM->CodeBytes;
+      }
+    }
+    double AllTime = wallTime() - Start;
+
+    outs() << format("%-6s %15.2f %8.1f %16.2f %8.1f\n",
+                     Lazy ? "lazy" : "eager", FirstTime * 1e3,
+                     FirstBytes / 1024.0, AllTime * 1e3,
+                     MM->CodeBytes / 1024.0);
+  }
+  return 0;
+}
+
+namespace {
+/// A buffer whose data is aligned for the widest vector loads.
+class AlignedBuffer {
+  std::vector<uint8_t> Storage;
+  uint8_t *Data;
+public:
+  explicit AlignedBuffer(size_t Size) : Storage(Size + 32) {
+    uintptr_t Addr = reinterpret_cast<uintptr_t>(&Storage[0]);
+    Data = &Storage[0] + ((32 - Addr % 32) % 32);
+  }
+  uint8_t *data() { return Data; }
+};
+} // end anonymous namespace
+
+/// Time MCJIT at -O0, where FastISel selects what it can, on the module in
+/// FirstRunCL: from creating the engine to the first results of all its
+/// functions, which are compiled together on the first lookup. Every function
+/// defined in the module is called with two buffers of SizeCL bytes.
+static int runFirstRun(const char *Argv0) {
+  LLVMContext Context;
+  SMDiagnostic Err;
+  Module *M = ParseAssemblyFile(FirstRunCL, Err, Context);
+  if (!M) {
+    Err.print(Argv0, errs());
+    return 1;
+  }
+  if (verifyModule(*M, &errs())) {
+    delete M;
+    return 1;
+  }
+  std::vector<std::string> Names;
+  for (Module::iterator F = M->begin(), E = M->end(); F != E; ++F)
+    if (!F->isDeclaration())
+      Names.push_back(F->getName());
+  if (Names.empty()) {
+    delete M;
+    errs() << Argv0 << ": no functions in " << FirstRunCL << '\n';
+    return 1;
+  }
+
+  typedef void (*FirstRunFn)(uint8_t *In, uint8_t *Out);
+  AlignedBuffer In(SizeCL), Out(SizeCL);
+  memset(In.data(), 0x5a, SizeCL);
+
+  std::string ErrorStr;
+  CodeCountingMemoryManager *MM = new CodeCountingMemoryManager();
+  double Start = wallTime();
+  std::unique_ptr<ExecutionEngine> EE(
+      createEngine(M, ErrorStr, MM, CodeGenOpt::None));
+  if (!EE) {
+    errs() << Argv0 << ": " << ErrorStr << '\n';
+    return 1;
+  }
+
+  for (unsigned i = 0, e = Names.size(); i != e; ++i) {
+    FirstRunFn Fn = (FirstRunFn)EE->getFunctionAddress(Names[i]);
+    if (!Fn) {
+      errs() << Argv0 << ": " << Names[i] << " did not compile\n";
+      return 1;
+    }
+    Fn(In.data(), Out.data());
+  }
+  double Time = wallTime() - Start;
+
+  outs() << "functions  first results ms  code KB\n"
+         << format("%9u %17.2f %8.1f\n", (unsigned)Names.size(), Time * 1e3,
+                   MM->CodeBytes / 1024.0);
+  return 0;
+}
+
+#if LLVM_ENABLE_THREADS != 0 && defined(HAVE_PTHREAD_H)
+namespace {
+/// Kernel modules handed out to the threads of one throughput run. Each module
+/// has an LLVMContext of its own, which MCJIT needs to compile modules in
+/// parallel.
+struct JITWork {
+  ExecutionEngine *EE;
+  std::vector<Module *> Modules;
+  std::vector<std::string> Names;
+  volatile sys::cas_flag Next;
+  volatile sys::cas_flag Failures;
+};
+} // end anonymous namespace
+
+static void *compileKernels(void *Arg) {
+  JITWork &W = *static_cast<JITWork *>(Arg);
+  for (;;) {
+    unsigned I = sys::AtomicIncrement(&W.Next) - 1;
+    if (I >= W.Modules.size())
+      return nullptr;
+    W.EE->addModule(W.Modules[I]);
+    if (!W.EE->getFunctionAddress(W.Names[I]))
+      sys::AtomicIncrement(&W.Failures);
+  }
+}
+
+/// Compile and load ModulesCL kernel modules on one engine from Threads
+/// threads; return the wall time taken, or a negative value on failure.
+static double measureJIT(unsigned Threads, std::string &ErrorStr) {
+  // The engine deletes the modules, so the contexts must outlive it.
+  std::vector<std::unique_ptr<LLVMContext> > Contexts;
+  Contexts.emplace_back(new LLVMContext());
+  std::unique_ptr<ExecutionEngine> EE(createEngine(
+      new Module("mcjit-threads-bench", *Contexts.back()), ErrorStr));
+  if (!EE)
+    return -1;
+
+  // Only code generation and loading is timed, not parsing. Names are made
+  // unique because the engine resolves symbols across all of its modules.
+  JITWork W;
+  W.EE = EE.get();
+  W.Next = 0;
+  W.Failures = 0;
+  for (unsigned i = 0; i != ModulesCL; ++i) {
+    std::string Name = kernelName(i);
+    std::string IR;
+    raw_string_ostream IROS(IR);
+    emitKernel(IROS, Name, i % 100);
+    IROS.flush();
+
+    Contexts.emplace_back(new LLVMContext());
+    Module *M = new Module(Name, *Contexts.back());
+    SMDiagnostic Err;
+    if (!ParseAssemblyString(IR.c_str(), M, Err, *Contexts.back())) {
+      delete M;
+      ErrorStr = Err.getMessage();
+      return -1;
+    }
+    W.Modules.push_back(M);
+    W.Names.push_back(Name);
+  }
+
+  double Start = wallTime();
+  std::vector<pthread_t> Workers(Threads - 1);
+  for (pthread_t &T : Workers)
+    pthread_create(&T, nullptr, compileKernels, &W);
+  compileKernels(&W);
+  for (pthread_t &T : Workers)
+    pthread_join(T, nullptr);
+  double Elapsed = wallTime() - Start;
+
+  if (W.Failures) {
+    ErrorStr = utostr(W.Failures) + " kernel(s) did not compile";
+    return -1;
+  }
+  return Elapsed;
+}
+
+static int runThroughput(const char *Argv0) {
+  if (!ModulesCL) {
+    errs() << Argv0 << ": no kernels to compile\n";
+    return 1;
+  }
+  llvm_start_multithreaded();
+
+  outs() << "threads   kernels/s    speedup\n";
+  unsigned MaxThreads = ThreadsCL;
+  double Base = 0;
+  for (unsigned Threads = 1;; Threads = std::min(Threads * 2, MaxThreads)) {
+    std::string ErrorStr;
+    double Elapsed = measureJIT(Threads, ErrorStr);
+    if (Elapsed < 0) {
+      errs() << Argv0 << ": " << ErrorStr << '\n';
+      return 1;
+    }
+    double Rate = ModulesCL / Elapsed;
+    if (Threads == 1)
+      Base = Rate;
+    outs() << format("%7u %11.1f %9.2fx\n", Threads, Rate, Rate / Base);
+    if (Threads == MaxThreads)
+      break;
+  }
+  return 0;
+}
+#else
+static int runThroughput(const char *Argv0) {
+  errs() << Argv0 << ": -threads needs LLVM built with threads\n";
+  return 1;
+}
+#endif
+
+int main(int argc, char **argv) {
+  sys::PrintStackTraceOnErrorSignal();
+  PrettyStackTraceProgram X(argc, argv);
+  llvm_shutdown_obj Y;  // Call llvm_shutdown() on exit.
+
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+
+  cl::ParseCommandLineOptions(argc, argv, "llvm MCJIT benchmark\n");
+
+  if (ThreadsCL)
+    return runThroughput(argv[0]);
+  if (LinkModulesCL)
+    return runLinkStress(argv[0]);
+  if (ChurnCL)
+    return runChurn(argv[0]);
+  if (LazyCL)
+    return runLazy(argv[0]);
+  if (!FirstRunCL.empty())
+    return runFirstRun(argv[0]);
+
+  errs() << argv[0] << ": pick a measurement: -threads, -link-modules, "
+         << "-churn, -lazy or -first-run\n";
+  return 1;
+}
@@ -0,0 +1,411 @@
+//===-- llvm-parabix-bench.cpp - Benchmark JITed Parabix stream operations ===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This program JITs a small loop kernel through MCJIT for every legal Parabix
+// stream type and operation, checks its output against a field-by-field scalar
+// reference, and reports ns/op and GB/s for the JITed code next to the time
+// taken by the reference. Lowering changes that slow down an operation show up
+// here as numbers rather than only as changed instruction sequences.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/CodeGen/ValueTypes.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetLowering.h"
+#include "llvm/Target/TargetMachine.h"
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace llvm;
+
+static cl::opt<std::string>
+MCPU("mcpu", cl::desc("Target a specific cpu type (default: the host cpu)"),
+     cl::value_desc("cpu-name"), cl::init(""));
+
+static cl::list<std::string>
+MAttrs("mattr", cl::CommaSeparated,
+       cl::desc("Target specific attributes (-mattr=help for details)"),
+       cl::value_desc("a1,+a2,-a3,..."));
+
+static cl::opt<unsigned>
+SizeCL("size", cl::desc("Bytes per input stream"), cl::init(64 * 1024));
+
+static cl::opt<unsigned>
+ItersCL("iters", cl::desc("Timed runs of each JITed kernel"), cl::init(200));
+
+static cl::opt<unsigned>
+ScalarItersCL("scalar-iters", cl::desc("Timed runs of each scalar reference"),
+              cl::init(5));
+
+static cl::opt<std::string>
+FilterCL("filter", cl::desc("Only run kernels whose name contains this string"),
+         cl::init(""));
+
+static cl::opt<bool>
+PrintIRCL("print-ir", cl::desc("Print the generated kernels and exit"));
+
+namespace {
+
+enum OpKind { Binary, Shift, ShiftByOne, Compare, Select };
+
+struct StreamOp {
+  const char *Name;
+  OpKind Kind;
+  const char *IR;   // Instruction opcode or icmp predicate.
+};
+
+const StreamOp StreamOps[] = {
+  { "add",      Binary,     "add"  },
+  { "sub",      Binary,     "sub"  },
+  { "mul",      Binary,     "mul"  },
+  { "and",      Binary,     "and"  },
+  { "or",       Binary,     "or"   },
+  { "xor",      Binary,     "xor"  },
+  { "shl",      Shift,      "shl"  },
+  { "lshr",     Shift,      "lshr" },
+  { "ashr",     Shift,      "ashr" },
+  { "shl_1",    ShiftByOne, "shl"  },
+  { "lshr_1",   ShiftByOne, "lshr" },
+  { "ashr_1",   ShiftByOne, "ashr" },
+  { "icmp_eq",  Compare,    "eq"   },
+  { "icmp_ne",  Compare,    "ne"   },
+  { "icmp_ult", Compare,    "ult"  },
+  { "icmp_ugt", Compare,    "ugt"  },
+  { "icmp_ule", Compare,    "ule"  },
+  { "icmp_uge", Compare,    "uge"  },
+  { "icmp_slt", Compare,    "slt"  },
+  { "icmp_sgt", Compare,    "sgt"  },
+  { "icmp_sle", Compare,    "sle"  },
+  { "icmp_sge", Compare,    "sge"  },
+  { "select",   Select,     "select" },
+};
+
+// The Parabix stream types, as (number of fields, field width in bits).
+const struct { unsigned NumElts, FieldBits; } StreamTypes[] = {
+  { 32, 1 }, { 64, 1 }, { 128, 1 }, { 64, 2 }, { 32, 4 },
+  { 256, 1 }, { 128, 2 }, { 64, 4 },
+};
+
+typedef void (*KernelFn)(uint8_t *A, uint8_t *B, uint8_t *M, uint8_t *Out,
+                         uint64_t N);
+
+struct Kernel {
+  std::string Name;
+  unsigned NumElts, FieldBits;
+  const StreamOp *Op;
+
+  unsigned regBytes() const { return NumElts * FieldBits / 8; }
+  unsigned maskBytes() const { return NumElts / 8; }
+};
+
+} // end anonymous namespace
+
+/// Emit a kernel that applies the operation to N consecutive stream registers
+/// of A and B (and the select masks in M) and stores the results to Out.
+static void emitKernel(raw_ostream &OS, const Kernel &K) {
+  std::string Ty = "<" + utostr(K.NumElts) + " x i" + utostr(K.FieldBits) + ">";
+  std::string MaskTy = "<" + utostr(K.NumElts) + " x i1>";
+  unsigned Align = K.regBytes();
+
+  OS << "define void @" << K.Name
+     << "(i8* %a, i8* %b, i8* %m, i8* %out, i64 %n) {\n"
+     << "entry:\n"
+     << "  %empty = icmp eq i64 %n, 0\n"
+     << "  br i1 %empty, label %exit, label %loop\n"
+     << "loop:\n"
+     << "  %i = phi i64 [ 0, %entry ], [ %next, %loop ]\n"
+     << "  %off = mul i64 %i, " << Align << '\n';
+  // Vectors of i1 are allocated a byte per element, so address the streams
+  // as bytes rather than indexing the stream type.
+  const char *Streams[] = { "a", "b", "out" };
+  for (const char *S : Streams)
+    OS << "  %p" << S << " = getelementptr i8* %" << S << ", i64 %off\n"
+       << "  %c" << S << " = bitcast i8* %p" << S << " to " << Ty << "*\n";
+  OS << "  %x = load " << Ty << "* %ca, align " << Align << '\n'
+     << "  %y = load " << Ty << "* %cb, align " << Align << '\n';
+
+  switch (K.Op->Kind) {
+  case Binary:
+  case Shift:
+    OS << "  %r = " << K.Op->IR << ' ' << Ty << " %x, %y\n";
+    break;
+  case ShiftByOne:
+    OS << "  %r = " << K.Op->IR << ' ' << Ty << " %x, <";
+    for (unsigned i = 0; i != K.NumElts; ++i)
+      OS << (i ? ", " : "") << 'i' << K.FieldBits << " 1";
+    OS << ">\n";
+    break;
+  case Compare:
+    if (K.FieldBits == 1) {
+      OS << "  %r = icmp " << K.Op->IR << ' ' << Ty << " %x, %y\n";
+      break;
+    }
+    OS << "  %cmp = icmp " << K.Op->IR << ' ' << Ty << " %x, %y\n"
+       << "  %r = sext " << MaskTy << " %cmp to " << Ty << '\n';
+    break;
+  case Select:
+    OS << "  %moff = mul i64 %i, " << K.maskBytes() << '\n'
+       << "  %pm = getelementptr i8* %m, i64 %moff\n"
+       << "  %cm = bitcast i8* %pm to " << MaskTy << "*\n"
+       << "  %k = load " << MaskTy << "* %cm, align " << K.maskBytes() << '\n'
+       << "  %r = select " << MaskTy << " %k, " << Ty << " %x, " << Ty
+       << " %y\n";
+    break;
+  }
+
+  OS << "  store " << Ty << " %r, " << Ty << "* %cout, align " << Align << '\n'
+     << "  %next = add i64 %i, 1\n"
+     << "  %done = icmp eq i64 %next, %n\n"
+     << "  br i1 %done, label %exit, label %loop\n"
+     << "exit:\n"
+     << "  ret void\n"
+     << "}\n\n";
+}
+
+// Field I of a stream occupies bits [I*W, (I+1)*W) of the little-endian
+// byte buffer; with W in {1, 2, 4} a field never straddles a byte.
+static unsigned getField(const uint8_t *Buf, uint64_t I, unsigned W) {
+  uint64_t Bit = I * W;
+  return (Buf[Bit / 8] >> (Bit % 8)) & ((1u << W) - 1);
+}
+
+static void setField(uint8_t *Buf, uint64_t I, unsigned W, unsigned V) {
+  uint64_t Bit = I * W;
+  unsigned Mask = ((1u << W) - 1) << (Bit % 8);
+  Buf[Bit / 8] = (Buf[Bit / 8] & ~Mask) | ((V << (Bit % 8)) & Mask);
+}
+
+static int signExtend(unsigned V, unsigned W) {
+  return (int)(V << (32 - W)) >> (32 - W);
+}
+
+static bool compare(StringRef Pred, unsigned X, unsigned Y, unsigned W) {
+  int SX = signExtend(X, W), SY = signExtend(Y, W);
+  if (Pred == "eq")  return X == Y;
+  if (Pred == "ne")  return X != Y;
+  if (Pred == "ult") return X < Y;
+  if (Pred == "ugt") return X > Y;
+  if (Pred == "ule") return X <= Y;
+  if (Pred == "uge") return X >= Y;
+  if (Pred == "slt") return SX < SY;
+  if (Pred == "sgt") return SX > SY;
+  if (Pred == "sle") return SX <= SY;
+  assert(Pred == "sge" && "Unknown icmp predicate");
+  return SX >= SY;
+}
+
+/// The scalar reference: the same computation as the kernel, one field at a
+/// time.
+static void runReference(const Kernel &K, const uint8_t *A, const uint8_t *B,
+                         const uint8_t *M, uint8_t *Out, uint64_t N) {
+  unsigned W = K.FieldBits, FieldMask = (1u << W) - 1;
+  StringRef IR = K.Op->IR;
+  for (uint64_t I = 0, E = N * K.NumElts; I != E; ++I) {
+    unsigned X = getField(A, I, W), Y = getField(B, I, W), R = 0;
+    switch (K.Op->Kind) {
+    case Binary:
+      if (IR == "add")      R = X + Y;
+      else if (IR == "sub") R = X - Y;
+      else if (IR == "mul") R = X * Y;
+      else if (IR == "and") R = X & Y;
+      else if (IR == "or")  R = X | Y;
+      else                  R = X ^ Y;
+      break;
+    case ShiftByOne:
+      Y = 1;
+      // FALLTHROUGH
+    case Shift:
+      if (IR == "shl")       R = X << Y;
+      else if (IR == "lshr") R = X >> Y;
+      else                   R = (unsigned)(signExtend(X, W) >> Y);
+      break;
+    case Compare:
+      R = compare(IR, X, Y, W) ? FieldMask : 0;
+      break;
+    case Select:
+      R = getField(M, I, 1) ? X : Y;
+      break;
+    }
+    setField(Out, I, W, R & FieldMask);
+  }
+}
+
+namespace {
+/// A zero-initialized buffer whose data is aligned for the widest stream
+/// register.
+class StreamBuffer {
+  std::vector<uint8_t> Storage;
+  uint8_t *Data;
+public:
+  explicit StreamBuffer(size_t Size) : Storage(Size + 32) {
+    uintptr_t Addr = reinterpret_cast<uintptr_t>(&Storage[0]);
+    Data = &Storage[0] + ((32 - Addr % 32) % 32);
+  }
+  uint8_t *data() { return Data; }
+};
+} // end anonymous namespace
+
+static double wallTime() {
+  return TimeRecord::getCurrentTime(true).getWallTime();
+}
+
+int main(int argc, char **argv) {
+  sys::PrintStackTraceOnErrorSignal();
+  PrettyStackTraceProgram X(argc, argv);
+  llvm_shutdown_obj Y;  // Call llvm_shutdown() on exit.
+
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+
+  cl::ParseCommandLineOptions(argc, argv,
+                              "llvm Parabix stream operation benchmark\n");
+
+  LLVMContext &Context = getGlobalContext();
+  Module *M = new Module("parabix-bench", Context);
+  M->setTargetTriple(sys::getProcessTriple());
+
+  std::string ErrorStr;
+  EngineBuilder Builder(M);
+  Builder.setUseMCJIT(true)
+         .setEngineKind(EngineKind::JIT)
+         .setErrorStr(&ErrorStr)
+         .setMCPU(MCPU.empty() ? sys::getHostCPUName() : StringRef(MCPU))
+         .setMAttrs(MAttrs);
+  TargetMachine *TM = Builder.selectTarget();
+  if (!TM) {
+    errs() << argv[0] << ": " << ErrorStr << '\n';
+    return 1;
+  }
+
+  // Benchmark each stream type the target has registers for, e.g. no 256-bit
+  // streams without AVX2.
+  const TargetLowering *TLI = TM->getTargetLowering();
+  std::vector<Kernel> Kernels;
+  for (const auto &ST : StreamTypes) {
+    MVT VT = MVT::getVectorVT(MVT::getIntegerVT(ST.FieldBits), ST.NumElts);
+    if (!TLI->isTypeLegal(VT))
+      continue;
+    for (const StreamOp &Op : StreamOps) {
+      // Every shift of an i1 field by a valid amount is the identity.
+      if (ST.FieldBits == 1 && (Op.Kind == Shift || Op.Kind == ShiftByOne))
+        continue;
+      Kernel K;
+      K.Name = EVT(VT).getEVTString() + "_" + Op.Name;
+      K.NumElts = ST.NumElts;
+      K.FieldBits = ST.FieldBits;
+      K.Op = &Op;
+      if (K.Name.find(FilterCL) != std::string::npos)
+        Kernels.push_back(K);
+    }
+  }
+
+  std::string IR;
+  raw_string_ostream IROS(IR);
+  for (const Kernel &K : Kernels)
+    emitKernel(IROS, K);
+  IROS.flush();
+  if (PrintIRCL) {
+    outs() << IR;
+    return 0;
+  }
+
+  SMDiagnostic Err;
+  if (!ParseAssemblyString(IR.c_str(), M, Err, Context)) {
+    Err.print(argv[0], errs());
+    return 1;
+  }
+  if (verifyModule(*M, &errs()))
+    return 1;
+
+  std::unique_ptr<ExecutionEngine> EE(Builder.create(TM));
+  if (!EE) {
+    errs() << argv[0] << ": " << ErrorStr << '\n';
+    return 1;
+  }
+  EE->finalizeObject();
+
+  size_t Size = SizeCL;
+  StreamBuffer A(Size), B(Size), Mask(Size), Out(Size), Ref(Size);
+  uint64_t Seed = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i != Size; ++i) {
+    Seed ^= Seed << 13; Seed ^= Seed >> 7; Seed ^= Seed << 17;
+    A.data()[i] = (uint8_t)Seed;
+    B.data()[i] = (uint8_t)(Seed >> 8);
+    Mask.data()[i] = (uint8_t)(Seed >> 16);
+  }
+
+  outs() << "kernel                  ns/op       GB/s   scalar ns/op    speedup\n";
+  unsigned Failures = 0;
+  for (const Kernel &K : Kernels) {
+    KernelFn Fn = (KernelFn)EE->getFunctionAddress(K.Name);
+    uint64_t N = Size / K.regBytes();
+
+    // Shifts by the field width or more are undefined; keep the amounts in
+    // range for variable shifts.
+    StreamBuffer Amounts(Size);
+    uint8_t *BData = B.data();
+    if (K.Op->Kind == Shift) {
+      memcpy(Amounts.data(), B.data(), Size);
+      BData = Amounts.data();
+      for (uint64_t I = 0, E = N * K.NumElts; I != E; ++I)
+        setField(BData, I, K.FieldBits,
+                 getField(BData, I, K.FieldBits) % K.FieldBits);
+    }
+
+    memset(Out.data(), 0, Size);
+    Fn(A.data(), BData, Mask.data(), Out.data(), N);
+    runReference(K, A.data(), BData, Mask.data(), Ref.data(), N);
+    if (memcmp(Out.data(), Ref.data(), N * K.regBytes())) {
+      uint64_t I = 0;
+      while (Out.data()[I] == Ref.data()[I])
+        ++I;
+      errs() << K.Name << ": MISMATCH in stream register "
+             << I / K.regBytes() << '\n';
+      ++Failures;
+      continue;
+    }
+
+    double Start = wallTime();
+    for (unsigned i = 0; i != ItersCL; ++i)
+      Fn(A.data(), BData, Mask.data(), Out.data(), N);
+    double JITNs = (wallTime() - Start) * 1e9 / ((double)ItersCL * N);
+
+    Start = wallTime();
+    for (unsigned i = 0; i != ScalarItersCL; ++i)
+      runReference(K, A.data(), BData, Mask.data(), Ref.data(), N);
+    double RefNs = (wallTime() - Start) * 1e9 / ((double)ScalarItersCL * N);
+
+    // One stream register of input per op, so bytes per ns is GB/s.
+    outs() << format("%-18s %10.3f %10.2f %14.2f %9.1fx\n", K.Name.c_str(),
+                     JITNs, K.regBytes() / JITNs, RefNs, RefNs / JITNs);
+  }
+
+  if (Failures) {
+    errs() << Failures << " kernel(s) did not match the scalar reference\n";
+    return 1;
+  }
+  return 0;
+}
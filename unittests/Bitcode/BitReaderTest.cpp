@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitstreamWriter.h"
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/IR/Constants.h"
@@ -16,7 +17,10 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/PassManager.h"
+#include "llvm/Support/DataStream.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <algorithm>
+#include <cstring>
 #include "gtest/gtest.h"
 
 namespace llvm {
@@ -44,12 +48,47 @@ static Module *makeLLVMModule() {
   return Mod;
 }
 
-static void writeModuleToBuffer(SmallVectorImpl<char> &Buffer) {
+static void writeModuleToBuffer(SmallVectorImpl<char> &Buffer,
+                                bool EmitFunctionIndex = false) {
   std::unique_ptr<Module> Mod(makeLLVMModule());
   raw_svector_ostream OS(Buffer);
-  WriteBitcodeToFile(Mod.get(), OS);
+  WriteBitcodeToFile(Mod.get(), OS, EmitFunctionIndex);
 }
 
+/// A module of functions f0 ... fN-1, where fI returns I, with a declaration
+/// between each so that the bodies and the prototypes are numbered apart.
+static Module *makeFunctionsModule(unsigned N) {
+  Module *Mod = new Module("test-functions", getGlobalContext());
+  Type *Int32Ty = Type::getInt32Ty(Mod->getContext());
+  FunctionType *FuncTy = FunctionType::get(Int32Ty, false);
+  for (unsigned i = 0; i != N; ++i) {
+    Function *F = Function::Create(FuncTy, GlobalValue::ExternalLinkage,
+                                   "f" + Twine(i), Mod);
+    BasicBlock *Entry = BasicBlock::Create(Mod->getContext(), "entry", F);
+    ReturnInst::Create(Mod->getContext(), ConstantInt::get(Int32Ty, i), Entry);
+    Function::Create(FuncTy, GlobalValue::ExternalLinkage, "d" + Twine(i), Mod);
+  }
+  return Mod;
+}
+
+static unsigned getReturnedValue(Function *F) {
+  ReturnInst *Ret = cast<ReturnInst>(F->getEntryBlock().getTerminator());
+  return cast<ConstantInt>(Ret->getReturnValue())->getZExtValue();
+}
+
+/// Streams a buffer, as getDataFileStreamer would a file.
+class BufferStreamer : public DataStreamer {
+  StringRef Data;
+public:
+  BufferStreamer(StringRef Data) : Data(Data) {}
+  size_t GetBytes(unsigned char *Buf, size_t Len) override {
+    size_t N = std::min(Len, Data.size());
+    memcpy(Buf, Data.data(), N);
+    Data = Data.drop_front(N);
+    return N;
+  }
+};
+
 TEST(BitReaderTest, MaterializeFunctionsForBlockAddr) { // PR11677
   SmallString<1024> Mem;
   writeModuleToBuffer(Mem);
@@ -63,5 +102,78 @@ TEST(BitReaderTest, MaterializeFunctionsForBlockAddr) { // PR11677
   passes.run(*m);
 }
 
+TEST(BitReaderTest, MaterializeFunctionsForBlockAddrWithIndex) {
+  SmallString<1024> Mem;
+  writeModuleToBuffer(Mem, /*EmitFunctionIndex=*/true);
+  MemoryBuffer *Buffer = MemoryBuffer::getMemBuffer(Mem.str(), "test", false);
+  ErrorOr<Module *> ModuleOrErr =
+      getLazyBitcodeModule(Buffer, getGlobalContext());
+  ASSERT_TRUE(!!ModuleOrErr);
+  std::unique_ptr<Module> m(ModuleOrErr.get());
+  ASSERT_FALSE(m->materializeAll());
+  EXPECT_FALSE(verifyModule(*m));
+}
+
+TEST(BitReaderTest, MaterializeOutOfOrderWithFunctionIndex) {
+  const unsigned N = 8;
+  for (unsigned Index = 0; Index != 2; ++Index) {
+    SmallString<4096> Mem;
+    {
+      std::unique_ptr<Module> Mod(makeFunctionsModule(N));
+      raw_svector_ostream OS(Mem);
+      WriteBitcodeToFile(Mod.get(), OS, Index);
+    }
+    MemoryBuffer *Buffer =
+        MemoryBuffer::getMemBuffer(Mem.str(), "test", false);
+    ErrorOr<Module *> ModuleOrErr =
+        getLazyBitcodeModule(Buffer, getGlobalContext());
+    ASSERT_TRUE(!!ModuleOrErr);
+    std::unique_ptr<Module> m(ModuleOrErr.get());
+
+    // Last body first, then every other one, then the whole module.
+    for (unsigned i = N; i-- != 0;) {
+      if (i % 2 && i != N - 1)
+        continue;
+      Function *F = m->getFunction("f" + utostr(i));
+      ASSERT_TRUE(F->isMaterializable());
+      ASSERT_FALSE(F->Materialize());
+      EXPECT_EQ(i, getReturnedValue(F));
+    }
+    ASSERT_FALSE(m->materializeAllPermanently());
+    for (unsigned i = 0; i != N; ++i) {
+      EXPECT_EQ(i, getReturnedValue(m->getFunction("f" + utostr(i))));
+      EXPECT_TRUE(m->getFunction("d" + utostr(i))->isDeclaration());
+    }
+    EXPECT_FALSE(verifyModule(*m));
+  }
+}
+
+TEST(BitReaderTest, StreamLastFunctionWithFunctionIndex) {
+  const unsigned N = 8;
+  SmallString<4096> Mem;
+  {
+    std::unique_ptr<Module> Mod(makeFunctionsModule(N));
+    raw_svector_ostream OS(Mem);
+    WriteBitcodeToFile(Mod.get(), OS, /*EmitFunctionIndex=*/true);
+  }
+  std::string ErrMsg;
+  std::unique_ptr<Module> m(getStreamedBitcodeModule(
+      "test", new BufferStreamer(Mem.str()), getGlobalContext(), &ErrMsg));
+  ASSERT_TRUE(m.get()) << ErrMsg;
+
+  Function *Last = m->getFunction("f" + utostr(N - 1));
+  ASSERT_FALSE(Last->Materialize());
+  EXPECT_EQ(N - 1, getReturnedValue(Last));
+  Function *First = m->getFunction("f0");
+  EXPECT_TRUE(First->isMaterializable());
+  ASSERT_FALSE(First->Materialize());
+  EXPECT_EQ(0u, getReturnedValue(First));
+
+  ASSERT_FALSE(m->materializeAllPermanently());
+  for (unsigned i = 0; i != N; ++i)
+    EXPECT_EQ(i, getReturnedValue(m->getFunction("f" + utostr(i))));
+  EXPECT_FALSE(verifyModule(*m));
+}
+
 }
 }
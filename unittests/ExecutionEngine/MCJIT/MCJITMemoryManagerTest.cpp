@@ -9,6 +9,7 @@
 
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/ExecutionEngine/JIT.h"
+#include "llvm/Support/Process.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -167,5 +168,110 @@ TEST(MCJITMemoryManagerTest, ManyVariedAllocations) {
   }
 }
 
+TEST(MCJITMemoryManagerTest, ObjectUnloading) {
+  std::unique_ptr<SectionMemoryManager> MemMgr(new SectionMemoryManager());
+  // Only used as keys.
+  int Objects[2];
+  const ObjectImage *Obj1 = reinterpret_cast<const ObjectImage *>(&Objects[0]);
+  const ObjectImage *Obj2 = reinterpret_cast<const ObjectImage *>(&Objects[1]);
+
+  // By default the next object's sections go in the same block, and freeing
+  // an object keeps its memory.
+  uint8_t *data1 = MemMgr->allocateDataSection(100, 16, 1, "", false);
+  MemMgr->notifyObjectLoaded(nullptr, Obj1);
+  uint8_t *data2 = MemMgr->allocateDataSection(100, 16, 1, "", false);
+  EXPECT_EQ(data1 + 112, data2);
+  MemMgr->notifyObjectFreed(nullptr, Obj1);
+  data1[0] = 1;
+  MemMgr->notifyObjectLoaded(nullptr, Obj2);
+
+  // With object unloading, an object starts a block of its own.
+  MemMgr->setObjectUnloading(true);
+  uint8_t *data3 = MemMgr->allocateDataSection(100, 16, 1, "", false);
+  EXPECT_NE(data2 + 112, data3);
+}
+
+TEST(MCJITMemoryManagerTest, ArenaAllocations) {
+  std::unique_ptr<SectionMemoryManager> MemMgr(
+      new SectionMemoryManager(1 << 20));
+  MemMgr->setObjectUnloading(true);
+  // Only used as keys.
+  int Objects[3];
+  const ObjectImage *Obj1 = reinterpret_cast<const ObjectImage *>(&Objects[0]);
+  const ObjectImage *Obj2 = reinterpret_cast<const ObjectImage *>(&Objects[1]);
+  const ObjectImage *Obj3 = reinterpret_cast<const ObjectImage *>(&Objects[2]);
+  std::string Error;
+
+  MemMgr->reserveAllocationSpace(320, 128, 128);
+  uint8_t *code1 = MemMgr->allocateCodeSection(100, 16, 1, "");
+  uint8_t *code2 = MemMgr->allocateCodeSection(200, 16, 2, "");
+  uint8_t *data1 = MemMgr->allocateDataSection(100, 16, 3, "", true);
+  uint8_t *data2 = MemMgr->allocateDataSection(100, 16, 4, "", false);
+  EXPECT_NE((uint8_t*)0, code1);
+  EXPECT_NE((uint8_t*)0, data1);
+  EXPECT_NE((uint8_t*)0, data2);
+  // The sections of the object share the block reserved for them.
+  EXPECT_EQ(code1 + 112, code2);
+  EXPECT_FALSE(MemMgr->finalizeMemory(&Error));
+  MemMgr->notifyObjectLoaded(nullptr, Obj1);
+
+  // The next object's code follows, below all of the data.
+  MemMgr->reserveAllocationSpace(100, 0, 0);
+  uint8_t *code3 = MemMgr->allocateCodeSection(100, 16, 1, "");
+  EXPECT_LT(code2, code3);
+  EXPECT_LT(code3, data2);
+  EXPECT_LT(data2, data1);
+  EXPECT_FALSE(MemMgr->finalizeMemory(&Error));
+  MemMgr->notifyObjectLoaded(nullptr, Obj2);
+
+  // The memory of a freed object is reused, and writable again.
+  MemMgr->notifyObjectFreed(nullptr, Obj1);
+  MemMgr->reserveAllocationSpace(100, 100, 0);
+  uint8_t *code4 = MemMgr->allocateCodeSection(100, 16, 1, "");
+  uint8_t *data3 = MemMgr->allocateDataSection(100, 16, 2, "", true);
+  EXPECT_EQ(code1, code4);
+  EXPECT_EQ(data1, data3);
+  code4[0] = 1;
+  data3[0] = 2;
+  EXPECT_FALSE(MemMgr->finalizeMemory(&Error));
+  MemMgr->notifyObjectLoaded(nullptr, Obj3);
+}
+
+TEST(MCJITMemoryManagerTest, ArenaFreedOutOfOrder) {
+  std::unique_ptr<SectionMemoryManager> MemMgr(
+      new SectionMemoryManager(1 << 20));
+  MemMgr->setObjectUnloading(true);
+  EXPECT_TRUE(MemMgr->needsToReserveAllocationSpace());
+  EXPECT_FALSE(SectionMemoryManager().needsToReserveAllocationSpace());
+  uintptr_t PageSize = sys::process::get_self()->page_size();
+  // Only used as keys.
+  int Objects[3];
+  const ObjectImage *Obj1 = reinterpret_cast<const ObjectImage *>(&Objects[0]);
+  const ObjectImage *Obj2 = reinterpret_cast<const ObjectImage *>(&Objects[1]);
+  const ObjectImage *Obj3 = reinterpret_cast<const ObjectImage *>(&Objects[2]);
+  std::string Error;
+
+  MemMgr->reserveAllocationSpace(100, 0, 0);
+  uint8_t *code1 = MemMgr->allocateCodeSection(100, 16, 1, "");
+  EXPECT_FALSE(MemMgr->finalizeMemory(&Error));
+  MemMgr->notifyObjectLoaded(nullptr, Obj1);
+  MemMgr->reserveAllocationSpace(100, 0, 0);
+  uint8_t *code2 = MemMgr->allocateCodeSection(100, 16, 1, "");
+  EXPECT_EQ(code1 + PageSize, code2);
+  EXPECT_FALSE(MemMgr->finalizeMemory(&Error));
+  MemMgr->notifyObjectLoaded(nullptr, Obj2);
+
+  // Freeing the lower object first leaves a free block; freeing the upper one
+  // then returns both to the arena, which has room for two pages again.
+  MemMgr->notifyObjectFreed(nullptr, Obj1);
+  MemMgr->notifyObjectFreed(nullptr, Obj2);
+  MemMgr->reserveAllocationSpace(2 * PageSize, 0, 0);
+  uint8_t *code3 = MemMgr->allocateCodeSection(2 * PageSize, 16, 1, "");
+  EXPECT_EQ(code1, code3);
+  code3[2 * PageSize - 1] = 1;
+  EXPECT_FALSE(MemMgr->finalizeMemory(&Error));
+  MemMgr->notifyObjectLoaded(nullptr, Obj3);
+}
+
 } // Namespace
 
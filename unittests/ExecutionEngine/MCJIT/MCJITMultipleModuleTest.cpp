@@ -14,7 +14,13 @@
 
 #include "llvm/ExecutionEngine/MCJIT.h"
 #include "MCJITTestBase.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/Threading.h"
 #include "gtest/gtest.h"
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
 
 using namespace llvm;
 
@@ -392,4 +398,93 @@ TEST_F(MCJITMultipleModuleTest, cross_module_dependency_case3) {
   ptr = TheJIT->getFunctionAddress(FB2->getName().str());
   checkAccumulate(ptr);
 }
+
+// Module A { Function FA },
+// Module B { Function add2 }, finalized, removed and added again three times.
+TEST_F(MCJITMultipleModuleTest, remove_finalized_module) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  std::unique_ptr<Module> A(createEmptyModule("A"));
+  Function *FA = insertAddFunction(A.get());
+  createJIT(A.release());
+
+  for (unsigned i = 0; i != 3; ++i) {
+    Module *B = createEmptyModule("B" + utostr(i));
+    insertAddFunction(B, "add2");
+    TheJIT->addModule(B);
+    checkAdd(TheJIT->getFunctionAddress("add2"));
+
+    EXPECT_TRUE(TheJIT->removeModule(B));
+    delete B;
+    EXPECT_EQ(0U, TheJIT->getFunctionAddress("add2"))
+      << "Symbol of a removed module is still defined";
+  }
+
+  checkAdd(TheJIT->getFunctionAddress(FA->getName().str()));
+}
+
+#if LLVM_ENABLE_THREADS != 0 && defined(HAVE_PTHREAD_H)
+struct ConcurrentLookup {
+  ExecutionEngine *EE;
+  std::string Name;
+  uint64_t Addr;
+};
+
+void *lookupFunction(void *Arg) {
+  ConcurrentLookup *L = static_cast<ConcurrentLookup *>(Arg);
+  L->Addr = L->EE->getFunctionAddress(L->Name);
+  return nullptr;
+}
+
+// Module A { Function add },
+// Modules C0..C3, each in a context of its own { Extern add, Function caller_i
+// which calls add }, compiled from four threads at once.
+TEST_F(MCJITMultipleModuleTest, concurrent_compiles) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  llvm_start_multithreaded();
+
+  const unsigned NumThreads = 4;
+  LLVMContext Contexts[NumThreads];
+  ConcurrentLookup Lookups[NumThreads];
+
+  std::unique_ptr<Module> A(createEmptyModule("A"));
+  Function *FA = insertAddFunction(A.get());
+  createJIT(A.release());
+
+  for (unsigned i = 0; i != NumThreads; ++i) {
+    LLVMContext &Ctx = Contexts[i];
+    Module *C = new Module("C" + utostr(i), Ctx);
+    C->setTargetTriple(Triple::normalize(BuilderTriple));
+    FunctionType *FTy = TypeBuilder<int32_t(int32_t, int32_t), false>::get(Ctx);
+    Function *Add =
+        Function::Create(FTy, GlobalValue::ExternalLinkage, FA->getName(), C);
+    Function *Caller = Function::Create(FTy, GlobalValue::ExternalLinkage,
+                                        "caller_" + utostr(i), C);
+    IRBuilder<> B(BasicBlock::Create(Ctx, "entry", Caller));
+    Function::arg_iterator Args = Caller->arg_begin();
+    Value *Arg1 = Args;
+    Value *Arg2 = ++Args;
+    B.CreateRet(B.CreateCall2(Add, Arg1, Arg2));
+    TheJIT->addModule(C);
+
+    Lookups[i].EE = TheJIT.get();
+    Lookups[i].Name = Caller->getName();
+    Lookups[i].Addr = 0;
+  }
+
+  pthread_t Threads[NumThreads];
+  for (unsigned i = 0; i != NumThreads; ++i)
+    pthread_create(&Threads[i], nullptr, lookupFunction, &Lookups[i]);
+  for (unsigned i = 0; i != NumThreads; ++i)
+    pthread_join(Threads[i], nullptr);
+
+  for (unsigned i = 0; i != NumThreads; ++i)
+    checkAdd(Lookups[i].Addr);
+
+  // The engine deletes the modules, which must happen before their contexts
+  // go away.
+  TheJIT.reset();
+}
+#endif
 }
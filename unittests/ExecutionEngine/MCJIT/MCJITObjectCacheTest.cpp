@@ -11,10 +11,12 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSet.h"
+#include "llvm/ExecutionEngine/FileSystemObjectCache.h"
 #include "llvm/ExecutionEngine/JIT.h"
 #include "llvm/ExecutionEngine/MCJIT.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/Support/FileSystem.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -85,6 +87,39 @@ private:
   bool                            DuplicateInserted;
 };
 
+// A scratch directory for FileSystemObjectCache, removed with its contents.
+class ScratchDir {
+public:
+  ScratchDir() {
+    EXPECT_FALSE(sys::fs::createUniqueDirectory("mcjit-object-cache", Path));
+  }
+
+  ~ScratchDir() {
+    error_code EC;
+    std::vector<std::string> Files;
+    for (sys::fs::directory_iterator I(Path.str(), EC), E; I != E && !EC;
+         I.increment(EC))
+      Files.push_back(I->path());
+    for (unsigned i = 0, e = Files.size(); i != e; ++i)
+      sys::fs::remove(Files[i]);
+    sys::fs::remove(Path.str());
+  }
+
+  unsigned countFiles() const {
+    unsigned Count = 0;
+    error_code EC;
+    for (sys::fs::directory_iterator I(Path.str(), EC), E; I != E && !EC;
+         I.increment(EC))
+      ++Count;
+    return Count;
+  }
+
+  StringRef path() const { return Path.str(); }
+
+private:
+  SmallString<128> Path;
+};
+
 class MCJITObjectCacheTest : public testing::Test, public MCJITTestBase {
 protected:
 
@@ -115,6 +150,18 @@ protected:
     EXPECT_EQ(returnCode, ExpectedRC);
   }
 
+  // Throw away the engine and memory manager and JIT a fresh main() that
+  // returns RC, as a restarted process would.
+  const Module *restart(int RC, const char *Name = "<main>") {
+    TheJIT.reset();
+    MM = new SectionMemoryManager;
+    M.reset(createEmptyModule(Name));
+    Main = insertMainFunction(M.get(), RC);
+    const Module *NewModule = M.get();
+    createJIT(M.release());
+    return NewModule;
+  }
+
   Function *Main;
 };
 
@@ -237,5 +284,90 @@ TEST_F(MCJITObjectCacheTest, VerifyNonLoadFromCache) {
   EXPECT_FALSE(Cache->wereDuplicatesInserted());
 }
 
+TEST_F(MCJITObjectCacheTest, FileSystemCacheWarmRestart) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  ScratchDir Dir;
+  createJIT(M.release());
+  std::unique_ptr<FileSystemObjectCache> Cache(
+      new FileSystemObjectCache(Dir.path(), *TheJIT->getTargetMachine()));
+  TheJIT->setObjectCache(Cache.get());
+  compileAndRun();
+  EXPECT_EQ(1u, Dir.countFiles());
+
+  // An identical module in a new engine and cache hits, whatever the module
+  // is called.
+  const Module *Restarted = restart(OriginalRC, "<restarted>");
+  Cache.reset(
+      new FileSystemObjectCache(Dir.path(), *TheJIT->getTargetMachine()));
+  std::unique_ptr<MemoryBuffer> Obj(Cache->getObject(Restarted));
+  EXPECT_TRUE(0 != Obj.get());
+  TheJIT->setObjectCache(Cache.get());
+  compileAndRun();
+  EXPECT_EQ(1u, Dir.countFiles());
+
+  // A changed module misses and is compiled and cached.
+  const Module *Changed = restart(ReplacementRC);
+  Cache.reset(
+      new FileSystemObjectCache(Dir.path(), *TheJIT->getTargetMachine()));
+  Obj.reset(Cache->getObject(Changed));
+  EXPECT_EQ(0, Obj.get());
+  TheJIT->setObjectCache(Cache.get());
+  compileAndRun(ReplacementRC);
+  EXPECT_EQ(2u, Dir.countFiles());
+}
+
+TEST_F(MCJITObjectCacheTest, FileSystemCacheLargeObject) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  // Objects bigger than a page are memory mapped on a hit, and the dynamic
+  // linker writes section addresses into the object it loads.
+  std::vector<uint8_t> Bytes(64 * 1024, 1);
+  ScratchDir Dir;
+  for (unsigned Run = 0; Run != 2; ++Run) {
+    const Module *Mod = Run ? restart(OriginalRC) : M.get();
+    new GlobalVariable(*const_cast<Module *>(Mod),
+                       ArrayType::get(Type::getInt8Ty(Context), Bytes.size()),
+                       true, GlobalValue::ExternalLinkage,
+                       ConstantDataArray::get(Context, Bytes), "Data");
+    if (!Run)
+      createJIT(M.release());
+    FileSystemObjectCache Cache(Dir.path(), *TheJIT->getTargetMachine());
+    if (Run) {
+      std::unique_ptr<MemoryBuffer> Obj(Cache.getObject(Mod));
+      ASSERT_TRUE(0 != Obj.get());
+      EXPECT_LT(Bytes.size(), Obj->getBufferSize());
+    }
+    TheJIT->setObjectCache(&Cache);
+    compileAndRun();
+    TheJIT->setObjectCache(nullptr);
+  }
+}
+
+TEST_F(MCJITObjectCacheTest, FileSystemCacheEviction) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  ScratchDir Dir;
+  const Module *First = M.get();
+  createJIT(M.release());
+  std::unique_ptr<FileSystemObjectCache> Cache(
+      new FileSystemObjectCache(Dir.path(), *TheJIT->getTargetMachine()));
+  TheJIT->setObjectCache(Cache.get());
+  std::string FirstPath = Cache->getCachePath(First);
+  compileAndRun();
+  uint64_t ObjectSize;
+  ASSERT_FALSE(sys::fs::file_size(FirstPath, ObjectSize));
+
+  // With room for one object, caching a second object evicts the first.
+  const Module *Second = restart(ReplacementRC);
+  Cache.reset(new FileSystemObjectCache(
+      Dir.path(), *TheJIT->getTargetMachine(), ObjectSize + ObjectSize / 2));
+  TheJIT->setObjectCache(Cache.get());
+  std::string SecondPath = Cache->getCachePath(Second);
+  compileAndRun(ReplacementRC);
+  EXPECT_EQ(1u, Dir.countFiles());
+  EXPECT_TRUE(sys::fs::exists(SecondPath));
+}
+
 } // Namespace
 
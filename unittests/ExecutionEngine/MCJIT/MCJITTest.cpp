@@ -13,8 +13,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ExecutionEngine/JITEventListener.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
 #include "MCJITTestBase.h"
 #include "gtest/gtest.h"
+#include <cstdlib>
+#include <cstring>
 
 using namespace llvm;
 
@@ -78,6 +86,21 @@ TEST_F(MCJITTest, add_function) {
   EXPECT_EQ(-40, AddPtr(-10, -30));
 }
 
+TEST_F(MCJITTest, function_defined_after_add) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  Module *Owned = M.get();
+  createJIT(M.release());
+  Function *Foo = startFunction<int32_t(void)>(Owned, "foo");
+  endFunctionWithRet(Foo, ConstantInt::get(Context, APInt(32, 42)));
+
+  uint64_t ptr = TheJIT->getFunctionAddress("foo");
+  ASSERT_TRUE(0 != ptr)
+    << "A function defined after its module was added should be found";
+  int32_t (*FuncPtr)(void) = (int32_t(*)(void))ptr;
+  EXPECT_EQ(42, FuncPtr());
+}
+
 TEST_F(MCJITTest, run_main) {
   SKIP_UNSUPPORTED_PLATFORM;
 
@@ -187,4 +210,165 @@ TEST_F(MCJITTest, multiple_functions) {
 
 #endif /*!defined(__arm__)*/
 
+// Counts the objects MCJIT loads and frees.
+class ObjectCountingListener : public JITEventListener {
+public:
+  ObjectCountingListener() : Emitted(0), Freed(0) {}
+  void NotifyObjectEmitted(const ObjectImage &) override { ++Emitted; }
+  void NotifyFreeingObject(const ObjectImage &) override { ++Freed; }
+  unsigned Emitted, Freed;
+};
+
+TEST_F(MCJITTest, lazy_compilation) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  // The body of caller refers back to an internal function and variable.
+  GlobalVariable *Offset = insertGlobalInt32(M.get(), "offset", 1000);
+  Offset->setLinkage(GlobalValue::InternalLinkage);
+  Function *Accumulate = insertAccumulateFunction(M.get());
+  Accumulate->setLinkage(GlobalValue::InternalLinkage);
+  Function *Caller = startFunction<int32_t(int32_t)>(M.get(), "caller");
+  Value *Sum = Builder.CreateCall(Accumulate, Caller->arg_begin());
+  endFunctionWithRet(Caller,
+                     Builder.CreateAdd(Sum, Builder.CreateLoad(Offset)));
+  insertAddFunction(M.get(), "unused");
+
+  Module *Owned = M.get();
+  createJIT(M.release());
+  ObjectCountingListener Listener;
+  TheJIT->RegisterJITEventListener(&Listener);
+  TheJIT->DisableLazyCompilation(false);
+
+  uint64_t ptr = TheJIT->getFunctionAddress("caller");
+  EXPECT_TRUE(0 != ptr)
+    << "Unable to get pointer to caller from JIT";
+  EXPECT_EQ(1u, Listener.Emitted)
+    << "Only the stubs should be compiled before the first call";
+  if (ptr) {
+    int32_t(*FuncPtr)(int32_t) = (int32_t(*)(int32_t))ptr;
+    EXPECT_EQ(1000 + 5050, FuncPtr(100));
+    EXPECT_EQ(1000 + 15, FuncPtr(5));
+  }
+  // The stubs and the bodies of caller and accumulate, but not unused.
+  EXPECT_EQ(3u, Listener.Emitted);
+
+  EXPECT_TRUE(TheJIT->removeModule(Owned));
+  EXPECT_EQ(3u, Listener.Freed)
+    << "The lazily compiled bodies should be freed with their module";
+  delete Owned;
+  TheJIT->UnregisterJITEventListener(&Listener);
+}
+
+TEST_F(MCJITTest, lazy_compilation_leaves_module) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  Function *Helper = insertMainFunction(M.get(), 42);
+  Helper->setName("helper");
+  Helper->setLinkage(GlobalValue::InternalLinkage);
+  Function *Foo = insertSimpleCallFunction<int32_t()>(M.get(), Helper);
+  Foo->setName("foo");
+
+  Module *Owned = M.get();
+  createJIT(M.release());
+  TheJIT->DisableLazyCompilation(false);
+
+  uint64_t ptr = TheJIT->getFunctionAddress("foo");
+  ASSERT_TRUE(0 != ptr) << "Unable to get pointer to foo from JIT";
+  EXPECT_EQ(42, ((int32_t(*)())ptr)());
+  void *HelperPtr = TheJIT->getPointerToFunction(Helper);
+  ASSERT_TRUE(HelperPtr != nullptr)
+    << "An internal function should be found under its own name";
+  EXPECT_EQ(42, ((int32_t(*)())(intptr_t)HelperPtr)());
+
+  // The module the engine is given back still has its bodies, and nothing in
+  // it refers to the engine it was removed from.
+  EXPECT_TRUE(TheJIT->removeModule(Owned));
+  TheJIT.reset();
+  EXPECT_FALSE(verifyModule(*Owned));
+  EXPECT_FALSE(Owned->getFunction("foo")->isDeclaration());
+  EXPECT_TRUE(Helper->hasLocalLinkage());
+  EXPECT_EQ("helper", Helper->getName());
+
+  MM = new SectionMemoryManager();
+  createJIT(Owned);
+  ptr = TheJIT->getFunctionAddress("foo");
+  ASSERT_TRUE(0 != ptr) << "Unable to get pointer to foo from a new JIT";
+  EXPECT_EQ(42, ((int32_t(*)())ptr)());
+}
+
+#ifdef __linux__
+TEST_F(MCJITTest, perf_jit_event_listener) {
+  SKIP_UNSUPPORTED_PLATFORM;
+
+  insertAddFunction(M.get(), "perf_add");
+  createJIT(M.release());
+  std::unique_ptr<JITEventListener> Listener(
+      JITEventListener::createPerfJITEventListener(/*JITDump=*/true));
+  ASSERT_TRUE(Listener.get() != nullptr);
+  TheJIT->RegisterJITEventListener(Listener.get());
+  uint64_t Addr = TheJIT->getFunctionAddress("perf_add");
+  ASSERT_TRUE(0 != Addr);
+  TheJIT->UnregisterJITEventListener(Listener.get());
+  // Writes the closing record of the jitdump file.
+  Listener.reset();
+
+  std::string Pid = utostr(sys::process::get_self()->get_id());
+  std::string MapPath = "/tmp/perf-" + Pid + ".map";
+  const char *Dir = getenv("JITDUMPDIR");
+  std::string DumpPath = std::string(Dir ? Dir : "/tmp") + "/jit-" + Pid +
+                         ".dump";
+
+  // The map has a line "<address> <size> <name>" in hex.
+  std::unique_ptr<MemoryBuffer> Map;
+  ASSERT_FALSE(MemoryBuffer::getFile(MapPath, Map));
+  bool FoundInMap = false;
+  SmallVector<StringRef, 8> Lines;
+  Map->getBuffer().split(Lines, "\n", -1, false);
+  for (unsigned i = 0, e = Lines.size(); i != e; ++i) {
+    SmallVector<StringRef, 3> Fields;
+    Lines[i].split(Fields, " ");
+    uint64_t LineAddr;
+    if (Fields.size() == 3 && Fields[2] == "perf_add" &&
+        !Fields[0].getAsInteger(16, LineAddr))
+      FoundInMap |= LineAddr == Addr;
+  }
+  EXPECT_TRUE(FoundInMap) << "perf_add is missing from " << MapPath;
+
+  // The jitdump file has a header, then records that each start with their
+  // type and size; the code load record of perf_add carries its code.
+  std::unique_ptr<MemoryBuffer> Dump;
+  ASSERT_FALSE(MemoryBuffer::getFile(DumpPath, Dump, -1, false));
+  StringRef Data = Dump->getBuffer();
+  ASSERT_LE(40u, Data.size());
+  uint32_t Magic;
+  memcpy(&Magic, Data.data(), 4);
+  EXPECT_EQ(0x4A695444u, Magic);
+  bool FoundCode = false;
+  uint32_t LastType = ~0U;
+  for (size_t Off = 40; Off + 16 <= Data.size();) {
+    uint32_t Type, Size;
+    memcpy(&Type, Data.data() + Off, 4);
+    memcpy(&Size, Data.data() + Off + 4, 4);
+    ASSERT_LE(16u, Size);
+    ASSERT_LE(Off + Size, Data.size());
+    if (Type == 0) {
+      uint64_t CodeAddr, CodeSize;
+      memcpy(&CodeAddr, Data.data() + Off + 32, 8);
+      memcpy(&CodeSize, Data.data() + Off + 40, 8);
+      StringRef Name(Data.data() + Off + 56);
+      const char *Code = Data.data() + Off + 56 + Name.size() + 1;
+      if (Name == "perf_add" && CodeAddr == Addr)
+        FoundCode = !memcmp(Code, (const void *)(uintptr_t)Addr, CodeSize);
+    }
+    LastType = Type;
+    Off += Size;
+  }
+  EXPECT_TRUE(FoundCode) << "perf_add's code is missing from " << DumpPath;
+  EXPECT_EQ(3u, LastType) << "The jitdump file should end with a close record";
+
+  sys::fs::remove(MapPath);
+  sys::fs::remove(DumpPath);
+}
+#endif
+
 }
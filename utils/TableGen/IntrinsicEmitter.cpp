@@ -250,7 +250,13 @@ enum IIT_Info {
   IIT_ANYPTR = 25,
   IIT_V1   = 26,
   IIT_VARARG = 27,
-  IIT_HALF_VEC_ARG = 28
+  IIT_HALF_VEC_ARG = 28,
+  IIT_STRUCT6 = 29,
+  IIT_STRUCT7 = 30,
+  IIT_STRUCT8 = 31,
+  IIT_V64  = 32,
+  IIT_V128 = 33,
+  IIT_V256 = 34
 };
 
 
@@ -350,6 +356,9 @@ static void EncodeFixedType(Record *R, std::vector<unsigned char> &ArgCodes,
     case 8: Sig.push_back(IIT_V8); break;
     case 16: Sig.push_back(IIT_V16); break;
     case 32: Sig.push_back(IIT_V32); break;
+    case 64: Sig.push_back(IIT_V64); break;
+    case 128: Sig.push_back(IIT_V128); break;
+    case 256: Sig.push_back(IIT_V256); break;
     }
 
     return EncodeFixedValueType(VVT.getVectorElementType().SimpleTy, Sig);
@@ -380,6 +389,9 @@ static void ComputeFixedEncoding(const CodeGenIntrinsic &Int,
       case 3: TypeSig.push_back(IIT_STRUCT3); break;
       case 4: TypeSig.push_back(IIT_STRUCT4); break;
       case 5: TypeSig.push_back(IIT_STRUCT5); break;
+      case 6: TypeSig.push_back(IIT_STRUCT6); break;
+      case 7: TypeSig.push_back(IIT_STRUCT7); break;
+      case 8: TypeSig.push_back(IIT_STRUCT8); break;
       default: assert(0 && "Unhandled case in struct");
     }
 
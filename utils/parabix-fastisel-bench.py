@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+
+"""Time-to-first-execution benchmark for FastISel on Parabix kernels.
+
+Generates kernels shaped like generated Parabix code -- streams loaded from
+memory, combined with logic operations and i1 add/sub, and stored back --
+and has llvm-mcjit-bench -first-run JIT them through MCJIT at -O0,
+with FastISel on and off. It reports the wall time from creating the engine
+to the first results of all kernels. The number of instructions FastISel
+missed is reported as well; each miss sends the rest of its block to
+SelectionDAG.
+
+The kernels run on the host; --width 256 asks for AVX2, which the host must
+have.
+
+Usage:
+  parabix-fastisel-bench.py [--bench path/to/llvm-mcjit-bench]
+                            [--kernels K] [--ops N] [--width 32|64|128|256]
+                            [--runs R] [--emit file.ll]
+                            [-- extra llvm-mcjit-bench args]
+"""
+
+from __future__ import print_function
+
+import argparse
+import subprocess
+import sys
+import tempfile
+
+OPS = ['and', 'or', 'xor', 'add', 'sub']
+
+def kernel(name, ty, num_ops):
+    lines = ['define void @%s(%s* %%in, %s* %%out) {' % (name, ty, ty),
+             'entry:']
+    streams = []
+    for k in range(4):
+        lines.append('  %%p%d = getelementptr %s* %%in, i64 %d' % (k, ty, k))
+        lines.append('  %%s%d = load %s* %%p%d' % (k, ty, k))
+        streams.append('%%s%d' % k)
+    for n in range(num_ops):
+        cur = '%%v%d' % n
+        lines.append('  %s = %s %s %s, %s' % (cur, OPS[n % len(OPS)], ty,
+                                             streams[-1], streams[-4]))
+        streams.append(cur)
+        if n % 8 == 7:
+            lines.append('  %%q%d = getelementptr %s* %%out, i64 %d'
+                         % (n, ty, n // 8))
+            lines.append('  store %s %s, %s* %%q%d' % (ty, cur, ty, n))
+    lines += ['  ret void', '}']
+    return '\n'.join(lines) + '\n'
+
+def generate(num_kernels, num_ops, width):
+    ty = '<%d x i1>' % width
+    return ''.join(kernel('kernel%d' % k, ty, num_ops)
+                   for k in range(num_kernels))
+
+def buffer_bytes(num_ops, width):
+    # The kernels index whole streams, which may be allocated a byte per i1.
+    return (4 + num_ops // 8) * width
+
+def run_bench(bench, path, size, extra):
+    cmd = [bench, '-first-run=' + path, '-size=%d' % size] + extra
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                            universal_newlines=True)
+    out, err = proc.communicate()
+    if proc.returncode != 0:
+        sys.exit('llvm-mcjit-bench failed:\n' + err)
+    # functions, first results ms, code KB
+    fields = out.splitlines()[-1].split()
+    return float(fields[1]) / 1e3, err
+
+def fastisel_misses(bench, path, size, extra):
+    err = run_bench(bench, path, size, extra + ['-fast-isel-verbose'])[1]
+    return sum(1 for line in err.splitlines()
+               if line.startswith('FastISel miss'))
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--bench', default='llvm-mcjit-bench')
+    parser.add_argument('--kernels', type=int, default=200)
+    parser.add_argument('--ops', type=int, default=200,
+                        help='stream operations per kernel')
+    parser.add_argument('--width', type=int, choices=[32, 64, 128, 256],
+                        default=128, help='bits per stream register')
+    parser.add_argument('--runs', type=int, default=5)
+    parser.add_argument('--emit', help='write the generated IR here and exit')
+    parser.add_argument('extra', nargs='*',
+                        help='extra llvm-mcjit-bench arguments')
+    args = parser.parse_args()
+
+    extra = args.extra
+    if args.width == 256 and not any('avx2' in a for a in extra):
+        extra = extra + ['-mattr=+avx2']
+    size = buffer_bytes(args.ops, args.width)
+    ir = generate(args.kernels, args.ops, args.width)
+    if args.emit:
+        with open(args.emit, 'w') as f:
+            f.write(ir)
+        return
+
+    with tempfile.NamedTemporaryFile(mode='w', suffix='.ll') as f:
+        f.write(ir)
+        f.flush()
+        fast = min(run_bench(args.bench, f.name, size, extra)[0]
+                   for _ in range(args.runs))
+        dag = min(run_bench(args.bench, f.name, size,
+                            extra + ['-fast-isel=false'])[0]
+                  for _ in range(args.runs))
+        misses = fastisel_misses(args.bench, f.name, size, extra)
+
+    print('fast-isel:     %8.3fs  (%d FastISel misses)' % (fast, misses))
+    print('selection-dag: %8.3fs' % dag)
+    print('speedup:       %8.2fx  (%d kernels x %d ops, <%d x i1>, best of %d)'
+          % (dag / fast, args.kernels, args.ops, args.width, args.runs))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,385 @@
+#!/usr/bin/env python
+#
+# Generate lib/Target/X86/ParabixGeneratedFuncs.h.
+#
+# Each GENLower* function lowers one operation on Parabix vectors with small
+# fields (i2, i4, i8) into full register logic, shifts and arithmetic, in the
+# style of the IDISA library. The formulas are written once in the small
+# expression language below, which can both print SDNodeTreeBuilder calls and
+# evaluate itself on Python integers. Every formula is checked against the
+# plain per-field semantics before the header is written, so a wrong formula
+# breaks the build instead of the generated code.
+#
+# Usage: parabix-gen-funcs.py -o ParabixGeneratedFuncs.h
+
+from __future__ import print_function
+
+import argparse
+import random
+import sys
+
+# Full registers are evaluated as WIDTH-bit integers made of 64-bit lanes,
+# which is what the v2i64 / v4i64 FullVT operations of the builder see.
+WIDTH = 256
+LANE = 64
+
+def splat(value, bits):
+    r = 0
+    for i in range(WIDTH // bits):
+        r |= value << (i * bits)
+    return r
+
+def field_pattern(fw, bits_in_field):
+    """64-bit constant repeating bits_in_field in every fw-bit field."""
+    return splat(bits_in_field, fw) & ((1 << 64) - 1)
+
+def lanes(x, bits):
+    mask = (1 << bits) - 1
+    return [(x >> (i * bits)) & mask for i in range(WIDTH // bits)]
+
+def join(vals, bits):
+    mask = (1 << bits) - 1
+    r = 0
+    for i, v in enumerate(vals):
+        r |= (v & mask) << (i * bits)
+    return r
+
+ALL = (1 << WIDTH) - 1
+
+class Expr(object):
+    def __xor__(self, o): return Op('XOR', self, o)
+    def __and__(self, o): return Op('AND', self, o)
+    def __or__(self, o): return Op('OR', self, o)
+    def __invert__(self): return Op('NOT', self)
+    def __add__(self, o): return Op('ADD', self, o)
+    def __sub__(self, o): return Op('SUB', self, o)
+    def __lshift__(self, n): return Shift('SHL', self, n)
+    def __rshift__(self, n): return Shift('SRL', self, n)
+
+class Var(Expr):
+    def __init__(self, name): self.name = name
+    def cpp(self): return self.name
+    def eval(self, env): return env[self.name]
+
+class Const(Expr):
+    """A 64-bit pattern splatted over the full register type."""
+    def __init__(self, value): self.value = value
+    def cpp(self): return 'b.Splat64(0x%016xull, FullVT)' % self.value
+    def eval(self, env): return splat(self.value, 64)
+
+class HalfConst(Expr):
+    """A 16-bit constant splatted over the 16-bit vector type WVT."""
+    def __init__(self, value): self.value = value
+    def cpp(self): return 'b.ConstantVector(WVT, 0x%04x)' % self.value
+    def eval(self, env): return splat(self.value, 16)
+
+class Op(Expr):
+    def __init__(self, op, *args):
+        self.op, self.args = op, args
+    def cpp(self):
+        return 'b.%s(%s)' % (self.op, ', '.join(a.cpp() for a in self.args))
+    def eval(self, env):
+        v = [a.eval(env) for a in self.args]
+        if self.op == 'XOR': return v[0] ^ v[1]
+        if self.op == 'AND': return v[0] & v[1]
+        if self.op == 'OR': return v[0] | v[1]
+        if self.op == 'NOT': return ~v[0] & ALL
+        if self.op == 'ADD':
+            return join([x + y for x, y in zip(lanes(v[0], LANE), lanes(v[1], LANE))], LANE)
+        if self.op == 'SUB':
+            return join([x - y for x, y in zip(lanes(v[0], LANE), lanes(v[1], LANE))], LANE)
+        raise ValueError(self.op)
+
+class Shift(Expr):
+    def __init__(self, op, a, n): self.op, self.a, self.n = op, a, n
+    def cpp(self): return 'b.%s<%d>(%s)' % (self.op, self.n, self.a.cpp())
+    def eval(self, env):
+        x = lanes(self.a.eval(env), LANE)
+        if self.op == 'SHL':
+            return join([v << self.n for v in x], LANE)
+        return join([v >> self.n for v in x], LANE)
+
+class Mul16(Expr):
+    """Multiply 16-bit fields, the operands are bitcast to WVT."""
+    def __init__(self, a, b): self.a, self.b = a, b
+    def cpp(self): return 'b.MUL(%s, %s)' % (self.a.cpp(), self.b.cpp())
+    def eval(self, env):
+        return join([x * y for x, y in zip(lanes(self.a.eval(env), 16),
+                                           lanes(self.b.eval(env), 16))], 16)
+
+class IFH1(Expr):
+    def __init__(self, m, a, b): self.m, self.a, self.b = m, a, b
+    def cpp(self):
+        return 'b.IFH1(%s, %s, %s)' % (self.m.cpp(), self.a.cpp(), self.b.cpp())
+    def eval(self, env):
+        m = self.m.eval(env)
+        return (m & self.a.eval(env)) | (~m & ALL & self.b.eval(env))
+
+class HiMask(Expr):
+    def __init__(self, fw): self.fw = fw
+    def cpp(self): return 'b.HiMask(VT.getSizeInBits(), %d)' % self.fw
+    def eval(self, env):
+        return splat(((1 << (self.fw // 2)) - 1) << (self.fw // 2), self.fw)
+
+class Body(object):
+    """A list of SDValue definitions followed by the returned value."""
+    def __init__(self):
+        self.lets = []
+    def let(self, name, expr):
+        self.lets.append((name, expr))
+        return Var(name)
+    def ret(self, expr):
+        self.result = expr
+        return self
+    def cpp(self, indent):
+        lines = ['SDValue %s = %s;' % (n, e.cpp()) for n, e in self.lets]
+        lines.append('return b.BITCAST(%s, VT);' % self.result.cpp())
+        return '\n'.join(indent + l for l in lines)
+    def eval(self, a1, a2):
+        env = {'A1': a1, 'A2': a2}
+        for n, e in self.lets:
+            env[n] = e.eval(env) & ALL
+        return self.result.eval(env) & ALL
+
+A1, A2 = Var('A1'), Var('A2')
+
+#===-- i2 ---------------------------------------------------------------===#
+
+def i2_add():
+    b = Body()
+    tmp = b.let('Tmp', A1 ^ A2)
+    return b.ret(IFH1(HiMask(2), tmp ^ ((A1 & A2) << 1), tmp))
+
+def i2_sub():
+    b = Body()
+    tmp = b.let('Tmp', A1 ^ A2)
+    return b.ret(IFH1(HiMask(2), tmp ^ ((~A1 & A2) << 1), tmp))
+
+def i2_mul():
+    b = Body()
+    t1 = b.let('Tmp1', A1 << 1)
+    t2 = b.let('Tmp2', A2 << 1)
+    return b.ret(IFH1(HiMask(2),
+                      (t1 & (A2 & (~A1 | ~t2))) | (A1 & (t2 & (~t1 | ~A2))),
+                      A1 & A2))
+
+def i2_spread(b, ans):
+    # ans holds the result in the high bit of every field.
+    return b.ret(IFH1(HiMask(2), ans, ans >> 1))
+
+def i2_icmp_eq():
+    b = Body()
+    tmp = b.let('Tmp', A1 ^ A2)
+    ans = b.let('TmpAns', ~(tmp << 1) & ~tmp)
+    return i2_spread(b, ans)
+
+def i2_icmp_lt(x, y, signed):
+    b = Body()
+    if signed:
+        tmp = b.let('Tmp', ~y)
+        ans = b.let('TmpAns', (x & tmp) | (((~x & y) << 1) & (x | tmp)))
+    else:
+        tmp = b.let('Tmp', ~x)
+        ans = b.let('TmpAns', (tmp & y) | (((tmp & y) << 1) & (tmp | y)))
+    return i2_spread(b, ans)
+
+def i2_shl():
+    b = Body()
+    t1 = b.let('Tmp1', A2 << 1)
+    tmp = b.let('Tmp', ((A1 << 1) & t1) | (A1 & ~t1))
+    return b.ret(IFH1(HiMask(2), tmp, A1 & ~A2))
+
+def i2_lshr():
+    b = Body()
+    tmp = b.let('Tmp', (A1 & ~A2) | ((A1 >> 1) & A2))
+    return b.ret(IFH1(HiMask(2), A1 & ~(A2 << 1), tmp))
+
+def i2_ashr():
+    b = Body()
+    return b.ret(IFH1(HiMask(2), A1, (A1 & ~A2) | (A2 & (A1 >> 1))))
+
+#===-- i4 (SWAR on 64-bit lanes) ---------------------------------------===#
+
+H4 = Const(field_pattern(4, 0x8))
+L4 = Const(field_pattern(4, 0x7))
+
+def i4_spread(b, hi):
+    # hi holds the result in bit 3 of every field, copy it to bits 0..2.
+    return b.ret(hi | (hi - (hi >> 3)))
+
+def i4_add():
+    b = Body()
+    s = b.let('Sum', (A1 & L4) + (A2 & L4))
+    return b.ret(s ^ ((A1 ^ A2) & H4))
+
+def i4_sub_expr(b, x, y):
+    return b.let('Diff', ((x | H4) - (y & L4)) ^ ((x ^ ~y) & H4))
+
+def i4_sub():
+    b = Body()
+    return b.ret(i4_sub_expr(b, A1, A2))
+
+def i4_icmp_eq():
+    b = Body()
+    t = b.let('Tmp', A1 ^ A2)
+    nz = b.let('NonZero', (((t & L4) + L4) | t) & H4)
+    return i4_spread(b, b.let('Hi', nz ^ H4))
+
+def i4_icmp_lt(x, y, signed):
+    # x < y is the borrow out of x - y.
+    b = Body()
+    if signed:
+        x = b.let('X', x ^ H4)
+        y = b.let('Y', y ^ H4)
+    d = i4_sub_expr(b, x, y)
+    nx = b.let('NotX', ~x)
+    return i4_spread(b, b.let('Borrow', ((nx & y) | ((nx | y) & d)) & H4))
+
+def i4_mask_of_bit(b, name, bit):
+    # All ones in the fields of A2 whose shift amount has this bit set.
+    hi = b.let(name + 'Hi', (A2 << (3 - bit)) & H4)
+    return b.let(name, hi | (hi - (hi >> 3)))
+
+def i4_shift(kind):
+    b = Body()
+    m0 = i4_mask_of_bit(b, 'M0', 0)
+    m1 = i4_mask_of_bit(b, 'M1', 1)
+    if kind == 'SHL':
+        r = b.let('R', IFH1(m0, (A1 << 1) & Const(field_pattern(4, 0xe)), A1))
+        return b.ret(IFH1(m1, (r << 2) & Const(field_pattern(4, 0xc)), r))
+    if kind == 'LSHR':
+        r = b.let('R', IFH1(m0, (A1 >> 1) & L4, A1))
+        return b.ret(IFH1(m1, (r >> 2) & Const(field_pattern(4, 0x3)), r))
+    r = b.let('R', IFH1(m0, ((A1 >> 1) & L4) | (A1 & H4), A1))
+    s = b.let('Sign', r & H4)
+    return b.ret(IFH1(m1, ((r >> 2) & Const(field_pattern(4, 0x3))) | s | (s >> 1),
+                      r))
+
+#===-- i8 ----------------------------------------------------------------===#
+
+def i8_mul():
+    # SSE2 / AVX2 only multiply 16-bit fields: do the low and the high byte of
+    # every 16-bit field separately and merge.
+    b = Body()
+    lo = b.let('Lo', Mul16(A1, A2) & HalfConst(0x00ff))
+    hi = b.let('Hi', Mul16(A1 & HalfConst(0xff00), Shift('SRL', A2, 8)))
+    return b.ret(lo | hi)
+
+#===-- Operation table ---------------------------------------------------===#
+
+TYPES = {2: ['v64i2', 'v128i2'], 4: ['v32i4', 'v64i4'], 8: ['v16i8', 'v32i8']}
+
+def sx(v, fw):
+    return v - (1 << fw) if v >> (fw - 1) else v
+
+def cmp_ref(pred):
+    return lambda a, b, fw: ((1 << fw) - 1) if pred(a, b, fw) else 0
+
+# (name, description, {field width: body}, reference, shift amount operand)
+OPERATIONS = [
+    ('ADD', 'add', {2: i2_add(), 4: i4_add()},
+     lambda a, b, fw: a + b, False),
+    ('SUB', 'sub', {2: i2_sub(), 4: i4_sub()},
+     lambda a, b, fw: a - b, False),
+    ('MUL', 'mul', {2: i2_mul(), 8: i8_mul()},
+     lambda a, b, fw: a * b, False),
+    ('ICMP_EQ', 'icmp eq', {2: i2_icmp_eq(), 4: i4_icmp_eq()},
+     cmp_ref(lambda a, b, fw: a == b), False),
+    ('ICMP_SLT', 'icmp slt',
+     {2: i2_icmp_lt(A1, A2, True), 4: i4_icmp_lt(A1, A2, True)},
+     cmp_ref(lambda a, b, fw: sx(a, fw) < sx(b, fw)), False),
+    ('ICMP_SGT', 'icmp sgt',
+     {2: i2_icmp_lt(A2, A1, True), 4: i4_icmp_lt(A2, A1, True)},
+     cmp_ref(lambda a, b, fw: sx(a, fw) > sx(b, fw)), False),
+    ('ICMP_ULT', 'icmp ult',
+     {2: i2_icmp_lt(A1, A2, False), 4: i4_icmp_lt(A1, A2, False)},
+     cmp_ref(lambda a, b, fw: a < b), False),
+    ('ICMP_UGT', 'icmp ugt',
+     {2: i2_icmp_lt(A2, A1, False), 4: i4_icmp_lt(A2, A1, False)},
+     cmp_ref(lambda a, b, fw: a > b), False),
+    ('SHL', 'shl', {2: i2_shl(), 4: i4_shift('SHL')},
+     lambda a, b, fw: a << b, True),
+    ('LSHR', 'lshr', {2: i2_lshr(), 4: i4_shift('LSHR')},
+     lambda a, b, fw: a >> b, True),
+    ('ASHR', 'ashr', {2: i2_ashr(), 4: i4_shift('ASHR')},
+     lambda a, b, fw: sx(a, fw) >> b, True),
+]
+
+def check(rng, trials):
+    errors = 0
+    for name, _, bodies, ref, is_shift in OPERATIONS:
+        for fw, body in sorted(bodies.items()):
+            mask = (1 << fw) - 1
+            for _ in range(trials):
+                a = lanes(rng.getrandbits(WIDTH), fw)
+                if is_shift:
+                    b = [rng.randrange(fw) for _ in a]
+                else:
+                    b = [rng.choice([x, rng.getrandbits(fw)]) for x in a]
+                got = lanes(body.eval(join(a, fw), join(b, fw)), fw)
+                want = [ref(x, y, fw) & mask for x, y in zip(a, b)]
+                if got != want:
+                    print('error: GENLower%s is wrong for i%d' % (name, fw),
+                          file=sys.stderr)
+                    errors += 1
+                    break
+    return errors
+
+HEADER = '''\
+/*===- ParabixGeneratedFuncs.h - Generated Parabix lowering -----*- C++ -*-===*\\
+ *
+ * Lower i2 / i4 / i8 Parabix vector operations into logic / shiftings.
+ *
+ * AUTO GENERATED FILE by utils/parabix-gen-funcs.py, do not edit.
+ *
+\\*===----------------------------------------------------------------------===*/
+#ifndef PARABIX_GENERATED_FUNCS
+#define PARABIX_GENERATED_FUNCS
+
+#include "llvm/CodeGen/SelectionDAG.h"
+using namespace llvm;
+
+MVT getFullRegisterType(MVT VT);
+'''
+
+def emit(out):
+    out.write(HEADER)
+    for name, desc, bodies, _, _ in OPERATIONS:
+        out.write('\n/* Generated function */\n')
+        out.write('static SDValue GENLower%s(SDValue Op, SelectionDAG &DAG) {\n' % name)
+        out.write('  MVT VT = Op.getSimpleValueType();\n')
+        out.write('  MVT FullVT = getFullRegisterType(VT);\n')
+        out.write('  SDNodeTreeBuilder b(Op, &DAG);\n')
+        first = True
+        for fw, body in sorted(bodies.items()):
+            cond = ' || '.join('VT == MVT::%s' % t for t in TYPES[fw])
+            out.write('%sif (%s) {\n' % ('\n  ' if first else '  else ', cond))
+            first = False
+            if fw == 8:
+                out.write('    MVT WVT = MVT::getVectorVT(MVT::i16, VT.getSizeInBits() / 16);\n')
+                out.write('    SDValue A1 = b.BITCAST(Op.getOperand(0), WVT);\n')
+                out.write('    SDValue A2 = b.BITCAST(Op.getOperand(1), WVT);\n')
+            else:
+                out.write('    SDValue A1 = b.BITCAST(Op.getOperand(0), FullVT);\n')
+                out.write('    SDValue A2 = b.BITCAST(Op.getOperand(1), FullVT);\n')
+            out.write('\n' + body.cpp('    ') + '\n')
+            out.write('  }\n')
+        out.write('\n  llvm_unreachable("GENLower of %s is misused.");\n' % desc)
+        out.write('  return SDValue();\n}\n')
+    out.write('\n#endif\n')
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate ParabixGeneratedFuncs.h')
+    parser.add_argument('-o', dest='output', required=True)
+    parser.add_argument('--trials', type=int, default=64,
+                        help='random vectors used to check each formula')
+    args = parser.parse_args()
+
+    if check(random.Random(0), args.trials):
+        sys.exit(1)
+
+    with open(args.output, 'w') as out:
+        emit(out)
+
+if __name__ == '__main__':
+    main()
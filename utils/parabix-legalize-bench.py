@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+
+"""Compile-time microbenchmark for DAG legalization of Parabix code.
+
+Generates one large function full of Parabix vector arithmetic (v32i1,
+v64i1, v128i1, v64i2, v32i4) and reports the "DAG Legalization" time that
+llc -time-passes prints for it. Every node in that function goes through
+getOperand0Action and getOperationAction in the legalizer loop.
+
+Usage:
+  parabix-legalize-bench.py [--llc path/to/llc] [--ops N] [--runs R]
+                            [--emit file.ll] [-- extra llc args]
+"""
+
+from __future__ import print_function
+
+import argparse
+import re
+import subprocess
+import sys
+import tempfile
+
+TYPES = ['<32 x i1>', '<64 x i1>', '<128 x i1>', '<64 x i2>', '<32 x i4>']
+OPS = ['add', 'sub', 'and', 'or', 'xor']
+
+def generate(num_ops):
+    lines = []
+    args = []
+    for i, ty in enumerate(TYPES):
+        args.append('%s %%a%d' % (ty, i))
+        args.append('%s %%b%d' % (ty, i))
+        args.append('%s* %%out%d' % (ty, i))
+    lines.append('define void @parabix_bench(%s) {' % ', '.join(args))
+    lines.append('entry:')
+    for i, ty in enumerate(TYPES):
+        prev, other = '%%a%d' % i, '%%b%d' % i
+        for n in range(num_ops):
+            op = OPS[n % len(OPS)]
+            cur = '%%v%d_%d' % (i, n)
+            lines.append('  %s = %s %s %s, %s' % (cur, op, ty, prev, other))
+            other, prev = prev, cur
+        lines.append('  store %s %s, %s* %%out%d' % (ty, prev, ty, i))
+    lines.append('  ret void')
+    lines.append('}')
+    return '\n'.join(lines) + '\n'
+
+def legalize_time(llc, path, extra):
+    cmd = [llc, '-O0', '-time-passes', '-mtriple=x86_64-unknown-unknown',
+           '-mattr=+sse2', '-o', '/dev/null', path] + extra
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                            universal_newlines=True)
+    _, err = proc.communicate()
+    if proc.returncode != 0:
+        sys.exit('llc failed:\n' + err)
+    for line in err.splitlines():
+        if line.strip().endswith('DAG Legalization'):
+            # The last numeric column before the name is the wall time.
+            return float(re.findall(r'([0-9.]+) \(', line)[-1])
+    sys.exit('no "DAG Legalization" timer in llc output')
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--llc', default='llc')
+    parser.add_argument('--ops', type=int, default=20000,
+                        help='operations per vector type')
+    parser.add_argument('--runs', type=int, default=5)
+    parser.add_argument('--emit', help='write the generated IR here and exit')
+    parser.add_argument('extra', nargs='*', help='extra llc arguments')
+    args = parser.parse_args()
+
+    ir = generate(args.ops)
+    if args.emit:
+        with open(args.emit, 'w') as f:
+            f.write(ir)
+        return
+
+    with tempfile.NamedTemporaryFile(mode='w', suffix='.ll') as f:
+        f.write(ir)
+        f.flush()
+        times = sorted(legalize_time(args.llc, f.name, args.extra)
+                       for _ in range(args.runs))
+    print('DAG Legalization: min %.4fs  median %.4fs  (%d nodes/type, %d runs)'
+          % (times[0], times[len(times) // 2], args.ops, args.runs))
+
+if __name__ == '__main__':
+    main()
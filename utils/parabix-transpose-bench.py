@@ -0,0 +1,183 @@
+#!/usr/bin/env python
+
+"""Throughput benchmark for the Parabix bit transposition intrinsics.
+
+Generates loops that run llvm.x86.parabix.s2p and llvm.x86.parabix.p2s (or
+their .256 forms) over a buffer, compiles them with llc, links them with a
+small C driver and reports the transposition speed in GB/s of byte stream.
+
+Usage:
+  parabix-transpose-bench.py [--llc path/to/llc] [--cc cc] [--width 128|256]
+                             [--size BYTES] [--iters N] [--keep DIR]
+                             [-- extra llc args]
+"""
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+DRIVER = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void s2p_loop(const void *In, void *Out, long Blocks);
+void p2s_loop(const void *In, void *Out, long Blocks);
+
+static double now(void) {
+  struct timespec T;
+  clock_gettime(CLOCK_MONOTONIC, &T);
+  return T.tv_sec + T.tv_nsec * 1e-9;
+}
+
+static double run(void (*F)(const void *, void *, long), const void *In,
+                  void *Out, long Blocks, long Iters) {
+  double Best = 1e30;
+  int Rep;
+  for (Rep = 0; Rep < 5; ++Rep) {
+    long I;
+    double Start = now(), Elapsed;
+    for (I = 0; I < Iters; ++I)
+      F(In, Out, Blocks);
+    Elapsed = now() - Start;
+    if (Elapsed < Best)
+      Best = Elapsed;
+  }
+  return Best;
+}
+
+int main(int argc, char **argv) {
+  long Size = atol(argv[1]), Iters = atol(argv[2]), Width = atol(argv[3]);
+  long Blocks = Size / Width, I;
+  unsigned char *In, *Basis, *Out;
+  double Bytes, T;
+
+  if (posix_memalign((void **)&In, 64, Size) ||
+      posix_memalign((void **)&Basis, 64, Size) ||
+      posix_memalign((void **)&Out, 64, Size))
+    return 1;
+  for (I = 0; I < Size; ++I)
+    In[I] = (unsigned char)rand();
+
+  s2p_loop(In, Basis, Blocks);
+  p2s_loop(Basis, Out, Blocks);
+  if (memcmp(In, Out, Blocks * Width) != 0) {
+    fprintf(stderr, "p2s(s2p(x)) != x\n");
+    return 1;
+  }
+
+  Bytes = (double)Blocks * Width * Iters;
+  T = run(s2p_loop, In, Basis, Blocks, Iters);
+  printf("s2p: %.2f GB/s\n", Bytes / T * 1e-9);
+  T = run(p2s_loop, Basis, Out, Blocks, Iters);
+  printf("p2s: %.2f GB/s\n", Bytes / T * 1e-9);
+  return 0;
+}
+'''
+
+def loop(name, intrinsic, in_ty, out_ty, mem_ty):
+    """A loop over Blocks groups of eight in_ty values. Addresses are computed
+    in mem_ty, the byte vector type: vectors of i1 have no sensible alloc size
+    at every width."""
+    struct = '{' + ', '.join([out_ty] * 8) + '}'
+    lines = ['declare %s @%s(%s)' % (struct, intrinsic, ', '.join([in_ty] * 8)),
+             'define void @%s(%s* %%in, %s* %%out, i64 %%blocks) {'
+             % (name, mem_ty, mem_ty),
+             'entry:',
+             '  %empty = icmp sle i64 %blocks, 0',
+             '  br i1 %empty, label %done, label %body',
+             'body:',
+             '  %i = phi i64 [ 0, %entry ], [ %next, %body ]',
+             '  %base = mul i64 %i, 8']
+    args = []
+    for k in range(8):
+        lines.append('  %%idx%d = add i64 %%base, %d' % (k, k))
+        lines.append('  %%src%d = getelementptr %s* %%in, i64 %%idx%d'
+                     % (k, mem_ty, k))
+        lines.append('  %%srcp%d = bitcast %s* %%src%d to %s*'
+                     % (k, mem_ty, k, in_ty))
+        lines.append('  %%v%d = load %s* %%srcp%d, align 16' % (k, in_ty, k))
+        args.append('%s %%v%d' % (in_ty, k))
+    lines.append('  %%r = call %s @%s(%s)' % (struct, intrinsic, ', '.join(args)))
+    for k in range(8):
+        lines.append('  %%r%d = extractvalue %s %%r, %d' % (k, struct, k))
+        lines.append('  %%dst%d = getelementptr %s* %%out, i64 %%idx%d'
+                     % (k, mem_ty, k))
+        lines.append('  %%dstp%d = bitcast %s* %%dst%d to %s*'
+                     % (k, mem_ty, k, out_ty))
+        lines.append('  store %s %%r%d, %s* %%dstp%d, align 16'
+                     % (out_ty, k, out_ty, k))
+    lines += ['  %next = add i64 %i, 1',
+              '  %again = icmp slt i64 %next, %blocks',
+              '  br i1 %again, label %body, label %done',
+              'done:',
+              '  ret void',
+              '}']
+    return '\n'.join(lines) + '\n'
+
+def generate(width):
+    suffix = '' if width == 128 else '.256'
+    bytes_ty = '<%d x i8>' % (width // 8)
+    bits_ty = '<%d x i1>' % width
+    return (loop('s2p_loop', 'llvm.x86.parabix.s2p' + suffix,
+                 bytes_ty, bits_ty, bytes_ty) +
+            loop('p2s_loop', 'llvm.x86.parabix.p2s' + suffix,
+                 bits_ty, bytes_ty, bytes_ty))
+
+def check_call(cmd):
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                            universal_newlines=True)
+    out, err = proc.communicate()
+    if proc.returncode != 0:
+        sys.exit('%s failed:\n%s%s' % (cmd[0], out, err))
+    return out
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--llc', default='llc')
+    parser.add_argument('--cc', default='cc')
+    parser.add_argument('--width', type=int, choices=[128, 256], default=128,
+                        help='bits per basis stream register')
+    parser.add_argument('--size', type=int, default=64 * 1024,
+                        help='bytes of stream per pass')
+    parser.add_argument('--iters', type=int, default=2000,
+                        help='passes over the buffer per measurement')
+    parser.add_argument('--keep', help='leave the generated files here')
+    parser.add_argument('extra', nargs='*', help='extra llc arguments')
+    args = parser.parse_args()
+
+    extra = args.extra
+    if args.width == 256 and not any('avx2' in a for a in extra):
+        extra = extra + ['-mattr=+avx2']
+
+    work = args.keep or tempfile.mkdtemp()
+    if not os.path.isdir(work):
+        os.makedirs(work)
+    try:
+        ll = os.path.join(work, 'transpose.ll')
+        asm = os.path.join(work, 'transpose.s')
+        driver = os.path.join(work, 'driver.c')
+        exe = os.path.join(work, 'transpose-bench')
+        with open(ll, 'w') as f:
+            f.write(generate(args.width))
+        with open(driver, 'w') as f:
+            f.write(DRIVER)
+        check_call([args.llc, '-O3', '-mtriple=x86_64-unknown-unknown',
+                    '-o', asm, ll] + extra)
+        check_call([args.cc, '-O2', '-o', exe, driver, asm])
+        print(check_call([exe, str(args.size), str(args.iters),
+                          str(args.width)]), end='')
+    finally:
+        if not args.keep:
+            shutil.rmtree(work)
+
+if __name__ == '__main__':
+    main()
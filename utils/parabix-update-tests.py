@@ -0,0 +1,196 @@
+#!/usr/bin/env python
+
+"""Regenerate the test/Parabix/ops_<type>.ll tests.
+
+Each test holds one function per operation on a Parabix stream type and pins
+the instruction sequence llc emits for it with SSE2, AVX, AVX2 and
+AVX2+BMI2. Runs that emit the same sequence share a check prefix: CHECK for
+all of them, AVXANY for AVX and up, AVX2ANY for AVX2 and AVX2+BMI2. Bodies
+longer than --max-lines (operations that are scalarized) only record their
+length in a comment.
+
+Run it from the top of the source tree after a lowering change and review
+the diff; the runtime cost of each operation is measured by
+llvm-parabix-bench.
+
+Usage:
+  parabix-update-tests.py [--llc path/to/llc] [--max-lines N] [type ...]
+"""
+
+from __future__ import print_function
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+TRIPLE = 'x86_64-unknown-linux-gnu'
+
+# (prefix, -mattr) for every run, in RUN line order.
+SUBTARGETS = [('SSE2', '+sse2'), ('AVX', '+avx'), ('AVX2', '+avx2'),
+              ('BMI2', '+avx2,+bmi,+bmi2')]
+
+# Shared prefixes, coarsest first.
+GROUPS = [('CHECK', ['SSE2', 'AVX', 'AVX2', 'BMI2']),
+          ('AVXANY', ['AVX', 'AVX2', 'BMI2']),
+          ('AVX2ANY', ['AVX2', 'BMI2'])]
+
+# (number of fields, field width); 256-bit streams need AVX2.
+TYPES = [(32, 1), (64, 1), (128, 1), (64, 2), (32, 4),
+         (256, 1), (128, 2), (64, 4)]
+
+BINARY = ['add', 'sub', 'mul', 'and', 'or', 'xor']
+SHIFTS = ['shl', 'lshr', 'ashr']
+PREDICATES = ['eq', 'ne', 'ult', 'ugt', 'ule', 'uge',
+              'slt', 'sgt', 'sle', 'sge']
+
+def type_name(n, w):
+    return 'v%di%d' % (n, w)
+
+def functions(n, w):
+    ty = '<%d x i%d>' % (n, w)
+    mask_ty = '<%d x i1>' % n
+    prefix = type_name(n, w) + '_'
+    def binary(name, body, args='%s %%a, %s %%b' % (ty, ty)):
+        return (prefix + name,
+                'define %s @%s%s(%s) nounwind {\n%s  ret %s %%r\n}\n'
+                % (ty, prefix, name, args, body, ty))
+    fns = []
+    for op in BINARY:
+        fns.append(binary(op, '  %%r = %s %s %%a, %%b\n' % (op, ty)))
+    # Every valid shift amount of an i1 field is zero.
+    if w > 1:
+        splat = '<%s>' % ', '.join(['i%d 1' % w] * n)
+        for op in SHIFTS:
+            fns.append(binary(op, '  %%r = %s %s %%a, %%b\n' % (op, ty)))
+        for op in SHIFTS:
+            fns.append(binary(op + '_1', '  %%r = %s %s %%a, %s\n'
+                              % (op, ty, splat)))
+    for pred in PREDICATES:
+        if w == 1:
+            body = '  %%r = icmp %s %s %%a, %%b\n' % (pred, ty)
+        else:
+            body = ('  %%c = icmp %s %s %%a, %%b\n'
+                    '  %%r = sext %s %%c to %s\n' % (pred, ty, mask_ty, ty))
+        fns.append(binary('icmp_' + pred, body))
+    fns.append(binary('select',
+                      '  %%r = select %s %%m, %s %%a, %s %%b\n'
+                      % (mask_ty, ty, ty),
+                      '%s %%m, %s %%a, %s %%b' % (mask_ty, ty, ty)))
+    return fns
+
+def run_llc(llc, ir, mattr):
+    cmd = [llc, '-mtriple=' + TRIPLE, '-mattr=' + mattr, '-asm-verbose=false']
+    proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE, universal_newlines=True)
+    out, err = proc.communicate(ir)
+    if proc.returncode != 0:
+        sys.exit('llc %s failed:\n%s' % (mattr, err))
+    return out
+
+LOCAL_LABEL = re.compile(r'\.(LCPI|LBB)[0-9]+_[0-9]+')
+
+def bodies(asm, names):
+    """Map each function name to its list of instruction lines."""
+    result = {}
+    cur = None
+    for line in asm.splitlines():
+        if cur is None:
+            if line.endswith(':') and line[:-1] in names:
+                cur = line[:-1]
+                result[cur] = []
+            continue
+        text = ' '.join(line.split())
+        if text.startswith('.size') or text.startswith('.Ltmp') or \
+           text.startswith('.Lfunc_end'):
+            cur = None
+            continue
+        if not text or (text.startswith('.') and
+                        not LOCAL_LABEL.match(text)):
+            continue
+        result[cur].append(LOCAL_LABEL.sub(
+            lambda m: '{{\\.%s[0-9]+_[0-9]+}}' % m.group(1), text))
+    return result
+
+def assign_prefixes(outputs, runs):
+    """Pick the coarsest prefixes that cover every run exactly once."""
+    chosen = []
+    uncovered = list(runs)
+    groups = [(p, members) for p, members in GROUPS
+              if all(r in runs for r in members)] + [(r, [r]) for r in runs]
+    for prefix, members in groups:
+        if any(r not in uncovered for r in members):
+            continue
+        if any(outputs[r] != outputs[members[0]] for r in members):
+            continue
+        chosen.append((runs.index(members[0]), prefix, outputs[members[0]]))
+        uncovered = [r for r in uncovered if r not in members]
+    return [(prefix, lines) for _, prefix, lines in sorted(chosen)]
+
+def run_prefixes(run, runs):
+    return [p for p, members in GROUPS
+            if run in members and all(r in runs for r in members)] + [run]
+
+def generate(llc, n, w, max_lines):
+    runs = [p for p, _ in SUBTARGETS if n * w <= 128 or p in ('AVX2', 'BMI2')]
+    fns = functions(n, w)
+    ir = ''.join(text for _, text in fns)
+    names = set(name for name, _ in fns)
+    asm = {}
+    for prefix, mattr in SUBTARGETS:
+        if prefix in runs:
+            asm[prefix] = bodies(run_llc(llc, ir, mattr), names)
+
+    out = []
+    for prefix, mattr in SUBTARGETS:
+        if prefix not in runs:
+            continue
+        checks = ' '.join('-check-prefix=%s' % p
+                          for p in run_prefixes(prefix, runs))
+        out.append('; RUN: llc < %%s -mtriple=%s -mattr=%s -asm-verbose=false '
+                   '| FileCheck %%s %s' % (TRIPLE, mattr, checks))
+    out.append('')
+    out.append('; Instruction sequences for every <%d x i%d> stream operation.'
+               % (n, w))
+    out.append('; Generated by utils/parabix-update-tests.py; regenerate '
+               'instead of editing.')
+    if len(runs) < len(SUBTARGETS):
+        out.append('; 256-bit streams are only legal with AVX2.')
+    out.append('')
+
+    for name, text in fns:
+        out.append(text.rstrip('\n'))
+        for prefix, lines in assign_prefixes(
+                dict((r, asm[r][name]) for r in runs), runs):
+            out.append('; %s-LABEL: %s:' % (prefix, name))
+            if len(lines) > max_lines:
+                out.append('; %d lines, scalarized; not pinned.' % len(lines))
+                continue
+            for line in lines:
+                out.append('; %s-NEXT: %s' % (prefix, line))
+        out.append('')
+    return '\n'.join(out)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--llc', default='llc')
+    parser.add_argument('--max-lines', type=int, default=64)
+    parser.add_argument('--outdir', default=os.path.join('test', 'Parabix'))
+    parser.add_argument('types', nargs='*',
+                        help='stream types to regenerate, e.g. v64i2')
+    args = parser.parse_args()
+
+    for n, w in TYPES:
+        name = type_name(n, w)
+        if args.types and name not in args.types:
+            continue
+        path = os.path.join(args.outdir, 'ops_%s.ll' % name)
+        with open(path, 'w') as f:
+            f.write(generate(args.llc, n, w, args.max_lines))
+        print('wrote ' + path)
+
+if __name__ == '__main__':
+    main()